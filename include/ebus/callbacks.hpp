@@ -52,6 +52,42 @@ struct BusEventInfo {
   void toJson(detail::JsonWriter& writer) const;
 };
 
+/**
+ * End-to-end timestamps of a session started by the local Scheduler, in
+ * microseconds on ebus::Clock (0 = milestone not reached). Queue-side stamps
+ * refer to the first attempt, bus-side stamps to the final attempt.
+ */
+struct SessionTimings {
+  uint64_t enqueued_us = 0;     // accepted by the Scheduler (or due time)
+  uint64_t dequeued_us = 0;     // taken from the queue for the first time
+  uint64_t bus_request_us = 0;  // bus requested at a SYN
+  uint64_t won_us = 0;          // arbitration won
+  uint64_t master_ack_us = 0;   // master part acknowledged by the target
+  uint64_t response_us = 0;     // telegram complete (slave response or ACK)
+  uint64_t delivered_us = 0;    // handed to the protocol callback
+  uint8_t priority = 0;
+
+  static uint64_t toMicros(Clock::time_point tp) {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            tp.time_since_epoch())
+            .count());
+  }
+
+  void toJson(detail::JsonWriter& writer) const;
+};
+
+/**
+ * Byte timing of a single telegram as observed by the Handler, in
+ * microseconds between byte receptions (0 = not measured, saturated at
+ * 65535).
+ */
+struct TelegramTimings {
+  uint16_t first_byte_us = 0;  // SYN to the source address (QQ)
+  uint16_t response_us = 0;    // master ACK to the first slave byte (NN)
+  uint8_t naks = 0;            // negative acknowledges before completion
+};
+
 /**
  * Unified carrier for protocol results (Success or Error).
  * Delivered to the user via the decoupled ProtocolCallback.
@@ -82,6 +118,13 @@ struct ProtocolInfo {
   ByteView master_view;
   ByteView slave_view;
 
+  // Latency breakdown of the finished session; only set for sessions of the
+  // local Scheduler and only valid during the callback.
+  const SessionTimings* timings = nullptr;
+
+  // Byte timing of the telegram; first_byte_us only for passive telegrams
+  TelegramTimings telegram_timings;
+
   void toJson(detail::JsonWriter& writer) const;
 };
 
@@ -39,11 +39,39 @@ struct RuntimeConfig {
   struct Network {
     uint32_t session_timeout_ms = 500;
     uint32_t transmit_timeout_ms = 250;
+    // Shared broadcast ring per client wire format, applied on start; a
+    // client lagging by more than half of it skips ahead
     size_t outbound_buffer_size = 4096;
+    // Read-only clients collect bus bytes for up to this window (or until
+    // SYN) into one send; write-capable clients always flush immediately
+    uint32_t readonly_flush_window_ms = 0;  // 0 = flush every byte
+    bool readonly_flush_on_syn = false;
     bool enable_server = false;
     uint16_t port_regular = 3333;
     uint16_t port_readonly = 3334;
     uint16_t port_enhanced = 3335;
+    uint16_t port_filtered = 3336;  // Telegram frames matching client filters
+    uint16_t port_metrics = 0;  // OpenMetrics HTTP endpoint, 0 = disabled
+    // AF_UNIX stream listeners for co-located clients (POSIX only), sharing
+    // the slots of their type; empty = disabled. With a path set, port 0
+    // leaves the type reachable only through the local socket.
+    std::string unix_path_regular;
+    std::string unix_path_readonly;
+    std::string unix_path_enhanced;
+    std::string unix_path_filtered;
+    // Client slots per type, applied on start; 0 disables the listener
+    size_t max_regular_clients = detail::NetworkLimits::max_clients;
+    size_t max_readonly_clients = detail::NetworkLimits::max_clients;
+    size_t max_enhanced_clients = detail::NetworkLimits::max_clients;
+    size_t max_filtered_clients = detail::NetworkLimits::max_clients;
+    // Bus sessions of the local scheduler per turn of each waiting
+    // write-capable client (fair queueing, 1 = round-robin)
+    uint8_t local_session_weight = 1;
+    // Reaction to a client lagging by more than half of the broadcast ring
+    SlowClientPolicy regular_slow_policy = SlowClientPolicy::drop_oldest;
+    SlowClientPolicy readonly_slow_policy = SlowClientPolicy::drop_oldest;
+    SlowClientPolicy enhanced_slow_policy = SlowClientPolicy::drop_oldest;
+    SlowClientPolicy filtered_slow_policy = SlowClientPolicy::drop_oldest;
   } network;
 
   struct Device {
@@ -51,6 +79,17 @@ struct RuntimeConfig {
     uint32_t initial_delay_s = 10;
     uint32_t startup_interval_s = 60;
     uint8_t max_startup_scans = 5;
+    // Device inventory snapshot, loaded on start and saved on stop; empty =
+    // disabled. Restored devices are not scanned again.
+    std::string inventory_path;
+    // Saves a changed inventory this often while running (0 = on stop only)
+    uint32_t inventory_interval_s = 300;
+    // Bytes available for device entries (identification, vendor data and
+    // traffic statistics); entries are allocated when a device first appears
+    uint32_t memory_budget = detail::DeviceLimits::memory_budget;
+    // Holds scans back until the rhythm of the other masters predicts a
+    // quiet bus window (at most IdleLimits::max_defer_ms)
+    bool idle_prediction = true;
   } device;
 
   struct Scheduler {
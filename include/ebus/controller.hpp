@@ -17,8 +17,11 @@
 #include "ebus/callbacks.hpp"
 #include "ebus/config.hpp"
 #include "ebus/device.hpp"
+#include "ebus/message_database.hpp"
 #include "ebus/metrics.hpp"
 #include "ebus/status.hpp"
+#include "ebus/subscription.hpp"
+#include "ebus/traffic.hpp"
 #include "ebus/types.hpp"
 
 namespace ebus {
@@ -190,6 +193,24 @@ class Controller {
    */
   void setTraceCallback(TraceCallback callback);
 
+  /**
+   * @brief Decodes every observed telegram with the given message
+   * definitions (nullptr disables decoding). Can be replaced while running.
+   */
+  void setMessageDatabase(std::shared_ptr<const MessageDatabase> database);
+
+  /**
+   * @brief Registers a callback for the named values decoded by the message
+   * database.
+   */
+  void setValueCallback(ValueCallback callback);
+
+  /**
+   * @brief Registers a callback for significant changes of subscribed
+   * values. It runs on the Reactor thread and may change the subscriptions.
+   */
+  void setChangeCallback(ChangeCallback callback);
+
   // Working Methods
 
   /**
@@ -226,6 +247,53 @@ class Controller {
    */
   void clearPollItems();
 
+  /**
+   * @brief Watches one field of a message for changes beyond its deadband.
+   * @return A unique ID for the subscription, or 0 if rejected.
+   */
+  uint16_t subscribe(const Subscription& subscription);
+
+  /**
+   * @brief Removes a subscription by ID.
+   */
+  void unsubscribe(uint16_t id);
+
+  /**
+   * @brief Clears all subscriptions.
+   */
+  void clearSubscriptions();
+
+  /**
+   * @brief Returns the recorded samples of a subscription with history
+   * enabled, oldest first.
+   */
+  void fetchHistory(uint16_t id,
+                    std::function<void(uint64_t timestamp, float value)>
+                        callback,
+                    const HistoryQuery& query = {}) const;
+
+  /**
+   * @brief Streams the value history of a subscription as JSON: samples
+   * {"t", "v"} or, with query.step_ms, buckets {"t", "n", "min", "mean",
+   * "max"}; timestamps in ms since epoch.
+   */
+  void fetchHistory(uint16_t id, const JsonChunkVisitor& visitor,
+                    const HistoryQuery& query = {}, bool pretty = false) const;
+
+  /**
+   * @brief Serializes the device inventory (identified devices, vendor data,
+   * observed addresses, scan quarantine) for a warm start. The same snapshot
+   * is written to device.inventory_path, if configured.
+   */
+  std::vector<uint8_t> saveInventory() const;
+
+  /**
+   * @brief Merges a snapshot from saveInventory() into the inventory;
+   * restored devices are not scanned again. Call before start().
+   * @return false if the snapshot is malformed.
+   */
+  bool loadInventory(ByteView snapshot);
+
   /**
    * @brief Standard eBUS System Discovery: Broadcast "Inquiry of Existence"
    * (07h FEh) This advises other masters that a new participant has entered the
@@ -290,6 +358,37 @@ class Controller {
    */
   void fetchMetrics(const JsonChunkVisitor& visitor, bool pretty = false) const;
 
+  /**
+   * @brief Invokes a visitor callback with the latest metrics snapshot
+   * published by the reactor. Unlike fetchMetrics() this never takes the
+   * metrics lock, so slow consumers cannot delay protocol-side updates.
+   * @return false if no snapshot has been published yet.
+   */
+  bool fetchMetricsSnapshot(
+      std::function<void(const MetricsSnapshot&)> callback) const;
+
+  /**
+   * @brief Streams the latest metrics snapshot JSON (generation, metrics and
+   * the counter deltas to the previous snapshot) to the provided visitor.
+   */
+  void fetchMetricsSnapshot(const JsonChunkVisitor& visitor,
+                            bool pretty = false) const;
+
+  /**
+   * @brief Invokes a visitor callback with the latest traffic matrix
+   * (telegrams, wire bytes and errors per source/target pair and per
+   * service), published by the reactor about once per second. Lock-free.
+   * @return false if no matrix has been published yet.
+   */
+  bool fetchTrafficMatrix(
+      std::function<void(const TrafficMatrix&)> callback) const;
+
+  /**
+   * @brief Streams the latest traffic matrix JSON to the provided visitor.
+   */
+  void fetchTrafficMatrix(const JsonChunkVisitor& visitor,
+                          bool pretty = false) const;
+
   /**
    * @brief Returns the recent history of bus utilization percentages.
    */
@@ -351,11 +450,51 @@ class Controller {
    */
   void resetMetrics();
 
+  /**
+   * @brief Starts a new percentile window for all latency histograms while
+   * keeping the cumulative timing counters.
+   */
+  void resetLatencyWindow();
+
   /**
    * @brief Clears the diagnostic error log.
    */
   void clearErrors();
 
+  /**
+   * @brief Streams the timeline of the internal trace points (bus I/O, FSMs,
+   * scheduler, reactor and client I/O per thread) as Chrome trace-event
+   * JSON, viewable in chrome://tracing or Perfetto.
+   * @note Trace points are compiled in only with EBUS_TRACING; otherwise the
+   * event list is empty.
+   */
+  void fetchTraceEvents(const JsonChunkVisitor& visitor,
+                        bool pretty = false) const;
+
+  /**
+   * @brief Hides all trace events recorded so far from later dumps.
+   */
+  void clearTraceEvents();
+
+  /**
+   * @brief Starts a lossless binary capture of every bus byte (with its
+   * timestamp and FSM states) into rotating segment files named
+   * "<path_prefix>.<index>.ebcap". Only the newest max_segments segments are
+   * kept. Encoding and file I/O run on a dedicated writer thread.
+   * @return false if not configured, already capturing, or the first segment
+   * cannot be created.
+   */
+  bool startCapture(const std::string& path_prefix,
+                    size_t segment_size = 1024 * 1024,
+                    size_t max_segments = 8);
+
+  /**
+   * @brief Flushes pending records and closes the current capture segment.
+   */
+  void stopCapture();
+
+  bool isCapturing() const;
+
 #if EBUS_SIMULATION
   /**
    * @brief Returns a VirtualBus instance for direct interaction with the
@@ -7,13 +7,16 @@
 
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <limits>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
+#include "ebus/detail/protocol_limits.hpp"
 #include "ebus/sequence.hpp"
 #include "ebus/types.hpp"
 
@@ -96,12 +99,64 @@ struct DataTypeInfo : DataTypeInfoBase {
   void toJson(detail::JsonWriter& writer) const;
 };
 
+/**
+ * Inline value of the CHAR and HEX types. Holds up to max_text_bytes bytes
+ * (longer input is truncated) without touching the heap. Converts implicitly
+ * from and to strings so DataValue accepts literals and std::string.
+ */
+class DataString {
+ public:
+  static constexpr size_t capacity = detail::DataTypeLimits::max_text_bytes;
+
+  DataString() = default;
+  // cppcheck-suppress noExplicitConstructor
+  DataString(std::string_view s) noexcept { assign(s); }
+  // cppcheck-suppress noExplicitConstructor
+  DataString(const char* s) noexcept {
+    if (s) assign(s);
+  }
+  // cppcheck-suppress noExplicitConstructor
+  DataString(const std::string& s) noexcept { assign(s); }
+
+  void assign(std::string_view s) noexcept {
+    size_ = static_cast<uint8_t>(s.size() < capacity ? s.size() : capacity);
+    if (size_ > 0) std::memcpy(data_, s.data(), size_);
+  }
+
+  const char* data() const noexcept { return data_; }
+  size_t size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+  const char* begin() const noexcept { return data_; }
+  const char* end() const noexcept { return data_ + size_; }
+  char operator[](size_t i) const { return data_[i]; }
+
+  operator std::string_view() const noexcept {
+    return std::string_view(data_, size_);
+  }
+  std::string str() const { return std::string(data_, size_); }
+
+  friend bool operator==(const DataString& a, const DataString& b) noexcept {
+    return std::string_view(a) == std::string_view(b);
+  }
+  friend bool operator!=(const DataString& a, const DataString& b) noexcept {
+    return !(a == b);
+  }
+
+ private:
+  char data_[capacity] = {};
+  uint8_t size_ = 0;
+};
+
 /**
  * A variant containing any possible decoded eBUS value.
  */
 using DataValue =
     std::variant<std::monostate, uint8_t, int8_t, uint16_t, int16_t, uint32_t,
-                 int32_t, int64_t, float, std::string>;
+                 int32_t, int64_t, float, DataString>;
+
+static_assert(std::is_trivially_copyable_v<DataValue>,
+              "DataValue must stay heap-free and trivially copyable.");
+static_assert(sizeof(DataValue) <= 24, "DataValue should stay compact.");
 
 /* --- Core Operations --- */
 
@@ -118,6 +173,44 @@ using DataValue =
 std::optional<DataValue> decode(DataType dt, ByteView data,
                                 Endian e = Endian::little);
 
+/**
+ * One field of a batch of payloads sharing a layout, decoded into columns.
+ * Row i of ints holds what decode() returns as an integer (fixed-point for
+ * scaled types), row i of reals what asFloat() makes of it; either output may
+ * be nullptr. Bit i of nulls (LSB first) is set for replacement values,
+ * invalid BCD digits and payloads too short for the field; those rows hold 0.
+ */
+struct Column {
+  DataType type = DataType::error;
+  size_t offset = 0;  // byte offset of the field in every payload
+  Endian endian = Endian::little;
+
+  int64_t* ints = nullptr;   // count values
+  float* reals = nullptr;    // count values
+  uint8_t* nulls = nullptr;  // (count + 7) / 8 bytes
+
+  bool isNull(size_t row) const {
+    return nulls && (nulls[row / 8] >> (row % 8)) & 1;
+  }
+};
+
+/**
+ * Decodes one field of count payloads into column. BCD, DATA1C, DATA2B/C,
+ * UINT16/INT16 and their reversed variants run a loop specialised for the
+ * type; other numeric types fall back to decode() per row. Results are
+ * bit-identical to the scalar path. Non-numeric types yield null rows.
+ *
+ * @return The number of rows that are not null.
+ */
+size_t decodeColumn(const ByteView* payloads, size_t count,
+                    const Column& column);
+
+/**
+ * Decodes several fields of the same payloads, see decodeColumn().
+ */
+void decodeColumns(const ByteView* payloads, size_t count,
+                   const Column* columns, size_t column_count);
+
 /**
  * Performs a shallow validity check on a byte sequence for a specific type.
  * Verifies minimum size and data-specific constraints (e.g., BCD nibble
@@ -185,9 +278,10 @@ float asFloat(const DataValue& value) noexcept;
 int64_t asInt64(const DataValue& value) noexcept;
 
 /**
- * Returns a reference to the internal string if the variant holds one.
+ * Returns a view of the internal string if the variant holds one, otherwise
+ * an empty view. Valid as long as value.
  */
-std::string const& asString(const DataValue& value) noexcept;
+std::string_view asString(const DataValue& value) noexcept;
 
 /**
  * Formats a DataValue into a human-readable string.
@@ -92,8 +92,9 @@ inline constexpr uint8_t bus_syn_priority = 3;
 inline constexpr uint8_t bus_syn_priority = EBUS_BUS_SYN_PRIORITY;
 #endif
 
+// Sized for serving OpenMetrics scrapes (metrics and status snapshots)
 #ifndef EBUS_CLIENT_MANAGER_STACK_SIZE
-inline constexpr size_t client_manager_stack_size = 4096;
+inline constexpr size_t client_manager_stack_size = 6144;
 #else
 inline constexpr size_t client_manager_stack_size =
     EBUS_CLIENT_MANAGER_STACK_SIZE;
@@ -205,17 +206,169 @@ inline constexpr size_t trace_history_size = EBUS_TRACE_HISTORY_SIZE;
 #endif
 static_assert(trace_history_size >= 1,
               "Bus trace history size must be at least 1");
+
+/**
+ * Slots of the metrics snapshot buffer: latest, previous and spare slots for
+ * readers still holding an older snapshot.
+ */
+#ifndef EBUS_METRICS_SNAPSHOT_SLOTS
+inline constexpr size_t metrics_snapshot_slots = 4;
+#else
+inline constexpr size_t metrics_snapshot_slots = EBUS_METRICS_SNAPSHOT_SLOTS;
+#endif
+static_assert(metrics_snapshot_slots >= 3,
+              "Metrics snapshot slots must be at least 3");
+
+// Slots of the service status snapshot served to metrics scrapes
+inline constexpr size_t status_snapshot_slots = 3;
 }  // namespace DiagnosticsLimits
 
+namespace TraceLimits {
+/**
+ * Per-thread ring buffers of the timeline tracer (only used with
+ * EBUS_TRACING). Each event takes 24 bytes.
+ */
+#ifndef EBUS_TRACE_MAX_THREADS
+inline constexpr size_t max_threads = 8;
+#else
+inline constexpr size_t max_threads = EBUS_TRACE_MAX_THREADS;
+#endif
+static_assert(max_threads >= 1, "Trace threads must be at least 1");
+
+#ifndef EBUS_TRACE_EVENTS_PER_THREAD
+inline constexpr size_t events_per_thread = 256;
+#else
+inline constexpr size_t events_per_thread = EBUS_TRACE_EVENTS_PER_THREAD;
+#endif
+static_assert(events_per_thread >= 1,
+              "Trace events per thread must be at least 1");
+
+inline constexpr size_t thread_name_size = 16;
+}  // namespace TraceLimits
+
+namespace CaptureLimits {
+/**
+ * Bus events buffered between the bus thread and the capture writer. Events
+ * are dropped (and the next record flagged as a gap) when it overflows.
+ */
+#ifndef EBUS_CAPTURE_QUEUE_SIZE
+inline constexpr size_t queue_size = 256;
+#else
+inline constexpr size_t queue_size = EBUS_CAPTURE_QUEUE_SIZE;
+#endif
+static_assert(queue_size >= 1, "Capture queue size must be at least 1");
+
+inline constexpr size_t default_segment_size = 1024 * 1024;
+inline constexpr size_t min_segment_size = 1024;
+inline constexpr size_t default_max_segments = 8;
+inline constexpr uint32_t flush_interval_ms = 200;
+inline constexpr size_t stack_size = 3072;
+inline constexpr uint8_t priority = 3;
+}  // namespace CaptureLimits
+
+namespace HistogramLimits {
+/**
+ * Number of linear sub-buckets per power of two (2^bits). Higher values
+ * improve percentile precision (~1/2^bits relative error) at the cost of RAM.
+ */
+#ifndef EBUS_HISTOGRAM_SUB_BUCKET_BITS
+inline constexpr uint32_t sub_bucket_bits = 3;
+#else
+inline constexpr uint32_t sub_bucket_bits = EBUS_HISTOGRAM_SUB_BUCKET_BITS;
+#endif
+static_assert(sub_bucket_bits >= 1 && sub_bucket_bits <= 6,
+              "Histogram sub bucket bits must be between 1 and 6");
+
+/**
+ * Highest tracked sample is 2^max_value_bits - 1 us (~16.7 s); larger samples
+ * are accumulated in the last bucket.
+ */
+inline constexpr uint32_t max_value_bits = 24;
+inline constexpr size_t bucket_count =
+    (max_value_bits - sub_bucket_bits + 1) * (size_t{1} << sub_bucket_bits);
+}  // namespace HistogramLimits
+
+namespace SessionLimits {
+/**
+ * Number of equally sized priority bands (0..255) used to aggregate the
+ * end-to-end latency of Scheduler sessions.
+ */
+#ifndef EBUS_SESSION_PRIORITY_CLASSES
+inline constexpr size_t priority_classes = 4;
+#else
+inline constexpr size_t priority_classes = EBUS_SESSION_PRIORITY_CLASSES;
+#endif
+static_assert(priority_classes >= 1 && priority_classes <= 256,
+              "Session priority classes must be between 1 and 256");
+
+inline constexpr size_t priorityClass(uint8_t priority) {
+  return (static_cast<size_t>(priority) * priority_classes) / 256;
+}
+
+/**
+ * Latency distributions per priority band. Each band keeps five TimingStats
+ * of HistogramLimits::bucket_count 32-bit buckets, i.e. priority_classes * 5 *
+ * bucket_count * 4 bytes of RAM per BusMonitor (~14 KB with the defaults).
+ * Build with EBUS_SESSION_STATS=0, or fewer priority classes, to save them;
+ * EBUS_MINIMAL_DIAGNOSTICS drops them by default.
+ */
+#ifndef EBUS_SESSION_STATS
+#ifndef EBUS_MINIMAL_DIAGNOSTICS
+#define EBUS_SESSION_STATS 1
+#else
+#define EBUS_SESSION_STATS 0
+#endif
+#endif
+// Bands that keep latency statistics
+inline constexpr size_t stats_classes =
+    EBUS_SESSION_STATS ? priority_classes : 0;
+}  // namespace SessionLimits
+
 // --- Networking Layer ---
 namespace NetworkLimits {
 inline constexpr uint32_t wake_interval_ms = 20;
 
+/**
+ * Default number of client slots per type (regular, read-only, enhanced,
+ * filtered). The runtime limits network.max_*_clients may raise it up to
+ * max_clients_per_type.
+ */
 #ifndef EBUS_MAX_CLIENTS
 inline constexpr size_t max_clients = 4;
 #else
 inline constexpr size_t max_clients = EBUS_MAX_CLIENTS;
 #endif
+inline constexpr size_t max_clients_per_type = 256;
+static_assert(max_clients <= max_clients_per_type,
+              "EBUS_MAX_CLIENTS must not exceed max_clients_per_type");
+
+// Client I/O loop: readiness wait timeout and events handled per wakeup
+inline constexpr uint32_t io_wait_timeout_ms = 10;
+inline constexpr size_t io_events_per_wait = 32;
+
+// Client output: private responses queued per client (enhanced protocol) and
+// segments gathered per writev() from the broadcast ring and the responses
+inline constexpr size_t client_response_slots = 32;
+inline constexpr size_t client_write_segments = 8;
+
+// Upper bound of the read-only flush window; longer windows would let the
+// broadcast ring lap a coalescing client on a busy bus
+inline constexpr uint32_t max_flush_window_ms = 100;
+
+// Session arbitration: highest weight of the local scheduler, and how long
+// its last bus request stays valid (it asks again every reactor tick)
+inline constexpr uint8_t max_session_weight = 8;
+inline constexpr uint32_t local_session_request_ms = 40;
+
+// AF_UNIX listener paths; sockaddr_un::sun_path holds 104 bytes on BSD and
+// 108 on Linux, including the terminator
+inline constexpr size_t max_unix_path_len = 103;
+
+// OpenMetrics scrape endpoint (HTTP)
+inline constexpr size_t metrics_max_connections = 2;
+inline constexpr size_t metrics_request_size = 512;
+inline constexpr uint32_t metrics_request_timeout_ms = 1000;
+inline constexpr uint32_t metrics_send_timeout_ms = 200;
 }  // namespace NetworkLimits
 
 // --- Application Layer ---
@@ -250,13 +403,22 @@ inline constexpr uint32_t status_update_interval_ms_slow = 500;
 }  // namespace ReactorLimits
 
 namespace DeviceLimits {
-#ifndef EBUS_MAX_DEVICES
-inline constexpr size_t max_devices = 16;
+// Default memory budget for device entries, see device.memory_budget
+#ifndef EBUS_DEVICE_MEMORY
+inline constexpr size_t memory_budget = 16384;
 #else
-inline constexpr size_t max_devices = EBUS_MAX_DEVICES;
+inline constexpr size_t memory_budget = EBUS_DEVICE_MEMORY;
 #endif
 
+// Entries are indexed by a byte; 255 covers every possible slave address
+inline constexpr size_t max_devices = 255;
+
 inline constexpr uint8_t scan_priority = 5;
+
+// Writer thread for periodic inventory saves; keeps file I/O off the Reactor
+inline constexpr size_t inventory_stack_size = 3072;
+inline constexpr uint8_t inventory_priority = 3;
+inline constexpr uint32_t inventory_wait_ms = 1000;
 }  // namespace DeviceLimits
 
 namespace SchedulerLimits {
@@ -281,6 +443,73 @@ inline constexpr size_t max_items = EBUS_POLL_MAX_ITEMS;
 static_assert(max_items >= 1, "Poll max items must be at least 1");
 }  // namespace PollLimits
 
+namespace SubscriptionLimits {
+#ifndef EBUS_MAX_SUBSCRIPTIONS
+inline constexpr size_t max_subscriptions = 32;
+#else
+inline constexpr size_t max_subscriptions = EBUS_MAX_SUBSCRIPTIONS;
+#endif
+static_assert(max_subscriptions >= 1,
+              "Subscription capacity must be at least 1");
+}  // namespace SubscriptionLimits
+
+namespace HistoryLimits {
+// Compressed samples per block; a regular, slowly changing value takes
+// about 2 bytes per sample, a noisy one up to 10
+inline constexpr size_t block_bytes = 256;
+// Memory cap of the value history; the oldest blocks are evicted beyond it
+#ifndef EBUS_HISTORY_BYTES
+inline constexpr size_t max_bytes = 16 * 1024;
+#else
+inline constexpr size_t max_bytes = EBUS_HISTORY_BYTES;
+#endif
+static_assert(max_bytes >= 2 * block_bytes,
+              "History needs room for at least two blocks");
+}  // namespace HistoryLimits
+
+namespace TrafficLimits {
+// Distinct source/target pairs and services (PB SB) of the traffic matrix
+#ifndef EBUS_TRAFFIC_MAX_PAIRS
+inline constexpr size_t max_pairs = 64;
+#else
+inline constexpr size_t max_pairs = EBUS_TRAFFIC_MAX_PAIRS;
+#endif
+#ifndef EBUS_TRAFFIC_MAX_SERVICES
+inline constexpr size_t max_services = 64;
+#else
+inline constexpr size_t max_services = EBUS_TRAFFIC_MAX_SERVICES;
+#endif
+static_assert(max_pairs >= 1 && max_pairs < 0x8000,
+              "Traffic pair capacity must be 1..32767");
+static_assert(max_services >= 1 && max_services < 0x8000,
+              "Traffic service capacity must be 1..32767");
+
+inline constexpr size_t snapshot_slots = 3;
+}  // namespace TrafficLimits
+
+namespace IdleLimits {
+// Telegrams of one master closer than this belong to the same burst
+inline constexpr uint32_t burst_gap_ms = 500;
+// A source counts as periodic after this many burst intervals in a row
+// within the tolerance of its mean period (percent, at least 100 ms)
+inline constexpr uint8_t min_matches = 3;
+inline constexpr uint32_t tolerance_percent = 20;
+inline constexpr uint32_t min_tolerance_ms = 100;
+inline constexpr uint32_t min_period_ms = 1000;
+inline constexpr uint32_t max_period_ms = 10 * 60 * 1000;
+// Margin around a predicted burst, added to twice its jitter
+inline constexpr uint32_t guard_ms = 50;
+// Bus time reserved for one scan telegram including arbitration and the
+// slave response
+inline constexpr uint32_t scan_window_ms = 200;
+// Background traffic waits at most this long for a quiet window
+#ifndef EBUS_IDLE_MAX_DEFER_MS
+inline constexpr uint32_t max_defer_ms = 5000;
+#else
+inline constexpr uint32_t max_defer_ms = EBUS_IDLE_MAX_DEFER_MS;
+#endif
+}  // namespace IdleLimits
+
 // --- Formatting Limits ---
 namespace FormattingLimits {
 inline constexpr float float_lower_threshold = 1e-6f;
@@ -326,8 +555,36 @@ inline constexpr size_t outbound_queue_capacity = 16;
 namespace EnhancedProtocolLimits {
 inline constexpr size_t max_sequence_len = 2;
 inline constexpr uint8_t data_threshold = 0x80;
+
+// Whole-telegram submission extension: longest message (ZZ PB SB NN data),
+// its result frame, submissions queued per client until the I/O loop hands
+// them to the scheduler, sessions awaiting their result and their priority
+inline constexpr size_t max_submit_len = 4 + SequenceLimits::max_data_bytes;
+inline constexpr size_t max_submit_result_len = 4 + 2 * max_submit_len;
+inline constexpr size_t max_queued_submits = 4;
+inline constexpr size_t max_pending_submits = 8;
+inline constexpr uint8_t submit_priority = 128;
 }  // namespace EnhancedProtocolLimits
 
+namespace FilteredProtocolLimits {
+// Filter rules per client, one bit each in the compiled lookup tables
+inline constexpr size_t max_rules = 32;
+// Longest client command: length, command and an 8 byte rule
+inline constexpr size_t max_command_len = 10;
+// Longest frame: length, kind, telegram type and both sequences with their
+// lengths
+inline constexpr size_t max_frame_len = 5 + 2 * SequenceLimits::model_capacity;
+}  // namespace FilteredProtocolLimits
+
+namespace MessageDatabaseLimits {
+// ID bytes following PB SB that identify a message; the index packs PB, SB,
+// the ID length and the ID bytes into one 64 bit key
+inline constexpr size_t max_id_bytes = 4;
+// Leading columns of an ebusd-style CSV definition and columns per field
+inline constexpr size_t message_columns = 9;
+inline constexpr size_t field_columns = 6;
+}  // namespace MessageDatabaseLimits
+
 // --- Data Type Sentinels (Replacement Values) ---
 namespace DataTypeLimits {
 inline constexpr uint8_t null_sentinel = 0xff;
@@ -337,6 +594,8 @@ inline constexpr uint16_t sentinel_16 = 0xffff;
 inline constexpr uint16_t sentinel_s16 = 0x8000;  // -32768
 inline constexpr uint32_t sentinel_32 = 0xffffffff;
 inline constexpr uint32_t sentinel_s32 = 0x80000000;  // -2147483648
+// Largest CHAR/HEX type, held inline by DataString
+inline constexpr size_t max_text_bytes = 8;
 }  // namespace DataTypeLimits
 
 // --- Fixed-Point Scaling ---
@@ -38,6 +38,21 @@ struct DeviceInfo {
 
   // Statistics
   uint32_t frequency = 0;  // Total messages observed from this device
+  // Loaded from a saved inventory and not observed on the bus since
+  bool restored = false;
+
+  // Traffic and health since start (not part of the saved inventory).
+  // Latencies are gaps between byte receptions in microseconds.
+  struct Traffic {
+    uint32_t telegrams = 0;  // completed telegrams as source or target
+    uint32_t bytes = 0;      // master part and slave response of these
+    uint32_t errors = 0;     // failed telegrams addressed to the device
+    uint32_t naks = 0;       // negative acknowledges in these telegrams
+    uint32_t response_mean_us = 0;  // master ACK to the first slave byte
+    uint32_t response_p99_us = 0;   // bucket upper bound, <= +25%
+    uint32_t first_byte_mean_us = 0;  // SYN to its master address (QQ)
+    uint64_t last_seen = 0;           // ms since epoch, 0 = never
+  } traffic;
 
   void toJson(detail::JsonWriter& writer) const;
 };
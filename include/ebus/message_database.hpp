@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ebus/data_types.hpp"
+#include "ebus/detail/delegate.hpp"
+#include "ebus/detail/protocol_limits.hpp"
+#include "ebus/types.hpp"
+
+namespace ebus {
+
+/**
+ * One named value inside the master or slave data of a message.
+ */
+struct FieldDefinition {
+  std::string name;
+  std::string unit;
+  DataType type = DataType::error;
+  bool slave = false;  // part of the telegram holding the field
+  // Byte offset into the data of the part; master data starts after the ID
+  uint8_t offset = 0;
+  // Applied to numeric values, which are then reported as float
+  float factor = 1.0f;
+};
+
+/**
+ * A message identified by target, PB, SB and the leading data bytes (ID).
+ */
+struct MessageDefinition {
+  std::string circuit;
+  std::string name;
+  bool any_target = true;  // matches every ZZ unless a target is given
+  uint8_t zz = 0;
+  uint8_t pb = 0;
+  uint8_t sb = 0;
+  std::array<uint8_t, detail::MessageDatabaseLimits::max_id_bytes> id{};
+  uint8_t id_size = 0;
+  std::vector<FieldDefinition> fields;
+};
+
+/**
+ * A decoded field of an observed telegram, valid during the callback only.
+ */
+struct ValueInfo {
+  std::string_view circuit;
+  std::string_view message;
+  std::string_view field;
+  std::string_view unit;
+  DataValue value;  // null state for replacement values
+
+  ByteView master_view;
+  ByteView slave_view;
+  uint64_t timestamp = 0;  // ms since epoch
+};
+
+using ValueCallback = detail::Delegate<void(const ValueInfo& info)>;
+
+/**
+ * Message definitions compiled into an index for decoding passive traffic.
+ *
+ * Definitions are kept in an array sorted by a 64 bit key of PB, SB, the ID
+ * length and the ID bytes. A lookup builds the key for every ID length in
+ * use (longest first) and binary searches the array, so the most specific
+ * definition wins; among equal keys a definition for the telegram's target
+ * precedes one that matches any target. The database is immutable once
+ * built and can be shared between threads.
+ */
+class MessageDatabase {
+ public:
+  struct LoadResult {
+    size_t added = 0;
+    size_t rejected = 0;  // malformed definitions or unknown types
+  };
+
+  /**
+   * @brief Adds a definition; call build() after the last one.
+   * @return false if the ID is too long or a field has no concrete type.
+   */
+  bool add(MessageDefinition definition);
+
+  /**
+   * @brief Loads ebusd-style CSV definitions and rebuilds the index.
+   *
+   * Columns: type,circuit,level,name,comment,qq,zz,pbsb,id followed by one
+   * group name,part,type,divider,unit,comment per field. Lines starting with
+   * '#' or '*' are skipped. Field offsets follow from the type sizes; an
+   * empty part means slave data for read ('r') and master data for other
+   * messages. Types are the library names (e.g. DATA2C) or the ebusd base
+   * types UCH, SCH, UIN, UIR, SIN, SIR, ULG, ULR, SLG, SLR, D1B, D1C, D2B,
+   * D2C, BCD, EXP, EXR, HEX:n, STR:n and IGN:n (skipped bytes).
+   */
+  LoadResult loadCsv(std::string_view csv);
+
+  /**
+   * @brief Loads a JSON array of definitions and rebuilds the index.
+   *
+   * [{"circuit": "bai", "name": "FlowTemp", "zz": "08", "pbsb": "b509",
+   *   "id": "0d1800", "fields": [{"name": "temp", "part": "s",
+   *   "type": "DATA2C", "offset": 0, "factor": 1, "unit": "°C"}]}]
+   *
+   * "zz", "id", "part", "offset", "factor" and "unit" are optional; fields
+   * without an offset follow the previous field of their part.
+   */
+  LoadResult loadJson(std::string_view json);
+
+  // Sorts the definitions into the lookup index
+  void build();
+
+  /**
+   * @brief Finds the definition of a telegram (QQ ZZ PB SB NN data).
+   * @return nullptr if no definition matches or the index is not built.
+   */
+  const MessageDefinition* find(ByteView master) const;
+
+  /**
+   * @brief Decodes all fields of a telegram into callback.
+   * @param slave The slave response (NN data) or empty.
+   * @return The matching definition, or nullptr.
+   */
+  const MessageDefinition* decode(ByteView master, ByteView slave,
+                                  uint64_t timestamp,
+                                  const ValueCallback& callback) const;
+
+  size_t size() const { return definitions_.size(); }
+  bool empty() const { return definitions_.empty(); }
+  void clear();
+
+ private:
+  struct IndexEntry {
+    uint64_t key = 0;
+    uint32_t definition = 0;
+  };
+
+  std::vector<MessageDefinition> definitions_;
+  std::vector<IndexEntry> index_;
+  uint8_t id_sizes_ = 0;  // bit n set if an ID of n bytes is defined
+  bool built_ = false;
+
+  static uint64_t makeKey(uint8_t pb, uint8_t sb, const uint8_t* id,
+                          uint8_t id_size);
+};
+
+}  // namespace ebus
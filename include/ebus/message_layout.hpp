@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+#include "ebus/data_types.hpp"
+#include "ebus/detail/protocol_limits.hpp"
+#include "ebus/types.hpp"
+
+namespace ebus {
+
+namespace detail {
+
+/**
+ * Compile-time decoding properties of a DataType. Mirrors the runtime meta
+ * table of decode(); the tests keep both bit-identical.
+ */
+struct FieldSpec {
+  enum class Kind { invalid, bcd, integer, scaled, real, text };
+  Kind kind = Kind::invalid;
+  uint8_t size = 0;
+  bool is_signed = false;
+  bool reversed = false;
+  bool has_replacement = false;
+  uint32_t replacement = 0;
+  int32_t num = 1;
+  int32_t den = 1;
+};
+
+constexpr FieldSpec fieldSpec(DataType dt) {
+  using K = FieldSpec::Kind;
+  switch (dt) {
+    case DataType::bcd:
+      return {K::bcd, 1, false, false, true, DataTypeLimits::null_sentinel};
+    case DataType::uint8:
+      return {K::integer, 1, false, false, true, DataTypeLimits::sentinel_8};
+    case DataType::int8:
+    case DataType::data1b:
+      return {K::integer, 1, true, false, true, DataTypeLimits::sentinel_s8};
+    case DataType::data1c:
+      return {
+          K::scaled, 1, false, false, true, DataTypeLimits::sentinel_8, 1, 2};
+    case DataType::uint16:
+    case DataType::uint16r:
+      return {K::integer, 2, false, dt == DataType::uint16r, true,
+              DataTypeLimits::sentinel_16};
+    case DataType::int16:
+    case DataType::int16r:
+      return {K::integer, 2, true, dt == DataType::int16r, true,
+              DataTypeLimits::sentinel_s16};
+    case DataType::data2b:
+    case DataType::data2br:
+      return {K::scaled, 2, true, dt == DataType::data2br, true,
+              DataTypeLimits::sentinel_s16, 1, 256};
+    case DataType::data2c:
+    case DataType::data2cr:
+      return {K::scaled, 2, true, dt == DataType::data2cr, true,
+              DataTypeLimits::sentinel_s16, 1, 16};
+    case DataType::uint32:
+    case DataType::uint32r:
+      return {K::integer, 4, false, dt == DataType::uint32r, true,
+              DataTypeLimits::sentinel_32};
+    case DataType::int32:
+    case DataType::int32r:
+      return {K::integer, 4, true, dt == DataType::int32r, true,
+              DataTypeLimits::sentinel_s32};
+    case DataType::float4:
+    case DataType::float4r:
+      return {K::real, 4, false, dt == DataType::float4r};
+    case DataType::error:
+    case DataType::auto_detect:
+      return {};
+    default:
+      return {K::text, static_cast<uint8_t>(sizeOfDataType(dt))};
+  }
+}
+
+template <typename T, size_t N>
+constexpr T readField(const uint8_t* data, bool big_endian) {
+  T val = 0;
+  for (size_t i = 0; i < N; ++i) {
+    const size_t shift = 8 * (big_endian ? N - 1 - i : i);
+    val |= static_cast<T>(static_cast<T>(data[i]) << shift);
+  }
+  return val;
+}
+
+// Decoded type of a field, matching the DataValue alternative of decode()
+template <DataType DT, FieldSpec::Kind K = fieldSpec(DT).kind>
+struct FieldValue;
+
+template <DataType DT>
+struct FieldValue<DT, FieldSpec::Kind::bcd> {
+  using type = uint8_t;
+};
+
+template <DataType DT>
+struct FieldValue<DT, FieldSpec::Kind::integer> {
+  static constexpr FieldSpec spec = fieldSpec(DT);
+  using unsigned_type = std::conditional_t<
+      spec.size == 1, uint8_t,
+      std::conditional_t<spec.size == 2, uint16_t, uint32_t>>;
+  using type = std::conditional_t<spec.is_signed,
+                                  std::make_signed_t<unsigned_type>,
+                                  unsigned_type>;
+};
+
+template <DataType DT>
+struct FieldValue<DT, FieldSpec::Kind::scaled> {
+  using type = int64_t;  // Fixed-point, see FixedPointLimits
+};
+
+template <DataType DT>
+struct FieldValue<DT, FieldSpec::Kind::real> {
+  using type = float;
+};
+
+template <DataType DT>
+struct FieldValue<DT, FieldSpec::Kind::text> {
+  using type = std::array<char, fieldSpec(DT).size>;
+};
+
+}  // namespace detail
+
+/**
+ * One field of a fixed message layout: a DataType at a byte offset of the
+ * payload. The value type, byte order, scale and replacement value are all
+ * resolved at compile time.
+ */
+template <DataType DT, size_t Offset, Endian E = Endian::little>
+struct Field {
+  static constexpr detail::FieldSpec spec = detail::fieldSpec(DT);
+  static_assert(spec.kind != detail::FieldSpec::Kind::invalid,
+                "Field requires a concrete DataType");
+
+  using value_type = typename detail::FieldValue<DT>::type;
+
+  static constexpr DataType type = DT;
+  static constexpr size_t offset = Offset;
+  static constexpr size_t end = Offset + spec.size;
+
+  /**
+   * @brief Decodes the field from a payload holding at least end bytes.
+   * @return The value, or nullopt for the replacement value and for invalid
+   * BCD digits (the cases decode() reports as null or nullopt).
+   */
+  static std::optional<value_type> decode(const uint8_t* payload) noexcept {
+    using K = detail::FieldSpec::Kind;
+    const uint8_t* data = payload + Offset;
+
+    if constexpr (spec.kind == K::text) {
+      value_type text;
+      std::memcpy(text.data(), data, spec.size);
+      return text;
+    } else {
+      constexpr bool big_endian =
+          spec.reversed ? (E == Endian::little) : (E == Endian::big);
+      using unsigned_type =
+          std::conditional_t<spec.size == 1, uint8_t,
+                             std::conditional_t<spec.size == 2, uint16_t,
+                                                uint32_t>>;
+      const unsigned_type bits =
+          detail::readField<unsigned_type, spec.size>(data, big_endian);
+
+      if constexpr (spec.kind == K::real) {
+        float val;
+        std::memcpy(&val, &bits, sizeof(val));
+        return val;
+      } else {
+        if constexpr (spec.has_replacement) {
+          if (bits == static_cast<unsigned_type>(spec.replacement))
+            return std::nullopt;
+        }
+
+        if constexpr (spec.kind == K::bcd) {
+          if ((bits & 0x0f) > 9 || (bits >> 4) > 9) return std::nullopt;
+          return static_cast<uint8_t>((bits >> 4) * 10 + (bits & 0x0f));
+        } else if constexpr (spec.kind == K::scaled) {
+          using signed_type = std::make_signed_t<unsigned_type>;
+          const int64_t raw =
+              spec.is_signed ? static_cast<int64_t>(
+                                   static_cast<signed_type>(bits))
+                             : static_cast<int64_t>(bits);
+          return raw * spec.num * detail::FixedPointLimits::fixed_point_scale /
+                 spec.den;
+        } else {
+          return static_cast<value_type>(bits);
+        }
+      }
+    }
+  }
+};
+
+/**
+ * A fixed payload layout decoded without runtime type dispatch, e.g.
+ *
+ *   using FlowTemp = MessageLayout<Field<DataType::data2c, 0>,
+ *                                  Field<DataType::bcd, 2>>;
+ *   FlowTemp::Values values;
+ *   if (FlowTemp::decode(slave_data, values)) ...
+ *
+ * The payload length is checked once against the compile-time size; every
+ * field then costs its loads, shifts and the replacement compare. Values is
+ * a tuple of std::optional<Field::value_type> in field order.
+ */
+template <typename... Fields>
+class MessageLayout {
+ public:
+  static_assert(sizeof...(Fields) > 0, "MessageLayout requires fields");
+
+  using Values = std::tuple<std::optional<typename Fields::value_type>...>;
+
+  template <size_t I>
+  using FieldAt = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+  static constexpr size_t field_count = sizeof...(Fields);
+  static constexpr size_t size = std::max({Fields::end...});
+  static_assert(size <= detail::SequenceLimits::max_data_bytes,
+                "Fields exceed the eBUS data bytes of a telegram");
+
+  /**
+   * @brief Decodes all fields of payload into values.
+   * @return false (values untouched) if payload is shorter than size.
+   */
+  static bool decode(ByteView payload, Values& values) noexcept {
+    if (payload.size() < size) return false;
+    values = Values{Fields::decode(payload.data())...};
+    return true;
+  }
+
+  static std::optional<Values> decode(ByteView payload) noexcept {
+    Values values;
+    if (!decode(payload, values)) return std::nullopt;
+    return values;
+  }
+};
+
+}  // namespace ebus
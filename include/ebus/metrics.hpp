@@ -22,7 +22,8 @@ class JsonWriter;  // Forward declaration
 namespace ebus {
 
 /**
- * Results of a rolling metric calculation.
+ * Results of a rolling metric calculation. Percentiles are taken from the
+ * current histogram window and stay 0 with EBUS_MINIMAL_DIAGNOSTICS.
  */
 struct MetricValues {
   MetricValues() = default;
@@ -32,6 +33,9 @@ struct MetricValues {
   uint32_t max_us = 0;
   uint64_t sum_us = 0;
   uint64_t count = 0;
+  uint32_t p50_us = 0;
+  uint32_t p95_us = 0;
+  uint32_t p99_us = 0;
 
   void toJson(detail::JsonWriter& writer) const;
 };
@@ -166,6 +170,34 @@ struct ReactorMetrics {
   void toJson(detail::JsonWriter& writer) const;
 };
 
+/**
+ * End-to-end latency breakdown of Scheduler sessions within one priority band.
+ * Each segment only counts sessions that reached both of its milestones.
+ */
+struct SessionClassMetrics {
+  uint8_t priority_min = 0;
+  uint8_t priority_max = 0;
+
+  MetricValues queue_wait;  // enqueue -> first dequeue
+  MetricValues bus_wait;    // first dequeue -> arbitration won
+  MetricValues transfer;    // arbitration won -> telegram complete
+  MetricValues dispatch;    // telegram complete -> protocol callback
+  MetricValues total;       // enqueue -> protocol callback
+
+  void toJson(detail::JsonWriter& writer) const;
+};
+
+/**
+ * Session latency metrics per priority band (empty without
+ * EBUS_SESSION_STATS).
+ */
+struct SessionMetrics {
+  std::array<SessionClassMetrics, detail::SessionLimits::priority_classes>
+      classes{};
+
+  void toJson(detail::JsonWriter& writer) const;
+};
+
 /**
  * Aggregate system telemetry.
  */
@@ -175,6 +207,7 @@ struct SystemMetrics {
   BusMetrics bus;
   DeviceMetrics devices;
   ReactorMetrics reactor;
+  SessionMetrics sessions;
 
   void toJson(detail::JsonWriter& writer) const;
 };
@@ -186,4 +219,19 @@ struct SystemMetrics {
  */
 using Metrics = metrics::SystemMetrics;
 
+/**
+ * View of a metrics snapshot published periodically by the reactor. Readers
+ * access it without taking the metrics lock; the pointers are only valid
+ * inside the fetch callback. previous refers to the snapshot of
+ * generation - 1 while it is still retained, so interval deltas come for
+ * free.
+ */
+struct MetricsSnapshot {
+  uint64_t generation = 0;
+  const Metrics* current = nullptr;
+  const Metrics* previous = nullptr;
+
+  void toJson(detail::JsonWriter& writer) const;
+};
+
 }  // namespace ebus
\ No newline at end of file
@@ -8,7 +8,9 @@
 #include <bitset>
 #include <cstddef>
 #include <string>
+#include <vector>
 
+#include "ebus/metrics.hpp"
 #include "ebus/static_vector.hpp"
 #include "ebus/types.hpp"
 
@@ -76,6 +78,9 @@ struct ReactorStatus {
   uint32_t protocol_queue_dropped = 0;
   uint32_t bus_queue_dropped = 0;
   uint32_t max_loop_cycle_us = 0;
+  // Telegrams matched and not matched by the message database
+  uint32_t decoded_telegrams = 0;
+  uint32_t undecoded_telegrams = 0;
 
   void toJson(detail::JsonWriter& writer) const;
 };
@@ -117,6 +122,19 @@ struct SchedulerStatus {
   void toJson(detail::JsonWriter& writer) const;
 };
 
+/**
+ * Bridge latency per bus byte sent by a write-capable client (us), from
+ * receiving it on the socket to sending its bus echo back to the client.
+ */
+struct BridgeLatencyValues {
+  MetricValues receive_to_write;  // socket receive to bus write
+  MetricValues write_to_echo;     // bus write to echo, incl. arbitration
+  MetricValues echo_to_send;      // echo to socket send
+  MetricValues total;             // socket receive to echo sent
+
+  void toJson(detail::JsonWriter& writer) const;
+};
+
 /**
  * Detailed information about a connected network client.
  */
@@ -132,7 +150,20 @@ struct ClientInfo {
   FixedString<12> type;
   bool connected = false;
   bool write_capable = false;
-  size_t outbound_buffer_usage = 0;
+  size_t outbound_buffer_usage = 0;  // bytes not yet sent
+  FixedString<12> slow_policy;       // reaction to lagging behind the bus
+  uint64_t lag_bytes = 0;            // bus bytes not yet sent
+  uint64_t dropped_bytes = 0;        // skipped while lagging behind the bus
+  uint32_t overflows = 0;            // times the client fell too far behind
+  uint64_t send_calls = 0;           // socket writes since connect
+  uint64_t bytes_sent = 0;
+  float sends_per_second = 0.0f;     // average since connect
+  float bytes_per_send = 0.0f;
+  uint64_t sessions = 0;             // bridge sessions granted
+  float session_wait_avg_ms = 0.0f;  // request to start of a session
+  float session_wait_max_ms = 0.0f;
+  float session_share = 0.0f;        // fraction of all granted sessions
+  BridgeLatencyValues latency;       // write-capable clients only
 
   void toJson(detail::JsonWriter& writer) const;
 };
@@ -152,7 +183,18 @@ struct ClientManagerStatus {
   bool session_active = false;
   FixedString<12> session_state;
   FixedString<48> last_error;
-  StaticVector<ClientInfo, detail::NetworkLimits::max_clients> clients;
+  FixedString<8> io_backend;      // "epoll" or "select"
+  size_t client_capacity = 0;     // client slots over all types
+  uint32_t rejected_clients = 0;  // connections refused for lack of a slot
+  uint64_t io_events = 0;         // readiness events dispatched
+  MetricValues io_iteration;      // processing time per loop wakeup (us)
+  MetricValues accept_latency;    // readiness to client registration (us)
+  uint64_t local_sessions = 0;    // scheduler attempts granted the bus
+  float local_session_wait_avg_ms = 0.0f;
+  float local_session_wait_max_ms = 0.0f;
+  float local_session_share = 0.0f;
+  BridgeLatencyValues bridge_latency;  // over all write-capable clients
+  std::vector<ClientInfo> clients;
 
   void toJson(detail::JsonWriter& writer) const;
 };
@@ -164,6 +206,8 @@ struct DeviceManagerStatus {
   size_t identified_count = 0;
   size_t unknown_count = 0;
   size_t device_capacity = 0;
+  size_t restored_count = 0;  // loaded from a snapshot, not yet observed
+  size_t memory_usage = 0;    // bytes allocated for device entries
 
   void toJson(detail::JsonWriter& writer) const;
 };
@@ -201,6 +245,47 @@ struct PollManagerStatus {
   void toJson(detail::JsonWriter& writer) const;
 };
 
+/**
+ * Snapshot of the change-detection subscriptions. Matches counts decoded
+ * values, reports the callbacks fired for them.
+ */
+struct SubscriptionStatus {
+  size_t count = 0;
+  size_t capacity = 0;
+  uint64_t matches = 0;
+  uint64_t reports = 0;
+
+  // Compressed value history shared by all subscriptions
+  size_t history_samples = 0;
+  size_t history_bytes = 0;
+  size_t history_capacity = 0;
+  uint64_t history_evictions = 0;
+
+  void toJson(detail::JsonWriter& writer) const;
+};
+
+/**
+ * Snapshot of the idle-gap predictor. Deferrals count background commands
+ * held back for a quiet window, forced those sent after waiting too long.
+ * Arbitrations of own sessions are split by whether the session was
+ * scheduled into a predicted quiet window; the loss reduction compares the
+ * loss rate of those sessions with all others.
+ */
+struct IdlePredictorStatus {
+  bool enabled = false;
+  size_t sources = 0;
+  size_t periodic_sources = 0;
+  uint64_t deferrals = 0;
+  uint64_t forced = 0;
+  uint64_t quiet_won = 0;
+  uint64_t quiet_lost = 0;
+  uint64_t other_won = 0;
+  uint64_t other_lost = 0;
+  float loss_reduction_percent = 0.0f;
+
+  void toJson(detail::JsonWriter& writer) const;
+};
+
 /**
  * Minimal snapshot of system resources (stacks and queues).
  */
@@ -227,6 +312,8 @@ struct ServiceStatus {
   DeviceManagerStatus device_manager;
   DeviceScannerStatus device_scanner;
   PollManagerStatus poll_manager;
+  SubscriptionStatus subscriptions;
+  IdlePredictorStatus idle_predictor;
 
   void toJson(detail::JsonWriter& writer) const;
 };
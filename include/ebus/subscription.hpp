@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+#include "ebus/data_types.hpp"
+#include "ebus/detail/delegate.hpp"
+#include "ebus/detail/protocol_limits.hpp"
+#include "ebus/types.hpp"
+
+namespace ebus {
+
+/**
+ * A value watched for significant changes: a message key (target, PB, SB and
+ * the leading ID bytes of the master data) plus the layout of one field.
+ */
+struct Subscription {
+  bool any_target = true;  // matches every ZZ unless a target is given
+  uint8_t zz = 0;
+  uint8_t pb = 0;
+  uint8_t sb = 0;
+  std::array<uint8_t, detail::MessageDatabaseLimits::max_id_bytes> id{};
+  uint8_t id_size = 0;
+
+  DataType type = DataType::error;
+  bool slave = false;  // part of the telegram holding the field
+  // Byte offset into the data of the part; master data starts after the ID
+  uint8_t offset = 0;
+
+  // Smallest change worth reporting; a fraction of the last reported value
+  // if relative. Non-numeric values are reported on every difference.
+  float deadband = 0.0f;
+  bool relative = false;
+  // Reports an unchanged value again once this long has passed since the
+  // last report (0 = only on change)
+  uint32_t max_silence_ms = 0;
+
+  // Records every decoded numeric value in the compressed value history
+  bool history = false;
+};
+
+/**
+ * Selects samples from the value history of a subscription.
+ */
+struct HistoryQuery {
+  uint64_t from = 0;  // ms since epoch, inclusive
+  uint64_t to = std::numeric_limits<uint64_t>::max();
+  // Aggregates into min/mean/max buckets of this length (0 = raw samples)
+  uint32_t step_ms = 0;
+};
+
+/**
+ * A significant change of a subscribed value, valid during the callback only.
+ */
+struct ChangeInfo {
+  uint16_t subscription_id = 0;
+  DataValue value;     // null for replacement values
+  DataValue previous;  // last reported value, null on the first report
+  bool refresh = false;  // unchanged, reported because max_silence_ms passed
+
+  ByteView master_view;
+  ByteView slave_view;
+  uint64_t timestamp = 0;  // ms since epoch
+};
+
+using ChangeCallback = detail::Delegate<void(const ChangeInfo& info)>;
+
+}  // namespace ebus
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "ebus/detail/protocol_limits.hpp"
+#include "ebus/static_vector.hpp"
+#include "ebus/types.hpp"
+
+namespace ebus {
+
+/**
+ * Counters of one source/target pair or one service. Wire bytes are the
+ * bytes on the bus including escapes, CRCs and acknowledges, without SYN
+ * and repetitions.
+ */
+struct TrafficCount {
+  uint32_t telegrams = 0;
+  uint32_t wire_bytes = 0;
+  uint32_t errors = 0;
+};
+
+struct TrafficPair {
+  uint8_t source = 0;  // QQ
+  uint8_t target = 0;  // ZZ
+  TrafficCount count;
+};
+
+struct TrafficService {
+  uint8_t pb = 0;
+  uint8_t sb = 0;
+  TrafficCount count;
+  // Telegrams sent by the local address; a service with both own and foreign
+  // telegrams is polled by us and by another master
+  uint32_t own_telegrams = 0;
+};
+
+/**
+ * Published view of who talks to whom since start: a sparse source x target
+ * matrix and a histogram of the services (PB SB). Pairs and services beyond
+ * the capacity are only counted in the overflow totals.
+ */
+struct TrafficMatrix {
+  uint64_t generation = 0;
+  uint64_t timestamp = 0;  // ms since epoch of the snapshot
+
+  StaticVector<TrafficPair, detail::TrafficLimits::max_pairs> pairs;
+  StaticVector<TrafficService, detail::TrafficLimits::max_services> services;
+
+  TrafficCount total;
+  TrafficCount pair_overflow;
+  TrafficCount service_overflow;
+
+  void toJson(detail::JsonWriter& writer) const;
+};
+
+}  // namespace ebus
@@ -181,7 +181,16 @@ enum class ProtocolError : uint8_t {
 /**
  * Available client types for the network bridge.
  */
-enum class ClientType : uint8_t { read_only, regular, enhanced };
+enum class ClientType : uint8_t { read_only, regular, enhanced, filtered };
+
+/**
+ * Reaction to a bridge client falling too far behind the bus.
+ */
+enum class SlowClientPolicy : uint8_t {
+  drop_oldest,  // Skip the oldest bytes, keep a quarter of the buffer
+  skip_to_syn,  // Resume at a recent SYN, i.e. at a telegram start
+  disconnect    // Close the connection
+};
 
 enum class SessionState : uint8_t {
   idle,      // Waiting for a client to have data
@@ -200,6 +209,7 @@ const char* toString(RequestState state) noexcept;
 const char* toString(RequestResult state) noexcept;
 const char* toString(ProtocolError error) noexcept;
 const char* toString(ClientType type) noexcept;
+const char* toString(SlowClientPolicy policy) noexcept;
 const char* toString(SessionState state) noexcept;
 
 // --- Struct ---
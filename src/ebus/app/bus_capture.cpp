@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "app/bus_capture.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include "utils/logger.hpp"
+
+namespace ebus::detail {
+
+BusCapture::BusCapture() : queue_(CaptureLimits::queue_size) {}
+
+BusCapture::~BusCapture() { stop(); }
+
+bool BusCapture::start(const std::string& path_prefix, size_t segment_size,
+                       size_t max_segments) {
+  if (running_.load() || path_prefix.empty()) return false;
+
+  prefix_ = path_prefix;
+  segment_size_ = std::max(segment_size, CaptureLimits::min_segment_size);
+  max_segments_ = std::max<size_t>(max_segments, 1);
+  segment_index_ = 0;
+  seen_dropped_ = dropped_.load();
+
+  // Discard events queued by a previous capture
+  BusEventInfo stale;
+  while (queue_.tryPop(stale)) {
+  }
+
+  if (!openSegment(static_cast<uint64_t>(
+          Clock::now().time_since_epoch().count()))) {
+    EBUS_LOG_ERROR_F("[BusCapture] Cannot create segment '%s'",
+                     segmentPath(prefix_, 0).c_str());
+    return false;
+  }
+
+  running_.store(true, std::memory_order_release);
+  worker_ = std::make_unique<platform::ServiceThread>(
+      "ebus_capture",
+      Delegate<void()>::bind<BusCapture, &BusCapture::run>(this),
+      CaptureLimits::stack_size, CaptureLimits::priority);
+  worker_->start();
+
+  active_.store(true, std::memory_order_release);
+  return true;
+}
+
+void BusCapture::stop() {
+  active_.store(false, std::memory_order_release);
+  running_.store(false, std::memory_order_release);
+  if (worker_) {
+    worker_->join();
+    worker_.reset();
+  }
+  closeSegment();
+}
+
+void BusCapture::record(const BusEventInfo& info) {
+  if (!active_.load(std::memory_order_acquire)) return;
+  if (!queue_.tryPush(info)) dropped_.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::string BusCapture::segmentPath(const std::string& path_prefix,
+                                    uint32_t index) {
+  char suffix[24];
+  std::snprintf(suffix, sizeof(suffix), ".%06u.ebcap",
+                static_cast<unsigned>(index));
+  return path_prefix + suffix;
+}
+
+BusCapture::Stats BusCapture::stats() const {
+  Stats s;
+  s.records = records_.load(std::memory_order_relaxed);
+  s.bytes = bytes_.load(std::memory_order_relaxed);
+  s.dropped = dropped_.load(std::memory_order_relaxed);
+  s.segments = segments_.load(std::memory_order_relaxed);
+  return s;
+}
+
+void BusCapture::run() {
+  BusEventInfo info;
+  while (running_.load(std::memory_order_acquire)) {
+    if (queue_.pop(info, CaptureLimits::flush_interval_ms)) {
+      write(info);
+      while (queue_.tryPop(info)) write(info);
+    } else if (file_) {
+      std::fflush(file_);  // Idle: make the tail visible to readers
+    }
+  }
+
+  while (queue_.tryPop(info)) write(info);
+}
+
+void BusCapture::write(const BusEventInfo& info) {
+  capture::Record record;
+  record.timestamp_us =
+      static_cast<uint64_t>(info.timestamp.time_since_epoch().count());
+  record.byte = info.byte;
+  record.handler_state = info.handler_state;
+  record.request_state = info.request_state;
+  record.result = info.result;
+  record.lock_counter = info.lock_counter;
+
+  const uint32_t dropped = dropped_.load(std::memory_order_relaxed);
+  record.gap = dropped != seen_dropped_;
+
+  if (!file_ || segment_bytes_ + capture::max_record_size > segment_size_) {
+    closeSegment();
+    if (!openSegment(record.timestamp_us)) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+  }
+
+  uint8_t buffer[capture::max_record_size];
+  const size_t length = encoder_.encode(record, buffer);
+  if (std::fwrite(buffer, 1, length, file_) != length) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  seen_dropped_ = dropped;
+  segment_bytes_ += length;
+  records_.fetch_add(1, std::memory_order_relaxed);
+  bytes_.fetch_add(length, std::memory_order_relaxed);
+}
+
+bool BusCapture::openSegment(uint64_t base_us) {
+  const std::string path = segmentPath(prefix_, segment_index_);
+  file_ = std::fopen(path.c_str(), "wb");
+  if (!file_) return false;
+
+  capture::Header header;
+  header.base_us = base_us;
+  header.wall_us = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count());
+
+  uint8_t buffer[capture::header_size];
+  capture::encodeHeader(header, buffer);
+  if (std::fwrite(buffer, 1, sizeof(buffer), file_) != sizeof(buffer)) {
+    closeSegment();
+    return false;
+  }
+  encoder_.reset(base_us);
+  segment_bytes_ = sizeof(buffer);
+  bytes_.fetch_add(sizeof(buffer), std::memory_order_relaxed);
+  segments_.fetch_add(1, std::memory_order_relaxed);
+
+  // Rotate: keep only the newest max_segments_ files
+  if (segment_index_ >= max_segments_)
+    std::remove(segmentPath(prefix_, segment_index_ - max_segments_).c_str());
+  segment_index_++;
+  return true;
+}
+
+void BusCapture::closeSegment() {
+  if (file_) {
+    std::fclose(file_);
+    file_ = nullptr;
+  }
+}
+
+}  // namespace ebus::detail
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <ebus/callbacks.hpp>
+#include <ebus/detail/protocol_limits.hpp>
+#include <memory>
+#include <string>
+
+#include "platform/queue.hpp"
+#include "platform/service_thread.hpp"
+#include "utils/capture_format.hpp"
+
+namespace ebus::detail {
+
+/**
+ * Lossless capture of every bus byte into size-bounded, rotating segment
+ * files (see utils/capture_format.hpp). The bus thread only pushes the
+ * BusEventInfo into a queue; encoding and file I/O happen on a dedicated
+ * writer thread. Segments are named "<prefix>.<index>.ebcap"; only the newest
+ * max_segments files are kept.
+ */
+class BusCapture {
+ public:
+  // Public Types & Constants
+  struct Stats {
+    uint64_t records = 0;
+    uint64_t bytes = 0;     // encoded bytes incl. headers
+    uint32_t dropped = 0;   // records lost because the queue was full
+    uint32_t segments = 0;  // segments opened since start
+  };
+
+  // Lifecycle
+  BusCapture();
+  ~BusCapture();
+
+  /**
+   * @brief Starts capturing into segments of at most segment_size bytes.
+   * @return false if already running or the first segment cannot be created.
+   */
+  bool start(const std::string& path_prefix,
+             size_t segment_size = CaptureLimits::default_segment_size,
+             size_t max_segments = CaptureLimits::default_max_segments);
+
+  /**
+   * @brief Stops the writer after draining the queue and closes the segment.
+   */
+  void stop();
+
+  // Special Members & Operators
+  BusCapture(const BusCapture&) = delete;
+  BusCapture& operator=(const BusCapture&) = delete;
+
+  // Working Methods
+  /**
+   * @brief Queues a bus event for capture. Safe to call from the bus thread;
+   * never blocks.
+   */
+  void record(const BusEventInfo& info);
+
+  static std::string segmentPath(const std::string& path_prefix,
+                                 uint32_t index);
+
+  // Status/Telemetry
+  bool isActive() const { return active_.load(std::memory_order_acquire); }
+  Stats stats() const;
+
+ private:
+  platform::Queue<BusEventInfo> queue_;
+  std::unique_ptr<platform::ServiceThread> worker_;
+  std::atomic<bool> active_{false};
+  std::atomic<bool> running_{false};
+
+  std::atomic<uint64_t> records_{0};
+  std::atomic<uint64_t> bytes_{0};
+  std::atomic<uint32_t> dropped_{0};
+  std::atomic<uint32_t> segments_{0};
+
+  // Writer thread state
+  std::string prefix_;
+  size_t segment_size_ = 0;
+  size_t max_segments_ = 0;
+  FILE* file_ = nullptr;
+  uint32_t segment_index_ = 0;
+  size_t segment_bytes_ = 0;
+  uint32_t seen_dropped_ = 0;
+  capture::Encoder encoder_;
+
+  void run();
+  void write(const BusEventInfo& info);
+  bool openSegment(uint64_t base_us);
+  void closeSegment();
+};
+
+}  // namespace ebus::detail
@@ -51,6 +51,24 @@ void ProtocolInfo::toJson(detail::JsonWriter& writer) const {
 
   writer.writeHexField("master", master_view);
   writer.writeHexField("slave", slave_view);
+
+  if (timings) writer.writeField("timings", *timings);
+}
+
+void SessionTimings::toJson(detail::JsonWriter& writer) const {
+  // Durations relative to enqueue keep the output independent of the clock
+  auto since = [this](uint64_t stamp) -> int64_t {
+    return stamp > 0 ? static_cast<int64_t>(stamp - enqueued_us) : -1;
+  };
+
+  auto scope = writer.objectScope();
+  writer.writeField("priority", priority);
+  writer.writeField("dequeued_us", since(dequeued_us));
+  writer.writeField("bus_request_us", since(bus_request_us));
+  writer.writeField("won_us", since(won_us));
+  writer.writeField("master_ack_us", since(master_ack_us));
+  writer.writeField("response_us", since(response_us));
+  writer.writeField("delivered_us", since(delivered_us));
 }
 
 void ReactiveInfo::toJson(detail::JsonWriter& writer) const {
@@ -5,6 +5,10 @@
 
 #include "app/client.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstring>
 #include <ebus/utils.hpp>
 
 #include "utils/logger.hpp"
@@ -24,12 +28,18 @@ namespace ebus::detail {
 
 AbstractClient::AbstractClient(std::unique_ptr<platform::Socket> socket,
                                Request* request, bool write_capable,
-                               size_t max_buffer)
+                               size_t max_buffer, BroadcastRing* broadcast)
     : socket_(std::move(socket)),
       request_(request),
       write_capable_(write_capable),
-      max_buffer_size_(max_buffer),
-      outbound_buffer_(new uint8_t[max_buffer]) {}
+      connected_at_(Clock::now()) {
+  if (!broadcast) {
+    own_ring_ = std::make_unique<BroadcastRing>(max_buffer);
+    broadcast = own_ring_.get();
+  }
+  ring_ = broadcast;
+  cursor_ = ring_->head();
+}
 
 AbstractClient::~AbstractClient() { stop(); }
 
@@ -39,8 +49,32 @@ void AbstractClient::stop() {
   }
 }
 
-bool AbstractClient::flushOutgoingData() {
+void AbstractClient::attachBroadcast(BroadcastRing* broadcast) {
+  if (!broadcast) return;
+  platform::LockGuard<platform::Mutex> lock(io_mutex_);
+  ring_ = broadcast;
+  cursor_ = ring_->head();
+  own_ring_.reset();
+}
+
+bool AbstractClient::hasPendingOutgoingData() const {
   platform::LockGuard<platform::Mutex> lock(io_mutex_);
+  return response_count_ > 0 || cursor_ != ring_->head();
+}
+
+void AbstractClient::setSlowPolicy(SlowClientPolicy policy) {
+  platform::LockGuard<platform::Mutex> lock(io_mutex_);
+  slow_policy_ = policy;
+}
+
+void AbstractClient::setLatencyAggregate(BridgeLatency* aggregate) {
+  platform::LockGuard<platform::Mutex> lock(io_mutex_);
+  latency_aggregate_ = aggregate;
+}
+
+bool AbstractClient::flushOutgoingData(bool writable) {
+  platform::LockGuard<platform::Mutex> lock(io_mutex_);
+  if (writable) stalled_ = false;
   return flushLocked();
 }
 
@@ -48,29 +82,175 @@ bool AbstractClient::isConnected() const {
   return socket_ && socket_->isValid();
 }
 
+void AbstractClient::pushOutgoingLocked(const uint8_t* data, size_t len,
+                                        size_t replaced_bus_bytes) {
+  if (len == 0) return;
+  if (own_ring_) {
+    own_ring_->append(data, std::min(len, own_ring_->lagLimit()));
+    return;
+  }
+
+  // Queued behind everything published so far
+  const uint64_t position = ring_->head();
+  for (size_t i = 0; i < len; i += sizeof(Response::data)) {
+    if (response_count_ == responses_.size()) {
+      dropped_bytes_ += len - i;  // Keep the queued sequences intact
+      return;
+    }
+    Response& response =
+        responses_[(response_head_ + response_count_) % responses_.size()];
+    response.position = position;
+    response.skip = static_cast<uint8_t>(i == 0 ? replaced_bus_bytes : 0);
+    response.size =
+        static_cast<uint8_t>(std::min(len - i, sizeof(Response::data)));
+    std::memcpy(response.data, data + i, response.size);
+    response_count_++;
+  }
+}
+
+void AbstractClient::markReceivedLocked(bool queue_was_empty) {
+  last_received_at_ = Clock::now();
+  if (queue_was_empty) received_at_ = last_received_at_;
+}
+
+void AbstractClient::markWrittenLocked(bool more_pending) {
+  written_at_ = Clock::now();
+  written_received_at_ = received_at_;
+  written_ = true;
+  recordLatency(&BridgeLatency::receive_to_write, received_at_, written_at_);
+  if (more_pending) received_at_ = last_received_at_;
+}
+
+void AbstractClient::markEchoedLocked() {
+  if (!written_) return;
+  written_ = false;
+  echoed_at_ = Clock::now();
+  recordLatency(&BridgeLatency::write_to_echo, written_at_, echoed_at_);
+  // The echo is published next, at the current head
+  echo_position_ = ring_->head();
+  echoed_ = true;
+}
+
+void AbstractClient::recordLatency(TimingStats BridgeLatency::*stage,
+                                   const Clock::time_point& begin,
+                                   const Clock::time_point& end) {
+  (latency_.*stage).addDurationWithTime(begin, end);
+  if (latency_aggregate_)
+    (latency_aggregate_->*stage).addDurationWithTime(begin, end);
+}
+
+void AbstractClient::forwardBusByte(uint8_t byte) {
+  if (!own_ring_) return;
+  if (byte == Symbols::syn) {
+    platform::LockGuard<platform::Mutex> lock(io_mutex_);
+    own_ring_->markBoundary();
+  }
+  enqueueOutgoingData(ByteView(&byte, 1));
+}
+
+bool AbstractClient::skipLaggingLocked(uint64_t head) {
+  overflows_++;
+  if (slow_policy_ == SlowClientPolicy::disconnect) {
+    EBUS_LOG_INFO_F("[Client fd=%d] lagging %" PRIu64 " bytes, disconnecting",
+                    socket_->getFd(), head - cursor_);
+    return false;
+  }
+
+  // Keep the newest quarter of the ring; framed output always resumes at a
+  // frame start
+  uint64_t target = head - ring_->lagLimit() / 2;
+  if (slow_policy_ == SlowClientPolicy::skip_to_syn || framedOutput()) {
+    if (!ring_->nextBoundary(target, target)) {
+      target = head;
+      resync_ = true;
+    }
+  } else {
+    while (target < head && !startsSequence(ring_->at(target))) target++;
+  }
+  dropped_bytes_ += target - cursor_;
+  cursor_ = target;
+  return true;
+}
+
+size_t AbstractClient::pendingBytesLocked() const {
+  size_t pending = static_cast<size_t>(ring_->head() - cursor_);
+  for (size_t i = 0; i < response_count_; ++i)
+    pending += responses_[(response_head_ + i) % responses_.size()].size;
+  return pending - response_offset_;
+}
+
 bool AbstractClient::flushLocked() {
   if (!socket_ || !socket_->isValid()) return false;
-  if (count_ == 0) return true;
-
-  while (count_ > 0) {
-    // Send in one or two parts depending on circular wrap
-    size_t part_len = std::min(count_, max_buffer_size_ - head_);
-    ssize_t n = socket_->write(&outbound_buffer_[head_], part_len);
-
-    if (n > 0) {
-      head_ = (head_ + n) % max_buffer_size_;
-      count_ -= static_cast<size_t>(n);
-      // Partial send: kernel TCP send buffer full, stop for now (will retry)
-      if (static_cast<size_t>(n) < part_len) break;
-    } else if (n == 0) {
-      // Shouldn't happen on a connected socket
-      break;
-    } else {
-      // n < 0: check errno
+
+  constexpr size_t max_segments = NetworkLimits::client_write_segments;
+  struct iovec iov[max_segments];
+  bool is_response[max_segments];
+
+  while (true) {
+    const uint64_t head = ring_->head();
+    // Too far behind: the unsent bytes are about to be overwritten
+    if (ring_->isLagging(cursor_, head) && !skipLaggingLocked(head)) {
+      stop();
+      return false;
+    }
+    if (resync_) {
+      // Nothing is sent until a telegram starts
+      uint64_t boundary = head;
+      resync_ = !ring_->nextBoundary(cursor_, boundary);
+      dropped_bytes_ += boundary - cursor_;
+      cursor_ = boundary;
+    }
+    // A stalled socket costs no syscall until it reports writability
+    if (stalled_) break;
+
+    // Gather ring bytes up to each queued response, the response itself and
+    // finally the rest of the ring into one writev()
+    size_t count = 0;
+    size_t total = 0;
+    uint64_t position = cursor_;
+    size_t offset = response_offset_;
+    auto addRing = [&](uint64_t to) {
+      BroadcastRing::Segment segments[2];
+      size_t n = ring_->segments(position, to, segments);
+      for (size_t i = 0; i < n; ++i) {
+        iov[count] = {const_cast<uint8_t*>(segments[i].data), segments[i].size};
+        is_response[count++] = false;
+        total += segments[i].size;
+      }
+      if (to > position) position = to;
+    };
+
+    size_t index = 0;
+    for (; index < response_count_; ++index) {
+      Response& response =
+          responses_[(response_head_ + index) % responses_.size()];
+      // The replaced bus bytes are not published yet
+      if (response.skip && head < response.position + response.skip) break;
+      if (count + 3 > max_segments) break;
+
+      addRing(response.position);
+      iov[count] = {response.data + offset, response.size - offset};
+      is_response[count++] = true;
+      total += response.size - offset;
+      offset = 0;
+      position = std::max(position, response.position + response.skip);
+    }
+    if (count + 2 <= max_segments)
+      addRing(index < response_count_
+                  ? responses_[(response_head_ + index) % responses_.size()]
+                        .position
+                  : head);
+
+    if (total == 0) break;
+
+    ssize_t n = socket_->writev(iov, static_cast<int>(count));
+    send_calls_++;
+    if (n < 0) {
       int err = errno;
       if (err == EAGAIN || err == EWOULDBLOCK || err == EINTR) {
         // Expected on non-blocking socket: buffer full or interrupted, try
         // later
+        stalled_ = err != EINTR;
         break;
       }
       // Real error (ECONNRESET, EPIPE, EBADF ...): close socket
@@ -79,14 +259,47 @@ bool AbstractClient::flushLocked() {
       stop();
       return false;
     }
+
+    // Advance the cursor and the responses by what was actually sent
+    bytes_sent_ += static_cast<uint64_t>(n);
+    size_t left = static_cast<size_t>(n);
+    for (size_t i = 0; i < count && left > 0; ++i) {
+      const size_t sent = std::min(left, iov[i].iov_len);
+      left -= sent;
+      if (!is_response[i]) {
+        cursor_ += sent;
+        continue;
+      }
+      Response& front = responses_[response_head_];
+      response_offset_ += sent;
+      if (response_offset_ < front.size) break;
+      cursor_ = std::max(cursor_, front.position + front.skip);
+      response_head_ = (response_head_ + 1) % responses_.size();
+      response_count_--;
+      response_offset_ = 0;
+    }
+
+    if (echoed_ && cursor_ > echo_position_) {
+      echoed_ = false;
+      const auto now = Clock::now();
+      recordLatency(&BridgeLatency::echo_to_send, echoed_at_, now);
+      recordLatency(&BridgeLatency::total, written_received_at_, now);
+    }
+
+    // Partial send: kernel TCP send buffer full, stop for now (will retry)
+    if (static_cast<size_t>(n) < total) break;
   }
 
   return true;
 }
 
 ReadOnlyClient::ReadOnlyClient(std::unique_ptr<platform::Socket> socket,
-                               Request* request, size_t max_buffer)
-    : AbstractClient(std::move(socket), request, false, max_buffer) {}
+                               Request* request, size_t max_buffer,
+                               BroadcastRing* broadcast)
+    : AbstractClient(std::move(socket), request, false, max_buffer,
+                     broadcast) {}
+
+ClientType ReadOnlyClient::getType() const { return ClientType::read_only; }
 
 void ReadOnlyClient::handleIncomingStream(const uint8_t* data, size_t len) {
   (void)data;
@@ -109,38 +322,48 @@ BridgeAction ReadOnlyClient::onBusByte(const BusEventInfo&) {
   return BridgeAction::stop_session;
 }
 
+void AbstractClient::addOutputStatsLocked(ClientInfo& info) const {
+  info.slow_policy = toString(slow_policy_);
+  info.lag_bytes = ring_->head() - cursor_;
+  info.dropped_bytes = dropped_bytes_;
+  info.overflows = overflows_;
+  info.send_calls = send_calls_;
+  info.bytes_sent = bytes_sent_;
+  const float seconds =
+      std::chrono::duration<float>(Clock::now() - connected_at_).count();
+  if (seconds > 0.0f)
+    info.sends_per_second = static_cast<float>(send_calls_) / seconds;
+  if (send_calls_ > 0)
+    info.bytes_per_send =
+        static_cast<float>(bytes_sent_) / static_cast<float>(send_calls_);
+}
+
 void ReadOnlyClient::enqueueOutgoingData(ByteView data) {
   if (!socket_ || !socket_->isValid() || data.empty()) return;
-  {
-    platform::LockGuard<platform::Mutex> lock(io_mutex_);
-
-    // Drop oldest data if we would exceed capacity (O(1) in circular buffer)
-    if (count_ + data.size() > max_buffer_size_) {
-      size_t to_drop = (count_ + data.size()) - max_buffer_size_;
-      head_ = (head_ + to_drop) % max_buffer_size_;
-      count_ -= to_drop;
-    }
-
-    for (uint8_t b : data) {
-      outbound_buffer_[(head_ + count_) % max_buffer_size_] = b;
-      count_++;
-    }
-  }
+  platform::LockGuard<platform::Mutex> lock(io_mutex_);
+  pushOutgoingLocked(data.data(), data.size());
 }
 
 ClientInfo ReadOnlyClient::getClientInfo() const {
   platform::LockGuard<platform::Mutex> lock(io_mutex_);
-  return ClientInfo{socket_ ? socket_->getFd() : -1, "read_only", isConnected(),
-                    write_capable_, count_};
+  ClientInfo info{socket_ ? socket_->getFd() : -1, "read_only", isConnected(),
+                  write_capable_, pendingBytesLocked()};
+  addOutputStatsLocked(info);
+  return info;
 }
 
 RegularClient::RegularClient(std::unique_ptr<platform::Socket> socket,
-                             Request* request, size_t max_buffer)
-    : AbstractClient(std::move(socket), request, true, max_buffer) {}
+                             Request* request, size_t max_buffer,
+                             BroadcastRing* broadcast)
+    : AbstractClient(std::move(socket), request, true, max_buffer,
+                     broadcast) {}
+
+ClientType RegularClient::getType() const { return ClientType::regular; }
 
 void RegularClient::handleIncomingStream(const uint8_t* data, size_t len) {
   if (!isConnected() || !write_capable_ || len == 0) return;
   platform::LockGuard<platform::Mutex> lock(io_mutex_);
+  markReceivedLocked(inbound_buffer_.empty());
   // Queue all received bytes for byte-by-byte forwarding
   for (size_t i = 0; i < len; ++i) {
     // showSingle(">", data[i]);
@@ -158,6 +381,7 @@ bool RegularClient::popPendingIncomingData(uint8_t& out) {
   if (inbound_buffer_.empty()) return false;
   inbound_buffer_.pop(out);
   last_sent_byte_ = out;
+  markWrittenLocked(!inbound_buffer_.empty());
   return true;
 }
 
@@ -177,8 +401,9 @@ BridgeAction RegularClient::onBusByte(const BusEventInfo& info) {
     case RequestResult::first_won:
     case RequestResult::second_won:
       // Arbitration won: send address echo back to client and proceed to data
-      lock.unlock();  // Release lock before calling enqueueOutgoingData
-      enqueueOutgoingData(ByteView(&info.byte, 1));
+      markEchoedLocked();
+      lock.unlock();  // Release lock before forwarding the byte
+      forwardBusByte(info.byte);
       return BridgeAction::bypass_wait;
 
     case RequestResult::first_lost:
@@ -192,46 +417,41 @@ BridgeAction RegularClient::onBusByte(const BusEventInfo& info) {
     case RequestResult::observe_data:
       // Echo verification: if we are active, the next data byte must match
       if (info.byte != last_sent_byte_) return BridgeAction::stop_session;
-      lock.unlock();  // Release lock before calling enqueueOutgoingData
-      enqueueOutgoingData(ByteView(&info.byte, 1));
+      markEchoedLocked();
+      lock.unlock();  // Release lock before forwarding the byte
+      forwardBusByte(info.byte);
       return BridgeAction::bypass_wait;
 
     default:
       // Sniffing heartbeats (SYN) or transparent traffic
-      lock.unlock();  // Release lock before calling enqueueOutgoingData
-      enqueueOutgoingData(ByteView(&info.byte, 1));
+      lock.unlock();  // Release lock before forwarding the byte
+      forwardBusByte(info.byte);
       return BridgeAction::keep_active;
   }
 }
 
 void RegularClient::enqueueOutgoingData(ByteView data) {
   if (!socket_ || !socket_->isValid() || data.empty()) return;
-  {
-    platform::LockGuard<platform::Mutex> lock(io_mutex_);
-
-    if (count_ + data.size() > max_buffer_size_) {
-      size_t to_drop = (count_ + data.size()) - max_buffer_size_;
-      head_ = (head_ + to_drop) % max_buffer_size_;
-      count_ -= to_drop;
-    }
-
-    for (uint8_t b : data) {
-      // showSingle("<", b);
-      outbound_buffer_[(head_ + count_) % max_buffer_size_] = b;
-      count_++;
-    }
-  }
+  platform::LockGuard<platform::Mutex> lock(io_mutex_);
+  pushOutgoingLocked(data.data(), data.size());
 }
 
 ClientInfo RegularClient::getClientInfo() const {
   platform::LockGuard<platform::Mutex> lock(io_mutex_);
-  return ClientInfo{socket_ ? socket_->getFd() : -1, "regular", isConnected(),
-                    write_capable_, count_};
+  ClientInfo info{socket_ ? socket_->getFd() : -1, "regular", isConnected(),
+                  write_capable_, pendingBytesLocked()};
+  addOutputStatsLocked(info);
+  info.latency = latency_.getValues();
+  return info;
 }
 
 EnhancedClient::EnhancedClient(std::unique_ptr<platform::Socket> socket,
-                               Request* request, size_t max_buffer)
-    : AbstractClient(std::move(socket), request, true, max_buffer) {}
+                               Request* request, size_t max_buffer,
+                               BroadcastRing* broadcast)
+    : AbstractClient(std::move(socket), request, true, max_buffer,
+                     broadcast) {}
+
+ClientType EnhancedClient::getType() const { return ClientType::enhanced; }
 
 void EnhancedClient::onSessionStart(uint32_t session_id) {
   (void)session_id;
@@ -244,9 +464,11 @@ void EnhancedClient::handleIncomingStream(const uint8_t* data, size_t len) {
 
   bool need_reset_response = false;
   bool need_info_response = false;
+  size_t rejected_submits = 0;
 
   {
     platform::UniqueLock<platform::Mutex> lock(io_mutex_);
+    markReceivedLocked(inbound_buffer_.empty());
 
     for (size_t i = 0; i < len; ++i) {
       uint8_t b = data[i];
@@ -304,6 +526,9 @@ void EnhancedClient::handleIncomingStream(const uint8_t* data, size_t len) {
         case enhanced::Command::info:
           need_info_response = true;
           break;
+        case enhanced::Command::submit:
+          if (!submitByteLocked(data_val)) rejected_submits++;
+          break;
         default:
           break;
       }
@@ -325,6 +550,43 @@ void EnhancedClient::handleIncomingStream(const uint8_t* data, size_t len) {
     createEnhancedResponse(enhanced::Response::info, 0xc4);
     createEnhancedResponse(enhanced::Response::info, 0x31);
   }
+  for (size_t i = 0; i < rejected_submits; ++i)
+    onSubmitResult(enhanced::SubmitStatus::rejected, ByteView());
+}
+
+bool EnhancedClient::submitByteLocked(uint8_t value) {
+  if (submit_remaining_ == 0) {
+    // Length of the next telegram
+    if (value == 0) return false;
+    submit_buf_.clear();
+    submit_remaining_ = value;
+    submit_discard_ = value > EnhancedProtocolLimits::max_submit_len;
+    return true;
+  }
+
+  if (!submit_discard_) submit_buf_[submit_buf_.size_bytes++] = value;
+  if (--submit_remaining_ > 0) return true;
+  return !submit_discard_ && write_capable_ &&
+         submitted_.push_back(submit_buf_);
+}
+
+bool EnhancedClient::popSubmittedTelegram(SubmittedTelegram& out) {
+  platform::LockGuard<platform::Mutex> lock(io_mutex_);
+  if (submitted_.empty()) return false;
+  out = submitted_.front();
+  submitted_.erase(submitted_.begin());
+  return true;
+}
+
+void EnhancedClient::onSubmitResult(enhanced::SubmitStatus status,
+                                    ByteView payload) {
+  if (!isConnected()) return;
+  uint8_t out[EnhancedProtocolLimits::max_submit_result_len];
+  const size_t len = enhanced::Protocol::encodeSubmitResult(
+      status, payload.data(), payload.size(), out);
+
+  platform::LockGuard<platform::Mutex> lock(io_mutex_);
+  pushOutgoingLocked(out, len);
 }
 
 bool EnhancedClient::hasPendingIncomingData() const {
@@ -337,6 +599,7 @@ bool EnhancedClient::popPendingIncomingData(uint8_t& out) {
   if (inbound_buffer_.empty()) return false;
   inbound_buffer_.pop(out);
   last_sent_byte_ = out;
+  markWrittenLocked(!inbound_buffer_.empty());
   return true;
 }
 
@@ -359,25 +622,26 @@ BridgeAction EnhancedClient::onBusByte(const BusEventInfo& info) {
       // Arbitration lost: return 0x0A + the master address that actually won
       {
         uint8_t byte = info.byte;
-        lock.unlock();  // Release lock before calling createEnhancedResponse
-        createEnhancedResponse(enhanced::Response::failed, byte);
+        lock.unlock();  // Release lock before queueing the response
+        replaceBusByte(byte, enhanced::Response::failed, byte);
       }
       return BridgeAction::stop_session;
     case RequestResult::first_error:
     case RequestResult::retry_error:
     case RequestResult::second_error:
       // Physical layer error
-      lock.unlock();  // Release lock before calling createEnhancedResponse
-      createEnhancedResponse(enhanced::Response::error_ebus,
-                             static_cast<uint8_t>(enhanced::Error::framing));
+      lock.unlock();  // Release lock before queueing the response
+      replaceBusByte(info.byte, enhanced::Response::error_ebus,
+                     static_cast<uint8_t>(enhanced::Error::framing));
       return BridgeAction::stop_session;
     case RequestResult::first_won:
     case RequestResult::second_won:
       // Arbitration won: signal started
       {
         uint8_t byte = info.byte;
-        lock.unlock();  // Release lock before calling createEnhancedResponse
-        createEnhancedResponse(enhanced::Response::started, byte);
+        markEchoedLocked();
+        lock.unlock();  // Release lock before queueing the response
+        replaceBusByte(byte, enhanced::Response::started, byte);
       }
       return BridgeAction::bypass_wait;
     case RequestResult::observe_data:
@@ -385,8 +649,9 @@ BridgeAction EnhancedClient::onBusByte(const BusEventInfo& info) {
       {
         uint8_t byte = info.byte;
         bool match = (byte == last_sent_byte_);
-        lock.unlock();  // Release lock before calling createEnhancedResponse
-        createEnhancedResponse(enhanced::Response::received, byte);
+        if (match) markEchoedLocked();
+        lock.unlock();  // Release lock before forwarding the byte
+        forwardBusByte(byte);
         if (match) {
           return BridgeAction::bypass_wait;
         }
@@ -397,8 +662,8 @@ BridgeAction EnhancedClient::onBusByte(const BusEventInfo& info) {
       // Sniffing (SYN, retry steps, etc.)
       {
         uint8_t byte = info.byte;
-        lock.unlock();  // Release lock before calling createEnhancedResponse
-        createEnhancedResponse(enhanced::Response::received, byte);
+        lock.unlock();  // Release lock before forwarding the byte
+        forwardBusByte(byte);
       }
       return BridgeAction::keep_active;
   }
@@ -407,55 +672,33 @@ BridgeAction EnhancedClient::onBusByte(const BusEventInfo& info) {
 void EnhancedClient::enqueueOutgoingData(ByteView data) {
   if (!socket_ || !socket_->isValid() || data.empty()) return;
 
-  uint8_t cmd;
-  uint8_t val;
+  uint8_t out[detail::EnhancedProtocolLimits::max_sequence_len];
+  size_t len = sizeof(out);
 
   if (data.size() == 1) {
-    // Single byte from broadcast loop: always a received notification
-    cmd = static_cast<uint8_t>(enhanced::Response::received);
-    val = data[0];
+    // Single byte: always a received notification
+    len = enhanced::Protocol::encodeReceived(data[0], out);
+  } else if (data[0] == static_cast<uint8_t>(enhanced::Response::received)) {
+    len = enhanced::Protocol::encodeReceived(data[1], out);
   } else {
-    cmd = data[0];
-    val = data[1];
+    enhanced::Protocol::encode(data[0], data[1], out);
   }
 
-  {
-    platform::LockGuard<platform::Mutex> lock(io_mutex_);
-
-    constexpr size_t seq_len = detail::EnhancedProtocolLimits::max_sequence_len;
-    auto pushByte = [this](uint8_t b) {
-      if (count_ >= max_buffer_size_) {
-        head_ = (head_ + 1) % max_buffer_size_;
-        count_--;
-      }
-      outbound_buffer_[(head_ + count_) % max_buffer_size_] = b;
-      count_++;
-    };
-
-    // Ensure room for potential 2-byte sequence
-    while (count_ + seq_len > max_buffer_size_) {
-      head_ = (head_ + 1) % max_buffer_size_;
-      count_--;
-    }
+  platform::LockGuard<platform::Mutex> lock(io_mutex_);
+  pushOutgoingLocked(out, len);
+}
 
-    if (cmd == static_cast<uint8_t>(enhanced::Response::received) &&
-        val < detail::EnhancedProtocolLimits::data_threshold) {
-      pushByte(val);
-      // showSingle("<", val);
-    } else {
-      uint8_t out[seq_len];
-      enhanced::Protocol::encode(cmd, val, out);
-      pushByte(out[0]);
-      pushByte(out[1]);
-      // showDouble("<", cmd, val, out);
-    }
-  }
+bool EnhancedClient::startsSequence(uint8_t byte) const {
+  return (byte & 0xc0) != 0x80;
 }
 
 ClientInfo EnhancedClient::getClientInfo() const {
   platform::LockGuard<platform::Mutex> lock(io_mutex_);
-  return ClientInfo{socket_ ? socket_->getFd() : -1, "enhanced", isConnected(),
-                    write_capable_, count_};
+  ClientInfo info{socket_ ? socket_->getFd() : -1, "enhanced", isConnected(),
+                  write_capable_, pendingBytesLocked()};
+  addOutputStatsLocked(info);
+  info.latency = latency_.getValues();
+  return info;
 }
 
 void EnhancedClient::createEnhancedResponse(enhanced::Response res,
@@ -464,19 +707,116 @@ void EnhancedClient::createEnhancedResponse(enhanced::Response res,
   enqueueOutgoingData(ByteView(raw, 2));
 }
 
+void EnhancedClient::replaceBusByte(uint8_t bus_byte, enhanced::Response res,
+                                    uint8_t val) {
+  if (!socket_ || !socket_->isValid()) return;
+
+  uint8_t published[detail::EnhancedProtocolLimits::max_sequence_len];
+  uint8_t out[detail::EnhancedProtocolLimits::max_sequence_len];
+  enhanced::Protocol::encode(res, val, out);
+
+  platform::LockGuard<platform::Mutex> lock(io_mutex_);
+  pushOutgoingLocked(out, sizeof(out),
+                     enhanced::Protocol::encodeReceived(bus_byte, published));
+}
+
+FilteredClient::FilteredClient(std::unique_ptr<platform::Socket> socket,
+                               Request* request, size_t max_buffer)
+    : AbstractClient(std::move(socket), request, false, max_buffer) {}
+
+ClientType FilteredClient::getType() const { return ClientType::filtered; }
+
+bool FilteredClient::onTelegram(ByteView master, ByteView frame) {
+  if (!isConnected()) return false;
+  platform::LockGuard<platform::Mutex> lock(io_mutex_);
+  if (!filter_.matches(master)) return false;
+  pushFrameLocked(frame);
+  return true;
+}
+
+void FilteredClient::handleIncomingStream(const uint8_t* data, size_t len) {
+  for (size_t i = 0; i < len; ++i) {
+    incoming_buf_[incoming_len_++] = data[i];
+    const size_t expected = 1 + static_cast<size_t>(incoming_buf_[0]);
+    if (expected < 2 || expected > sizeof(incoming_buf_)) {
+      // Malformed length, resynchronize on the next byte
+      incoming_len_ = 0;
+      continue;
+    }
+    if (incoming_len_ < expected) continue;
+    handleCommand(incoming_buf_ + 1, expected - 1);
+    incoming_len_ = 0;
+  }
+}
+
+void FilteredClient::handleCommand(const uint8_t* command, size_t len) {
+  const auto cmd = static_cast<filtered::Command>(command[0]);
+  filtered::Status status = filtered::Status::rejected;
+
+  platform::LockGuard<platform::Mutex> lock(io_mutex_);
+  if (cmd == filtered::Command::clear && len == 1) {
+    filter_.clear();
+    status = filtered::Status::ok;
+  } else if (cmd == filtered::Command::add &&
+             len == 1 + filtered::Protocol::rule_len &&
+             filter_.add(filtered::Protocol::decodeRule(command + 1))) {
+    status = filtered::Status::ok;
+  }
+
+  uint8_t ack[filtered::Protocol::ack_len];
+  filtered::Protocol::encodeAck(cmd, status, filter_.size(), ack);
+  pushFrameLocked(ByteView(ack, sizeof(ack)));
+}
+
+void FilteredClient::pushFrameLocked(ByteView frame) {
+  ring_->markBoundary();
+  pushOutgoingLocked(frame.data(), frame.size());
+}
+
+bool FilteredClient::hasPendingIncomingData() const {
+  return false;  // Filtered clients never generate bus requests
+}
+
+bool FilteredClient::popPendingIncomingData(uint8_t& out) {
+  (void)out;
+  return false;
+}
+
+BridgeAction FilteredClient::onBusByte(const BusEventInfo&) {
+  // Never an active sender, telegrams arrive through onTelegram
+  return BridgeAction::stop_session;
+}
+
+void FilteredClient::enqueueOutgoingData(ByteView data) {
+  if (!socket_ || !socket_->isValid() || data.empty()) return;
+  platform::LockGuard<platform::Mutex> lock(io_mutex_);
+  pushOutgoingLocked(data.data(), data.size());
+}
+
+ClientInfo FilteredClient::getClientInfo() const {
+  platform::LockGuard<platform::Mutex> lock(io_mutex_);
+  ClientInfo info{socket_ ? socket_->getFd() : -1, "filtered", isConnected(),
+                  write_capable_, pendingBytesLocked()};
+  addOutputStatsLocked(info);
+  return info;
+}
+
 std::unique_ptr<AbstractClient> createClient(
     std::unique_ptr<platform::Socket> socket, Request* req, ClientType type,
-    size_t max_buffer) {
+    size_t max_buffer, BroadcastRing* broadcast) {
   switch (type) {
     case ClientType::read_only:
       return std::unique_ptr<AbstractClient>(
-          new ReadOnlyClient(std::move(socket), req, max_buffer));
+          new ReadOnlyClient(std::move(socket), req, max_buffer, broadcast));
     case ClientType::regular:
       return std::unique_ptr<AbstractClient>(
-          new RegularClient(std::move(socket), req, max_buffer));
+          new RegularClient(std::move(socket), req, max_buffer, broadcast));
     case ClientType::enhanced:
       return std::unique_ptr<AbstractClient>(
-          new EnhancedClient(std::move(socket), req, max_buffer));
+          new EnhancedClient(std::move(socket), req, max_buffer, broadcast));
+    case ClientType::filtered:
+      return std::unique_ptr<AbstractClient>(
+          new FilteredClient(std::move(socket), req, max_buffer));
     default:
       return nullptr;
   }
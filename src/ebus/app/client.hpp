@@ -5,10 +5,12 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <ebus/callbacks.hpp>
 #include <ebus/config.hpp>
 #include <ebus/detail/protocol_limits.hpp>
+#include <ebus/static_vector.hpp>
 #include <ebus/status.hpp>
 #include <ebus/types.hpp>
 #include <memory>
@@ -16,15 +18,35 @@
 #include <vector>
 
 #include "app/enhanced_protocol.hpp"
+#include "app/filtered_protocol.hpp"
 #include "core/request.hpp"
 #include "platform/mutex.hpp"
 #include "platform/queue.hpp"
 #include "platform/socket.hpp"
+#include "utils/broadcast_ring.hpp"
+#include "utils/timing_stats.hpp"
 
 namespace ebus::detail {
 
 class Request;
 
+// A whole master telegram submitted by a client (ZZ PB SB NN data)
+using SubmittedTelegram =
+    StaticSequence<EnhancedProtocolLimits::max_submit_len>;
+
+// Bridge latency stages of the bytes a write-capable client sends (us)
+struct BridgeLatency {
+  TimingStats receive_to_write;
+  TimingStats write_to_echo;
+  TimingStats echo_to_send;
+  TimingStats total;
+
+  BridgeLatencyValues getValues() const {
+    return {receive_to_write.getValues(), write_to_echo.getValues(),
+            echo_to_send.getValues(), total.getValues()};
+  }
+};
+
 enum class BridgeAction {
   keep_active,   // Sniffing or heartbeat: stay in current wait state
   stop_session,  // Error or collision: drop client
@@ -34,12 +56,20 @@ enum class BridgeAction {
 
 /**
  * Abstract base for WiFi/Network clients (e.g. ebusd bridges).
+ *
+ * Bus traffic is read from a BroadcastRing: the ClientManager appends every
+ * bus byte once to the ring of the client's wire format and each client only
+ * keeps its read cursor. Client-specific output (enhanced responses) is
+ * queued with the ring position it belongs to and may replace the bus byte
+ * published there. A client created without a shared ring owns a private
+ * ring of max_buffer bytes and stores all of its output in it.
  */
 class AbstractClient {
  public:
   // Lifecycle
   AbstractClient(std::unique_ptr<platform::Socket> socket, Request* request,
-                 bool write_capable, size_t max_buffer);
+                 bool write_capable, size_t max_buffer,
+                 BroadcastRing* broadcast = nullptr);
   virtual ~AbstractClient();
   void stop();
 
@@ -50,18 +80,69 @@ class AbstractClient {
   // Configuration
   int getFd() const { return socket_->getFd(); }
   bool isWriteCapable() const { return write_capable_; }
+  virtual ClientType getType() const = 0;
+
+  /**
+   * @brief Switches to the shared broadcast ring, starting at its current
+   * head. Output still pending in the private ring is discarded.
+   */
+  void attachBroadcast(BroadcastRing* broadcast);
+  bool sharesBroadcast() const { return !own_ring_; }
+
+  /**
+   * @brief Sets the reaction to lagging more than half of the ring behind.
+   * It is applied on the next flush, so a stalled client never holds up
+   * the bus thread or other clients.
+   */
+  void setSlowPolicy(SlowClientPolicy policy);
+
+  /**
+   * @brief Additionally records the bridge latency of this client into an
+   * aggregate over all clients, which must outlive the client.
+   */
+  void setLatencyAggregate(BridgeLatency* aggregate);
 
   // Working Methods
   virtual void onSessionStart(uint32_t session_id) { (void)session_id; }
+
+  /**
+   * @brief Offers a validated telegram (master starts with QQ ZZ PB SB) and
+   * its encoded frame. Called from the Reactor thread.
+   * @return true if the frame was queued.
+   */
+  virtual bool onTelegram(ByteView master, ByteView frame) {
+    (void)master;
+    (void)frame;
+    return false;
+  }
   virtual void handleIncomingStream(const uint8_t* data, size_t len) = 0;
   virtual bool hasPendingIncomingData() const = 0;
   virtual bool popPendingIncomingData(uint8_t& out) = 0;
 
+  /**
+   * @brief Takes the next telegram submitted as a whole (enhanced protocol
+   * extension), to be sent by the gateway instead of byte by byte.
+   */
+  virtual bool popSubmittedTelegram(SubmittedTelegram& out) {
+    (void)out;
+    return false;
+  }
+
+  // Queues the result frame of a submitted telegram
+  virtual void onSubmitResult(enhanced::SubmitStatus status,
+                              ByteView payload) {
+    (void)status;
+    (void)payload;
+  }
+
   // Logic to determine if the client wants to continue sending after a byte
   virtual BridgeAction onBusByte(const BusEventInfo& info) = 0;
+
+  // Client-specific output, sent before any bus byte published later
   virtual void enqueueOutgoingData(ByteView data) = 0;
-  bool hasPendingOutgoingData() const { return count_ > 0; }
-  bool flushOutgoingData();
+  bool hasPendingOutgoingData() const;
+  // writable: the socket reported writability after a stalled send
+  bool flushOutgoingData(bool writable = false);
 
   // Status/Telemetry
   bool isConnected() const;
@@ -71,16 +152,83 @@ class AbstractClient {
   // inline void armSynFilter() { filter_next_syn_ = true; }
 
  protected:
+  // Queued output of at most one enhanced sequence. It is sent when the
+  // cursor reaches position and replaces the skip ring bytes found there.
+  struct Response {
+    uint64_t position = 0;
+    uint8_t skip = 0;
+    uint8_t size = 0;
+    uint8_t data[detail::EnhancedProtocolLimits::max_sequence_len] = {};
+  };
+
   std::unique_ptr<platform::Socket> socket_;
   Request* request_;
   bool write_capable_;
-  size_t max_buffer_size_;
-  std::unique_ptr<uint8_t[]> outbound_buffer_;  // Fixed-size circular storage
-  size_t head_ = 0;                             // Index of the oldest byte
-  size_t count_ = 0;                  // Current number of bytes stored
-  mutable platform::Mutex io_mutex_;  // Protects outbound_buffer_
+  std::unique_ptr<BroadcastRing> own_ring_;  // Clients without shared ring
+  BroadcastRing* ring_ = nullptr;
+  uint64_t cursor_ = 0;  // Next ring position to send
+  std::array<Response, NetworkLimits::client_response_slots> responses_;
+  size_t response_head_ = 0;
+  size_t response_count_ = 0;
+  size_t response_offset_ = 0;        // Bytes of the oldest response sent
+  uint64_t dropped_bytes_ = 0;        // Lost to lagging or a full queue
+  uint32_t overflows_ = 0;            // Times the client fell too far behind
+  SlowClientPolicy slow_policy_ = SlowClientPolicy::drop_oldest;
+  bool resync_ = false;               // skip_to_syn: waiting for a boundary
+  bool stalled_ = false;              // Socket buffer full until writable
+  Clock::time_point connected_at_;
+  uint64_t send_calls_ = 0;           // writev() calls, also failed ones
+  uint64_t bytes_sent_ = 0;
+  mutable platform::Mutex io_mutex_;  // Protects the cursor and responses
+
+  // Byte in flight between socket and bus echo; protected by io_mutex_.
+  // Pipelined bytes are timed from the latest receive, which only a bridge
+  // sending ahead of its echoes sees.
+  BridgeLatency latency_;
+  BridgeLatency* latency_aggregate_ = nullptr;
+  Clock::time_point received_at_;       // oldest unsent inbound byte
+  Clock::time_point last_received_at_;  // latest socket receive
+  Clock::time_point written_at_;        // byte handed to the bus
+  Clock::time_point written_received_at_;
+  Clock::time_point echoed_at_;
+  uint64_t echo_position_ = 0;  // ring position of the echo
+  bool written_ = false;        // waiting for the echo
+  bool echoed_ = false;         // waiting for the echo to be sent
   bool filter_next_syn_ = false;      // ONE-SHOT: Filter next SYN (0xAA) only
 
+  /**
+   * @brief Queues client-specific bytes. replaced_bus_bytes ring bytes
+   * published at the current head are not sent (shared ring only).
+   * io_mutex_ MUST be locked.
+   */
+  void pushOutgoingLocked(const uint8_t* data, size_t len,
+                          size_t replaced_bus_bytes = 0);
+
+  // A bus byte reaches shared ring clients through the ring already
+  void forwardBusByte(uint8_t byte);
+
+  // Whether a ring byte may start a resumed stream (wire format specific)
+  virtual bool startsSequence(uint8_t byte) const {
+    (void)byte;
+    return true;
+  }
+
+  // Framed output marks every frame start as ring boundary
+  virtual bool framedOutput() const { return false; }
+
+  // Applies the slow policy; returns false if the client is to disconnect
+  bool skipLaggingLocked(uint64_t head);
+
+  // Bridge latency timestamps; io_mutex_ MUST be locked
+  void markReceivedLocked(bool queue_was_empty);
+  void markWrittenLocked(bool more_pending);
+  void markEchoedLocked();
+  void recordLatency(TimingStats BridgeLatency::*stage,
+                     const Clock::time_point& begin,
+                     const Clock::time_point& end);
+
+  size_t pendingBytesLocked() const;
+  void addOutputStatsLocked(ClientInfo& info) const;
   bool flushLocked();  // Internal flush logic; returns false if connection lost
 };
 
@@ -92,7 +240,10 @@ class ReadOnlyClient : public AbstractClient {
  public:
   // Lifecycle
   ReadOnlyClient(std::unique_ptr<platform::Socket> socket, Request* request,
-                 size_t max_buffer);
+                 size_t max_buffer, BroadcastRing* broadcast = nullptr);
+
+  // Configuration
+  ClientType getType() const override;
 
   // Working Methods
   void handleIncomingStream(const uint8_t* data, size_t len) override;
@@ -114,7 +265,10 @@ class RegularClient : public AbstractClient {
  public:
   // Lifecycle
   RegularClient(std::unique_ptr<platform::Socket> socket, Request* request,
-                size_t max_buffer);
+                size_t max_buffer, BroadcastRing* broadcast = nullptr);
+
+  // Configuration
+  ClientType getType() const override;
 
   // Working Methods
   void handleIncomingStream(const uint8_t* data, size_t len) override;
@@ -140,14 +294,21 @@ class EnhancedClient : public AbstractClient {
  public:
   // Lifecycle
   EnhancedClient(std::unique_ptr<platform::Socket> socket, Request* request,
-                 size_t max_buffer);
+                 size_t max_buffer, BroadcastRing* broadcast = nullptr);
   void onSessionStart(uint32_t session_id) override;
 
+  // Configuration
+  ClientType getType() const override;
+
   // Working Methods
   void handleIncomingStream(const uint8_t* data, size_t len) override;
   bool hasPendingIncomingData() const override;
   bool popPendingIncomingData(uint8_t& out) override;
 
+  bool popSubmittedTelegram(SubmittedTelegram& out) override;
+  void onSubmitResult(enhanced::SubmitStatus status,
+                      ByteView payload) override;
+
   BridgeAction onBusByte(const BusEventInfo& info) override;
   void enqueueOutgoingData(ByteView data) override;
 
@@ -160,14 +321,69 @@ class EnhancedClient : public AbstractClient {
   uint8_t incoming_buf_[detail::EnhancedProtocolLimits::max_sequence_len];
   size_t incoming_len_ = 0;
 
+  // Whole-telegram submission in progress and completed ones waiting for
+  // the I/O loop; protected by io_mutex_
+  SubmittedTelegram submit_buf_;
+  size_t submit_remaining_ = 0;  // Bytes still expected, 0 = length next
+  bool submit_discard_ = false;  // Invalid length: consume and reject
+  StaticVector<SubmittedTelegram, EnhancedProtocolLimits::max_queued_submits>
+      submitted_;
+
+  // Feeds one submit(value) sequence; returns false to reject it.
+  // io_mutex_ MUST be locked.
+  bool submitByteLocked(uint8_t value);
+
   platform::Queue<uint8_t> inbound_buffer_;
   uint8_t last_sent_byte_ = 0;  // last sent inbound byte on the bus
 
   void createEnhancedResponse(enhanced::Response res, uint8_t val);
+
+  // Answers the session's own bus byte instead of the "received" sequence
+  // published for it
+  void replaceBusByte(uint8_t bus_byte, enhanced::Response res, uint8_t val);
+
+  // Second bytes of an encoded sequence never start one
+  bool startsSequence(uint8_t byte) const override;
+};
+
+/**
+ * Filtered Client: Receives complete, validated telegrams matching its
+ * server-side filter rules as compact frames (see filtered_protocol.hpp)
+ * instead of the raw byte stream. Never writes to the bus.
+ */
+class FilteredClient : public AbstractClient {
+ public:
+  // Lifecycle
+  FilteredClient(std::unique_ptr<platform::Socket> socket, Request* request,
+                 size_t max_buffer);
+
+  // Configuration
+  ClientType getType() const override;
+
+  // Working Methods
+  bool onTelegram(ByteView master, ByteView frame) override;
+  void handleIncomingStream(const uint8_t* data, size_t len) override;
+  bool hasPendingIncomingData() const override;
+  bool popPendingIncomingData(uint8_t& out) override;
+
+  BridgeAction onBusByte(const BusEventInfo& info) override;
+  void enqueueOutgoingData(ByteView data) override;
+
+  // Status/Telemetry
+  ClientInfo getClientInfo() const override;
+
+ private:
+  uint8_t incoming_buf_[detail::FilteredProtocolLimits::max_command_len];
+  size_t incoming_len_ = 0;
+  filtered::Filter filter_;  // Protected by io_mutex_
+
+  bool framedOutput() const override { return true; }
+  void handleCommand(const uint8_t* command, size_t len);
+  void pushFrameLocked(ByteView frame);
 };
 
 std::unique_ptr<AbstractClient> createClient(
     std::unique_ptr<platform::Socket> socket, Request* req, ClientType type,
-    size_t max_buffer);
+    size_t max_buffer, BroadcastRing* broadcast = nullptr);
 
 }  // namespace ebus::detail
\ No newline at end of file
@@ -10,6 +10,8 @@
 #include <cassert>
 #include <cinttypes>
 #include <cstring>  // for strerror
+#include <iterator>
+#include <utility>
 #include <ebus/detail/protocol_limits.hpp>
 #include <ebus/static_vector.hpp>
 #include <ebus/utils.hpp>
@@ -21,9 +23,65 @@
 #include "platform/socket.hpp"
 #include "platform/system.hpp"
 #include "utils/logger.hpp"
+#include "utils/tracer.hpp"
 
 namespace ebus::detail {
 
+namespace {
+
+// Poller tokens: source in the top byte, client type and slot index below.
+// Metrics connections carry their fd as index (see MetricsEndpoint::attach).
+enum class PollSource : uint8_t {
+  wakeup,
+  listener,
+  local_listener,
+  metrics,
+  client
+};
+
+constexpr uint64_t pollToken(PollSource source, uint32_t type = 0,
+                             uint32_t index = 0) {
+  return (static_cast<uint64_t>(source) << 56) |
+         (static_cast<uint64_t>(type & 0xff) << 32) | index;
+}
+
+constexpr PollSource pollSource(uint64_t token) {
+  return static_cast<PollSource>(token >> 56);
+}
+
+constexpr ClientType pollType(uint64_t token) {
+  return static_cast<ClientType>((token >> 32) & 0xff);
+}
+
+constexpr uint32_t pollIndex(uint64_t token) {
+  return static_cast<uint32_t>(token);
+}
+
+constexpr ClientType client_types[] = {
+    ClientType::regular, ClientType::read_only, ClientType::enhanced,
+    ClientType::filtered};
+
+// Edge-triggered registrations watch writability permanently
+constexpr uint16_t client_events =
+    platform::IoPoller::in | platform::IoPoller::err |
+    (platform::IoPoller::edge_triggered ? platform::IoPoller::out : 0);
+
+const char* typeName(ClientType type) {
+  switch (type) {
+    case ClientType::read_only:
+      return "readonly";
+    case ClientType::enhanced:
+      return "enhanced";
+    case ClientType::filtered:
+      return "filtered";
+    case ClientType::regular:
+    default:
+      return "regular";
+  }
+}
+
+}  // namespace
+
 ClientManager::ClientManager(platform::Bus* bus, BusHandler* bus_handler,
                              Request* request, BusMonitor* monitor)
     : bus_(bus),
@@ -39,13 +97,22 @@ ClientManager::ClientManager(platform::Bus* bus, BusHandler* bus_handler,
           ebus::RuntimeConfig{}.network.transmit_timeout_ms)),
       outbound_buffer_size_(
           ebus::RuntimeConfig{}.network.outbound_buffer_size) {
-  regular_clients_.fill(nullptr);
-  readonly_clients_.fill(nullptr);
-  enhanced_clients_.fill(nullptr);
+  resizeBroadcast(outbound_buffer_size_);
+  for (ClientType type : client_types)
+    resizeSlots(slotsFor(type), type, NetworkLimits::max_clients);
+
+  if (!poller_.init()) {
+    EBUS_LOG_ERROR_F("[ClientManager] %s poller init failed",
+                     platform::IoPoller::backend);
+  }
 
   if (!wakeup_signal_.init()) {
     EBUS_LOG_ERROR("[ClientManager] WakeupSignal init failed");
+  } else {
+    poller_.add(wakeup_signal_.getReadFd(), pollToken(PollSource::wakeup),
+                platform::IoPoller::in);
   }
+  metrics_endpoint_.attach(&poller_, pollToken(PollSource::metrics));
 
   if (bus_handler_) {
     bus_handler_->setClientManagerBusEventInfoCallback(
@@ -71,45 +138,47 @@ void ClientManager::start(const RuntimeConfig& config) {
 
   {
     platform::LockGuard<platform::Mutex> lock(mutex_);
-    if (config.network.enable_server) {
-      listen_socket_regular_ = std::make_unique<platform::Socket>(
-          platform::Socket::createListenSocket(config.network.port_regular));
-      if (listen_socket_regular_->isValid()) {
-        EBUS_LOG_INFO_F(
-            "[ClientManager] Listening for regular clients on port %u",
-            config.network.port_regular);
-      } else {
-        EBUS_LOG_ERROR_F(
-            "[ClientManager] ERROR: Failed to listen for regular clients on "
-            "port %u",
-            config.network.port_regular);
-      }
+    // In the order of client_types
+    const size_t limits[] = {
+        config.network.max_regular_clients, config.network.max_readonly_clients,
+        config.network.max_enhanced_clients,
+        config.network.max_filtered_clients};
+    const uint16_t ports[] = {
+        config.network.port_regular, config.network.port_readonly,
+        config.network.port_enhanced, config.network.port_filtered};
+    const std::string* paths[] = {
+        &config.network.unix_path_regular, &config.network.unix_path_readonly,
+        &config.network.unix_path_enhanced,
+        &config.network.unix_path_filtered};
+    const SlowClientPolicy policies[] = {
+        config.network.regular_slow_policy, config.network.readonly_slow_policy,
+        config.network.enhanced_slow_policy,
+        config.network.filtered_slow_policy};
+
+    size_t capacity = 0;
+    for (size_t i = 0; i < std::size(client_types); ++i) {
+      resizeSlots(slotsFor(client_types[i]), client_types[i], limits[i]);
+      capacity += limits[i];
+      slow_policies_[static_cast<size_t>(client_types[i])] = policies[i];
+      for (auto& slot : slotsFor(client_types[i]))
+        if (slot.client) slot.client->setSlowPolicy(policies[i]);
+    }
+    to_stop_.reserve(capacity);
+    resizeBroadcast(outbound_buffer_size_);
+    flush_window_ms_.store(config.network.readonly_flush_window_ms);
+    flush_on_syn_.store(config.network.readonly_flush_on_syn);
+    local_share_.weight = config.network.local_session_weight;
 
-      listen_socket_readonly_ = std::make_unique<platform::Socket>(
-          platform::Socket::createListenSocket(config.network.port_readonly));
-      if (listen_socket_readonly_->isValid()) {
-        EBUS_LOG_INFO_F(
-            "[ClientManager] Listening for readonly clients on port %u",
-            config.network.port_readonly);
-      } else {
-        EBUS_LOG_ERROR_F(
-            "[ClientManager] ERROR: Failed to listen for readonly clients on "
-            "port %u",
-            config.network.port_readonly);
+    if (config.network.enable_server) {
+      for (size_t i = 0; i < std::size(client_types); ++i) {
+        // Port 0 leaves a type with a local socket reachable only locally
+        if (ports[i] != 0) openListener(client_types[i], ports[i], limits[i]);
+        if (!paths[i]->empty())
+          openLocalListener(client_types[i], *paths[i], limits[i]);
       }
 
-      listen_socket_enhanced_ = std::make_unique<platform::Socket>(
-          platform::Socket::createListenSocket(config.network.port_enhanced));
-      if (listen_socket_enhanced_->isValid()) {
-        EBUS_LOG_INFO_F(
-            "[ClientManager] Listening for enhanced clients on port %u",
-            config.network.port_enhanced);
-      } else {
-        EBUS_LOG_ERROR_F(
-            "[ClientManager] ERROR: Failed to listen for enhanced clients on "
-            "port %u",
-            config.network.port_enhanced);
-      }
+      if (config.network.port_metrics != 0)
+        metrics_endpoint_.start(config.network.port_metrics);
     }
   }
 
@@ -138,12 +207,28 @@ void ClientManager::stop() {
 
   stopActiveSession();
 
+  // The scheduler drops its sessions on stop without reporting a result;
+  // answer the submits still waiting for one so their slots are freed
+  StaticVector<std::shared_ptr<AbstractClient>,
+               EnhancedProtocolLimits::max_pending_submits>
+      dropped;
+  {
+    platform::LockGuard<platform::Mutex> lock(mutex_);
+    for (auto& submit : pending_submits_)
+      dropped.push_back(std::move(submit.client));
+    pending_submits_.clear();
+  }
+  for (auto& client : dropped)
+    if (client) client->onSubmitResult(enhanced::SubmitStatus::rejected, {});
+
   {
     platform::LockGuard<platform::Mutex> lock(mutex_);
-    listen_socket_regular_.reset();
-    listen_socket_readonly_.reset();
-    listen_socket_enhanced_.reset();
+    for (ClientType type : client_types) {
+      closeListener(type);
+      closeLocalListener(type);
+    }
   }
+  metrics_endpoint_.stop();
 }
 
 void ClientManager::setSessionTimeout(uint32_t timeout_ms) {
@@ -161,6 +246,21 @@ void ClientManager::setOutgoingBufferSize(size_t size) {
   outbound_buffer_size_ = size;
 }
 
+void ClientManager::setMetricsExporter(MetricsEndpoint::Exporter exporter) {
+  metrics_endpoint_.setExporter(std::move(exporter));
+}
+
+void ClientManager::setTelegramSubmitter(
+    Delegate<uint32_t(uint8_t, ByteView)> submitter) {
+  platform::LockGuard<platform::Mutex> lock(mutex_);
+  submitter_ = submitter;
+}
+
+void ClientManager::setLocalSessionWakeup(Delegate<void()> wakeup) {
+  platform::LockGuard<platform::Mutex> lock(mutex_);
+  local_wakeup_ = wakeup;
+}
+
 bool ClientManager::addClient(int fd, ClientType type) {
   platform::setNonBlocking(fd);
   // Explicitly keep TCP_NODELAY disabled (leave Nagle's algorithm ON) on
@@ -174,54 +274,11 @@ bool ClientManager::addClient(int fd, ClientType type) {
 
 bool ClientManager::addClient(std::unique_ptr<platform::Socket> socket,
                               ClientType type) {
-  // Thread 2 only (called from acceptNewConnections) — no mutex needed
-  auto client =
-      createClient(std::move(socket), request_, type, outbound_buffer_size_);
+  auto client = createClient(std::move(socket), request_, type,
+                             outbound_buffer_size_, broadcastFor(type));
   if (!client) return false;
 
-  int new_fd = client->getFd();
-
-  auto& clients = [&]() -> auto& {
-    switch (type) {
-      case ClientType::regular:
-        return regular_clients_;
-      case ClientType::read_only:
-        return readonly_clients_;
-      case ClientType::enhanced:
-        return enhanced_clients_;
-      default:
-        return regular_clients_;
-    }
-  }();
-
-  // Evict any stale disconnected entries to free slots
-  for (size_t i = 0; i < NetworkLimits::max_clients; ++i) {
-    if (clients[i] && !clients[i]->isConnected()) {
-      EBUS_LOG_INFO_F(
-          "[ClientManager] Evicting stale disconnected client fd=%d at slot "
-          "%zu",
-          clients[i]->getFd(), i);
-      clients[i]->stop();
-      clients[i].reset();
-    }
-  }
-
-  // Find first empty slot
-  for (size_t i = 0; i < NetworkLimits::max_clients; ++i) {
-    if (!clients[i]) {
-      EBUS_LOG_INFO_F(
-          "[ClientManager] Registered client fd=%d type=%d at slot %zu", new_fd,
-          static_cast<int>(type), i);
-      clients[i] = std::move(client);
-      return true;
-    }
-  }
-
-  EBUS_LOG_ERROR_F(
-      "[ClientManager] ERROR: No free slot for client fd=%d type=%d", new_fd,
-      static_cast<int>(type));
-  client->stop();
-  return false;
+  return insertClient(std::move(client), type);
 }
 
 bool ClientManager::addClient(std::shared_ptr<AbstractClient> client) {
@@ -229,47 +286,7 @@ bool ClientManager::addClient(std::shared_ptr<AbstractClient> client) {
 
   // For mock clients (used in tests), default to regular
   // Production code should use addClient(int fd, ClientType type) instead
-  ClientType type = ClientType::regular;
-
-  platform::LockGuard<platform::Mutex> lock(mutex_);
-
-  // Select the appropriate array based on type
-  auto& clients = [&]() -> auto& {
-    switch (type) {
-      case ClientType::regular:
-        return regular_clients_;
-      case ClientType::read_only:
-        return readonly_clients_;
-      case ClientType::enhanced:
-        return enhanced_clients_;
-      default:
-        // Should not happen, but default to regular to avoid crash on ESP32
-        return regular_clients_;
-    }
-  }();
-
-  // Proactively clean up any disconnected clients in this array to free slots
-  // immediately
-  for (size_t i = 0; i < NetworkLimits::max_clients; ++i) {
-    if (clients[i] && !clients[i]->isConnected()) {
-      EBUS_LOG_INFO(
-          "[ClientManager] Removing disconnected client during addClient.");
-      clients[i]->stop();
-      clients[i].reset();
-    }
-  }
-
-  // Find first empty slot and add the client directly
-  for (size_t i = 0; i < NetworkLimits::max_clients; ++i) {
-    if (!clients[i]) {
-      clients[i] = std::move(client);
-      return true;
-    }
-  }
-
-  EBUS_LOG_ERROR("[ClientManager] No empty slot available for client.");
-  client->stop();
-  return false;
+  return insertClient(std::move(client), ClientType::regular);
 }
 
 void ClientManager::removeClient(int fd) { removeClientByFd(fd); }
@@ -287,30 +304,43 @@ ClientManagerStatus ClientManager::fetchStatus() const {
     return {s.name, s.task_stack_bytes, s.task_stack_free_bytes};
   };
 
-  ebus::StaticVector<ClientInfo, NetworkLimits::max_clients * 3> snapshot;
-  bool active = false;
-  std::string session_str;
-  std::string last_err;
+  ClientManagerStatus s{map(getThreadStatus()), false, "", ""};
 
   {
     platform::LockGuard<platform::Mutex> lock(mutex_);
-    active = (current_active_sender_ != nullptr);
-    session_str = ebus::toString(session_state_);
-    last_err = last_error_message_;
+    s.session_active = (current_active_sender_ != nullptr);
+    s.session_state = ebus::toString(session_state_);
+    s.last_error = last_error_message_;
 
     // Collect all clients
-    for (auto& client : regular_clients_)
-      if (client) snapshot.push_back(client->getClientInfo());
-    for (auto& client : readonly_clients_)
-      if (client) snapshot.push_back(client->getClientInfo());
-    for (auto& client : enhanced_clients_)
-      if (client) snapshot.push_back(client->getClientInfo());
-  }
+    for (const ClientSlots* slots : {&regular_clients_, &readonly_clients_,
+                                     &enhanced_clients_, &filtered_clients_}) {
+      s.client_capacity += slots->size();
+      for (const auto& slot : *slots) {
+        if (!slot.client) continue;
+        ClientInfo info = slot.client->getClientInfo();
+        info.sessions = slot.share.sessions;
+        info.session_wait_avg_ms = slot.share.averageWaitMs();
+        info.session_wait_max_ms =
+            static_cast<float>(slot.share.wait_max_us) / 1000.0f;
+        info.session_share = arbiter_.shareOf(slot.share);
+        s.clients.push_back(std::move(info));
+      }
+    }
 
-  ClientManagerStatus s{map(getThreadStatus()), active, session_str, last_err};
-  for (const auto& info : snapshot) {
-    s.clients.push_back(info);
+    s.local_sessions = local_share_.sessions;
+    s.local_session_wait_avg_ms = local_share_.averageWaitMs();
+    s.local_session_wait_max_ms =
+        static_cast<float>(local_share_.wait_max_us) / 1000.0f;
+    s.local_session_share = arbiter_.shareOf(local_share_);
   }
+
+  s.io_backend = platform::IoPoller::backend;
+  s.rejected_clients = rejected_clients_.load(std::memory_order_relaxed);
+  s.io_events = io_events_.load(std::memory_order_relaxed);
+  s.io_iteration = io_iteration_.getValues();
+  s.accept_latency = accept_latency_.getValues();
+  s.bridge_latency = bridge_latency_.getValues();
   return s;
 }
 
@@ -327,10 +357,6 @@ void ClientManager::onBusRequested() {
 }
 
 void ClientManager::onBusEventInfo(const BusEventInfo& info) {
-  // Collect all connected clients
-  ebus::StaticVector<std::shared_ptr<AbstractClient>,
-                     NetworkLimits::max_clients * 3>
-      all_clients;
   std::shared_ptr<AbstractClient> active_sender;
 
   {
@@ -339,14 +365,6 @@ void ClientManager::onBusEventInfo(const BusEventInfo& info) {
     active_sender = current_active_sender_;
     bool has_active_session = (session_state_ != SessionState::idle);
 
-    // Snapshot all connected clients
-    for (auto& client : regular_clients_)
-      if (client && client->isConnected()) all_clients.push_back(client);
-    for (auto& client : readonly_clients_)
-      if (client && client->isConnected()) all_clients.push_back(client);
-    for (auto& client : enhanced_clients_)
-      if (client && client->isConnected()) all_clients.push_back(client);
-
     // Reset session timeout if we have an active session
     if (has_active_session) {
       last_state_change_ = Clock::now();
@@ -385,18 +403,106 @@ void ClientManager::onBusEventInfo(const BusEventInfo& info) {
     }
   }
 
-  // Forward byte to all connected clients (excluding active sender)
-  for (auto& client : all_clients) {
-    if (client == active_sender) continue;  // Skip active sender
-    if (client && client->isConnected()) {
-      client->enqueueOutgoingData(ByteView(&info.byte, 1));
-    }
+  // Publish the byte once for all clients. The active sender queued its
+  // replacements above, so they are ordered before this byte.
+  publishBusByte(info.byte);
+
+  // Write-capable clients are flushed at once. Read-only output waits for
+  // its window or the next SYN, so most bytes need no wakeup at all.
+  const uint32_t window = flush_window_ms_.load(std::memory_order_relaxed);
+  const bool on_syn = flush_on_syn_.load(std::memory_order_relaxed);
+  bool wake = write_capable_clients_.load(std::memory_order_relaxed) > 0;
+  if ((window == 0 && !on_syn) || (on_syn && info.byte == Symbols::syn)) {
+    readonly_due_.store(true, std::memory_order_relaxed);
+    wake = true;
+  } else if (window > 0) {
+    // The first byte of a window lets the I/O thread shorten its wait
+    int64_t none = 0;
+    if (coalesce_since_.compare_exchange_strong(
+            none, Clock::now().time_since_epoch().count(),
+            std::memory_order_relaxed))
+      wake = true;
   }
 
   // Signal the I/O thread that data has been written and needs flushing
+  if (wake) signalClientIoThread();
+}
+
+void ClientManager::onTelegram(const ProtocolEvent& event) {
+  // Encoded once, every filtered client only looks up its rules
+  uint8_t frame[FilteredProtocolLimits::max_frame_len];
+  const ByteView master(event.master.data(), event.master.size());
+  const size_t len = filtered::Protocol::encodeTelegram(
+      event.telegram_type, master,
+      ByteView(event.slave.data(), event.slave.size()), frame);
+  if (len == 0) return;
+
+  bool queued = false;
+  {
+    platform::LockGuard<platform::Mutex> lock(mutex_);
+    for (auto& slot : filtered_clients_) {
+      if (slot.client && slot.client->onTelegram(master, ByteView(frame, len)))
+        queued = true;
+    }
+  }
+  if (queued) signalClientIoThread();
+}
+
+void ClientManager::onSessionResult(const ProtocolEvent& event) {
+  std::shared_ptr<AbstractClient> client;
+  {
+    platform::LockGuard<platform::Mutex> lock(mutex_);
+    for (auto it = pending_submits_.begin(); it != pending_submits_.end();
+         ++it) {
+      if (it->session_id != event.session_id) continue;
+      client = std::move(it->client);
+      pending_submits_.erase(it);
+      break;
+    }
+  }
+  if (!client) return;
+
+  if (event.type == ProtocolEvent::Type::telegram) {
+    client->onSubmitResult(enhanced::SubmitStatus::ok,
+                           ByteView(event.slave.data(), event.slave.size()));
+  } else {
+    const uint8_t error = static_cast<uint8_t>(event.protocol_error);
+    client->onSubmitResult(enhanced::SubmitStatus::failed,
+                           ByteView(&error, 1));
+  }
   signalClientIoThread();
 }
 
+bool ClientManager::acquireLocalSession() {
+  platform::LockGuard<platform::Mutex> lock(mutex_);
+  if (local_active_) return true;
+
+  const auto now = Clock::now();
+  arbiter_.request(local_share_, now);
+  local_requested_at_ = now;
+  // Otherwise a client started or the scheduler waits for its turn
+  if (!startNextSessionLocked(now)) return false;
+
+  arbiter_.grant(local_share_, now);
+  local_active_ = true;
+  return true;
+}
+
+void ClientManager::releaseLocalSession(bool more) {
+  bool wake = false;
+  {
+    platform::LockGuard<platform::Mutex> lock(mutex_);
+    local_active_ = false;
+    const auto now = Clock::now();
+    if (more) {
+      arbiter_.request(local_share_, now);
+      local_requested_at_ = now;
+    }
+    wake = startNextSessionLocked(now) && local_wakeup_;
+  }
+  if (wake) local_wakeup_();
+}
+
 void ClientManager::transitSessionState(const SessionState& state) {
   session_state_ = state;
   last_state_change_ = Clock::now();
@@ -445,26 +551,82 @@ void ClientManager::tryStartSessionForClient(
     return;
   }
 
-  platform::LockGuard<platform::Mutex> lock(mutex_);
-  // Can only start if no active session and not busy
-  if (current_active_sender_ || session_state_ != SessionState::idle) {
-    return;
+  bool wake = false;
+  {
+    platform::LockGuard<platform::Mutex> lock(mutex_);
+    const auto now = Clock::now();
+    for (ClientSlots* slots : {&regular_clients_, &enhanced_clients_}) {
+      for (auto& slot : *slots)
+        if (slot.client == client) arbiter_.request(slot.share, now);
+    }
+    wake = startNextSessionLocked(now) && local_wakeup_;
   }
+  if (wake) local_wakeup_();
+}
 
-  current_active_sender_ = client;
+void ClientManager::startNextSession() {
+  if (!running_.load(std::memory_order_acquire)) return;
+  bool wake = false;
+  {
+    platform::LockGuard<platform::Mutex> lock(mutex_);
+    wake = startNextSessionLocked(Clock::now()) && local_wakeup_;
+  }
+  if (wake) local_wakeup_();
+}
+
+bool ClientManager::startNextSessionLocked(const Clock::time_point& now) {
+  // mutex_ MUST be locked. Starts the session of the client whose turn it
+  // is; returns true if it is the scheduler's turn, which the caller wakes.
+  if (current_active_sender_ || session_state_ != SessionState::idle ||
+      local_active_) {
+    return false;
+  }
+
+  // A scheduler that stopped asking does not keep its turn
+  if (local_share_.waiting &&
+      now - local_requested_at_ >
+          std::chrono::milliseconds(NetworkLimits::local_session_request_ms))
+    arbiter_.withdraw(local_share_);
+
+  SessionShare* best = local_share_.waiting ? &local_share_ : nullptr;
+  ClientSlot* best_slot = nullptr;
+  for (ClientSlots* slots : {&regular_clients_, &enhanced_clients_}) {
+    for (auto& slot : *slots) {
+      if (!slot.client || !slot.client->isConnected() ||
+          !slot.client->hasPendingIncomingData()) {
+        arbiter_.withdraw(slot.share);
+        continue;
+      }
+      // Pipelined data asks for the next session right away
+      arbiter_.request(slot.share, now);
+      if (!best || arbiter_.precedes(slot.share, *best)) {
+        best = &slot.share;
+        best_slot = &slot;
+      }
+    }
+  }
+  if (!best) return false;
+  if (!best_slot) return true;
+
+  arbiter_.grant(best_slot->share, now);
+  current_active_sender_ = best_slot->client;
   uint32_t sid = ++session_counter_;
   transitSessionState(SessionState::request);
   EBUS_LOG_INFO_F(
       "[ClientManager] Session started for client fd=%d sid=%" PRIu32,
-      client->getFd(), sid);
-  client->onSessionStart(sid);
+      best_slot->client->getFd(), sid);
+  best_slot->client->onSessionStart(sid);
+  return false;
 }
 
 void ClientManager::trySendNextByte(std::shared_ptr<AbstractClient>& client) {
   if (!client || !client->isConnected()) return;
 
   uint8_t send_byte = 0;
-  if (client->popPendingIncomingData(send_byte)) {
+  if (!client->popPendingIncomingData(send_byte)) return;
+
+  bool wake = false;
+  {
     platform::LockGuard<platform::Mutex> lock(mutex_);
     bus_->writeByte(send_byte);
     last_sent_byte_ = send_byte;
@@ -476,10 +638,12 @@ void ClientManager::trySendNextByte(std::shared_ptr<AbstractClient>& client) {
       current_active_sender_.reset();
       EBUS_LOG_INFO_F("[ClientManager] Session complete for client fd=%d",
                       client->getFd());
+      wake = startNextSessionLocked(Clock::now()) && local_wakeup_;
     } else {
       transitSessionState(SessionState::response);
     }
   }
+  if (wake) local_wakeup_();
 }
 
 void ClientManager::stopActiveSession() {
@@ -496,6 +660,7 @@ void ClientManager::stopActiveSession() {
   }
   if (old_sender) old_sender->stop();
   if (request_) request_->reset();
+  startNextSession();
 }
 
 void ClientManager::checkSessionTimeout() {
@@ -551,244 +716,425 @@ void ClientManager::handleActiveSenderDisconnected() {
       request_->reset();
     }
   }
+  if (old_sender) startNextSession();
 }
 
 void ClientManager::removeDisconnectedClients() {
-  // Thread 2 only — client arrays not shared, no mutex needed
-  ebus::StaticVector<std::shared_ptr<AbstractClient>,
-                     NetworkLimits::max_clients * 3>
-      to_stop;
-
-  auto collect = [&](ClientArray& arr, const char* type_name) {
-    for (size_t i = 0; i < NetworkLimits::max_clients; ++i) {
-      if (arr[i] && !arr[i]->isConnected()) {
+  // I/O thread only
+  for (ClientType type : client_types) {
+    ClientSlots& slots = slotsFor(type);
+    for (size_t i = 0; i < slots.size(); ++i) {
+      if (slots[i].client && !slots[i].client->isConnected()) {
         EBUS_LOG_INFO_F(
             "[ClientManager] Removing disconnected %s client fd=%d slot=%zu",
-            type_name, arr[i]->getFd(), i);
-        to_stop.push_back(arr[i]);
-        arr[i].reset();
+            typeName(type), slots[i].fd, i);
+        to_stop_.push_back(releaseSlot(slots[i]));
       }
     }
-  };
+  }
 
-  collect(regular_clients_, "regular");
-  collect(readonly_clients_, "readonly");
-  collect(enhanced_clients_, "enhanced");
+  stopDroppedClients();
+}
 
-  for (auto& client : to_stop) {
-    client->stop();
+ClientManager::ClientSlots& ClientManager::slotsFor(ClientType type) {
+  switch (type) {
+    case ClientType::read_only:
+      return readonly_clients_;
+    case ClientType::enhanced:
+      return enhanced_clients_;
+    case ClientType::filtered:
+      return filtered_clients_;
+    case ClientType::regular:
+    default:
+      return regular_clients_;
   }
 }
 
-std::shared_ptr<AbstractClient> ClientManager::findClientByFdLocked(int fd) {
-  for (auto& client : regular_clients_)
-    if (client && client->getFd() == fd) return client;
-  for (auto& client : readonly_clients_)
-    if (client && client->getFd() == fd) return client;
-  for (auto& client : enhanced_clients_)
-    if (client && client->getFd() == fd) return client;
+std::unique_ptr<platform::Socket>& ClientManager::listenerFor(
+    ClientType type) {
+  switch (type) {
+    case ClientType::read_only:
+      return listen_socket_readonly_;
+    case ClientType::enhanced:
+      return listen_socket_enhanced_;
+    case ClientType::filtered:
+      return listen_socket_filtered_;
+    case ClientType::regular:
+    default:
+      return listen_socket_regular_;
+  }
+}
 
-  return nullptr;
+void ClientManager::resizeSlots(ClientSlots& slots, ClientType type,
+                                size_t count) {
+  // Only while the I/O thread is stopped; clients beyond the limit are dropped
+  for (size_t i = count; i < slots.size(); ++i) {
+    if (auto client = releaseSlotLocked(slots[i])) {
+      EBUS_LOG_INFO_F("[ClientManager] Dropping %s client fd=%d over limit",
+                      typeName(type), client->getFd());
+      client->stop();
+    }
+  }
+
+  slots.resize(count);
+  for (size_t i = 0; i < slots.size(); ++i)
+    slots[i].token = pollToken(PollSource::client,
+                               static_cast<uint32_t>(type),
+                               static_cast<uint32_t>(i));
 }
 
-std::shared_ptr<AbstractClient> ClientManager::findClientByFd(int fd) {
-  platform::LockGuard<platform::Mutex> lock(mutex_);
-  return findClientByFdLocked(fd);
+BroadcastRing* ClientManager::broadcastFor(ClientType type) {
+  switch (type) {
+    case ClientType::enhanced:
+      return enhanced_broadcast_.get();
+    case ClientType::filtered:
+      return nullptr;  // Telegram frames are client specific
+    default:
+      return raw_broadcast_.get();
+  }
 }
 
-template <typename ClientArrayType>
-bool removeFromArrayLocked(const std::shared_ptr<AbstractClient>& client,
-                           ClientArrayType& client_array) {
-  // mutex_ MUST be locked by caller
-  for (size_t i = 0; i < NetworkLimits::max_clients; ++i) {
-    if (client_array[i] == client) {
-      client_array[i].reset();
-      return true;
-    }
+void ClientManager::resizeBroadcast(size_t size) {
+  // Not while the bus thread publishes (before start or while stopped)
+  if (raw_broadcast_ &&
+      raw_broadcast_->capacity() == BroadcastRing::capacityFor(size))
+    return;
+
+  raw_broadcast_ = std::make_unique<BroadcastRing>(size);
+  enhanced_broadcast_ = std::make_unique<BroadcastRing>(size);
+  for (ClientType type : client_types)
+    for (auto& slot : slotsFor(type))
+      if (slot.client)
+        slot.client->attachBroadcast(broadcastFor(slot.client->getType()));
+}
+
+void ClientManager::publishBusByte(uint8_t byte) {
+  // Lagging clients may resume at a SYN
+  if (byte == Symbols::syn) {
+    raw_broadcast_->markBoundary();
+    enhanced_broadcast_->markBoundary();
   }
-  return false;
+  raw_broadcast_->append(&byte, 1);
+
+  uint8_t encoded[EnhancedProtocolLimits::max_sequence_len];
+  enhanced_broadcast_->append(
+      encoded, enhanced::Protocol::encodeReceived(byte, encoded));
 }
 
-void ClientManager::removeClientByFd(int fd) {
-  std::shared_ptr<AbstractClient> client;
+bool ClientManager::insertClient(std::shared_ptr<AbstractClient> client,
+                                 ClientType type) {
+  const int new_fd = client->getFd();
+  ClientList stale;
+  client->attachBroadcast(broadcastFor(client->getType()));
+  if (client->isWriteCapable()) client->setLatencyAggregate(&bridge_latency_);
+
   {
     platform::LockGuard<platform::Mutex> lock(mutex_);
-    client = findClientByFdLocked(fd);
-    if (!client) return;
+    client->setSlowPolicy(slow_policies_[static_cast<size_t>(type)]);
+    ClientSlots& slots = slotsFor(type);
 
-    // Remove from all client arrays (only one will match)
-    removeFromArrayLocked(client, regular_clients_);
-    removeFromArrayLocked(client, readonly_clients_);
-    removeFromArrayLocked(client, enhanced_clients_);
-  }  // Lock released before stopping client
+    // Evict any stale disconnected entries to free slots
+    for (size_t i = 0; i < slots.size(); ++i) {
+      if (slots[i].client && !slots[i].client->isConnected()) {
+        EBUS_LOG_INFO_F(
+            "[ClientManager] Evicting stale disconnected client fd=%d at slot "
+            "%zu",
+            slots[i].fd, i);
+        stale.push_back(releaseSlotLocked(slots[i]));
+      }
+    }
 
-  EBUS_LOG_INFO_F("[ClientManager] Removing client fd=%d", fd);
+    // Find first empty slot
+    for (size_t i = 0; i < slots.size(); ++i) {
+      ClientSlot& slot = slots[i];
+      if (slot.client) continue;
+
+      if (!poller_.add(new_fd, slot.token, client_events,
+                       platform::IoPoller::edge_triggered)) {
+        EBUS_LOG_ERROR_F("[ClientManager] ERROR: Cannot poll client fd=%d",
+                         new_fd);
+        break;
+      }
+      EBUS_LOG_INFO_F(
+          "[ClientManager] Registered client fd=%d type=%d at slot %zu", new_fd,
+          static_cast<int>(type), i);
+      if (client->isWriteCapable()) write_capable_clients_.fetch_add(1);
+      slot.client = std::move(client);
+      slot.fd = new_fd;
+      slot.want_write = false;
+      slot.share = SessionShare{};
+      break;
+    }
+  }
+
+  for (auto& old : stale) old->stop();
+  if (!client) return true;
+
+  EBUS_LOG_ERROR_F(
+      "[ClientManager] ERROR: No free slot for client fd=%d type=%d", new_fd,
+      static_cast<int>(type));
+  rejected_clients_.fetch_add(1, std::memory_order_relaxed);
   client->stop();
+  return false;
 }
 
-std::shared_ptr<AbstractClient> ClientManager::removeClientByFdLocked(int fd) {
+std::shared_ptr<AbstractClient> ClientManager::releaseSlotLocked(
+    ClientSlot& slot) {
   // mutex_ MUST be locked by caller
-  auto client = findClientByFdLocked(fd);
-  if (!client) return nullptr;
-
-  removeFromArrayLocked(client, regular_clients_);
-  removeFromArrayLocked(client, readonly_clients_);
-  removeFromArrayLocked(client, enhanced_clients_);
+  if (!slot.client) return nullptr;
+
+  // A client that already closed its socket may have lost its fd number to a
+  // newer registration; the poller only forgets it then.
+  if (slot.client->isConnected())
+    poller_.remove(slot.fd, slot.token);
+  else
+    poller_.discard(slot.fd, slot.token);
+
+  if (slot.client->isWriteCapable()) write_capable_clients_.fetch_sub(1);
+  slot.fd = -1;
+  slot.want_write = false;
+  return std::exchange(slot.client, nullptr);
+}
 
-  return client;
+std::shared_ptr<AbstractClient> ClientManager::releaseSlot(ClientSlot& slot) {
+  platform::LockGuard<platform::Mutex> lock(mutex_);
+  return releaseSlotLocked(slot);
 }
 
-void ClientManager::addListenerFds(fd_set& readfds, int& max_fd) {
-  // Thread 2 only — no mutex needed
-  auto add_listener = [&](const std::unique_ptr<platform::Socket>& listener) {
-    if (!listener || !listener->isValid()) return;
-    int fd = listener->getFd();
-    FD_SET(fd, &readfds);
-    if (fd > max_fd) max_fd = fd;
-  };
+std::shared_ptr<AbstractClient> ClientManager::findClientByFdLocked(int fd) {
+  for (ClientType type : client_types)
+    for (auto& slot : slotsFor(type))
+      if (slot.client && slot.client->getFd() == fd) return slot.client;
 
-  add_listener(listen_socket_regular_);
-  add_listener(listen_socket_readonly_);
-  add_listener(listen_socket_enhanced_);
+  return nullptr;
 }
 
-void ClientManager::addClientFdsToSet(const ClientArray& clients,
-                                      fd_set& readfds, fd_set& writefds,
-                                      fd_set& exceptfds, int& max_fd) {
-  // Thread 2 only — no mutex needed
-  for (size_t i = 0; i < NetworkLimits::max_clients; ++i) {
-    const auto& client = clients[i];
-    if (!client || !client->isConnected()) continue;
-
-    int fd = client->getFd();
-    FD_SET(fd, &readfds);    // Always monitor for read
-    FD_SET(fd, &exceptfds);  // Monitor for errors
-    if (client->hasPendingOutgoingData()) {
-      FD_SET(fd, &writefds);  // Monitor for write if buffer has data
-    }
-    if (fd > max_fd) max_fd = fd;
-  }
+std::shared_ptr<AbstractClient> ClientManager::findClientByFd(int fd) {
+  platform::LockGuard<platform::Mutex> lock(mutex_);
+  return findClientByFdLocked(fd);
 }
 
-int ClientManager::prepareFileDescriptors(fd_set& readfds, fd_set& writefds,
-                                          fd_set& exceptfds) {
-  FD_ZERO(&readfds);
-  FD_ZERO(&writefds);
-  FD_ZERO(&exceptfds);
+void ClientManager::removeClientByFd(int fd) {
+  std::shared_ptr<AbstractClient> client;
+  {
+    platform::LockGuard<platform::Mutex> lock(mutex_);
+    for (ClientType type : client_types) {
+      for (auto& slot : slotsFor(type)) {
+        if (slot.client && slot.client->getFd() == fd) {
+          client = releaseSlotLocked(slot);
+          break;
+        }
+      }
+      if (client) break;
+    }
+  }  // Lock released before stopping client
 
-  int max_fd = -1;
+  if (!client) return;
+  EBUS_LOG_INFO_F("[ClientManager] Removing client fd=%d", fd);
+  client->stop();
+}
 
-  // Add wakeup signal file descriptor
-  int wakeup_fd = wakeup_signal_.getReadFd();
-  if (wakeup_fd >= 0) {
-    FD_SET(wakeup_fd, &readfds);
-    max_fd = wakeup_fd;
+void ClientManager::openListener(ClientType type, uint16_t port,
+                                 size_t backlog) {
+  // mutex_ MUST be locked by caller
+  auto& listener = listenerFor(type);
+  if (backlog == 0) {
+    EBUS_LOG_INFO_F("[ClientManager] %s clients are disabled", typeName(type));
+    return;
   }
 
-  // Thread 2 only — client arrays and listen sockets are not touched by other
-  // threads here, no mutex needed
-  addListenerFds(readfds, max_fd);
-  addClientFdsToSet(regular_clients_, readfds, writefds, exceptfds, max_fd);
-  addClientFdsToSet(readonly_clients_, readfds, writefds, exceptfds, max_fd);
-  addClientFdsToSet(enhanced_clients_, readfds, writefds, exceptfds, max_fd);
-
-  return max_fd;
+  listener = std::make_unique<platform::Socket>(
+      platform::Socket::createListenSocket(port, static_cast<int>(backlog)));
+  if (listener->isValid()) {
+    listener->setNonBlocking(true);  // accept() drains the backlog
+    poller_.add(listener->getFd(),
+                pollToken(PollSource::listener, static_cast<uint32_t>(type)),
+                platform::IoPoller::in);
+    EBUS_LOG_INFO_F("[ClientManager] Listening for %s clients on port %u",
+                    typeName(type), port);
+  } else {
+    EBUS_LOG_ERROR_F(
+        "[ClientManager] ERROR: Failed to listen for %s clients on port %u",
+        typeName(type), port);
+  }
 }
 
-void ClientManager::drainWakeupSignal(fd_set& readfds) {
-  int wakeup_fd = wakeup_signal_.getReadFd();
-  if (wakeup_fd < 0) return;
+void ClientManager::closeListener(ClientType type) {
+  // mutex_ MUST be locked by caller
+  auto& listener = listenerFor(type);
+  if (listener && listener->isValid())
+    poller_.remove(listener->getFd(), pollToken(PollSource::listener,
+                                                static_cast<uint32_t>(type)));
+  listener.reset();
+}
 
-  if (FD_ISSET(wakeup_fd, &readfds)) {
-    wakeup_signal_.drain();
-    // std::cout << "[ClientManager] Wakeup signal drained" << std::endl;
+void ClientManager::openLocalListener(ClientType type, const std::string& path,
+                                      size_t backlog) {
+  // mutex_ MUST be locked by caller
+  if (backlog == 0) return;  // reported by openListener()
+
+  const size_t index = static_cast<size_t>(type);
+  auto& listener = local_listeners_[index];
+  listener = std::make_unique<platform::Socket>(
+      platform::Socket::createLocalListenSocket(path.c_str(),
+                                                static_cast<int>(backlog)));
+  if (listener->isValid()) {
+    local_paths_[index] = path;
+    listener->setNonBlocking(true);  // accept() drains the backlog
+    poller_.add(listener->getFd(),
+                pollToken(PollSource::local_listener,
+                          static_cast<uint32_t>(type)),
+                platform::IoPoller::in);
+    EBUS_LOG_INFO_F("[ClientManager] Listening for %s clients on %s",
+                    typeName(type), path.c_str());
+  } else {
+    EBUS_LOG_ERROR_F(
+        "[ClientManager] ERROR: Failed to listen for %s clients on %s",
+        typeName(type), path.c_str());
   }
 }
 
-void ClientManager::acceptNewConnections(fd_set& readfds) {
-  // Thread 2 only — listen sockets and client arrays not shared here
-  auto try_accept = [&](std::unique_ptr<platform::Socket>& listener,
-                        ClientType type) {
-    if (!listener || !listener->isValid()) return;
+void ClientManager::closeLocalListener(ClientType type) {
+  // mutex_ MUST be locked by caller
+  const size_t index = static_cast<size_t>(type);
+  auto& listener = local_listeners_[index];
+  if (listener && listener->isValid())
+    poller_.remove(listener->getFd(),
+                   pollToken(PollSource::local_listener,
+                             static_cast<uint32_t>(type)));
+  listener.reset();
+  if (!local_paths_[index].empty()) {
+    platform::unlinkLocalSocket(local_paths_[index].c_str());
+    local_paths_[index].clear();
+  }
+}
 
-    int listen_fd = listener->getFd();
-    if (!FD_ISSET(listen_fd, &readfds)) return;
+void ClientManager::updateWriteInterest(bool readonly_flushed) {
+  // Level-triggered select() must only watch writability while output is
+  // pending, otherwise every wait returns immediately. Coalesced read-only
+  // output is written when due, writability only resumes a partial send.
+  const bool coalescing =
+      flush_window_ms_.load(std::memory_order_relaxed) > 0 ||
+      flush_on_syn_.load(std::memory_order_relaxed);
+  for (ClientType type : client_types) {
+    const bool coalesced =
+        coalescing && !readonly_flushed && type == ClientType::read_only;
+    for (auto& slot : slotsFor(type)) {
+      if (!slot.client || !slot.client->isConnected()) continue;
+      const bool want = slot.client->hasPendingOutgoingData() &&
+                        (!coalesced || slot.want_write);
+      if (want == slot.want_write) continue;
+      poller_.modify(slot.fd, slot.token,
+                     client_events | (want ? platform::IoPoller::out : 0));
+      slot.want_write = want;
+    }
+  }
+}
 
-    int client_fd = listener->accept();
-    if (client_fd >= 0) {
-      EBUS_LOG_INFO_F(
-          "[ClientManager] Connection accepted on listener fd %d-> client fd "
-          "%d (type %d)",
-          listen_fd, client_fd, static_cast<int>(type));
-      if (!addClient(client_fd, type)) {
-        EBUS_LOG_ERROR_F("[ClientManager] Failed to register client fd %d",
-                         client_fd);
-        platform::close(client_fd);
+void ClientManager::dispatchEvents(int count,
+                                   const Clock::time_point& ready_at) {
+  EBUS_TRACE_SCOPE("client_manager.io");
+  // I/O thread only — slots are read without mutex_, writers lock it
+  ebus::StaticVector<int, NetworkLimits::metrics_max_connections + 1>
+      metrics_ready;
+  bool woken = false;
+
+  for (int i = 0; i < count; ++i) {
+    const platform::IoPoller::Ready& ready = ready_[i];
+    switch (pollSource(ready.token)) {
+      case PollSource::wakeup:
+        // Cleared first: a later signal writes again and is not lost
+        wakeup_pending_.store(false, std::memory_order_release);
+        wakeup_signal_.drain();
+        woken = true;
+        break;
+      case PollSource::listener:
+        acceptNewConnections(pollType(ready.token), false, ready_at);
+        break;
+      case PollSource::local_listener:
+        acceptNewConnections(pollType(ready.token), true, ready_at);
+        break;
+      case PollSource::metrics:
+        metrics_ready.push_back(static_cast<int>(pollIndex(ready.token)));
+        break;
+      case PollSource::client: {
+        ClientSlots& slots = slotsFor(pollType(ready.token));
+        const uint32_t index = pollIndex(ready.token);
+        if (index < slots.size()) handleClientEvent(slots[index], ready.events);
+        break;
       }
-    } else {
-      EBUS_LOG_ERROR_F(
-          "[ClientManager] accept() failed on listener fd %d, errno: %d",
-          listen_fd, errno);
     }
-  };
-
-  try_accept(listen_socket_regular_, ClientType::regular);
-  try_accept(listen_socket_readonly_, ClientType::read_only);
-  try_accept(listen_socket_enhanced_, ClientType::enhanced);
-}
+  }
+  io_events_.fetch_add(static_cast<uint64_t>(count),
+                       std::memory_order_relaxed);
 
-void ClientManager::handleClientIO(fd_set& readfds, fd_set& writefds,
-                                   fd_set& exceptfds) {
-  // Thread 2 only — client arrays not shared, no mutex needed here
-  ebus::StaticVector<std::shared_ptr<AbstractClient>,
-                     NetworkLimits::max_clients * 3>
-      to_stop;
+  // Edge-triggered writability does not fire again for sockets that stayed
+  // writable, so data queued by the bus thread is flushed on wakeup.
+  if (platform::IoPoller::edge_triggered && woken) flushPendingOutput(false);
 
-  handleClientActivity(regular_clients_, readfds, writefds, exceptfds, to_stop);
-  handleClientActivity(readonly_clients_, readfds, writefds, exceptfds,
-                       to_stop);
-  handleClientActivity(enhanced_clients_, readfds, writefds, exceptfds,
-                       to_stop);
+  stopDroppedClients();
 
-  for (auto& client : to_stop) {
-    client->stop();
-  }
+  // Serve metrics scrapes after the latency-sensitive bridge I/O
+  for (int fd : metrics_ready) metrics_endpoint_.handle(fd);
 }
 
-void ClientManager::handleClientActivity(
-    ClientArray& clients, fd_set& readfds, fd_set& writefds, fd_set& exceptfds,
-    ebus::StaticVector<std::shared_ptr<AbstractClient>,
-                       NetworkLimits::max_clients * 3>& to_stop) {
-  // Thread 2 only — no mutex needed for client array iteration
-  for (size_t i = 0; i < NetworkLimits::max_clients; ++i) {
-    auto& client = clients[i];
-    if (!client || !client->isConnected()) continue;
+void ClientManager::acceptNewConnections(ClientType type, bool local,
+                                         const Clock::time_point& ready_at) {
+  auto& listener = local ? local_listeners_[static_cast<size_t>(type)]
+                         : listenerFor(type);
+  if (!listener || !listener->isValid()) return;
+  const int listen_fd = listener->getFd();
 
-    int fd = client->getFd();
+  // Drain the backlog, the listener is non-blocking
+  while (true) {
+    int client_fd = listener->accept();
+    if (client_fd < 0) {
+      if (!platform::isWouldBlock() && !platform::isInterrupted()) {
+        EBUS_LOG_ERROR_F(
+            "[ClientManager] accept() failed on listener fd %d, errno: %d",
+            listen_fd, errno);
+      }
+      break;
+    }
 
-    if (FD_ISSET(fd, &exceptfds)) {
-      EBUS_LOG_ERROR("[ClientManager] Exception on client fd=" +
-                     std::to_string(fd));
-      to_stop.push_back(client);
-      client.reset();
+    EBUS_LOG_INFO_F(
+        "[ClientManager] Connection accepted on listener fd %d-> client fd "
+        "%d (type %d)",
+        listen_fd, client_fd, static_cast<int>(type));
+    // Local sockets have no TCP options; accept() made them non-blocking
+    const bool added =
+        local ? addClient(std::make_unique<platform::Socket>(client_fd), type)
+              : addClient(client_fd, type);
+    if (!added) {
+      EBUS_LOG_ERROR_F("[ClientManager] Failed to register client fd %d",
+                       client_fd);
+      platform::close(client_fd);
       continue;
     }
+    accept_latency_.addDurationWithTime(ready_at);
+  }
+}
 
-    if (FD_ISSET(fd, &readfds)) {
-      handleSocketInput(fd, client, to_stop);
-    }
+void ClientManager::handleClientEvent(ClientSlot& slot, uint16_t events) {
+  if (!slot.client || !slot.client->isConnected()) return;
 
-    if (client && FD_ISSET(fd, &writefds)) {
-      handleSocketOutput(fd, client, to_stop);
-    }
+  if (events & platform::IoPoller::err) {
+    EBUS_LOG_ERROR("[ClientManager] Exception on client fd=" +
+                   std::to_string(slot.fd));
+    to_stop_.push_back(releaseSlot(slot));
+    return;
   }
+
+  if (events & platform::IoPoller::in) handleSocketInput(slot);
+
+  if (slot.client && (events & platform::IoPoller::out))
+    handleSocketOutput(slot, true);
 }
 
-void ClientManager::handleSocketInput(
-    int fd, std::shared_ptr<AbstractClient>& client,
-    ebus::StaticVector<std::shared_ptr<AbstractClient>,
-                       NetworkLimits::max_clients * 3>& to_stop) {
-  // Thread 2 only — no mutex needed for client array or socket ops
+void ClientManager::handleSocketInput(ClientSlot& slot) {
+  // I/O thread only; drains the socket as edge-triggered polling requires
+  std::shared_ptr<AbstractClient> client = slot.client;
+  const int fd = slot.fd;
   uint8_t buffer[256];
 
   while (true) {
@@ -797,6 +1143,7 @@ void ClientManager::handleSocketInput(
 
     if (bytes_read > 0) {
       client->handleIncomingStream(buffer, static_cast<size_t>(bytes_read));
+      submitTelegrams(client);
 
       bool is_active_sender = false;
       bool is_transmit_state = false;
@@ -813,8 +1160,7 @@ void ClientManager::handleSocketInput(
       }
     } else if (bytes_read == 0) {
       EBUS_LOG_INFO_F("[ClientManager] Client fd=%d closed connection", fd);
-      to_stop.push_back(client);
-      client.reset();
+      to_stop_.push_back(releaseSlot(slot));
       break;
     } else {
       if (platform::isWouldBlock() || platform::isInterrupted()) {
@@ -822,93 +1168,152 @@ void ClientManager::handleSocketInput(
       }
       EBUS_LOG_ERROR_F(
           "[ClientManager] recv() failed on client fd=%d, errno=%d", fd, errno);
-      to_stop.push_back(client);
-      client.reset();
+      to_stop_.push_back(releaseSlot(slot));
       break;
     }
   }
 }
 
-void ClientManager::handleSocketOutput(
-    int fd, std::shared_ptr<AbstractClient>& client,
-    ebus::StaticVector<std::shared_ptr<AbstractClient>,
-                       NetworkLimits::max_clients * 3>& to_stop) {
-  (void)fd;
-  // Thread 2 only — no mutex needed
+void ClientManager::submitTelegrams(
+    const std::shared_ptr<AbstractClient>& client) {
+  // Rejections are flushed with the client's other pending output
+  SubmittedTelegram telegram;
+  while (client->popSubmittedTelegram(telegram)) {
+    uint32_t session_id = 0;
+    {
+      // Registered before the result can reach the Reactor thread
+      platform::LockGuard<platform::Mutex> lock(mutex_);
+      if (submitter_ && !pending_submits_.full()) {
+        session_id =
+            submitter_(EnhancedProtocolLimits::submit_priority, telegram);
+        if (session_id != 0) pending_submits_.push_back({session_id, client});
+      }
+    }
+    if (session_id == 0)
+      client->onSubmitResult(enhanced::SubmitStatus::rejected, ByteView());
+  }
+}
+
+void ClientManager::handleSocketOutput(ClientSlot& slot, bool writable) {
   // flushOutgoingData acquires io_mutex_ internally (shared with Thread 1)
-  if (!client->flushOutgoingData()) {
-    to_stop.push_back(client);
-    client.reset();
+  if (!slot.client->flushOutgoingData(writable)) {
+    to_stop_.push_back(releaseSlot(slot));
   }
 }
 
-void ClientManager::clientIoLoop() {
-  fd_set readfds, writefds, exceptfds;
+void ClientManager::flushPendingOutput(bool readonly) {
+  for (ClientType type : client_types) {
+    if ((type == ClientType::read_only) != readonly) continue;
+    for (auto& slot : slotsFor(type)) {
+      if (slot.client && slot.client->isConnected() &&
+          slot.client->hasPendingOutgoingData())
+        handleSocketOutput(slot, false);
+    }
+  }
+}
 
-  while (running_.load()) {
-    // Phase 1: Prepare file descriptor sets for this iteration
-    int max_fd = prepareFileDescriptors(readfds, writefds, exceptfds);
+void ClientManager::stopDroppedClients() {
+  for (auto& client : to_stop_) {
+    if (client) client->stop();
+  }
+  to_stop_.clear();
+}
 
-    if (max_fd == -1) {
-      platform::sleepMilli(NetworkLimits::wake_interval_ms);
-      continue;
+void ClientManager::housekeeping() {
+  checkSessionTimeout();
+  handleActiveSenderDisconnected();
+  removeDisconnectedClients();
+  metrics_endpoint_.checkTimeouts();
+  // Turns lost to disconnects or stale requests are passed on
+  startNextSession();
+  // Check if we have a session in request state waiting for bus
+  // availability This is a fallback for when no bus events are coming in
+  {
+    platform::UniqueLock<platform::Mutex> lock(mutex_);
+    if (session_state_ == SessionState::request && current_active_sender_) {
+      lock.unlock();
+      handleBusAvailableForSession();
     }
+  }
+}
+
+void ClientManager::clientIoLoop() {
+  const auto housekeeping_interval =
+      std::chrono::milliseconds(NetworkLimits::io_wait_timeout_ms);
+  Clock::time_point last_housekeeping = Clock::now();
 
-    // Phase 2: Use a short timeout for responsiveness
-    // We check for session timeouts and bus availability in the timeout
-    // handler
-    struct timeval tv{0, 10000};  // 10ms timeout
+  while (running_.load()) {
+    // Phase 1: select() rebuilds its sets; epoll registrations are persistent
+    // Coalesced read-only output is written as soon as it is due; a send
+    // that did not complete continues on writability.
+    int timeout_ms = static_cast<int>(NetworkLimits::io_wait_timeout_ms);
+    const bool readonly_due = readonlyFlushDue(Clock::now(), timeout_ms);
+    if (readonly_due) flushPendingOutput(true);
+    if (!platform::IoPoller::edge_triggered) updateWriteInterest(readonly_due);
 
-    // Phase 3: Block on socket events
-    int activity = select(max_fd + 1, &readfds, &writefds, &exceptfds, &tv);
+    // Phase 2: Block on readiness with a short timeout for responsiveness
+    int count = poller_.wait(ready_.data(), ready_.size(), timeout_ms);
 
     if (!running_.load()) break;
 
-    if (activity < 0) {
+    if (count < 0) {
       if (errno == EINTR) continue;
       if (errno == EBADF) {
         EBUS_LOG_ERROR(
-            "[ClientManager] select() EBADF: a socket fd became invalid, "
+            "[ClientManager] poll EBADF: a socket fd became invalid, "
             "cleaning up clients");
         removeDisconnectedClients();
         continue;
       }
-      EBUS_LOG_ERROR_F("[ClientManager] select() failed: %s", strerror(errno));
+      EBUS_LOG_ERROR_F("[ClientManager] %s wait failed: %s",
+                       platform::IoPoller::backend, strerror(errno));
       break;
     }
 
-    // Phase 3.5: On timeout, check for session timeout, disconnected clients,
-    // and bus availability for pending sessions
-    if (activity == 0) {
-      checkSessionTimeout();
-      handleActiveSenderDisconnected();
-      removeDisconnectedClients();
-      // Check if we have a session in request state waiting for bus
-      // availability This is a fallback for when no bus events are coming in
-      {
-        platform::UniqueLock<platform::Mutex> lock(mutex_);
-        if (session_state_ == SessionState::request && current_active_sender_) {
-          lock.unlock();
-          handleBusAvailableForSession();
-        }
-      }
-      continue;
+    // Phase 3: Dispatch only the ready descriptors
+    const Clock::time_point now = Clock::now();
+    if (count > 0) {
+      dispatchEvents(count, now);
+      io_iteration_.addDurationWithTime(now);
     }
 
-    // Phase 4: Drain wakeup signal if triggered
-    drainWakeupSignal(readfds);
-
-    // Phase 5: Accept pending new connections
-    acceptNewConnections(readfds);
-
-    // Phase 6: Process client read/write activity
-    handleClientIO(readfds, writefds, exceptfds);
+    // Phase 4: Session timeouts, disconnected clients and pending bus
+    // requests; also under steady traffic that never lets the wait time out
+    if (count == 0 || now - last_housekeeping >= housekeeping_interval) {
+      housekeeping();
+      last_housekeeping = now;
+    }
+  }
+}
 
-    // Phase 7: Cleanup disconnected clients (also on activity)
-    removeDisconnectedClients();
+bool ClientManager::readonlyFlushDue(const Clock::time_point& now,
+                                     int& timeout_ms) {
+  bool due = readonly_due_.exchange(false, std::memory_order_relaxed);
+  const int64_t since = coalesce_since_.load(std::memory_order_relaxed);
+  if (since == 0) return due;
+
+  const auto window = std::chrono::milliseconds(
+      flush_window_ms_.load(std::memory_order_relaxed));
+  const auto elapsed = now - Clock::time_point(Clock::duration(since));
+  if (due || elapsed >= window) {
+    // A window opened by the bus thread meanwhile is kept
+    int64_t expected = since;
+    coalesce_since_.compare_exchange_strong(expected, 0,
+                                            std::memory_order_relaxed);
+    return true;
   }
+
+  // Wake up in time to close the window
+  const auto left =
+      std::chrono::ceil<std::chrono::milliseconds>(window - elapsed).count();
+  if (left < timeout_ms) timeout_ms = static_cast<int>(left);
+  return false;
 }
 
-void ClientManager::signalClientIoThread() { wakeup_signal_.signal(); }
+void ClientManager::signalClientIoThread() {
+  // One pending wakeup is enough until the I/O thread drains it
+  if (!wakeup_pending_.exchange(true, std::memory_order_acq_rel))
+    wakeup_signal_.signal();
+}
 
 }  // namespace ebus::detail
@@ -11,10 +11,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
-
-#if !defined(ESP_PLATFORM)
-#include <sys/select.h>
-#endif
+#include <vector>
 
 #include <ebus/callbacks.hpp>
 #include <ebus/config.hpp>
@@ -22,11 +19,18 @@
 #include <ebus/static_vector.hpp>
 #include <ebus/status.hpp>
 
+#include "app/client.hpp"
+#include "app/metrics_endpoint.hpp"
+#include "app/protocol_event.hpp"
+#include "app/session_arbiter.hpp"
 #include "platform/bus.hpp"
+#include "platform/io_poller.hpp"
 #include "platform/mutex.hpp"
 #include "platform/queue.hpp"
 #include "platform/service_thread.hpp"
 #include "platform/socket.hpp"
+#include "utils/broadcast_ring.hpp"
+#include "utils/timing_stats.hpp"
 
 namespace ebus::detail {
 
@@ -37,6 +41,20 @@ class AbstractClient;
 /**
  * ClientManager handles all connected clients and routes data between them and
  * the eBus. It supports ReadOnly, Regular, and Enhanced clients.
+ *
+ * The I/O thread waits on a platform::IoPoller (edge-triggered epoll on Linux,
+ * select() elsewhere) and dispatches only the descriptors that became ready.
+ * The number of client slots per type is taken from the runtime config on
+ * start(). Besides its TCP port, every client type may listen on an AF_UNIX
+ * path; local connections share the slots and client classes of the type.
+ *
+ * Bus bytes are published once into a BroadcastRing per wire format (raw for
+ * read-only and regular clients, encoded for enhanced clients); clients send
+ * straight from the ring with their own cursor.
+ *
+ * Bridge sessions and the sessions of the local scheduler take turns through
+ * a SessionArbiter: the scheduler asks acquireLocalSession() before it starts
+ * an attempt, and a client session only starts when it is the client's turn.
  */
 class ClientManager {
  public:
@@ -56,12 +74,56 @@ class ClientManager {
   void setTransmitTimeout(uint32_t timeout_ms);
   void setOutgoingBufferSize(size_t size);
 
+  /**
+   * @brief Sets the producer of the OpenMetrics exposition served on
+   * network.port_metrics. Must be set before start().
+   */
+  void setMetricsExporter(MetricsEndpoint::Exporter exporter);
+
+  /**
+   * @brief Sets where telegrams submitted as a whole by enhanced clients are
+   * enqueued (priority, message); returns the session ID or 0 if rejected.
+   * Must be set before start(); results arrive through onSessionResult().
+   */
+  void setTelegramSubmitter(Delegate<uint32_t(uint8_t, ByteView)> submitter);
+
+  /**
+   * @brief Sets how the local scheduler is told that its deferred session may
+   * start now. Called without locks held; must be set before start().
+   */
+  void setLocalSessionWakeup(Delegate<void()> wakeup);
+
   // Working Methods
   bool addClient(int fd, ClientType type);
   bool addClient(std::unique_ptr<platform::Socket> socket, ClientType type);
   bool addClient(std::shared_ptr<AbstractClient> client);
   void removeClient(int fd);
 
+  /**
+   * @brief Forwards a validated telegram to the filtered clients whose rules
+   * match. Called from the Reactor thread.
+   */
+  void onTelegram(const ProtocolEvent& event);
+
+  /**
+   * @brief Answers the client that submitted the finished session, if any.
+   * Called from the Reactor thread for the final result of every session.
+   */
+  void onSessionResult(const ProtocolEvent& event);
+
+  /**
+   * @brief Asks for the bus on behalf of the local scheduler. Returns true if
+   * its session may start now; otherwise the scheduler is woken through the
+   * wakeup delegate once it is its turn.
+   */
+  bool acquireLocalSession();
+
+  /**
+   * @brief Ends the session of the local scheduler; more tells whether
+   * further scheduler items are due.
+   */
+  void releaseLocalSession(bool more);
+
   // Status/Telemetry
   platform::ServiceThread::Status getThreadStatus() const;
   ClientManagerStatus fetchStatus() const;
@@ -87,16 +149,40 @@ class ClientManager {
   Clock::time_point last_state_change_;
   mutable platform::Mutex mutex_;
 
-  // Internal IO events to replace poll.h macros
-  enum IoEvent : uint16_t { io_in = 0x01, io_out = 0x02, io_err = 0x04 };
-
-  // Fixed-size arrays for each client type
-  std::array<std::shared_ptr<AbstractClient>, NetworkLimits::max_clients>
-      regular_clients_;
-  std::array<std::shared_ptr<AbstractClient>, NetworkLimits::max_clients>
-      readonly_clients_;
-  std::array<std::shared_ptr<AbstractClient>, NetworkLimits::max_clients>
-      enhanced_clients_;
+  // A client slot remembers the fd it registered with the poller, so the
+  // registration can be dropped even after the client closed its socket.
+  struct ClientSlot {
+    std::shared_ptr<AbstractClient> client;
+    int fd = -1;
+    uint64_t token = 0;
+    bool want_write = false;  // select(): write interest registered
+    SessionShare share;       // bridge sessions of the client
+  };
+  using ClientSlots = std::vector<ClientSlot>;
+  using ClientList = std::vector<std::shared_ptr<AbstractClient>>;
+
+  // Declared before everything registering with it (destroyed last)
+  platform::IoPoller poller_;
+
+  ClientSlots regular_clients_;
+  ClientSlots readonly_clients_;
+  ClientSlots enhanced_clients_;
+  ClientSlots filtered_clients_;
+
+  // Shared output of all clients, sized by outbound_buffer_size on start()
+  std::unique_ptr<BroadcastRing> raw_broadcast_;
+  std::unique_ptr<BroadcastRing> enhanced_broadcast_;
+
+  ClientList to_stop_;  // I/O thread only: clients dropped this iteration
+  std::array<platform::IoPoller::Ready, NetworkLimits::io_events_per_wait>
+      ready_;
+
+  // I/O loop telemetry
+  TimingStats io_iteration_;
+  TimingStats accept_latency_;
+  BridgeLatency bridge_latency_;  // over all write-capable clients
+  std::atomic<uint64_t> io_events_{0};
+  std::atomic<uint32_t> rejected_clients_{0};
 
   uint32_t session_counter_ = 0;
   std::shared_ptr<AbstractClient> current_active_sender_ = nullptr;
@@ -113,13 +199,47 @@ class ClientManager {
   size_t outbound_buffer_size_ =
       ebus::RuntimeConfig{}.network.outbound_buffer_size;
 
+  // Reaction to lagging clients per ClientType, set on start()
+  std::array<SlowClientPolicy, 4> slow_policies_{};
+
+  // Read-only output coalescing, set on start(). The bus thread only wakes
+  // the I/O thread for write-capable clients, at SYN or when a window opens.
+  std::atomic<uint32_t> flush_window_ms_{0};
+  std::atomic<bool> flush_on_syn_{false};
+  std::atomic<size_t> write_capable_clients_{0};
+  std::atomic<bool> readonly_due_{false};    // flush read-only clients now
+  std::atomic<int64_t> coalesce_since_{0};   // window start ticks, 0 = none
+  std::atomic<bool> wakeup_pending_{false};  // one wakeup write in flight
+
   // Listening sockets (must be unique pointers)
   std::unique_ptr<platform::Socket> listen_socket_regular_{nullptr};
   std::unique_ptr<platform::Socket> listen_socket_readonly_{nullptr};
   std::unique_ptr<platform::Socket> listen_socket_enhanced_{nullptr};
-
-  using ClientArray =
-      std::array<std::shared_ptr<AbstractClient>, NetworkLimits::max_clients>;
+  std::unique_ptr<platform::Socket> listen_socket_filtered_{nullptr};
+
+  // AF_UNIX listeners per ClientType and the paths they unlink on close
+  std::array<std::unique_ptr<platform::Socket>, 4> local_listeners_;
+  std::array<std::string, 4> local_paths_;
+
+  // Whole telegrams submitted by clients and the sessions awaiting their
+  // result (protected by mutex_)
+  struct PendingSubmit {
+    uint32_t session_id = 0;
+    std::shared_ptr<AbstractClient> client;
+  };
+  Delegate<uint32_t(uint8_t, ByteView)> submitter_ = nullptr;
+  StaticVector<PendingSubmit, EnhancedProtocolLimits::max_pending_submits>
+      pending_submits_;
+
+  // Turns between bridge clients and the local scheduler (protected by mutex_)
+  SessionArbiter arbiter_;
+  SessionShare local_share_;
+  bool local_active_ = false;  // a scheduler attempt holds the bus
+  Clock::time_point local_requested_at_;
+  Delegate<void()> local_wakeup_ = nullptr;
+
+  // Prometheus/OpenMetrics scrape endpoint sharing the I/O loop
+  MetricsEndpoint metrics_endpoint_;
 
   // Request callback target
   void onBusRequested();
@@ -130,12 +250,27 @@ class ClientManager {
   void transitSessionState(const SessionState& state);
   void handleBusAvailableForSession();
   void tryStartSessionForClient(std::shared_ptr<AbstractClient>& client);
+  void startNextSession();
+  bool startNextSessionLocked(const Clock::time_point& now);
   void trySendNextByte(std::shared_ptr<AbstractClient>& client);
   void stopActiveSession();
   void checkSessionTimeout();
   void handleActiveSenderDisconnected();
 
-  // Helper to find client by fd across all client arrays mutex_ MUST be locked
+  // Client slot management
+  ClientSlots& slotsFor(ClientType type);
+  std::unique_ptr<platform::Socket>& listenerFor(ClientType type);
+  void resizeSlots(ClientSlots& slots, ClientType type, size_t count);
+  BroadcastRing* broadcastFor(ClientType type);
+  void resizeBroadcast(size_t size);
+  void publishBusByte(uint8_t byte);
+  bool insertClient(std::shared_ptr<AbstractClient> client, ClientType type);
+
+  // mutex_ MUST be locked
+  std::shared_ptr<AbstractClient> releaseSlotLocked(ClientSlot& slot);
+  std::shared_ptr<AbstractClient> releaseSlot(ClientSlot& slot);
+
+  // Helper to find client by fd across all client slots mutex_ MUST be locked
   std::shared_ptr<AbstractClient> findClientByFdLocked(int fd);
 
   // Helper to find client by fd
@@ -144,39 +279,27 @@ class ClientManager {
   // Helper to remove client by fd
   void removeClientByFd(int fd);
 
-  std::shared_ptr<AbstractClient> removeClientByFdLocked(int fd);
-
   void removeDisconnectedClients();
 
-  void addListenerFds(fd_set& readfds, int& max_fd);
-
-  void addClientFdsToSet(const ClientArray& clients, fd_set& readfds,
-                         fd_set& writefds, fd_set& exceptfds, int& max_fd);
-
-  int prepareFileDescriptors(fd_set& readfds, fd_set& writefds,
-                             fd_set& exceptfds);
-
-  void drainWakeupSignal(fd_set& readfds);
-
-  void acceptNewConnections(fd_set& readfds);
-
-  void handleClientIO(fd_set& readfds, fd_set& writefds, fd_set& exceptfds);
-
-  void handleClientActivity(
-      ClientArray& clients, fd_set& readfds, fd_set& writefds,
-      fd_set& exceptfds,
-      ebus::StaticVector<std::shared_ptr<AbstractClient>,
-                         NetworkLimits::max_clients * 3>& to_stop);
-
-  void handleSocketInput(
-      int fd, std::shared_ptr<AbstractClient>& client,
-      ebus::StaticVector<std::shared_ptr<AbstractClient>,
-                         NetworkLimits::max_clients * 3>& to_stop);
-
-  void handleSocketOutput(
-      int fd, std::shared_ptr<AbstractClient>& client,
-      ebus::StaticVector<std::shared_ptr<AbstractClient>,
-                         NetworkLimits::max_clients * 3>& to_stop);
+  void openListener(ClientType type, uint16_t port, size_t backlog);
+  void closeListener(ClientType type);
+  void openLocalListener(ClientType type, const std::string& path,
+                         size_t backlog);
+  void closeLocalListener(ClientType type);
+
+  // I/O loop phases (I/O thread only)
+  void updateWriteInterest(bool readonly_flushed);
+  void dispatchEvents(int count, const Clock::time_point& ready_at);
+  void acceptNewConnections(ClientType type, bool local,
+                            const Clock::time_point& ready_at);
+  void handleClientEvent(ClientSlot& slot, uint16_t events);
+  void handleSocketInput(ClientSlot& slot);
+  void submitTelegrams(const std::shared_ptr<AbstractClient>& client);
+  void handleSocketOutput(ClientSlot& slot, bool writable);
+  void flushPendingOutput(bool include_readonly);
+  bool readonlyFlushDue(const Clock::time_point& now, int& timeout_ms);
+  void stopDroppedClients();
+  void housekeeping();
 
   void clientIoLoop();
   void signalClientIoThread();
@@ -11,6 +11,22 @@
 
 namespace ebus {
 
+namespace {
+
+bool parseSlowPolicy(std::string_view name, SlowClientPolicy& policy) {
+  for (SlowClientPolicy candidate :
+       {SlowClientPolicy::drop_oldest, SlowClientPolicy::skip_to_syn,
+        SlowClientPolicy::disconnect}) {
+    if (name == toString(candidate)) {
+      policy = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
 void RuntimeConfig::reset() { *this = RuntimeConfig{}; }
 
 void RuntimeConfig::toJson(detail::JsonWriter& writer) const {
@@ -36,10 +52,32 @@ void RuntimeConfig::toJson(detail::JsonWriter& writer) const {
     writer.writeField("session_timeout_ms", network.session_timeout_ms);
     writer.writeField("transmit_timeout_ms", network.transmit_timeout_ms);
     writer.writeField("outbound_buffer_size", network.outbound_buffer_size);
+    writer.writeField("readonly_flush_window_ms",
+                      network.readonly_flush_window_ms);
+    writer.writeField("readonly_flush_on_syn", network.readonly_flush_on_syn);
     writer.writeField("enable_server", network.enable_server);
     writer.writeField("port_regular", network.port_regular);
     writer.writeField("port_readonly", network.port_readonly);
     writer.writeField("port_enhanced", network.port_enhanced);
+    writer.writeField("port_filtered", network.port_filtered);
+    writer.writeField("port_metrics", network.port_metrics);
+    writer.writeField("unix_path_regular", network.unix_path_regular);
+    writer.writeField("unix_path_readonly", network.unix_path_readonly);
+    writer.writeField("unix_path_enhanced", network.unix_path_enhanced);
+    writer.writeField("unix_path_filtered", network.unix_path_filtered);
+    writer.writeField("max_regular_clients", network.max_regular_clients);
+    writer.writeField("max_readonly_clients", network.max_readonly_clients);
+    writer.writeField("max_enhanced_clients", network.max_enhanced_clients);
+    writer.writeField("max_filtered_clients", network.max_filtered_clients);
+    writer.writeField("local_session_weight", network.local_session_weight);
+    writer.writeField("regular_slow_policy",
+                      toString(network.regular_slow_policy));
+    writer.writeField("readonly_slow_policy",
+                      toString(network.readonly_slow_policy));
+    writer.writeField("enhanced_slow_policy",
+                      toString(network.enhanced_slow_policy));
+    writer.writeField("filtered_slow_policy",
+                      toString(network.filtered_slow_policy));
   }
 
   {
@@ -48,6 +86,10 @@ void RuntimeConfig::toJson(detail::JsonWriter& writer) const {
     writer.writeField("initial_delay_s", device.initial_delay_s);
     writer.writeField("startup_interval_s", device.startup_interval_s);
     writer.writeField("max_startup_scans", device.max_startup_scans);
+    writer.writeField("inventory_path", device.inventory_path);
+    writer.writeField("inventory_interval_s", device.inventory_interval_s);
+    writer.writeField("memory_budget", device.memory_budget);
+    writer.writeField("idle_prediction", device.idle_prediction);
   }
 
   {
@@ -166,6 +208,17 @@ bool RuntimeConfig::mergeFromJson(std::string_view json) {
             if (val) network.outbound_buffer_size = *val;
             return val.has_value();
           }
+          if (k == "readonly_flush_window_ms") {
+            inner.next();
+            auto val = inner.asNumStrict<uint32_t>();
+            if (val) network.readonly_flush_window_ms = *val;
+            return val.has_value();
+          }
+          if (k == "readonly_flush_on_syn") {
+            inner.next();
+            network.readonly_flush_on_syn = inner.asBool();
+            return true;
+          }
           if (k == "enable_server") {
             inner.next();
             network.enable_server = inner.asBool();
@@ -189,6 +242,87 @@ bool RuntimeConfig::mergeFromJson(std::string_view json) {
             if (val) network.port_enhanced = *val;
             return val.has_value();
           }
+          if (k == "port_filtered") {
+            inner.next();
+            auto val = inner.asNumStrict<uint16_t>();
+            if (val) network.port_filtered = *val;
+            return val.has_value();
+          }
+          if (k == "port_metrics") {
+            inner.next();
+            auto val = inner.asNumStrict<uint16_t>();
+            if (val) network.port_metrics = *val;
+            return val.has_value();
+          }
+          if (k == "unix_path_regular") {
+            if (inner.next() != detail::JsonReader::Token::string) return false;
+            network.unix_path_regular = std::string(inner.value());
+            return true;
+          }
+          if (k == "unix_path_readonly") {
+            if (inner.next() != detail::JsonReader::Token::string) return false;
+            network.unix_path_readonly = std::string(inner.value());
+            return true;
+          }
+          if (k == "unix_path_enhanced") {
+            if (inner.next() != detail::JsonReader::Token::string) return false;
+            network.unix_path_enhanced = std::string(inner.value());
+            return true;
+          }
+          if (k == "unix_path_filtered") {
+            if (inner.next() != detail::JsonReader::Token::string) return false;
+            network.unix_path_filtered = std::string(inner.value());
+            return true;
+          }
+          if (k == "max_regular_clients") {
+            inner.next();
+            auto val = inner.asNumStrict<size_t>();
+            if (val) network.max_regular_clients = *val;
+            return val.has_value();
+          }
+          if (k == "max_readonly_clients") {
+            inner.next();
+            auto val = inner.asNumStrict<size_t>();
+            if (val) network.max_readonly_clients = *val;
+            return val.has_value();
+          }
+          if (k == "max_enhanced_clients") {
+            inner.next();
+            auto val = inner.asNumStrict<size_t>();
+            if (val) network.max_enhanced_clients = *val;
+            return val.has_value();
+          }
+          if (k == "max_filtered_clients") {
+            inner.next();
+            auto val = inner.asNumStrict<size_t>();
+            if (val) network.max_filtered_clients = *val;
+            return val.has_value();
+          }
+          if (k == "local_session_weight") {
+            inner.next();
+            auto val = inner.asNumStrict<int>();
+            if (val) network.local_session_weight = static_cast<uint8_t>(*val);
+            return val.has_value();
+          }
+          if (k == "regular_slow_policy") {
+            inner.next();
+            return parseSlowPolicy(inner.value(), network.regular_slow_policy);
+          }
+          if (k == "readonly_slow_policy") {
+            inner.next();
+            return parseSlowPolicy(inner.value(),
+                                   network.readonly_slow_policy);
+          }
+          if (k == "enhanced_slow_policy") {
+            inner.next();
+            return parseSlowPolicy(inner.value(),
+                                   network.enhanced_slow_policy);
+          }
+          if (k == "filtered_slow_policy") {
+            inner.next();
+            return parseSlowPolicy(inner.value(),
+                                   network.filtered_slow_policy);
+          }
           return false;
         });
       }
@@ -220,6 +354,28 @@ bool RuntimeConfig::mergeFromJson(std::string_view json) {
             if (val) device.max_startup_scans = static_cast<uint8_t>(*val);
             return val.has_value();
           }
+          if (k == "inventory_path") {
+            if (inner.next() != detail::JsonReader::Token::string) return false;
+            device.inventory_path = std::string(inner.value());
+            return true;
+          }
+          if (k == "inventory_interval_s") {
+            inner.next();
+            auto val = inner.asNumStrict<uint32_t>();
+            if (val) device.inventory_interval_s = *val;
+            return val.has_value();
+          }
+          if (k == "memory_budget") {
+            inner.next();
+            auto val = inner.asNumStrict<uint32_t>();
+            if (val) device.memory_budget = *val;
+            return val.has_value();
+          }
+          if (k == "idle_prediction") {
+            inner.next();
+            device.idle_prediction = inner.asBool();
+            return true;
+          }
           return false;
         });
       }
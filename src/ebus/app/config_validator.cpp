@@ -7,6 +7,7 @@
 #include <ebus/detail/config_validator.hpp>
 #include <ebus/detail/json_reader.hpp>
 #include <ebus/detail/protocol_limits.hpp>
+#include <iterator>
 
 namespace ebus::detail {
 
@@ -37,22 +38,61 @@ bool ConfigValidator::validate(const EbusConfig& config) {
 
   // 4. Network & Logging
   if (r.network.outbound_buffer_size == 0) return false;
+  if (r.network.readonly_flush_window_ms > NetworkLimits::max_flush_window_ms)
+    return false;
   if (r.network.session_timeout_ms == 0) return false;
   if (r.network.transmit_timeout_ms == 0) return false;
+  for (size_t limit :
+       {r.network.max_regular_clients, r.network.max_readonly_clients,
+        r.network.max_enhanced_clients, r.network.max_filtered_clients}) {
+    if (limit > NetworkLimits::max_clients_per_type) return false;
+  }
+  if (r.network.local_session_weight == 0 ||
+      r.network.local_session_weight > NetworkLimits::max_session_weight)
+    return false;
+  for (SlowClientPolicy policy :
+       {r.network.regular_slow_policy, r.network.readonly_slow_policy,
+        r.network.enhanced_slow_policy, r.network.filtered_slow_policy}) {
+    if (policy > SlowClientPolicy::disconnect) return false;
+  }
+  const std::string* unix_paths[] = {
+      &r.network.unix_path_regular, &r.network.unix_path_readonly,
+      &r.network.unix_path_enhanced, &r.network.unix_path_filtered};
+  for (const std::string* path : unix_paths) {
+    if (path->size() > NetworkLimits::max_unix_path_len) return false;
+  }
   if (r.network.enable_server) {
-    if (r.network.port_regular == 0 || r.network.port_readonly == 0 ||
-        r.network.port_enhanced == 0)
-      return false;
-    if (r.network.port_regular == r.network.port_readonly ||
-        r.network.port_regular == r.network.port_enhanced ||
-        r.network.port_readonly == r.network.port_enhanced)
-      return false;
+    // A client type needs a TCP port unless it has a local socket
+    const uint16_t type_ports[] = {
+        r.network.port_regular, r.network.port_readonly,
+        r.network.port_enhanced, r.network.port_filtered};
+    for (size_t i = 0; i < std::size(type_ports); ++i) {
+      if (type_ports[i] == 0 && unix_paths[i]->empty()) return false;
+      for (size_t j = i + 1; j < std::size(unix_paths); ++j) {
+        if (!unix_paths[i]->empty() && *unix_paths[i] == *unix_paths[j])
+          return false;
+      }
+    }
+    // Every listener needs its own port; 0 disables the metrics endpoint
+    const uint16_t ports[] = {r.network.port_regular, r.network.port_readonly,
+                              r.network.port_enhanced, r.network.port_filtered,
+                              r.network.port_metrics};
+    for (size_t i = 0; i < std::size(ports); ++i) {
+      for (size_t j = i + 1; j < std::size(ports); ++j) {
+        if (ports[i] != 0 && ports[i] == ports[j]) return false;
+      }
+    }
   }
 
   // 5. Platform Specifics
 #if defined(POSIX) && !EBUS_SIMULATION
   if (config.bus.device.empty()) return false;
 #endif
+#if !defined(POSIX)
+  for (const std::string* path : unix_paths) {
+    if (!path->empty()) return false;  // no AF_UNIX sockets
+  }
+#endif
 
   return true;
 }
@@ -127,6 +167,12 @@ bool ConfigValidator::validateJson(std::string_view json) {
     if (reader.asNum<size_t>() == 0) return false;
   }
 
+  if (reader.get("network.readonly_flush_window_ms") ==
+      JsonReader::Token::number) {
+    auto val = reader.asNumStrict<uint32_t>();
+    if (!val || *val > NetworkLimits::max_flush_window_ms) return false;
+  }
+
   if (reader.get("network.session_timeout_ms") == JsonReader::Token::number) {
     if (reader.asNum<uint32_t>() == 0) return false;
   }
@@ -135,19 +181,45 @@ bool ConfigValidator::validateJson(std::string_view json) {
     if (reader.asNum<uint32_t>() == 0) return false;
   }
 
-  if (reader.get("network.port_regular") == JsonReader::Token::number) {
-    auto val = reader.asNumStrict<uint16_t>();
-    if (!val || *val == 0) return false;
-  }
-
-  if (reader.get("network.port_readonly") == JsonReader::Token::number) {
-    auto val = reader.asNumStrict<uint16_t>();
-    if (!val || *val == 0) return false;
+  // Port 0 is only valid for a client type with a local socket path
+  const char* const type_ports[][2] = {
+      {"network.port_regular", "network.unix_path_regular"},
+      {"network.port_readonly", "network.unix_path_readonly"},
+      {"network.port_enhanced", "network.unix_path_enhanced"},
+      {"network.port_filtered", "network.unix_path_filtered"}};
+  for (const auto& keys : type_ports) {
+    bool local = false;
+    if (reader.get(keys[1]) == JsonReader::Token::string) {
+      if (reader.value().size() > NetworkLimits::max_unix_path_len)
+        return false;
+      local = !reader.value().empty();
+    }
+    if (reader.get(keys[0]) == JsonReader::Token::number) {
+      auto val = reader.asNumStrict<uint16_t>();
+      if (!val || (*val == 0 && !local)) return false;
+    }
+  }
+
+  // 0 disables the metrics endpoint
+  if (reader.get("network.port_metrics") == JsonReader::Token::number) {
+    if (!reader.asNumStrict<uint16_t>()) return false;
+  }
+
+  if (reader.get("network.local_session_weight") ==
+      JsonReader::Token::number) {
+    auto val = reader.asNumStrict<int>();
+    if (!val || *val < 1 || *val > NetworkLimits::max_session_weight)
+      return false;
   }
 
-  if (reader.get("network.port_enhanced") == JsonReader::Token::number) {
-    auto val = reader.asNumStrict<uint16_t>();
-    if (!val || *val == 0) return false;
+  // 0 disables the client type
+  for (const char* key :
+       {"network.max_regular_clients", "network.max_readonly_clients",
+        "network.max_enhanced_clients", "network.max_filtered_clients"}) {
+    if (reader.get(key) == JsonReader::Token::number) {
+      auto val = reader.asNumStrict<size_t>();
+      if (!val || *val > NetworkLimits::max_clients_per_type) return false;
+    }
   }
 
   return true;
@@ -15,14 +15,21 @@
 #endif
 #include <algorithm>
 #include <chrono>
+#include <cstdio>
 #include <memory>
+#include <utility>
 
+#include "app/bus_capture.hpp"
 #include "app/client_manager.hpp"
 #include "app/device_manager.hpp"
 #include "app/device_scanner.hpp"
+#include "app/idle_predictor.hpp"
+#include "app/metrics_endpoint.hpp"
 #include "app/poll_manager.hpp"
 #include "app/reactor.hpp"
 #include "app/scheduler.hpp"
+#include "app/subscription_manager.hpp"
+#include "app/traffic_analyzer.hpp"
 #include "core/bus_handler.hpp"
 #include "core/bus_monitor.hpp"
 #include "core/handler.hpp"
@@ -33,6 +40,8 @@
 #include "platform/service_thread.hpp"
 #include "utils/circular_buffer.hpp"
 #include "utils/logger.hpp"
+#include "utils/snapshot_buffer.hpp"
+#include "utils/tracer.hpp"
 
 #if defined(ESP_PLATFORM)
 #include <esp_heap_caps.h>
@@ -45,18 +54,26 @@ struct Impl {
   ebus::ReactiveCallback user_reactive_callback_;
   ebus::ProtocolCallback user_protocol_callback_;
   ebus::TraceCallback user_trace_callback_;
+  ebus::ValueCallback user_value_callback_;
+  ebus::ChangeCallback user_change_callback_;
+  std::shared_ptr<const MessageDatabase> message_database_;
 
   std::atomic<bool> configured_{false};
   std::atomic<bool> running_{false};
 
   std::unique_ptr<detail::Request> request_;
   std::unique_ptr<detail::BusMonitor> bus_monitor_;
+  // Declared before bus_ so it outlives the bus thread feeding it
+  std::unique_ptr<detail::BusCapture> bus_capture_;
   std::unique_ptr<detail::platform::Bus> bus_;
   std::unique_ptr<detail::BusHandler> bus_handler_;
   std::unique_ptr<detail::Handler> handler_;
   std::unique_ptr<detail::DeviceManager> device_manager_;
   std::unique_ptr<detail::DeviceScanner> device_scanner_;
   std::unique_ptr<detail::PollManager> poll_manager_;
+  std::unique_ptr<detail::SubscriptionManager> subscription_manager_;
+  std::unique_ptr<detail::TrafficAnalyzer> traffic_analyzer_;
+  std::unique_ptr<detail::IdlePredictor> idle_predictor_;
   std::unique_ptr<detail::Scheduler> scheduler_;
   std::unique_ptr<detail::Reactor> reactor_;
 #if EBUS_SIMULATION
@@ -70,14 +87,60 @@ struct Impl {
   mutable detail::platform::RecursiveMutex
       config_mutex_;  // Protects config_ and related members
 
+  // Device inventory persistence (device.inventory_path)
+  std::string inventory_path_;
+  std::chrono::seconds inventory_interval_{0};
+  std::atomic<uint32_t> saved_inventory_revision_{0};
+  Clock::time_point next_inventory_save_;
+
+  // Periodic saves: the Reactor serializes the inventory into
+  // pending_inventory_ and wakes inventory_writer_, which writes the file
+  detail::platform::Mutex inventory_mutex_;
+  std::vector<uint8_t> pending_inventory_;  // guarded by inventory_mutex_
+  std::string pending_inventory_path_;      // guarded by inventory_mutex_
+  uint32_t pending_inventory_revision_ = 0;  // guarded by inventory_mutex_
+  detail::platform::Queue<uint8_t> inventory_wakeup_{1};
+  std::atomic<bool> inventory_writer_running_{false};
+  std::unique_ptr<detail::platform::ServiceThread> inventory_writer_;
+
+  // Service status published with the reactor housekeeping; metrics scrapes
+  // read it without taking any component lock
+  detail::SnapshotBuffer<ServiceStatus,
+                         detail::DiagnosticsLimits::status_snapshot_slots>
+      status_snapshots_;
+
   void fetchServiceStatus(ServiceStatus& status) const;
+  bool exportOpenMetrics(size_t part, const JsonChunkVisitor& visitor) const;
 
   void constructMembers(Controller* owner);
 
+  // Enqueues a telegram submitted by a bridge client
+  uint32_t submitClientTelegram(uint8_t priority, ByteView message);
+
+  // Retries a scheduler attempt deferred by the session arbiter
+  void wakeLocalSession();
+
+  std::vector<uint8_t> saveInventory() const;
+  bool loadInventory(ByteView snapshot);
+  bool readInventoryFile();
+  bool writeInventoryFile();
+  static bool writeFile(const std::string& path,
+                        const std::vector<uint8_t>& data);
+  // Hands a changed inventory to the writer every inventory_interval_;
+  // Reactor thread
+  void maintainInventory();
+  void startInventoryWriter();
+  void stopInventoryWriter();
+  // Writer thread loop
+  void runInventoryWriter();
+  // Periodic housekeeping on the Reactor thread
+  void runMaintenance();
+
   // Predicates for resource fairness
   bool isSchedulerFull() const;
   bool isHandlerBusy() const;
   bool isSystemBusy() const;
+  bool isQuietWindow();
 };
 
 Controller::Controller() : impl_(new Impl()) {}
@@ -106,8 +169,13 @@ bool Controller::start() {
 
   impl_->reactor_->setProtocolCallback(impl_->user_protocol_callback_);
   impl_->reactor_->setTraceCallback(impl_->user_trace_callback_);
+  impl_->reactor_->setValueCallback(impl_->user_value_callback_);
+  impl_->reactor_->setMessageDatabase(impl_->message_database_);
   impl_->reactor_->setLogLevel(impl_->log_level_.load());
 
+  impl_->readInventoryFile();
+  impl_->next_inventory_save_ = Clock::now() + impl_->inventory_interval_;
+
   impl_->reactor_->start();
 
   if (config_.runtime.system_inquiry) triggerInquiryOfExistence();
@@ -125,9 +193,17 @@ void Controller::stop() {
     impl_->reactor_->stop();
   }
 
+  impl_->stopInventoryWriter();
+  {
+    detail::platform::LockGuard<detail::platform::RecursiveMutex> lock(
+        impl_->config_mutex_);
+    impl_->writeInventoryFile();
+  }
+
   impl_->client_manager_->stop();
   impl_->scheduler_->stop();
   impl_->bus_->stop();
+  stopCapture();
 }
 
 bool Controller::configure(const EbusConfig& config) {
@@ -179,6 +255,7 @@ void Controller::setAddress(const uint8_t& address) {
     impl_->handler_->reset();
     impl_->request_->reset();
     impl_->device_manager_->setOwnAddress(address);
+    impl_->traffic_analyzer_->setOwnAddress(address);
     impl_->device_scanner_->setOwnAddress(address);
     impl_->poll_manager_->setOwnAddress(address);
     impl_->bus_->setRuntimeConfig(config_.runtime);
@@ -364,6 +441,34 @@ void Controller::setTraceCallback(TraceCallback callback) {
   }
 }
 
+void Controller::setMessageDatabase(
+    std::shared_ptr<const MessageDatabase> database) {
+  detail::platform::LockGuard<detail::platform::RecursiveMutex> lock(
+      impl_->config_mutex_);
+  impl_->message_database_ = std::move(database);
+  if (impl_->reactor_) {
+    impl_->reactor_->setMessageDatabase(impl_->message_database_);
+  }
+}
+
+void Controller::setValueCallback(ValueCallback callback) {
+  detail::platform::LockGuard<detail::platform::RecursiveMutex> lock(
+      impl_->config_mutex_);
+  impl_->user_value_callback_ = std::move(callback);
+  if (impl_->reactor_) {
+    impl_->reactor_->setValueCallback(impl_->user_value_callback_);
+  }
+}
+
+void Controller::setChangeCallback(ChangeCallback callback) {
+  detail::platform::LockGuard<detail::platform::RecursiveMutex> lock(
+      impl_->config_mutex_);
+  impl_->user_change_callback_ = callback;
+  if (impl_->subscription_manager_) {
+    impl_->subscription_manager_->setCallback(impl_->user_change_callback_);
+  }
+}
+
 uint32_t Controller::enqueue(uint8_t priority, ByteView message) {
   if (!impl_->configured_.load()) return 0;
   uint32_t s_id = impl_->scheduler_->enqueue(priority, message);
@@ -408,6 +513,86 @@ void Controller::clearPollItems() {
   if (impl_->configured_.load()) impl_->poll_manager_->clear();
 }
 
+uint16_t Controller::subscribe(const Subscription& subscription) {
+  return impl_->configured_.load()
+             ? impl_->subscription_manager_->subscribe(subscription)
+             : 0;
+}
+
+void Controller::unsubscribe(uint16_t id) {
+  if (impl_->configured_.load()) impl_->subscription_manager_->unsubscribe(id);
+}
+
+void Controller::clearSubscriptions() {
+  if (impl_->configured_.load()) impl_->subscription_manager_->clear();
+}
+
+void Controller::fetchHistory(
+    uint16_t id, std::function<void(uint64_t timestamp, float value)> callback,
+    const HistoryQuery& query) const {
+  if (!impl_->configured_.load() || !callback) return;
+  // Decoded under the manager's lock, handed out after it is released
+  std::vector<std::pair<uint64_t, float>> samples;
+  impl_->subscription_manager_->fetchHistory(
+      id, query,
+      detail::TimeSeriesStore::SampleVisitor(
+          [&samples](uint64_t timestamp, float value) {
+            samples.emplace_back(timestamp, value);
+          }));
+  for (const auto& [timestamp, value] : samples) callback(timestamp, value);
+}
+
+void Controller::fetchHistory(uint16_t id, const JsonChunkVisitor& visitor,
+                              const HistoryQuery& query, bool pretty) const {
+  if (!impl_->configured_.load() || !visitor) return;
+  // Decoded under the manager's lock, streamed after it is released
+  std::vector<std::pair<uint64_t, float>> samples;
+  std::vector<detail::TimeSeriesStore::Bucket> buckets;
+  if (query.step_ms == 0) {
+    impl_->subscription_manager_->fetchHistory(
+        id, query,
+        detail::TimeSeriesStore::SampleVisitor(
+            [&samples](uint64_t timestamp, float value) {
+              samples.emplace_back(timestamp, value);
+            }));
+  } else {
+    impl_->subscription_manager_->fetchHistory(
+        id, query,
+        detail::TimeSeriesStore::BucketVisitor(
+            [&buckets](const detail::TimeSeriesStore::Bucket& bucket) {
+              buckets.push_back(bucket);
+            }));
+  }
+
+  detail::JsonWriter writer(visitor, pretty);
+  auto scope = writer.arrayScope();
+  for (const auto& [timestamp, value] : samples) {
+    auto sample = writer.objectScope();
+    writer.writeField("t", timestamp);
+    writer.writeFieldFloat("v", value);
+  }
+  for (const auto& bucket : buckets) {
+    auto sample = writer.objectScope();
+    writer.writeField("t", bucket.start);
+    writer.writeField("n", bucket.count);
+    writer.writeFieldFloat("min", bucket.min);
+    writer.writeFieldFloat("mean", bucket.mean);
+    writer.writeFieldFloat("max", bucket.max);
+  }
+}
+
+std::vector<uint8_t> Controller::saveInventory() const {
+  if (!impl_->configured_.load()) return {};
+  return impl_->saveInventory();
+}
+
+bool Controller::loadInventory(ByteView snapshot) {
+  if (!impl_->configured_.load()) return false;
+  detail::platform::LockGuard<detail::platform::RecursiveMutex> lock(
+      impl_->config_mutex_);
+  return impl_->loadInventory(snapshot);
+}
+
 void Controller::triggerInquiryOfExistence() {
   enqueue(detail::DeviceLimits::scan_priority,
           ebus::Sequence::inquiryOfExistence());
@@ -505,6 +690,42 @@ void Controller::fetchMetrics(const JsonChunkVisitor& visitor,
   }
 }
 
+bool Controller::fetchMetricsSnapshot(
+    std::function<void(const MetricsSnapshot&)> callback) const {
+  if (impl_->configured_.load() && callback) {
+    return impl_->bus_monitor_->fetchSnapshot(callback);
+  }
+  return false;
+}
+
+void Controller::fetchMetricsSnapshot(const JsonChunkVisitor& visitor,
+                                      bool pretty) const {
+  if (impl_->configured_.load() && visitor) {
+    impl_->bus_monitor_->fetchSnapshot([&](const MetricsSnapshot& snapshot) {
+      detail::JsonWriter writer(visitor, pretty);
+      snapshot.toJson(writer);
+    });
+  }
+}
+
+bool Controller::fetchTrafficMatrix(
+    std::function<void(const TrafficMatrix&)> callback) const {
+  if (impl_->configured_.load() && callback) {
+    return impl_->traffic_analyzer_->fetchSnapshot(callback);
+  }
+  return false;
+}
+
+void Controller::fetchTrafficMatrix(const JsonChunkVisitor& visitor,
+                                    bool pretty) const {
+  if (impl_->configured_.load() && visitor) {
+    impl_->traffic_analyzer_->fetchSnapshot([&](const TrafficMatrix& matrix) {
+      detail::JsonWriter writer(visitor, pretty);
+      matrix.toJson(writer);
+    });
+  }
+}
+
 void Controller::fetchUtilizationHistory(
     std::function<void(float)> callback) const {
   if (impl_->configured_.load() && callback) {
@@ -600,8 +821,58 @@ void Controller::resetMetrics() {
   if (impl_->configured_.load()) impl_->bus_monitor_->resetMetrics();
 }
 
+void Controller::resetLatencyWindow() {
+  if (impl_->configured_.load()) impl_->bus_monitor_->resetLatencyWindow();
+}
+
 void Controller::clearErrors() { impl_->reactor_->clearErrors(); }
 
+void Controller::fetchTraceEvents(const JsonChunkVisitor& visitor,
+                                  bool pretty) const {
+  if (!visitor) return;
+  detail::JsonWriter writer(visitor, pretty);
+#ifdef EBUS_TRACING
+  detail::Tracer::getInstance().toJson(writer);
+#else
+  auto scope = writer.objectScope();
+  { auto events = writer.arrayScope("traceEvents"); }
+#endif
+}
+
+void Controller::clearTraceEvents() {
+#ifdef EBUS_TRACING
+  detail::Tracer::getInstance().clear();
+#endif
+}
+
+bool Controller::startCapture(const std::string& path_prefix,
+                              size_t segment_size, size_t max_segments) {
+  if (!impl_->configured_.load()) return false;
+
+  detail::platform::LockGuard<detail::platform::RecursiveMutex> lock(
+      impl_->config_mutex_);
+  if (!impl_->bus_capture_)
+    impl_->bus_capture_ = std::make_unique<detail::BusCapture>();
+
+  if (!impl_->bus_capture_->start(path_prefix, segment_size, max_segments))
+    return false;
+
+  impl_->reactor_->setBusCapture(impl_->bus_capture_.get());
+  return true;
+}
+
+void Controller::stopCapture() {
+  detail::platform::LockGuard<detail::platform::RecursiveMutex> lock(
+      impl_->config_mutex_);
+  if (impl_->bus_capture_) impl_->bus_capture_->stop();
+}
+
+bool Controller::isCapturing() const {
+  detail::platform::LockGuard<detail::platform::RecursiveMutex> lock(
+      impl_->config_mutex_);
+  return impl_->bus_capture_ && impl_->bus_capture_->isActive();
+}
+
 #if EBUS_SIMULATION
 VirtualBus& Controller::getVirtualBus() { return *impl_->virtual_bus_; }
 #endif
@@ -618,9 +889,42 @@ void Impl::fetchServiceStatus(ServiceStatus& status) const {
     status.device_manager = device_manager_->fetchStatus();
     status.device_scanner = device_scanner_->fetchStatus();
     status.poll_manager = poll_manager_->fetchStatus();
+    status.subscriptions = subscription_manager_->fetchStatus();
+    status.idle_predictor = idle_predictor_->fetchStatus();
   }
 }
 
+bool Impl::exportOpenMetrics(size_t part,
+                             const JsonChunkVisitor& visitor) const {
+  if (!configured_.load()) return false;
+
+  detail::OpenMetricsWriter writer(visitor);
+  if (part < detail::metrics_parts) {
+    // Prefer the published snapshot so scrapes never take the metrics lock
+    if (!bus_monitor_->fetchSnapshot([&](const MetricsSnapshot& snapshot) {
+          detail::exportOpenMetrics(writer, *snapshot.current, part);
+        })) {
+      bus_monitor_->fetchMetrics([&](const Metrics& m) {
+        detail::exportOpenMetrics(writer, m, part);
+      });
+    }
+    return true;
+  }
+
+  part -= detail::metrics_parts;
+  if (part < detail::status_parts) {
+    // Status families appear once the reactor has published a snapshot
+    status_snapshots_.read(
+        [&](uint64_t, const ServiceStatus& status, const ServiceStatus*) {
+          detail::exportOpenMetrics(writer, status, part);
+        });
+    return true;
+  }
+
+  writer.finish();
+  return false;
+}
+
 void Impl::constructMembers(Controller* owner) {
   // -- 1. Telemetry & Core Arbitration --
   if (!bus_monitor_) {
@@ -677,6 +981,19 @@ void Impl::constructMembers(Controller* owner) {
         detail::Delegate<bool()>::bind<Impl, &Impl::isSchedulerFull>(this));
   }
 
+  if (!subscription_manager_) {
+    subscription_manager_ = std::make_unique<detail::SubscriptionManager>();
+    subscription_manager_->setCallback(user_change_callback_);
+  }
+
+  if (!traffic_analyzer_) {
+    traffic_analyzer_ = std::make_unique<detail::TrafficAnalyzer>();
+  }
+
+  if (!idle_predictor_) {
+    idle_predictor_ = std::make_unique<detail::IdlePredictor>();
+  }
+
   // -- 6. Plumbing --
   if (!bus_handler_) {
     bus_handler_ =
@@ -692,6 +1009,9 @@ void Impl::constructMembers(Controller* owner) {
   if (!client_manager_) {
     client_manager_ = std::make_unique<detail::ClientManager>(
         bus_.get(), bus_handler_.get(), request_.get(), bus_monitor_.get());
+    client_manager_->setMetricsExporter(
+        detail::MetricsEndpoint::Exporter::bind<Impl, &Impl::exportOpenMetrics>(
+            this));
   }
 
   // -- 7. Reactor --
@@ -706,6 +1026,46 @@ void Impl::constructMembers(Controller* owner) {
       reactor_->pushProtocolEvent(std::move(ev));
     });
 
+    // Wire Reactor -> ClientManager (filtered clients)
+    reactor_->setTelegramSink(
+        detail::Delegate<void(const detail::ProtocolEvent&)>::bind<
+            detail::ClientManager, &detail::ClientManager::onTelegram>(
+            client_manager_.get()));
+
+    // Wire Reactor -> SubscriptionManager (decoded value changes)
+    reactor_->setSubscriptionManager(subscription_manager_.get());
+
+    // Wire Reactor -> TrafficAnalyzer (traffic matrix)
+    reactor_->setTrafficAnalyzer(traffic_analyzer_.get());
+
+    // Wire Reactor -> IdlePredictor (quiet windows for background scans)
+    reactor_->setIdlePredictor(idle_predictor_.get());
+
+    // Periodic status snapshots and inventory saves
+    reactor_->setMaintenanceTask(
+        detail::Delegate<void()>::bind<Impl, &Impl::runMaintenance>(this));
+
+    // Wire enhanced client submissions -> Scheduler -> ClientManager
+    client_manager_->setTelegramSubmitter(
+        detail::Delegate<uint32_t(uint8_t, ByteView)>::bind<
+            Impl, &Impl::submitClientTelegram>(this));
+    reactor_->setSessionResultSink(
+        detail::Delegate<void(const detail::ProtocolEvent&)>::bind<
+            detail::ClientManager, &detail::ClientManager::onSessionResult>(
+            client_manager_.get()));
+
+    // Wire Scheduler <-> ClientManager (bus session turns)
+    scheduler_->setSessionGate(
+        detail::Delegate<bool()>::bind<
+            detail::ClientManager,
+            &detail::ClientManager::acquireLocalSession>(client_manager_.get()),
+        detail::Delegate<void(bool)>::bind<
+            detail::ClientManager,
+            &detail::ClientManager::releaseLocalSession>(
+            client_manager_.get()));
+    client_manager_->setLocalSessionWakeup(
+        detail::Delegate<void()>::bind<Impl, &Impl::wakeLocalSession>(this));
+
     // Wire BusHandler -> Reactor (trace events)
     bus_handler_->setReactorBusEventInfoCallback(
         detail::Delegate<void(const BusEventInfo&)>::bind<
@@ -729,6 +1089,11 @@ void Impl::constructMembers(Controller* owner) {
   owner->setInitialScanDelay(owner->config_.runtime.device.initial_delay_s);
   owner->setStartupScanInterval(
       owner->config_.runtime.device.startup_interval_s);
+  inventory_path_ = owner->config_.runtime.device.inventory_path;
+  inventory_interval_ =
+      std::chrono::seconds(owner->config_.runtime.device.inventory_interval_s);
+  device_manager_->setMemoryBudget(owner->config_.runtime.device.memory_budget);
+  idle_predictor_->setEnabled(owner->config_.runtime.device.idle_prediction);
   owner->setMaxAttempts(owner->config_.runtime.scheduler.max_attempts);
   owner->setBaseBackoff(owner->config_.runtime.scheduler.base_backoff_ms);
   owner->setFsmTimeout(owner->config_.runtime.scheduler.fsm_timeout_ms);
@@ -740,9 +1105,165 @@ void Impl::constructMembers(Controller* owner) {
   if (device_scanner_) {
     device_scanner_->setBusyPredicate(
         detail::Delegate<bool()>::bind<Impl, &Impl::isSystemBusy>(this));
+    device_scanner_->setQuietPredicate(
+        detail::Delegate<bool()>::bind<Impl, &Impl::isQuietWindow>(this));
   }
 }
 
+uint32_t Impl::submitClientTelegram(uint8_t priority, ByteView message) {
+  uint32_t s_id = scheduler_->enqueue(priority, message);
+  if (s_id > 0 && reactor_) {
+    detail::ReactorSignal ev;
+    ev.type = detail::ReactorSignal::Type::user_request;
+    reactor_->pushSignal(std::move(ev));
+  }
+  return s_id;
+}
+
+void Impl::wakeLocalSession() {
+  if (!reactor_) return;
+  detail::ReactorSignal ev;
+  ev.type = detail::ReactorSignal::Type::user_request;
+  reactor_->pushSignal(std::move(ev));
+}
+
+std::vector<uint8_t> Impl::saveInventory() const {
+  return device_manager_->saveSnapshot(device_scanner_->getQuarantined());
+}
+
+bool Impl::loadInventory(ByteView snapshot) {
+  std::bitset<256> quarantined;
+  if (!device_manager_->loadSnapshot(snapshot, quarantined)) return false;
+  device_scanner_->restoreQuarantined(quarantined);
+  saved_inventory_revision_.store(device_manager_->revision());
+  return true;
+}
+
+bool Impl::readInventoryFile() {
+  if (inventory_path_.empty()) return false;
+  FILE* file = std::fopen(inventory_path_.c_str(), "rb");
+  if (!file) return false;
+
+  std::vector<uint8_t> data;
+  uint8_t buffer[256];
+  size_t n;
+  while ((n = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+    data.insert(data.end(), buffer, buffer + n);
+  std::fclose(file);
+
+  if (!loadInventory(data)) {
+    EBUS_LOG_ERROR_F("[controller] Ignoring invalid device inventory %s",
+                     inventory_path_.c_str());
+    return false;
+  }
+  EBUS_LOG_INFO_F("[controller] Restored device inventory from %s",
+                  inventory_path_.c_str());
+  return true;
+}
+
+bool Impl::writeInventoryFile() {
+  if (inventory_path_.empty() || !device_manager_) return false;
+  const uint32_t revision = device_manager_->revision();
+  if (!writeFile(inventory_path_, saveInventory())) return false;
+  saved_inventory_revision_.store(revision);
+  return true;
+}
+
+bool Impl::writeFile(const std::string& path,
+                     const std::vector<uint8_t>& data) {
+  // Write a temporary file first so that a crash never leaves a torn one
+  const std::string temp = path + ".tmp";
+  FILE* file = std::fopen(temp.c_str(), "wb");
+  if (!file) return false;
+  const bool written =
+      std::fwrite(data.data(), 1, data.size(), file) == data.size();
+  if (std::fclose(file) != 0 || !written) {
+    std::remove(temp.c_str());
+    return false;
+  }
+  if (std::rename(temp.c_str(), path.c_str()) != 0) {
+    // Some file systems (e.g. FAT) do not replace an existing target
+    std::remove(path.c_str());
+    if (std::rename(temp.c_str(), path.c_str()) != 0) return false;
+  }
+  return true;
+}
+
+void Impl::maintainInventory() {
+  detail::platform::LockGuard<detail::platform::RecursiveMutex> lock(
+      config_mutex_);
+  if (inventory_path_.empty() || inventory_interval_.count() == 0) return;
+
+  const auto now = Clock::now();
+  if (now < next_inventory_save_) return;
+  next_inventory_save_ = now + inventory_interval_;
+  const uint32_t revision = device_manager_->revision();
+  if (revision == saved_inventory_revision_.load()) return;
+
+  // Only the serialization runs here; the writer does the file I/O
+  std::vector<uint8_t> data = saveInventory();
+  {
+    detail::platform::LockGuard<detail::platform::Mutex> pending(
+        inventory_mutex_);
+    pending_inventory_ = std::move(data);
+    pending_inventory_path_ = inventory_path_;
+    pending_inventory_revision_ = revision;
+  }
+  startInventoryWriter();
+  inventory_wakeup_.tryPush(1);
+}
+
+void Impl::startInventoryWriter() {
+  if (inventory_writer_) return;
+  inventory_writer_running_.store(true, std::memory_order_release);
+  inventory_writer_ = std::make_unique<detail::platform::ServiceThread>(
+      "ebus_inventory",
+      detail::Delegate<void()>::bind<Impl, &Impl::runInventoryWriter>(this),
+      detail::DeviceLimits::inventory_stack_size,
+      detail::DeviceLimits::inventory_priority);
+  inventory_writer_->start();
+}
+
+void Impl::stopInventoryWriter() {
+  if (!inventory_writer_) return;
+  inventory_writer_running_.store(false, std::memory_order_release);
+  inventory_wakeup_.tryPush(1);
+  inventory_writer_->join();
+  inventory_writer_.reset();
+}
+
+void Impl::runInventoryWriter() {
+  uint8_t wakeup;
+  while (inventory_writer_running_.load(std::memory_order_acquire)) {
+    if (!inventory_wakeup_.pop(wakeup,
+                               detail::DeviceLimits::inventory_wait_ms))
+      continue;
+
+    std::vector<uint8_t> data;
+    std::string path;
+    uint32_t revision;
+    {
+      detail::platform::LockGuard<detail::platform::Mutex> pending(
+          inventory_mutex_);
+      data.swap(pending_inventory_);
+      path = pending_inventory_path_;
+      revision = pending_inventory_revision_;
+    }
+    if (data.empty()) continue;
+    if (writeFile(path, data))
+      saved_inventory_revision_.store(revision);
+    else
+      EBUS_LOG_ERROR_F("[controller] Cannot write device inventory %s",
+                       path.c_str());
+  }
+}
+
+void Impl::runMaintenance() {
+  status_snapshots_.publish(
+      [this](ServiceStatus& status) { fetchServiceStatus(status); });
+  maintainInventory();
+}
+
 bool Impl::isSchedulerFull() const {
   return scheduler_ && scheduler_->size() >= scheduler_->capacity();
 }
@@ -756,4 +1277,8 @@ bool Impl::isSystemBusy() const {
          (client_manager_ && client_manager_->isSessionActive());
 }
 
+bool Impl::isQuietWindow() {
+  return !idle_predictor_ || idle_predictor_->admit(Clock::now());
+}
+
 }  // namespace ebus
@@ -5,17 +5,82 @@
 
 #include "app/device_manager.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <ebus/protocol_math.hpp>
+
 #include "core/bus_monitor.hpp"
 
 namespace ebus::detail {
 
+namespace {
+
+constexpr char snapshot_magic[4] = {'E', 'B', 'D', 'I'};
+constexpr uint8_t snapshot_version = 1;
+constexpr size_t bitsets_offset = 7;
+constexpr size_t snapshot_header = bitsets_offset + 3 * 32;
+
+void putBitset(std::vector<uint8_t>& out, const std::bitset<256>& bits) {
+  for (size_t i = 0; i < 256; i += 8) {
+    uint8_t byte = 0;
+    for (size_t b = 0; b < 8; ++b)
+      if (bits.test(i + b)) byte |= static_cast<uint8_t>(1u << b);
+    out.push_back(byte);
+  }
+}
+
+std::bitset<256> getBitset(const uint8_t* in) {
+  std::bitset<256> bits;
+  for (size_t i = 0; i < 256; ++i)
+    if ((in[i / 8] >> (i % 8)) & 1u) bits.set(i);
+  return bits;
+}
+
+uint8_t snapshotCrc(const uint8_t* data, size_t size) {
+  uint8_t crc = 0;
+  for (size_t i = 0; i < size; ++i) crc = calcCRC(data[i], crc);
+  return crc;
+}
+
+}  // namespace
+
 DeviceManager::DeviceManager(BusMonitor* monitor) : monitor_(monitor) {
-  address_map_.fill(-1);
+  address_map_.fill(unused);
+  setMemoryBudget(DeviceLimits::memory_budget);
 }
 
 void DeviceManager::setOwnAddress(uint8_t address) { own_address_ = address; }
 
-void DeviceManager::update(ByteView master_view, ByteView slave_view) {
+void DeviceManager::setMemoryBudget(size_t bytes) {
+  platform::LockGuard<platform::Mutex> lock(mutex_);
+  max_devices_ = std::min(bytes / sizeof(Device), DeviceLimits::max_devices);
+}
+
+Device* DeviceManager::find(uint8_t slave_addr) {
+  const uint8_t idx = address_map_[slave_addr];
+  return idx != unused ? &devices_[idx] : nullptr;
+}
+
+const Device* DeviceManager::find(uint8_t slave_addr) const {
+  const uint8_t idx = address_map_[slave_addr];
+  return idx != unused ? &devices_[idx] : nullptr;
+}
+
+Device* DeviceManager::allocate(uint8_t slave_addr) {
+  if (devices_.size() >= max_devices_) return nullptr;
+
+  // Grow in small steps so that the capacity stays close to the budget
+  if (devices_.size() == devices_.capacity())
+    devices_.reserve(std::min(devices_.size() + 8, max_devices_));
+
+  address_map_[slave_addr] = static_cast<uint8_t>(devices_.size());
+  identified_devices_.set(slave_addr);
+  return &devices_.emplace_back();
+}
+
+void DeviceManager::update(ByteView master_view, ByteView slave_view,
+                           const TelegramTimings& timings,
+                           uint64_t timestamp) {
   platform::LockGuard<platform::Mutex> lock(mutex_);
   uint8_t m_addr = master_view[0];
   uint8_t s_addr = master_view[1];
@@ -30,12 +95,14 @@ void DeviceManager::update(ByteView master_view, ByteView slave_view) {
       if (is_new(m_addr) && !identified_devices_.test(ebus::slaveOf(m_addr))) {
         d.unknown_devices++;
       }
+      if (!masters_.test(m_addr)) revision_++;
       masters_.set(m_addr);
 
       if (ebus::isSlave(s_addr)) {
         if (is_new(s_addr) && !identified_devices_.test(s_addr)) {
           d.unknown_devices++;
         }
+        if (!slaves_.test(s_addr)) revision_++;
         slaves_.set(s_addr);
       }
     });
@@ -44,38 +111,72 @@ void DeviceManager::update(ByteView master_view, ByteView slave_view) {
   // Device Inventory & Frequency Tracking
   uint8_t target = master_view[1];
 
-  auto updateEntry = [&](uint8_t slave_addr, ByteView m_view, ByteView s_view) {
-    if (slave_addr == ebus::slaveOf(own_address_)) return;
-
-    int16_t idx = address_map_[slave_addr];
-    if (idx == -1) {
-      if (pool_usage_ >= max_devices_) return;
+  auto updateEntry = [&](uint8_t slave_addr, ByteView m_view,
+                         ByteView s_view) -> Device* {
+    if (slave_addr == ebus::slaveOf(own_address_)) return nullptr;
 
-      idx = static_cast<int16_t>(pool_usage_++);
-      address_map_[slave_addr] = idx;
-      identified_devices_.set(slave_addr);
+    Device* device = find(slave_addr);
+    if (!device) {
+      device = allocate(slave_addr);
+      if (!device) return nullptr;
+      revision_++;
 
       if (monitor_) {
         monitor_->updateDevice([](auto& d) {
           if (d.unknown_devices > 0) d.unknown_devices--;
         });
         monitor_->updateDevice([this](auto& d) {
-          d.identified_devices = static_cast<uint32_t>(pool_usage_);
+          d.identified_devices = static_cast<uint32_t>(devices_.size());
         });
       }
     }
-    device_pool_[idx].update(slave_addr, m_view, s_view);
+    if (device->update(slave_addr, m_view, s_view)) revision_++;
+    return device;
   };
 
+  const size_t bytes = master_view.size() + slave_view.size();
+
   // 1. Track Source Activity (Master)
-  if (ebus::isMaster(m_addr))
-    updateEntry(ebus::slaveOf(m_addr), master_view, {});
+  if (ebus::isMaster(m_addr)) {
+    Device* source = updateEntry(ebus::slaveOf(m_addr), master_view, {});
+    if (source) {
+      source->stats().recordTelegram(bytes, {}, timestamp);
+      if (timings.first_byte_us > 0)
+        source->stats().recordFirstByte(timings.first_byte_us);
+    }
+  }
 
-  // 2. Track Target Activity (Master or Slave)
-  if (ebus::isMaster(target))
-    updateEntry(ebus::slaveOf(target), master_view, {});
-  else if (ebus::isSlave(target))
-    updateEntry(target, master_view, slave_view);
+  // 2. Track Target Activity (Master or Slave); acknowledges and the
+  // response belong to the target. Allocating the target may move the
+  // entries, so it is told apart from the source by address.
+  Device* device = nullptr;
+  uint8_t device_addr = 0;
+  if (ebus::isMaster(target)) {
+    device_addr = ebus::slaveOf(target);
+    device = updateEntry(device_addr, master_view, {});
+  } else if (ebus::isSlave(target)) {
+    device_addr = target;
+    device = updateEntry(target, master_view, slave_view);
+  }
+  const bool is_source =
+      ebus::isMaster(m_addr) && device_addr == ebus::slaveOf(m_addr);
+  if (device && !is_source) {
+    device->stats().recordTelegram(bytes, timings, timestamp);
+    if (!slave_view.empty() && timings.response_us > 0)
+      device->stats().recordResponse(timings.response_us);
+  }
+}
+
+void DeviceManager::recordError(ByteView master_view,
+                                const TelegramTimings& timings) {
+  if (master_view.size() < 2) return;
+  const uint8_t target = master_view[1];
+  if (!ebus::isMaster(target) && !ebus::isSlave(target)) return;
+
+  platform::LockGuard<platform::Mutex> lock(mutex_);
+  Device* device =
+      find(ebus::isMaster(target) ? ebus::slaveOf(target) : target);
+  if (device) device->stats().recordError(timings.naks);
 }
 
 uint16_t DeviceManager::findNextObservedSlave(uint8_t start) const {
@@ -99,11 +200,11 @@ uint16_t DeviceManager::findNextObservedSlave(uint8_t start) const {
 bool DeviceManager::getNextPendingVendorCommandForDevice(
     uint8_t device_addr, uint16_t& cursor, Sequence& out_cmd) const {
   platform::LockGuard<platform::Mutex> lock(mutex_);
-  const int16_t idx = address_map_[device_addr];
-  if (idx != -1) {
+  const Device* device = find(device_addr);
+  if (device) {
     // Ensure the cursor is within valid bounds for the device's vendor commands
     if (cursor < 4) {  // Assuming max 4 vendor commands for now (Vaillant)
-      return device_pool_[idx].getNextPendingVendorCommand(cursor, out_cmd);
+      return device->getNextPendingVendorCommand(cursor, out_cmd);
     }
   }
   cursor = 4;    // Mark as exhausted
@@ -114,18 +215,78 @@ uint16_t DeviceManager::findNextPendingVendorCommand(uint16_t start_addr,
                                                      Sequence& out_cmd) const {
   platform::LockGuard<platform::Mutex> lock(mutex_);
   for (uint16_t addr = start_addr; addr < 256; ++addr) {
-    int16_t idx = address_map_[addr];
-    if (idx != -1 && device_pool_[idx].getFirstPendingVendorCommand(out_cmd)) {
-      return addr;
-    }
+    const Device* device = find(static_cast<uint8_t>(addr));
+    if (device && device->getFirstPendingVendorCommand(out_cmd)) return addr;
   }
   return 256;
 }
 
+std::vector<uint8_t> DeviceManager::saveSnapshot(
+    const std::bitset<256>& quarantined) const {
+  platform::LockGuard<platform::Mutex> lock(mutex_);
+  std::vector<uint8_t> out(snapshot_magic,
+                           snapshot_magic + sizeof(snapshot_magic));
+  out.push_back(snapshot_version);
+  out.push_back(static_cast<uint8_t>(devices_.size()));
+  out.push_back(static_cast<uint8_t>(devices_.size() >> 8));
+  putBitset(out, masters_);
+  putBitset(out, slaves_);
+  putBitset(out, quarantined);
+
+  for (size_t addr = 0; addr < 256; ++addr) {
+    const Device* device = find(static_cast<uint8_t>(addr));
+    if (device) device->writeSnapshot(out);
+  }
+  out.push_back(snapshotCrc(out.data(), out.size()));
+  return out;
+}
+
+bool DeviceManager::loadSnapshot(ByteView snapshot,
+                                 std::bitset<256>& quarantined) {
+  if (snapshot.size() < snapshot_header + 1 ||
+      std::memcmp(snapshot.data(), snapshot_magic, sizeof(snapshot_magic)) !=
+          0 ||
+      snapshot[4] != snapshot_version ||
+      snapshotCrc(snapshot.data(), snapshot.size() - 1) !=
+          snapshot[snapshot.size() - 1])
+    return false;
+
+  // Parse everything before touching the inventory
+  const size_t count = std::min<size_t>(snapshot[5] | (snapshot[6] << 8),
+                                        DeviceLimits::max_devices);
+  std::vector<Device> devices(count);
+  ByteView in(snapshot.data() + snapshot_header,
+              snapshot.size() - snapshot_header - 1);
+  for (size_t i = 0; i < count; ++i)
+    if (!devices[i].readSnapshot(in)) return false;
+
+  platform::LockGuard<platform::Mutex> lock(mutex_);
+  const uint8_t* bitsets = snapshot.data() + bitsets_offset;
+  masters_ |= getBitset(bitsets);
+  slaves_ |= getBitset(bitsets + 32);
+  quarantined = getBitset(bitsets + 64);
+
+  const uint8_t own_slave = ebus::slaveOf(own_address_);
+  for (size_t i = 0; i < count; ++i) {
+    const uint8_t addr = devices[i].getSlave();
+    if (addr == own_slave || find(addr)) continue;
+    Device* device = allocate(addr);
+    if (!device) break;
+    *device = devices[i];
+  }
+
+  if (monitor_) {
+    monitor_->updateDevice([this](auto& d) {
+      d.identified_devices = static_cast<uint32_t>(devices_.size());
+    });
+  }
+  return true;
+}
+
 bool DeviceManager::isIdentified(uint8_t addr) const {
   platform::LockGuard<platform::Mutex> lock(mutex_);
-  int16_t idx = address_map_[addr];
-  return idx != -1 && device_pool_[idx].isIdentified();
+  const Device* device = find(addr);
+  return device && device->isIdentified();
 }
 
 bool DeviceManager::needsDeepScan(uint8_t addr) const {
@@ -150,8 +311,8 @@ void DeviceManager::fetchDevices(
   platform::LockGuard<platform::Mutex> lock(mutex_);
   if (callback) {
     for (size_t i = 0; i < 256; ++i) {
-      int16_t idx = address_map_[i];
-      if (idx != -1) callback(device_pool_[idx].getDevice());
+      const Device* device = find(static_cast<uint8_t>(i));
+      if (device) callback(device->getDevice());
     }
   }
 }
@@ -161,6 +322,9 @@ DeviceManagerStatus DeviceManager::fetchStatus() const {
   DeviceManagerStatus s;
   s.identified_count = identified_devices_.count();
   s.device_capacity = max_devices_;
+  s.memory_usage = devices_.capacity() * sizeof(Device);
+  for (const auto& device : devices_)
+    if (device.isRestored()) s.restored_count++;
   if (monitor_) {
     monitor_->fetchMetrics(
         [&](const Metrics& m) { s.unknown_count = m.devices.unknown_devices; });
@@ -168,4 +332,9 @@ DeviceManagerStatus DeviceManager::fetchStatus() const {
   return s;
 }
 
+uint32_t DeviceManager::revision() const {
+  platform::LockGuard<platform::Mutex> lock(mutex_);
+  return revision_;
+}
+
 }  // namespace ebus::detail
\ No newline at end of file
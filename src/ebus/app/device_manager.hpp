@@ -8,11 +8,13 @@
 #include <array>
 #include <bitset>
 #include <cstdint>
+#include <ebus/callbacks.hpp>
 #include <ebus/device.hpp>
 #include <ebus/metrics.hpp>
 #include <ebus/sequence.hpp>
 #include <ebus/status.hpp>
 #include <functional>
+#include <vector>
 
 #include "models/device.hpp"
 #include "platform/mutex.hpp"
@@ -27,6 +29,11 @@ class BusMonitor;
  * their manufacturers. Provides methods to generate scan commands for
  * discovered devices. Also tracks master and slave addresses observed on the
  * bus.
+ *
+ * Any slave address can hold a device. A byte map from address to entry
+ * covers all 256 addresses; entries are allocated when a device first
+ * appears, as long as they fit into the memory budget. Each entry keeps
+ * traffic and health statistics, updated in O(1) per telegram.
  */
 class DeviceManager {
  public:
@@ -36,8 +43,25 @@ class DeviceManager {
   // Configuration
   void setOwnAddress(uint8_t address);
 
+  /**
+   * @brief Limits the memory of the device entries. Existing entries are
+   * kept when the budget shrinks; only new devices are refused.
+   */
+  void setMemoryBudget(size_t bytes);
+
   // Working Methods
-  void update(ByteView master_view, ByteView slave_view);
+  /**
+   * @brief Updates the inventory and statistics with a completed telegram.
+   * @param timings Byte timing of the telegram as seen by the Handler.
+   * @param timestamp Wall time in ms, recorded as last seen.
+   */
+  void update(ByteView master_view, ByteView slave_view,
+              const TelegramTimings& timings = {}, uint64_t timestamp = 0);
+
+  /**
+   * @brief Counts a failed telegram against its known target device.
+   */
+  void recordError(ByteView master_view, const TelegramTimings& timings);
 
   /**
    * @brief Finds the next slave address that has been observed but not
@@ -69,6 +93,25 @@ class DeviceManager {
   uint16_t findNextPendingVendorCommand(uint16_t start_addr,
                                         Sequence& out_cmd) const;
 
+  /**
+   * @brief Serializes the inventory for a warm start (format version 1):
+   *
+   *   magic "EBDI" | version u8 | device count u16 LE | masters, slaves and
+   *   quarantined addresses as 32 byte bitsets | one Device record per
+   *   device | eBUS CRC u8 over all previous bytes
+   *
+   * @param quarantined Addresses the scanner has given up on.
+   */
+  std::vector<uint8_t> saveSnapshot(const std::bitset<256>& quarantined) const;
+
+  /**
+   * @brief Merges a snapshot into the inventory. Addresses already known
+   * keep their live data; restored devices count as identified, so the
+   * startup scan skips them, and are confirmed by passive traffic.
+   * @return false if the snapshot is malformed; nothing is changed then.
+   */
+  bool loadSnapshot(ByteView snapshot, std::bitset<256>& quarantined);
+
   // Status/Telemetry
   /**
    * @brief Returns true if the device at the given address has been identified
@@ -89,22 +132,33 @@ class DeviceManager {
 
   DeviceManagerStatus fetchStatus() const;
 
+  // Incremented whenever the data of a snapshot would change
+  uint32_t revision() const;
+
  private:
+  static constexpr uint8_t unused = 0xff;
+
   uint8_t own_address_ = 0xff;
   BusMonitor* monitor_ = nullptr;
-  size_t max_devices_ = DeviceLimits::max_devices;
+  size_t max_devices_ = 0;
 
   mutable platform::Mutex mutex_;
 
-  std::array<Device, DeviceLimits::max_devices> device_pool_;
-  std::array<int16_t, 256>
-      address_map_;  // Maps slave address to pool index, -1 if unused
-  size_t pool_usage_ = 0;
+  std::vector<Device> devices_;
+  // Maps slave address to entry index, unused if none
+  std::array<uint8_t, 256> address_map_;
 
   std::bitset<256> identified_devices_{};  // Tracks if address has an
                                            // associated Device entry
   std::bitset<256> masters_{};
   std::bitset<256> slaves_{};
+  uint32_t revision_ = 0;
+
+  // Returns the entry of a slave address, or nullptr if it has none
+  Device* find(uint8_t slave_addr);
+  const Device* find(uint8_t slave_addr) const;
+  // Adds an entry for a new address; nullptr if the budget is exhausted
+  Device* allocate(uint8_t slave_addr);
 };
 
 }  // namespace ebus::detail
@@ -38,6 +38,7 @@ void DeviceScanner::stop() {
   scan_attempt_counters_.fill(0);
   current_deep_scan_address_ = 256;
   startup_iteration_active_ = false;
+  held_command_.clear();
 }
 
 void DeviceScanner::setOwnAddress(uint8_t address) {
@@ -85,6 +86,11 @@ void DeviceScanner::setBusyPredicate(Delegate<bool()> pred) {
   is_busy_ = std::move(pred);
 }
 
+void DeviceScanner::setQuietPredicate(Delegate<bool()> pred) {
+  platform::LockGuard<platform::Mutex> lock(mutex_);
+  is_quiet_ = std::move(pred);
+}
+
 void DeviceScanner::initFullScan(bool enable) {
   platform::LockGuard<platform::Mutex> lock(mutex_);
   full_scan_ = enable;
@@ -128,6 +134,16 @@ bool DeviceScanner::scanAddresses(const std::vector<uint8_t>& addresses) {
 ebus::Sequence DeviceScanner::nextCommand() {
   platform::UniqueLock<platform::Mutex> lock(mutex_);
 
+  if (held_command_.empty()) held_command_ = selectCommand(lock);
+  if (held_command_.empty() || (is_quiet_ && !is_quiet_())) return {};
+
+  Sequence cmd = held_command_;
+  held_command_.clear();
+  return cmd;
+}
+
+ebus::Sequence DeviceScanner::selectCommand(
+    platform::UniqueLock<platform::Mutex>& lock) {
   if (!device_manager_) {
     return {};
   }
@@ -271,6 +287,17 @@ void DeviceScanner::onScanResult(uint8_t address, bool success) {
 
 void DeviceScanner::resetPeakMetrics() {}
 
+std::bitset<256> DeviceScanner::getQuarantined() const {
+  platform::LockGuard<platform::Mutex> lock(mutex_);
+  return quarantined_scans_;
+}
+
+void DeviceScanner::restoreQuarantined(const std::bitset<256>& quarantined) {
+  platform::LockGuard<platform::Mutex> lock(mutex_);
+  quarantined_scans_ |= quarantined;
+  last_scan_attempt_ = Clock::now();
+}
+
 bool DeviceScanner::isFullScan() const {
   platform::LockGuard<platform::Mutex> lock(mutex_);
   return full_scan_;
@@ -56,6 +56,13 @@ class DeviceScanner {
    */
   void setBusyPredicate(Delegate<bool()> pred);
 
+  /**
+   * @brief Sets a predicate that admits a scan command only in a quiet bus
+   * window. Applies to every scan; a held back command is kept and returned
+   * once the predicate admits it.
+   */
+  void setQuietPredicate(Delegate<bool()> pred);
+
   // Working Methods
   void initFullScan(bool enable);
   /** @brief Triggers a deep scan for all currently observed (but unknown)
@@ -71,6 +78,11 @@ class DeviceScanner {
   void onScanResult(uint8_t address, bool success);
   void resetPeakMetrics();
 
+  // Quarantine state for inventory snapshots; restoring it starts a new
+  // 30 minute epoch so that it is not cleared right away
+  std::bitset<256> getQuarantined() const;
+  void restoreQuarantined(const std::bitset<256>& quarantined);
+
   // Status/Telemetry
   bool isFullScan() const;
   bool isScanning() const;
@@ -86,6 +98,10 @@ class DeviceScanner {
   // Predicate to check if the system is busy, used for throttling background
   // scans.
   Delegate<bool()> is_busy_;
+  // Predicate admitting scan commands into quiet bus windows
+  Delegate<bool()> is_quiet_;
+  // The next scan command, held back until is_quiet_ admits it
+  Sequence held_command_;
 
   // Bitset to track addresses that need a "deep scan" (07 04 + vendor
   // specific).
@@ -143,6 +159,7 @@ class DeviceScanner {
   Clock::time_point last_scan_attempt_ = Clock::time_point::min();
 
   bool scanAddressInternal(uint8_t address);
+  Sequence selectCommand(platform::UniqueLock<platform::Mutex>& lock);
 };
 
 }  // namespace ebus::detail
\ No newline at end of file
@@ -5,19 +5,29 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <ebus/detail/protocol_limits.hpp>
 
 namespace ebus::detail::enhanced {
 
 /**
  * ebusd Enhanced Protocol (binary) constants and logic.
+ *
+ * Extension (not part of ebusd): a client may submit a whole master telegram
+ * (ZZ PB SB NN data, without QQ and CRC) as submit(length) followed by one
+ * submit(byte) per byte. The gateway arbitrates with its own address, streams
+ * the telegram through the Handler and answers with one frame:
+ * submitted(status), submitted(length) and one submitted(byte) per byte of
+ * the slave response (NN data), or of the ProtocolError if it failed.
  */
 
 enum class Command : uint8_t {
   init = 0x00,
   send = 0x01,
   start = 0x02,
-  info = 0x03
+  info = 0x03,
+  submit = 0x08  // Extension: whole telegram
 };
 
 enum class Response : uint8_t {
@@ -27,7 +37,14 @@ enum class Response : uint8_t {
   info = 0x03,
   failed = 0x0a,
   error_ebus = 0x0b,
-  error_host = 0x0c
+  error_host = 0x0c,
+  submitted = 0x08  // Extension: result of a submitted telegram
+};
+
+enum class SubmitStatus : uint8_t {
+  ok = 0x00,        // Payload: slave response, empty for broadcasts
+  rejected = 0x01,  // Invalid length, no free queue slot or stopped
+  failed = 0x02     // Payload: ProtocolError of the final attempt
 };
 
 enum class Error : uint8_t { framing = 0x00, overrun = 0x01 };
@@ -46,6 +63,33 @@ struct Protocol {
     out[1] = 0x80 | (val & 0x3f);             // Second byte: 10dd dddd
   }
 
+  // Bus bytes are forwarded as "received"; data bytes (< 0x80) unescaped.
+  static inline size_t encodeReceived(uint8_t val, uint8_t out[2]) {
+    if (val < EnhancedProtocolLimits::data_threshold) {
+      out[0] = val;
+      return 1;
+    }
+    encode(Response::received, val, out);
+    return 2;
+  }
+
+  /**
+   * @brief Encodes the result frame of a submitted telegram.
+   * @param out At least EnhancedProtocolLimits::max_submit_result_len bytes.
+   * @return Bytes written.
+   */
+  static inline size_t encodeSubmitResult(SubmitStatus status,
+                                          const uint8_t* payload, size_t len,
+                                          uint8_t* out) {
+    if (len > EnhancedProtocolLimits::max_submit_len)
+      len = EnhancedProtocolLimits::max_submit_len;
+    encode(Response::submitted, static_cast<uint8_t>(status), out);
+    encode(Response::submitted, static_cast<uint8_t>(len), out + 2);
+    for (size_t i = 0; i < len; ++i)
+      encode(Response::submitted, payload[i], out + 4 + 2 * i);
+    return 4 + 2 * len;
+  }
+
   template <typename T>
   static inline void decode(const uint8_t buf[2], T& cmd, uint8_t& val) {
     cmd = static_cast<T>((buf[0] >> 2) & 0x0f);      // Command in first byte
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ebus/address.hpp>
+#include <ebus/detail/protocol_limits.hpp>
+#include <ebus/types.hpp>
+
+namespace ebus::detail::filtered {
+
+/**
+ * Filtered subscription protocol (binary). Both directions use frames of a
+ * length byte followed by that many bytes.
+ *
+ * Client commands: [len][command][payload]
+ *   clear: no payload, removes all rules
+ *   add:   source, source mask, target, target mask, PB, PB mask, SB, SB mask
+ *
+ * Server frames: [len][kind][payload]
+ *   telegram: telegram type, master length, master (QQ ZZ PB SB NN data),
+ *             slave length, slave (NN data)
+ *   ack:      command, status (0 = ok), number of rules
+ *
+ * A client without rules receives no telegrams; a rule with all masks zero
+ * matches every telegram.
+ */
+
+enum class Command : uint8_t { clear = 0x00, add = 0x01 };
+
+enum class Frame : uint8_t { telegram = 0x00, ack = 0x01 };
+
+enum class Status : uint8_t { ok = 0x00, rejected = 0x01 };
+
+// A field matches if (field & mask) == (value & mask)
+struct Rule {
+  uint8_t source = 0;
+  uint8_t source_mask = 0;
+  uint8_t target = 0;
+  uint8_t target_mask = 0;
+  uint8_t primary = 0;
+  uint8_t primary_mask = 0;
+  uint8_t secondary = 0;
+  uint8_t secondary_mask = 0;
+};
+
+/**
+ * Filter rules compiled into one lookup table per header field. Every entry
+ * holds the set of rules accepting that field value, so a telegram matches
+ * if the four sets intersect: four loads and three ANDs, independent of the
+ * number of rules.
+ */
+class Filter {
+ public:
+  using RuleSet = uint32_t;
+  static_assert(FilteredProtocolLimits::max_rules <= sizeof(RuleSet) * 8,
+                "Filter rules must fit into a RuleSet");
+
+  bool add(const Rule& rule) {
+    if (count_ == FilteredProtocolLimits::max_rules) return false;
+    const RuleSet bit = RuleSet{1} << count_++;
+    compile(source_, rule.source, rule.source_mask, bit);
+    compile(target_, rule.target, rule.target_mask, bit);
+    compile(primary_, rule.primary, rule.primary_mask, bit);
+    compile(secondary_, rule.secondary, rule.secondary_mask, bit);
+    return true;
+  }
+
+  void clear() {
+    source_.fill(0);
+    target_.fill(0);
+    primary_.fill(0);
+    secondary_.fill(0);
+    count_ = 0;
+  }
+
+  // master starts with QQ ZZ PB SB
+  bool matches(ByteView master) const {
+    if (master.size() < 4) return false;
+    return (source_[master[0]] & target_[master[1]] & primary_[master[2]] &
+            secondary_[master[3]]) != 0;
+  }
+
+  size_t size() const { return count_; }
+
+ private:
+  using Table = std::array<RuleSet, 256>;
+
+  Table source_{};
+  Table target_{};
+  Table primary_{};
+  Table secondary_{};
+  size_t count_ = 0;
+
+  static void compile(Table& table, uint8_t value, uint8_t mask, RuleSet bit) {
+    for (size_t i = 0; i < table.size(); ++i) {
+      if ((static_cast<uint8_t>(i) & mask) == (value & mask)) table[i] |= bit;
+    }
+  }
+};
+
+struct Protocol {
+  static constexpr size_t rule_len = sizeof(Rule);
+  static constexpr size_t ack_len = 5;
+
+  /**
+   * @brief Encodes a telegram frame into out (max_frame_len bytes).
+   * @return The frame length, 0 if a sequence does not fit.
+   */
+  static inline size_t encodeTelegram(TelegramType type, ByteView master,
+                                      ByteView slave, uint8_t* out) {
+    if (master.size() > SequenceLimits::model_capacity ||
+        slave.size() > SequenceLimits::model_capacity)
+      return 0;
+    size_t len = 1;
+    out[len++] = static_cast<uint8_t>(Frame::telegram);
+    out[len++] = static_cast<uint8_t>(type);
+    out[len++] = static_cast<uint8_t>(master.size());
+    for (uint8_t byte : master) out[len++] = byte;
+    out[len++] = static_cast<uint8_t>(slave.size());
+    for (uint8_t byte : slave) out[len++] = byte;
+    out[0] = static_cast<uint8_t>(len - 1);
+    return len;
+  }
+
+  static inline void encodeAck(Command cmd, Status status, size_t rules,
+                               uint8_t out[ack_len]) {
+    out[0] = ack_len - 1;
+    out[1] = static_cast<uint8_t>(Frame::ack);
+    out[2] = static_cast<uint8_t>(cmd);
+    out[3] = static_cast<uint8_t>(status);
+    out[4] = static_cast<uint8_t>(rules);
+  }
+
+  static inline Rule decodeRule(const uint8_t in[rule_len]) {
+    return {in[0], in[1], in[2], in[3], in[4], in[5], in[6], in[7]};
+  }
+};
+
+}  // namespace ebus::detail::filtered
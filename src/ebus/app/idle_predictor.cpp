@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "app/idle_predictor.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <ebus/address.hpp>
+#include <limits>
+
+namespace ebus::detail {
+
+namespace {
+
+using Millis = std::chrono::milliseconds;
+
+// Master nibbles are 0, 1, 3, 7 or F; their bit count numbers them 0..4
+int masterIndex(uint8_t address) {
+  if (!ebus::isMaster(address)) return -1;
+  auto bits = [](uint8_t nibble) {
+    int n = 0;
+    for (; nibble; nibble >>= 1) n += nibble & 1;
+    return n;
+  };
+  return bits(address >> 4) * 5 + bits(address & 0x0f);
+}
+
+uint32_t toMs(Clock::duration duration) {
+  const auto ms = std::chrono::duration_cast<Millis>(duration).count();
+  return static_cast<uint32_t>(
+      std::clamp<int64_t>(ms, 0, std::numeric_limits<uint32_t>::max()));
+}
+
+// Moves a mean a quarter of the way towards a new sample
+uint32_t smooth(uint32_t mean, uint32_t sample) {
+  return static_cast<uint32_t>(static_cast<int64_t>(mean) +
+                               (static_cast<int64_t>(sample) - mean) / 4);
+}
+
+}  // namespace
+
+void IdlePredictor::setEnabled(bool enable) {
+  enabled_.store(enable, std::memory_order_relaxed);
+}
+
+void IdlePredictor::observe(uint8_t source, Clock::time_point now) {
+  const int index = masterIndex(source);
+  if (index < 0) return;
+  Source& s = sources_[index];
+
+  if (!s.seen) {
+    s.seen = true;
+    s.burst_start = now;
+    s.last_seen = now;
+    seen_sources_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  if (now < s.last_seen) return;
+  if (now - s.last_seen <= Millis(IdleLimits::burst_gap_ms)) {
+    s.last_seen = now;
+    return;
+  }
+
+  // A new burst: compare its distance to the previous one with the period
+  const bool was_periodic = isPeriodic(s);
+  const uint32_t interval = toMs(now - s.burst_start);
+  const uint32_t burst = toMs(s.last_seen - s.burst_start);
+  s.burst_start = now;
+  s.last_seen = now;
+
+  const uint32_t deviation = interval > s.period_ms ? interval - s.period_ms
+                                                    : s.period_ms - interval;
+  const uint32_t tolerance =
+      std::max(s.period_ms / 100 * IdleLimits::tolerance_percent,
+               IdleLimits::min_tolerance_ms);
+  if (s.period_ms != 0 && interval <= IdleLimits::max_period_ms &&
+      deviation <= tolerance) {
+    if (s.matches < std::numeric_limits<uint8_t>::max()) ++s.matches;
+    s.period_ms = smooth(s.period_ms, interval);
+    s.jitter_ms = smooth(s.jitter_ms, deviation);
+    s.burst_ms = smooth(s.burst_ms, burst);
+  } else {
+    // First interval, a missed burst or a new rhythm: learn it from scratch
+    s.matches = 0;
+    s.period_ms = interval <= IdleLimits::max_period_ms ? interval : 0;
+    s.jitter_ms = 0;
+    s.burst_ms = burst;
+  }
+
+  const bool periodic = isPeriodic(s);
+  if (periodic && !was_periodic)
+    periodic_sources_.fetch_add(1, std::memory_order_relaxed);
+  else if (!periodic && was_periodic)
+    periodic_sources_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+bool IdlePredictor::isQuietWindow(Clock::time_point now,
+                                  Clock::duration window) const {
+  const auto end = now + window;
+  for (const Source& s : sources_) {
+    if (!isPeriodic(s)) continue;
+
+    // A burst that is still going on
+    if (now < s.last_seen + Millis(IdleLimits::burst_gap_ms)) return false;
+
+    // The next burst or, if that one was skipped, the one after it; a master
+    // that stayed silent longer has changed its rhythm
+    const Millis period(s.period_ms);
+    const Millis burst(s.burst_ms);
+    const Millis guard(IdleLimits::guard_ms + 2 * s.jitter_ms);
+    for (auto next = s.burst_start + period;
+         next <= s.burst_start + 2 * period; next += period) {
+      if (next - guard <= end && next + burst + guard >= now) return false;
+    }
+  }
+  return true;
+}
+
+bool IdlePredictor::admit(Clock::time_point now) {
+  if (!enabled_.load(std::memory_order_relaxed) ||
+      isQuietWindow(now, Millis(IdleLimits::scan_window_ms))) {
+    deferred_since_ = Clock::time_point::min();
+    return true;
+  }
+
+  if (deferred_since_ == Clock::time_point::min()) {
+    deferred_since_ = now;
+    deferrals_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  if (now - deferred_since_ < Millis(IdleLimits::max_defer_ms)) return false;
+
+  // No quiet window in sight; do not starve background traffic
+  deferred_since_ = Clock::time_point::min();
+  forced_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void IdlePredictor::trackSession(uint32_t session_id, Clock::time_point now) {
+  quiet_session_ =
+      isQuietWindow(now, Millis(IdleLimits::scan_window_ms)) ? session_id : 0;
+}
+
+void IdlePredictor::recordArbitration(uint32_t session_id, bool won) {
+  const bool quiet = session_id != 0 && session_id == quiet_session_;
+  auto& counter = quiet ? (won ? quiet_won_ : quiet_lost_)
+                        : (won ? other_won_ : other_lost_);
+  counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+IdlePredictorStatus IdlePredictor::fetchStatus() const {
+  IdlePredictorStatus status;
+  status.enabled = enabled_.load(std::memory_order_relaxed);
+  status.sources = seen_sources_.load(std::memory_order_relaxed);
+  status.periodic_sources = periodic_sources_.load(std::memory_order_relaxed);
+  status.deferrals = deferrals_.load(std::memory_order_relaxed);
+  status.forced = forced_.load(std::memory_order_relaxed);
+  status.quiet_won = quiet_won_.load(std::memory_order_relaxed);
+  status.quiet_lost = quiet_lost_.load(std::memory_order_relaxed);
+  status.other_won = other_won_.load(std::memory_order_relaxed);
+  status.other_lost = other_lost_.load(std::memory_order_relaxed);
+
+  const uint64_t quiet_total = status.quiet_won + status.quiet_lost;
+  const uint64_t other_total = status.other_won + status.other_lost;
+  if (quiet_total > 0 && status.other_lost > 0) {
+    const float quiet_rate = static_cast<float>(status.quiet_lost) /
+                             static_cast<float>(quiet_total);
+    const float other_rate = static_cast<float>(status.other_lost) /
+                             static_cast<float>(other_total);
+    status.loss_reduction_percent = 100.0f * (1.0f - quiet_rate / other_rate);
+  }
+  return status;
+}
+
+bool IdlePredictor::isPeriodic(const Source& source) {
+  return source.matches >= IdleLimits::min_matches &&
+         source.period_ms >= IdleLimits::min_period_ms;
+}
+
+}  // namespace ebus::detail
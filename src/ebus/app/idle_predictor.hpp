@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+// Predicts quiet bus windows from the periodic traffic of other masters.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ebus/detail/protocol_limits.hpp>
+#include <ebus/status.hpp>
+#include <ebus/types.hpp>
+
+namespace ebus::detail {
+
+/**
+ * The IdlePredictor learns when the other masters on the bus talk. Room
+ * controllers and boilers poll in bursts every few seconds; for each master
+ * the predictor tracks the start of its bursts, the mean interval between
+ * them, its jitter and the burst length. Once the intervals of a master have
+ * been stable for IdleLimits::min_matches bursts in a row, its next burst is
+ * predicted and the bus is considered busy from shortly before it starts
+ * until shortly after it ends. Masters without a stable period are ignored;
+ * they are covered by the regular busy checks.
+ *
+ * Background traffic (device scans) asks admit() before it is sent and is
+ * held back until a quiet window opens, but never longer than
+ * IdleLimits::max_defer_ms. Arbitration outcomes of own telegrams are split
+ * by whether the session was scheduled into a predicted quiet window, which
+ * shows how much the prediction reduces lost arbitrations.
+ *
+ * All working methods run on the Reactor thread; fetchStatus() may be called
+ * from any thread.
+ */
+class IdlePredictor {
+ public:
+  IdlePredictor() = default;
+
+  IdlePredictor(const IdlePredictor&) = delete;
+  IdlePredictor& operator=(const IdlePredictor&) = delete;
+
+  // Configuration
+  // When disabled, admit() lets everything through; prediction and
+  // statistics keep running as a baseline
+  void setEnabled(bool enable);
+
+  // Working Methods
+  // Records a telegram sent by another master
+  void observe(uint8_t source, Clock::time_point now);
+  // True if no periodic master is expected to use the bus in
+  // [now, now + window]
+  bool isQuietWindow(Clock::time_point now, Clock::duration window) const;
+  /**
+   * @brief Gate for background traffic.
+   * @return true in a quiet window, when disabled or once the traffic has
+   * been held back for IdleLimits::max_defer_ms.
+   */
+  bool admit(Clock::time_point now);
+  // Remembers whether a just enqueued background session starts in a quiet
+  // window
+  void trackSession(uint32_t session_id, Clock::time_point now);
+  // Counts the arbitration outcome of an own session
+  void recordArbitration(uint32_t session_id, bool won);
+
+  // Status/Telemetry
+  IdlePredictorStatus fetchStatus() const;
+
+ private:
+  struct Source {
+    bool seen = false;
+    Clock::time_point burst_start;
+    Clock::time_point last_seen;
+    uint32_t period_ms = 0;  // mean interval between burst starts
+    uint32_t jitter_ms = 0;  // mean deviation from the period
+    uint32_t burst_ms = 0;   // mean burst length
+    uint8_t matches = 0;     // stable intervals in a row
+  };
+
+  // One entry per master address (25)
+  std::array<Source, 25> sources_{};
+
+  std::atomic<bool> enabled_{true};
+  Clock::time_point deferred_since_ = Clock::time_point::min();
+  uint32_t quiet_session_ = 0;
+
+  std::atomic<uint32_t> seen_sources_{0};
+  std::atomic<uint32_t> periodic_sources_{0};
+  std::atomic<uint64_t> deferrals_{0};
+  std::atomic<uint64_t> forced_{0};
+  std::atomic<uint64_t> quiet_won_{0};
+  std::atomic<uint64_t> quiet_lost_{0};
+  std::atomic<uint64_t> other_won_{0};
+  std::atomic<uint64_t> other_lost_{0};
+
+  static bool isPeriodic(const Source& source);
+};
+
+}  // namespace ebus::detail
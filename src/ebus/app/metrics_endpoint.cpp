@@ -0,0 +1,601 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "app/metrics_endpoint.hpp"
+
+#include <charconv>
+#include <cstring>
+
+#include "platform/socket.hpp"
+#include "utils/logger.hpp"
+
+namespace ebus::detail {
+
+namespace {
+
+using Label = OpenMetricsWriter::Label;
+
+constexpr std::string_view latency_family = "ebus_latency_microseconds";
+constexpr std::string_view latency_max_family = "ebus_latency_max_microseconds";
+constexpr std::string_view session_family =
+    "ebus_session_latency_microseconds";
+
+template <typename T>
+void counter(OpenMetricsWriter& writer, std::string_view name,
+             std::string_view help, T value) {
+  writer.family(name, "counter", help);
+  writer.sample(name, "_total", {}, value);
+}
+
+template <typename T>
+void gauge(OpenMetricsWriter& writer, std::string_view name,
+           std::string_view help, T value) {
+  writer.family(name, "gauge", help);
+  writer.sample(name, "", {}, value);
+}
+
+void summary(OpenMetricsWriter& writer, std::string_view name, Label first,
+             Label second, const MetricValues& values) {
+#ifndef EBUS_MINIMAL_DIAGNOSTICS
+  if (values.count > 0) {
+    writer.sample(name, "", {first, second, {"quantile", "0.5"}},
+                  values.p50_us);
+    writer.sample(name, "", {first, second, {"quantile", "0.95"}},
+                  values.p95_us);
+    writer.sample(name, "", {first, second, {"quantile", "0.99"}},
+                  values.p99_us);
+  }
+#endif
+  writer.sample(name, "_sum", {first, second}, values.sum_us);
+  writer.sample(name, "_count", {first, second}, values.count);
+}
+
+// One sample per bridge client, labelled with its fd and type
+template <typename T>
+void clientSamples(OpenMetricsWriter& writer, std::string_view name,
+                   std::string_view suffix,
+                   const std::vector<ClientInfo>& clients,
+                   T ClientInfo::*field) {
+  for (const auto& client : clients) {
+    char fd[12];
+    char* end = std::to_chars(fd, fd + sizeof(fd), client.fd).ptr;
+    writer.sample(name, suffix,
+                  {{"fd", std::string_view(fd, end - fd)},
+                   {"type", client.type}},
+                  client.*field);
+  }
+}
+
+struct Phase {
+  std::string_view name;
+  const MetricValues& values;
+};
+
+void exportCounters(OpenMetricsWriter& writer, const Metrics& metrics) {
+  const auto& h = metrics.handler;
+  const auto& r = metrics.request;
+  const auto& b = metrics.bus;
+  const auto& rc = metrics.reactor;
+
+  // Handler
+  writer.family("ebus_messages", "counter", "Completed telegrams by role");
+  writer.sample("ebus_messages", "_total", {{"role", "passive"}},
+                h.messages_passive);
+  writer.sample("ebus_messages", "_total", {{"role", "reactive"}},
+                h.messages_reactive);
+  writer.sample("ebus_messages", "_total", {{"role", "active"}},
+                h.messages_active);
+
+  writer.family("ebus_errors", "counter", "Protocol errors by role");
+  writer.sample("ebus_errors", "_total", {{"role", "passive"}},
+                h.error_passive);
+  writer.sample("ebus_errors", "_total", {{"role", "reactive"}},
+                h.error_reactive);
+  writer.sample("ebus_errors", "_total", {{"role", "active"}}, h.error_active);
+
+  writer.family("ebus_resets", "counter", "Handler buffer resets by role");
+  writer.sample("ebus_resets", "_total", {{"role", "passive"}},
+                h.resets_passive);
+  writer.sample("ebus_resets", "_total", {{"role", "active"}},
+                h.resets_active);
+
+  counter(writer, "ebus_attempts", "Scheduler retry attempts",
+          h.total_attempts);
+  counter(writer, "ebus_invalid_bytes", "Bytes not fitting the protocol",
+          h.invalid_bytes);
+
+  writer.family("ebus_sent_bytes", "counter", "Bytes sent by this node");
+  writer.sample("ebus_sent_bytes", "_total", {{"kind", "data"}},
+                h.total_sent_data_bytes);
+  writer.sample("ebus_sent_bytes", "_total", {{"kind", "protocol"}},
+                h.total_sent_protocol_bytes);
+
+  writer.family("ebus_observed_bytes", "counter", "Bytes observed on the bus");
+  writer.sample("ebus_observed_bytes", "_total", {{"kind", "data"}},
+                h.total_observed_data_bytes);
+  writer.sample("ebus_observed_bytes", "_total", {{"kind", "protocol"}},
+                h.total_observed_protocol_bytes);
+
+  // Request
+  writer.family("ebus_arbitration", "counter", "Bus arbitration outcomes");
+  writer.sample("ebus_arbitration", "_total", {{"result", "won"}},
+                r.won_total);
+  writer.sample("ebus_arbitration", "_total", {{"result", "lost"}},
+                r.lost_total);
+  writer.sample("ebus_arbitration", "_total", {{"result", "collision"}},
+                r.collisions);
+  writer.sample("ebus_arbitration", "_total", {{"result", "error"}},
+                r.arbitration_errors);
+  writer.sample("ebus_arbitration", "_total", {{"result", "first_syn"}},
+                r.first_syn);
+
+  counter(writer, "ebus_bus_request_blocked", "Bus requests refused",
+          r.bus_request_blocked);
+  counter(writer, "ebus_lock_counter_resets", "Lock counter resets",
+          r.lock_counter_reset);
+  counter(writer, "ebus_session_timeouts", "Bridge session timeouts",
+          r.session_timeouts);
+
+  // Bus
+  counter(writer, "ebus_start_bit_errors", "Spurious start bits",
+          b.start_bit_errors.load(std::memory_order_relaxed));
+  counter(writer, "ebus_syn_postponed", "Postponed SYN symbols",
+          b.syn_postponed_count.load(std::memory_order_relaxed));
+  gauge(writer, "ebus_bus_utilization_percent", "Bus utilization",
+        b.utilization);
+  gauge(writer, "ebus_bus_congestion", "Sustained high utilization",
+        b.congestion);
+  gauge(writer, "ebus_bus_high_jitter", "SYN jitter above threshold",
+        b.high_jitter);
+  writer.family("ebus_uptime_seconds", "gauge", "Time since metrics reset",
+                "seconds");
+  writer.sample("ebus_uptime_seconds", "", {}, b.uptime_us / 1000000);
+
+  // Devices
+  writer.family("ebus_devices", "gauge", "Observed bus participants");
+  writer.sample("ebus_devices", "", {{"state", "identified"}},
+                metrics.devices.identified_devices);
+  writer.sample("ebus_devices", "", {{"state", "unknown"}},
+                metrics.devices.unknown_devices);
+
+  // Reactor
+  writer.family("ebus_reactor_dropped", "counter", "Dropped reactor events");
+  writer.sample("ebus_reactor_dropped", "_total", {{"queue", "signal"}},
+                rc.signal_queue_dropped);
+  writer.sample("ebus_reactor_dropped", "_total", {{"queue", "protocol"}},
+                rc.protocol_queue_dropped);
+  writer.sample("ebus_reactor_dropped", "_total", {{"queue", "bus"}},
+                rc.bus_queue_dropped);
+  writer.family("ebus_reactor_loop_max_microseconds", "gauge",
+                "Longest reactor loop cycle in the current interval",
+                "microseconds");
+  writer.sample("ebus_reactor_loop_max_microseconds", "", {},
+                rc.max_loop_cycle_us);
+}
+
+void exportPhases(OpenMetricsWriter& writer, const Metrics& metrics) {
+  const auto& h = metrics.handler;
+  const auto& b = metrics.bus;
+  const Phase phases[] = {{"sync", h.sync},
+                          {"write", h.write},
+                          {"passive_first", h.passive_first},
+                          {"passive_data", h.passive_data},
+                          {"active_first", h.active_first},
+                          {"active_data", h.active_data},
+                          {"delay", b.delay},
+                          {"window", b.window},
+                          {"transmit", b.transmit},
+                          {"syn_postpone", b.syn_postpone}};
+
+  writer.family(latency_family, "summary", "Protocol phase timings",
+                "microseconds");
+  for (const auto& phase : phases)
+    summary(writer, latency_family, {"phase", phase.name}, {}, phase.values);
+
+  writer.family(latency_max_family, "gauge", "Peak protocol phase timings",
+                "microseconds");
+  for (const auto& phase : phases)
+    writer.sample(latency_max_family, "", {{"phase", phase.name}},
+                  phase.values.max_us);
+}
+
+// Session breakdown of one priority band
+void exportSessionClass(OpenMetricsWriter& writer, const Metrics& metrics,
+                        size_t index) {
+#if EBUS_SESSION_STATS
+  if (index == 0)
+    writer.family(session_family, "summary",
+                  "End-to-end latency of scheduled sessions", "microseconds");
+  const auto& cls = metrics.sessions.classes[index];
+  char band[8];
+  char* end = std::to_chars(band, band + sizeof(band), cls.priority_min).ptr;
+  *end++ = '-';
+  end = std::to_chars(end, band + sizeof(band), cls.priority_max).ptr;
+  const Label priority{"priority", std::string_view(band, end - band)};
+
+  summary(writer, session_family, priority, {"segment", "queue_wait"},
+          cls.queue_wait);
+  summary(writer, session_family, priority, {"segment", "bus_wait"},
+          cls.bus_wait);
+  summary(writer, session_family, priority, {"segment", "transfer"},
+          cls.transfer);
+  summary(writer, session_family, priority, {"segment", "dispatch"},
+          cls.dispatch);
+  summary(writer, session_family, priority, {"segment", "total"}, cls.total);
+#else
+  (void)writer;
+  (void)metrics;
+  (void)index;
+#endif
+}
+
+void exportStatusFigures(OpenMetricsWriter& writer,
+                         const ServiceStatus& status) {
+  const QueueStatus* queues[] = {
+      &status.reactor.signal_queue, &status.reactor.protocol_queue,
+      &status.reactor.bus_queue, &status.scheduler.queue};
+
+  writer.family("ebus_queue_size", "gauge", "Current queue fill level");
+  for (const auto* q : queues)
+    if (!q->name.empty())
+      writer.sample("ebus_queue_size", "", {{"queue", q->name}}, q->size);
+
+  writer.family("ebus_queue_max_size", "gauge", "Peak queue fill level");
+  for (const auto* q : queues)
+    if (!q->name.empty())
+      writer.sample("ebus_queue_max_size", "", {{"queue", q->name}},
+                    q->max_size);
+
+  writer.family("ebus_queue_capacity", "gauge", "Queue capacity");
+  for (const auto* q : queues)
+    if (!q->name.empty())
+      writer.sample("ebus_queue_capacity", "", {{"queue", q->name}},
+                    q->capacity);
+
+  const ThreadStatus* threads[] = {
+      &status.reactor.thread, &status.bus.bus_thread, &status.bus.syn_thread,
+      &status.client_manager.thread};
+
+  writer.family("ebus_thread_stack_free_bytes", "gauge",
+                "Unused stack of service threads", "bytes");
+  for (const auto* t : threads)
+    if (!t->name.empty() && t->stack_free != -1)
+      writer.sample("ebus_thread_stack_free_bytes", "", {{"thread", t->name}},
+                    t->stack_free);
+
+  gauge(writer, "ebus_poll_items", "Registered poll items",
+        status.poll_manager.item_count);
+  gauge(writer, "ebus_clients", "Connected bridge clients",
+        status.client_manager.clients.size());
+  gauge(writer, "ebus_client_capacity", "Bridge client slots over all types",
+        status.client_manager.client_capacity);
+  counter(writer, "ebus_client_rejected",
+          "Bridge connections refused for lack of a slot",
+          status.client_manager.rejected_clients);
+  gauge(writer, "ebus_bridge_session_active", "Bridge session in progress",
+        status.client_manager.session_active);
+  counter(writer, "ebus_local_sessions",
+          "Scheduler attempts granted the bus by the session arbiter",
+          status.client_manager.local_sessions);
+}
+
+void exportClientLatency(OpenMetricsWriter& writer,
+                         const ServiceStatus& status) {
+
+  constexpr std::string_view io_family = "ebus_client_io_microseconds";
+  writer.family(io_family, "summary",
+                "Client I/O loop cost per wakeup and accept latency",
+                "microseconds");
+  summary(writer, io_family, {"phase", "iteration"}, {},
+          status.client_manager.io_iteration);
+  summary(writer, io_family, {"phase", "accept"}, {},
+          status.client_manager.accept_latency);
+
+  constexpr std::string_view bridge_family = "ebus_bridge_latency_microseconds";
+  const BridgeLatencyValues& bridge = status.client_manager.bridge_latency;
+  writer.family(bridge_family, "summary",
+                "Bridge client byte from socket receive to echo sent",
+                "microseconds");
+  summary(writer, bridge_family, {"stage", "receive_to_write"}, {},
+          bridge.receive_to_write);
+  summary(writer, bridge_family, {"stage", "write_to_echo"}, {},
+          bridge.write_to_echo);
+  summary(writer, bridge_family, {"stage", "echo_to_send"}, {},
+          bridge.echo_to_send);
+  summary(writer, bridge_family, {"stage", "total"}, {}, bridge.total);
+}
+
+void exportClientFamily(OpenMetricsWriter& writer,
+                        const std::vector<ClientInfo>& clients, size_t index) {
+  switch (index) {
+    case 0:
+      writer.family("ebus_client_outbound_bytes", "gauge",
+                    "Pending outbound bytes per bridge client", "bytes");
+      clientSamples(writer, "ebus_client_outbound_bytes", "", clients,
+                    &ClientInfo::outbound_buffer_usage);
+      break;
+    case 1:
+      writer.family("ebus_client_dropped_bytes", "counter",
+                    "Bus bytes a lagging bridge client skipped", "bytes");
+      clientSamples(writer, "ebus_client_dropped_bytes", "_total", clients,
+                    &ClientInfo::dropped_bytes);
+      break;
+    case 2:
+      writer.family("ebus_client_lag_bytes", "gauge",
+                    "Bus bytes a bridge client has not been sent yet",
+                    "bytes");
+      clientSamples(writer, "ebus_client_lag_bytes", "", clients,
+                    &ClientInfo::lag_bytes);
+      break;
+    case 3:
+      writer.family("ebus_client_overflows", "counter",
+                    "Times a bridge client fell too far behind the bus");
+      clientSamples(writer, "ebus_client_overflows", "_total", clients,
+                    &ClientInfo::overflows);
+      break;
+    case 4:
+      writer.family("ebus_client_send_calls", "counter",
+                    "Socket writes per bridge client");
+      clientSamples(writer, "ebus_client_send_calls", "_total", clients,
+                    &ClientInfo::send_calls);
+      break;
+    case 5:
+      writer.family("ebus_client_sent_bytes", "counter",
+                    "Bytes written to a bridge client", "bytes");
+      clientSamples(writer, "ebus_client_sent_bytes", "_total", clients,
+                    &ClientInfo::bytes_sent);
+      break;
+    case 6:
+      writer.family("ebus_client_sessions", "counter",
+                    "Bridge sessions granted to a client");
+      clientSamples(writer, "ebus_client_sessions", "_total", clients,
+                    &ClientInfo::sessions);
+      break;
+  }
+}
+
+}  // namespace
+
+void exportOpenMetrics(OpenMetricsWriter& writer, const Metrics& metrics) {
+  for (size_t part = 0; part < metrics_parts; ++part)
+    exportOpenMetrics(writer, metrics, part);
+}
+
+void exportOpenMetrics(OpenMetricsWriter& writer, const Metrics& metrics,
+                       size_t part) {
+  if (part == 0)
+    exportCounters(writer, metrics);
+  else if (part == 1)
+    exportPhases(writer, metrics);
+  else if (part < metrics_parts)
+    exportSessionClass(writer, metrics, part - 2);
+}
+
+void exportOpenMetrics(OpenMetricsWriter& writer, const ServiceStatus& status) {
+  for (size_t part = 0; part < status_parts; ++part)
+    exportOpenMetrics(writer, status, part);
+}
+
+void exportOpenMetrics(OpenMetricsWriter& writer, const ServiceStatus& status,
+                       size_t part) {
+  if (part == 0)
+    exportStatusFigures(writer, status);
+  else if (part == 1)
+    exportClientLatency(writer, status);
+  else if (part < status_parts)
+    exportClientFamily(writer, status.client_manager.clients, part - 2);
+}
+
+// --- MetricsEndpoint ---
+
+MetricsEndpoint::~MetricsEndpoint() { stop(); }
+
+bool MetricsEndpoint::start(uint16_t port) {
+  listen_socket_ = std::make_unique<platform::Socket>(
+      platform::Socket::createListenSocket(port));
+  if (!listen_socket_->isValid()) {
+    EBUS_LOG_ERROR_F(
+        "[MetricsEndpoint] ERROR: Failed to listen for scrapes on port %u",
+        port);
+    listen_socket_.reset();
+    return false;
+  }
+  if (poller_) {
+    const int fd = listen_socket_->getFd();
+    poller_->add(fd, tag_ | static_cast<uint32_t>(fd), platform::IoPoller::in);
+  }
+  EBUS_LOG_INFO_F("[MetricsEndpoint] Serving /metrics on port %u", port);
+  return true;
+}
+
+void MetricsEndpoint::stop() {
+  for (auto& connection : connections_) close(connection);
+  if (listen_socket_ && poller_) {
+    const int fd = listen_socket_->getFd();
+    poller_->remove(fd, tag_ | static_cast<uint32_t>(fd));
+  }
+  listen_socket_.reset();
+}
+
+void MetricsEndpoint::setExporter(Exporter exporter) {
+  exporter_ = std::move(exporter);
+}
+
+void MetricsEndpoint::attach(platform::IoPoller* poller, uint64_t tag) {
+  poller_ = poller;
+  tag_ = tag;
+}
+
+bool MetricsEndpoint::addConnection(int fd) {
+  for (auto& connection : connections_) {
+    if (connection.socket) continue;
+    platform::setNonBlocking(fd);
+    connection.socket = std::make_unique<platform::Socket>(fd);
+    connection.accepted = Clock::now();
+    connection.length = 0;
+    if (poller_)
+      poller_->add(fd, tag_ | static_cast<uint32_t>(fd),
+                   platform::IoPoller::in);
+    return true;
+  }
+  return false;
+}
+
+void MetricsEndpoint::handle(int fd) {
+  if (listen_socket_ && listen_socket_->getFd() == fd) {
+    acceptConnection();
+    return;
+  }
+
+  for (auto& connection : connections_) {
+    if (connection.socket && connection.socket->getFd() == fd) {
+      if (connection.responding)
+        flush(connection);
+      else
+        readRequest(connection);
+      return;
+    }
+  }
+}
+
+void MetricsEndpoint::checkTimeouts() {
+  const auto timeout =
+      std::chrono::milliseconds(NetworkLimits::metrics_request_timeout_ms);
+  const auto now = Clock::now();
+  for (auto& connection : connections_) {
+    if (!connection.socket) continue;
+    if (connection.responding ? now > connection.send_deadline
+                              : now - connection.accepted > timeout) {
+      if (connection.responding)
+        EBUS_LOG_ERROR_F("[MetricsEndpoint] Scrape fd=%d timed out",
+                         connection.socket->getFd());
+      close(connection);
+    }
+  }
+}
+
+bool MetricsEndpoint::isListening() const { return listen_socket_ != nullptr; }
+
+size_t MetricsEndpoint::connectionCount() const {
+  size_t count = 0;
+  for (const auto& connection : connections_)
+    if (connection.socket) count++;
+  return count;
+}
+
+void MetricsEndpoint::acceptConnection() {
+  int fd = listen_socket_->accept();
+  if (fd < 0) return;
+  if (!addConnection(fd)) {
+    EBUS_LOG_ERROR_F("[MetricsEndpoint] No free slot for scrape fd=%d", fd);
+    platform::close(fd);
+  }
+}
+
+void MetricsEndpoint::readRequest(Connection& connection) {
+  const int fd = connection.socket->getFd();
+  const size_t space = sizeof(connection.request) - connection.length;
+  ssize_t n = platform::recv(fd, connection.request + connection.length, space,
+                             platform::Flags::dont_wait);
+  if (n == 0 || (n < 0 && !platform::isWouldBlock() &&
+                 !platform::isInterrupted())) {
+    close(connection);
+    return;
+  }
+  if (n < 0) return;
+  connection.length += static_cast<size_t>(n);
+
+  // Only the request line matters; wait for the end of the header block
+  std::string_view request(connection.request, connection.length);
+  if (request.find("\r\n\r\n") == std::string_view::npos &&
+      connection.length < sizeof(connection.request))
+    return;
+
+  respond(connection, request.substr(0, request.find("\r\n")));
+  connection.responding = true;
+  connection.send_deadline =
+      Clock::now() +
+      std::chrono::milliseconds(NetworkLimits::metrics_send_timeout_ms);
+  flush(connection);
+}
+
+void MetricsEndpoint::respond(Connection& connection,
+                              std::string_view request_line) {
+  const bool is_get = request_line.substr(0, 4) == "GET ";
+  std::string_view target = is_get ? request_line.substr(4) : "";
+  target = target.substr(0, target.find(' '));
+  target = target.substr(0, target.find('?'));
+
+  if (!is_get) {
+    connection.output =
+        "HTTP/1.1 405 Method Not Allowed\r\nAllow: GET\r\nContent-Length: "
+        "0\r\nConnection: close\r\n\r\n";
+    return;
+  }
+  if (target != "/metrics" || !exporter_) {
+    connection.output =
+        "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: "
+        "close\r\n\r\n";
+    return;
+  }
+
+  connection.output =
+      "HTTP/1.1 200 OK\r\nContent-Type: application/openmetrics-text; "
+      "version=1.0.0; charset=utf-8\r\nConnection: close\r\n\r\n";
+  connection.exporting = true;
+  connection.next_part = 0;
+}
+
+void MetricsEndpoint::flush(Connection& connection) {
+  const int fd = connection.socket->getFd();
+  auto append = [&connection](std::string_view data) {
+    connection.output.append(data.data(), data.size());
+  };
+
+  for (;;) {
+    while (connection.sent < connection.output.size()) {
+      ssize_t n =
+          platform::send(fd, connection.output.data() + connection.sent,
+                         connection.output.size() - connection.sent,
+                         platform::Flags::dont_wait);
+      if (n > 0) {
+        connection.sent += static_cast<size_t>(n);
+        continue;
+      }
+      if (n < 0 && platform::isInterrupted()) continue;
+      if (n < 0 && platform::isWouldBlock()) {
+        // The rest goes out from handle() once the socket is writable again
+        if (poller_)
+          poller_->modify(fd, tag_ | static_cast<uint32_t>(fd),
+                          platform::IoPoller::out);
+        return;
+      }
+      close(connection);
+      return;
+    }
+    if (!connection.exporting) break;
+
+    // The next part reuses the buffer of the one just sent
+    connection.output.clear();
+    connection.sent = 0;
+    connection.exporting = exporter_(connection.next_part++, append);
+  }
+  close(connection);
+}
+
+void MetricsEndpoint::close(Connection& connection) {
+  if (connection.socket && poller_) {
+    const int fd = connection.socket->getFd();
+    poller_->remove(fd, tag_ | static_cast<uint32_t>(fd));
+  }
+  connection.socket.reset();
+  connection.length = 0;
+  connection.output = std::string();
+  connection.sent = 0;
+  connection.responding = false;
+  connection.exporting = false;
+}
+
+}  // namespace ebus::detail
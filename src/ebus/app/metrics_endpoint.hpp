@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <ebus/detail/delegate.hpp>
+#include <ebus/detail/protocol_limits.hpp>
+#include <ebus/metrics.hpp>
+#include <ebus/status.hpp>
+#include <ebus/types.hpp>
+
+#include "platform/io_poller.hpp"
+#include "platform/socket.hpp"
+#include "utils/openmetrics_writer.hpp"
+
+namespace ebus::detail {
+
+/**
+ * A scrape is rendered in parts of a few families each, so that a connection
+ * only ever buffers one of them. The system metrics consist of the counters
+ * and gauges, the phase timings and one part per session priority class
+ * (none without EBUS_SESSION_STATS); the service status of the queue, thread
+ * and loop figures, the client I/O summaries and one part per client family.
+ */
+inline constexpr size_t metrics_parts = 2 + SessionLimits::stats_classes;
+inline constexpr size_t status_parts = 2 + 7;
+
+/**
+ * Writes the system metrics (counters, gauges and latency summaries) as
+ * OpenMetrics families, all of them or a single part.
+ */
+void exportOpenMetrics(OpenMetricsWriter& writer, const Metrics& metrics);
+void exportOpenMetrics(OpenMetricsWriter& writer, const Metrics& metrics,
+                       size_t part);
+
+/**
+ * Writes queue, thread and client statistics of a service status snapshot as
+ * OpenMetrics families, all of them or a single part.
+ */
+void exportOpenMetrics(OpenMetricsWriter& writer, const ServiceStatus& status);
+void exportOpenMetrics(OpenMetricsWriter& writer, const ServiceStatus& status,
+                       size_t part);
+
+/**
+ * Minimal HTTP listener serving "GET /metrics" in OpenMetrics text format. It
+ * is driven by the ClientManager I/O loop: the endpoint registers its file
+ * descriptors with the loop's poller and handles the ones that became ready.
+ * The exporter renders the scrape part by part into a per-connection buffer;
+ * a part is sent as far as the socket accepts it (Connection: close) and the
+ * next one is only rendered once the previous one is out, whenever the
+ * poller reports the socket writable. The loop never waits on a scraper: a
+ * response not sent within NetworkLimits::metrics_send_timeout_ms is dropped
+ * by checkTimeouts().
+ */
+class MetricsEndpoint {
+ public:
+  // Public Types & Constants
+  // Renders part 0, 1, ... of a scrape; returns false once it has written
+  // the last one
+  using Exporter =
+      Delegate<bool(size_t part, const JsonChunkVisitor& visitor)>;
+
+  // Lifecycle
+  MetricsEndpoint() = default;
+  ~MetricsEndpoint();
+  bool start(uint16_t port);
+  void stop();
+
+  // Special Members & Operators
+  MetricsEndpoint(const MetricsEndpoint&) = delete;
+  MetricsEndpoint& operator=(const MetricsEndpoint&) = delete;
+
+  // Configuration
+  void setExporter(Exporter exporter);
+
+  /**
+   * @brief Registers the listener and all connections with poller (level
+   * triggered, token = tag | fd). Must be called before start().
+   */
+  void attach(platform::IoPoller* poller, uint64_t tag);
+
+  // Working Methods
+  /**
+   * @brief Registers an already accepted connection (tests, embedded use).
+   */
+  bool addConnection(int fd);
+
+  /**
+   * @brief Handles readiness of the listener or a connection: reads the
+   * request or sends more of a pending response.
+   */
+  void handle(int fd);
+  void checkTimeouts();
+
+  // Status/Telemetry
+  bool isListening() const;
+  size_t connectionCount() const;
+
+ private:
+  struct Connection {
+    std::unique_ptr<platform::Socket> socket;
+    Clock::time_point accepted;
+    size_t length = 0;
+    char request[NetworkLimits::metrics_request_size];
+
+    // Part of the response not yet accepted by the socket
+    std::string output;
+    size_t sent = 0;
+    bool responding = false;
+    bool exporting = false;  // more parts to render
+    size_t next_part = 0;
+    Clock::time_point send_deadline;
+  };
+
+  std::unique_ptr<platform::Socket> listen_socket_;
+  std::array<Connection, NetworkLimits::metrics_max_connections> connections_;
+  Exporter exporter_ = nullptr;
+  platform::IoPoller* poller_ = nullptr;
+  uint64_t tag_ = 0;
+
+  void acceptConnection();
+  void readRequest(Connection& connection);
+  void respond(Connection& connection, std::string_view request_line);
+  void flush(Connection& connection);
+  void close(Connection& connection);
+};
+
+}  // namespace ebus::detail
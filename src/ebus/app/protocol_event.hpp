@@ -9,6 +9,7 @@
 
 #include "ebus/callbacks.hpp"
 #include "ebus/detail/protocol_limits.hpp"
+#include "ebus/types.hpp"
 
 namespace ebus::detail {
 
@@ -22,6 +23,9 @@ struct ProtocolEvent {
 
   // Common metadata
   LogLevel level;
+  // Clock (us, low 32 bits) when the bus thread completed the event; see
+  // completedAt()
+  uint32_t completed_us = 0;
   uint64_t timestamp = 0;  // ms since epoch
 
   uint32_t session_id;
@@ -34,6 +38,7 @@ struct ProtocolEvent {
   // Telegram-specific fields
   MessageType message_type = MessageType::undefined;
   TelegramType telegram_type = TelegramType::undefined;
+  TelegramTimings telegram_timings;
 
   // Error-specific fields
   ProtocolError protocol_error = ProtocolError::none;
@@ -45,6 +50,17 @@ struct ProtocolEvent {
   // (slave).
   StaticSequence<detail::SequenceLimits::model_capacity> master;
   StaticSequence<detail::SequenceLimits::model_capacity> slave;
+
+  void stampCompletion(Clock::time_point now) {
+    completed_us = static_cast<uint32_t>(now.time_since_epoch().count());
+  }
+
+  // Completion time on the Clock; exact for events younger than ~71 minutes
+  Clock::time_point completedAt(Clock::time_point now) const {
+    const uint32_t age =
+        static_cast<uint32_t>(now.time_since_epoch().count()) - completed_us;
+    return now - Clock::duration(age);
+  }
 };
 
 static_assert(std::is_trivially_copyable_v<ProtocolEvent>,
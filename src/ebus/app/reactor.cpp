@@ -11,6 +11,7 @@
 #include <cstdint>
 #include <ebus/utils.hpp>
 
+#include "app/bus_capture.hpp"
 #include "app/device_manager.hpp"
 #include "app/device_scanner.hpp"
 #include "app/poll_manager.hpp"
@@ -19,6 +20,7 @@
 #include "core/bus_monitor.hpp"
 #include "platform/service_thread.hpp"
 #include "utils/logger.hpp"
+#include "utils/tracer.hpp"
 
 namespace ebus::detail {
 
@@ -83,6 +85,44 @@ void Reactor::setLogLevel(LogLevel level) {
   detail::Logger::getInstance().setLevel(level);
 }
 
+void Reactor::setTelegramSink(Delegate<void(const ProtocolEvent&)> sink) {
+  telegram_sink_ = sink;
+}
+
+void Reactor::setSessionResultSink(
+    Delegate<void(const ProtocolEvent&)> sink) {
+  session_result_sink_ = sink;
+}
+
+void Reactor::setMessageDatabase(
+    std::shared_ptr<const MessageDatabase> database) {
+  std::atomic_store(&message_database_, std::move(database));
+}
+
+void Reactor::setValueCallback(ValueCallback callback) {
+  user_value_callback_ = callback;
+}
+
+void Reactor::setSubscriptionManager(SubscriptionManager* subscriptions) {
+  subscriptions_ = subscriptions;
+}
+
+void Reactor::setTrafficAnalyzer(TrafficAnalyzer* traffic) {
+  traffic_ = traffic;
+}
+
+void Reactor::setIdlePredictor(IdlePredictor* predictor) {
+  idle_predictor_ = predictor;
+}
+
+void Reactor::setMaintenanceTask(Delegate<void()> task) {
+  maintenance_task_ = task;
+}
+
+void Reactor::setBusCapture(BusCapture* capture) {
+  bus_capture_.store(capture, std::memory_order_release);
+}
+
 bool Reactor::pushSignal(ReactorSignal&& signal) {
   if (!signal_queue_.tryPush(std::move(signal))) {
     if (signal_queue_.discard() > 0) {
@@ -140,6 +180,8 @@ void Reactor::onBusEventInfo(const BusEventInfo& info) {
   ebus::updateMaxAtomic(max_bus_queue_, bus_queue_.size());
 
   trace_buffer_.push_back(info);
+  if (BusCapture* capture = bus_capture_.load(std::memory_order_acquire))
+    capture->record(info);
 
   ReactorSignal sig;
   sig.type = ReactorSignal::Type::bus_byte;
@@ -181,6 +223,8 @@ ebus::ReactorStatus Reactor::fetchStatus() const {
       status.max_loop_cycle_us = m.reactor.max_loop_cycle_us;
     });
   }
+  status.decoded_telegrams = decoded_telegrams_.load();
+  status.undecoded_telegrams = undecoded_telegrams_.load();
 
   return status;
 }
@@ -248,9 +292,14 @@ void Reactor::run() {
     // 4. Process due scan commands if scheduler has capacity
     if (scheduler_->size() < SchedulerLimits::scan_threshold) {
       auto scan_cmd = device_scanner_->nextCommand();
-      if (!scan_cmd.empty() &&
-          scheduler_->enqueue(DeviceLimits::scan_priority, scan_cmd)) {
-        activity = true;
+      if (!scan_cmd.empty()) {
+        const uint32_t s_id =
+            scheduler_->enqueue(DeviceLimits::scan_priority, scan_cmd);
+        if (s_id > 0) {
+          if (idle_predictor_)
+            idle_predictor_->trackSession(s_id, Clock::now());
+          activity = true;
+        }
       }
     }
 
@@ -323,6 +372,10 @@ void Reactor::run() {
              ReactorLimits::status_update_interval_ms_slow))) {
       bus_monitor_->updateUtilizationHistory();
 
+      // Publish before the interval peaks are reset
+      bus_monitor_->publishSnapshot();
+      if (traffic_) traffic_->publish(ebus::getWallTimeMs());
+
       // Reset windowed metrics
       bus_monitor_->resetLoopCycle();
       bus_monitor_->resetMaxSignalQueueSize(signal_queue_.size());
@@ -332,6 +385,8 @@ void Reactor::run() {
       device_scanner_->resetPeakMetrics();
       poll_manager_->resetPeakMetrics();
 
+      if (maintenance_task_) maintenance_task_();
+
       last_status_update = Clock::now();
     }
   }
@@ -389,16 +444,58 @@ void Reactor::processUserRequest() {
 }
 
 void Reactor::processPublicEvents() {
+  EBUS_TRACE_SCOPE("reactor.public_events");
   ProtocolCallback user_callback = user_protocol_callback_;
+  ValueCallback value_callback = user_value_callback_;
+  const auto database = std::atomic_load(&message_database_);
 
   ProtocolEvent ev;
   while (protocol_queue_.tryPop(ev)) {
-    scheduler_->injectProtocolEvent(ev);
+    SessionTimings timings;
+    const bool completed = scheduler_->injectProtocolEvent(ev, &timings) &&
+                           timings.enqueued_us != 0;
+    if (completed) {
+      timings.delivered_us = SessionTimings::toMicros(Clock::now());
+      bus_monitor_->recordSession(timings);
+      if (session_result_sink_) session_result_sink_(ev);
+    }
+
+    if (idle_predictor_) {
+      if (ev.type == ProtocolEvent::Type::won ||
+          ev.type == ProtocolEvent::Type::lost)
+        idle_predictor_->recordArbitration(
+            ev.session_id, ev.type == ProtocolEvent::Type::won);
+      else if (ev.type == ProtocolEvent::Type::telegram &&
+               ev.message_type != MessageType::active && !ev.master.empty())
+        idle_predictor_->observe(ev.master[0],
+                                 ev.completedAt(Clock::now()));
+    }
 
     if (ev.type == ProtocolEvent::Type::telegram) {
       if (device_manager_)
         device_manager_->update({ev.master.data(), ev.master.size()},
-                                {ev.slave.data(), ev.slave.size()});
+                                {ev.slave.data(), ev.slave.size()},
+                                ev.telegram_timings, ev.timestamp);
+
+      if (telegram_sink_) telegram_sink_(ev);
+
+      if (traffic_)
+        traffic_->recordTelegram({ev.master.data(), ev.master.size()},
+                                 {ev.slave.data(), ev.slave.size()});
+
+      if (database) {
+        const bool decoded =
+            database->decode({ev.master.data(), ev.master.size()},
+                             {ev.slave.data(), ev.slave.size()},
+                             ev.timestamp, value_callback) != nullptr;
+        (decoded ? decoded_telegrams_ : undecoded_telegrams_)
+            .fetch_add(1, std::memory_order_relaxed);
+      }
+
+      if (subscriptions_)
+        subscriptions_->process({ev.master.data(), ev.master.size()},
+                                {ev.slave.data(), ev.slave.size()},
+                                ev.timestamp);
 
       if (device_scanner_ && ev.session_id > 0) {
         bool is_broadcast = (ev.type == ProtocolEvent::Type::telegram &&
@@ -437,6 +534,11 @@ void Reactor::processPublicEvents() {
 
       error_buffer_.push_back(std::move(entry));
 
+      if (device_manager_)
+        device_manager_->recordError({ev.master.data(), ev.master.size()},
+                                     ev.telegram_timings);
+      if (traffic_) traffic_->recordError({ev.master.data(), ev.master.size()});
+
       if (device_scanner_ && ev.session_id > 0) {
         bool is_broadcast = (ev.type == ProtocolEvent::Type::telegram &&
                              ev.telegram_type == TelegramType::broadcast);
@@ -458,6 +560,8 @@ void Reactor::processPublicEvents() {
         info.request_state = ev.request_state;
         info.master_view = {ev.master.data(), ev.master.size()};
         info.slave_view = {ev.slave.data(), ev.slave.size()};
+        info.telegram_timings = ev.telegram_timings;
+        if (completed) info.timings = &timings;
 
         if (info.is_error) {
           info.level = ev.level;
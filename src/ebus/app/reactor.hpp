@@ -9,6 +9,7 @@
 #include <chrono>
 #include <cstdint>
 #include <ebus/callbacks.hpp>
+#include <ebus/message_database.hpp>
 #include <ebus/status.hpp>
 #include <ebus/types.hpp>
 #include <functional>
@@ -16,15 +17,19 @@
 
 #include "app/device_manager.hpp"
 #include "app/device_scanner.hpp"
+#include "app/idle_predictor.hpp"
 #include "app/poll_manager.hpp"
 #include "app/protocol_event.hpp"
 #include "app/scheduler.hpp"
+#include "app/subscription_manager.hpp"
+#include "app/traffic_analyzer.hpp"
 #include "platform/mutex.hpp"
 #include "platform/queue.hpp"
 #include "platform/service_thread.hpp"
 #include "utils/circular_buffer.hpp"
 
 namespace ebus::detail {
+class BusCapture;
 class BusMonitor;
 
 /**
@@ -69,6 +74,27 @@ class Reactor {
   void setProtocolCallback(ProtocolCallback callback);
   void setTraceCallback(TraceCallback callback);
   void setLogLevel(LogLevel level);
+  // Forwards every bus event to capture (nullptr detaches it)
+  void setBusCapture(BusCapture* capture);
+  // Receives every validated telegram on the Reactor thread; before start()
+  void setTelegramSink(Delegate<void(const ProtocolEvent&)> sink);
+  // Receives the final event of every scheduled session; before start()
+  void setSessionResultSink(Delegate<void(const ProtocolEvent&)> sink);
+  // Decodes every telegram into named values (nullptr detaches it); may be
+  // replaced while running
+  void setMessageDatabase(std::shared_ptr<const MessageDatabase> database);
+  void setValueCallback(ValueCallback callback);
+  // Evaluates every telegram against the subscriptions; before start()
+  void setSubscriptionManager(SubscriptionManager* subscriptions);
+  // Counts every telegram and error and publishes the traffic matrix with
+  // the status housekeeping; before start()
+  void setTrafficAnalyzer(TrafficAnalyzer* traffic);
+  // Learns the rhythm of the other masters from their telegrams and counts
+  // the arbitration outcomes of own sessions; before start()
+  void setIdlePredictor(IdlePredictor* predictor);
+  // Runs with the periodic status housekeeping (about once per second);
+  // before start()
+  void setMaintenanceTask(Delegate<void()> task);
 
   void onBusEventInfo(const BusEventInfo& info);
 
@@ -110,6 +136,13 @@ class Reactor {
   DeviceScanner* device_scanner_ = nullptr;
   DeviceManager* device_manager_ = nullptr;
   BusMonitor* bus_monitor_ = nullptr;
+  SubscriptionManager* subscriptions_ = nullptr;
+  TrafficAnalyzer* traffic_ = nullptr;
+  IdlePredictor* idle_predictor_ = nullptr;
+  std::atomic<BusCapture*> bus_capture_{nullptr};
+  Delegate<void(const ProtocolEvent&)> telegram_sink_ = nullptr;
+  Delegate<void(const ProtocolEvent&)> session_result_sink_ = nullptr;
+  Delegate<void()> maintenance_task_ = nullptr;
 
   platform::Queue<ReactorSignal> signal_queue_;
   platform::Queue<ProtocolEvent> protocol_queue_;
@@ -126,12 +159,17 @@ class Reactor {
   std::atomic<size_t> max_signal_queue_{0};
   std::atomic<size_t> max_bus_queue_{0};
 
+  std::shared_ptr<const MessageDatabase> message_database_;
+  std::atomic<uint32_t> decoded_telegrams_{0};
+  std::atomic<uint32_t> undecoded_telegrams_{0};
+
   std::unique_ptr<platform::ServiceThread> worker_;
   std::atomic<bool> running_{false};
 
   // User callbacks
   ProtocolCallback user_protocol_callback_;
   TraceCallback user_trace_callback_;
+  ValueCallback user_value_callback_;
 
   void run();
 
@@ -12,6 +12,7 @@
 
 #include "core/bus_monitor.hpp"
 #include "core/handler.hpp"
+#include "utils/tracer.hpp"
 
 namespace ebus::detail {
 
@@ -20,18 +21,18 @@ Scheduler::Scheduler(Handler* handler)
 
 Scheduler::~Scheduler() { detachHandlerCallbacks(); }
 
-void Scheduler::stop() {
-  {
-    platform::LockGuard<platform::Mutex> lock(data_mutex_);
-    active_item_.reset();
-  }
-  clear();
-}
+void Scheduler::stop() { clear(); }
 
 void Scheduler::setProtocolEventSink(Delegate<void(ProtocolEvent&&)> sink) {
   event_sink_ = std::move(sink);
 }
 
+void Scheduler::setSessionGate(Delegate<bool()> acquire,
+                               Delegate<void(bool)> release) {
+  gate_acquire_ = acquire;
+  gate_release_ = release;
+}
+
 void Scheduler::setMaxAttempts(uint8_t max_attempts) {
   platform::LockGuard<platform::Mutex> lock(data_mutex_);
   max_attempts_ = max_attempts;
@@ -95,6 +96,7 @@ void Scheduler::onBusRequestWon() {
   ev.handler_state = handler_->getState();
   ev.request_state = RequestState::observe;
   ev.timestamp = ebus::getWallTimeMs();
+  ev.stampCompletion(Clock::now());
 
   if (event_sink_) {
     event_sink_(std::move(ev));
@@ -113,6 +115,7 @@ void Scheduler::onBusRequestLost() {
   ev.handler_state = handler_->getState();
   ev.request_state = RequestState::observe;
   ev.timestamp = ebus::getWallTimeMs();
+  ev.stampCompletion(Clock::now());
 
   if (event_sink_) {
     event_sink_(std::move(ev));
@@ -134,6 +137,13 @@ void Scheduler::onHandlerProtocol(const ProtocolInfo& info) {
     platform::LockGuard<platform::Mutex> lock(data_mutex_);
     if (active_item_ && active_item_->session_id == s_id) {
       scheduler_attempts = active_item_->item.attempts;
+      if (info.timings) {
+        auto& timings = active_item_->item.timings;
+        timings.bus_request_us = info.timings->bus_request_us;
+        timings.won_us = info.timings->won_us;
+        timings.master_ack_us = info.timings->master_ack_us;
+        timings.response_us = info.timings->response_us;
+      }
     }
   }
 
@@ -146,7 +156,9 @@ void Scheduler::onHandlerProtocol(const ProtocolInfo& info) {
   ev.handler_state = info.handler_state;
   ev.request_state = info.request_state;
   ev.timestamp = ebus::getWallTimeMs();
+  ev.stampCompletion(Clock::now());
   ev.level = info.level;
+  ev.telegram_timings = info.telegram_timings;
   ev.master.assign(info.master_view.data(), info.master_view.size());
   ev.slave.assign(info.slave_view.data(), info.slave_view.size());
   if (info.is_error) {
@@ -163,7 +175,8 @@ void Scheduler::onHandlerProtocol(const ProtocolInfo& info) {
   }
 }
 
-bool Scheduler::injectProtocolEvent(const ProtocolEvent& event) {
+bool Scheduler::injectProtocolEvent(const ProtocolEvent& event,
+                                    SessionTimings* completed) {
   {
     platform::LockGuard<platform::Mutex> lock(data_mutex_);
     if (!active_item_ || event.session_id != active_item_->session_id)
@@ -172,6 +185,7 @@ bool Scheduler::injectProtocolEvent(const ProtocolEvent& event) {
   }
 
   // Inlined handleAttemptResult logic:
+  bool retried = false;
   {
     platform::LockGuard<platform::Mutex> lock(data_mutex_);
     if (!active_item_) return false;
@@ -197,22 +211,27 @@ bool Scheduler::injectProtocolEvent(const ProtocolEvent& event) {
         active_item_.reset();
         current_session_id_.store(0, std::memory_order_release);
         current_poll_id_.store(0, std::memory_order_release);
-        return true;
+        retried = true;
       }
     }
 
-    auto terminal_item = std::move(active_item_->item);
-    active_item_.reset();
-    current_session_id_.store(0, std::memory_order_release);
-    current_poll_id_.store(0, std::memory_order_release);
+    if (!retried) {
+      auto terminal_item = std::move(active_item_->item);
+      if (completed) *completed = terminal_item.timings;
+      active_item_.reset();
+      current_session_id_.store(0, std::memory_order_release);
+      current_poll_id_.store(0, std::memory_order_release);
+    }
   }
+  releaseSessionGate();
   return true;
 }
 
 bool Scheduler::tick() {
-  std::optional<Item> item_to_start;
+  EBUS_TRACE_SCOPE("scheduler.tick");
   ProtocolEvent timeout_ev{};
   bool has_timeout = false;
+  bool start_due = false;
 
   {
     platform::LockGuard<platform::Mutex> lock(data_mutex_);
@@ -235,13 +254,7 @@ bool Scheduler::tick() {
     } else if (!scheduled_items_.empty() &&
                scheduled_items_.front().due <= Clock::now()) {
       if (handler_->isActiveMessagePending()) return false;
-      std::pop_heap(scheduled_items_.begin(), scheduled_items_.end(),
-                    Compare());
-      item_to_start = std::move(scheduled_items_.back());
-      scheduled_items_.pop_back();
-      current_session_id_.store(item_to_start->session_id,
-                                std::memory_order_release);
-      current_poll_id_.store(item_to_start->poll_id, std::memory_order_release);
+      start_due = true;
     }
   }
 
@@ -254,13 +267,43 @@ bool Scheduler::tick() {
     return true;
   }
 
-  if (item_to_start) {
-    {
+  if (!start_due) return false;
+
+  // The bus is shared with bridge clients: wait for the local turn
+  if (gate_acquire_ && !gate_acquire_()) {
+    gate_closed_.store(true, std::memory_order_relaxed);
+    return false;
+  }
+  gate_closed_.store(false, std::memory_order_relaxed);
+
+  std::optional<Item> item_to_start;
+  {
+    platform::LockGuard<platform::Mutex> lock(data_mutex_);
+    if (!active_item_ && !scheduled_items_.empty()) {
+      std::pop_heap(scheduled_items_.begin(), scheduled_items_.end(),
+                    Compare());
+      item_to_start = std::move(scheduled_items_.back());
+      scheduled_items_.pop_back();
+      if (item_to_start->timings.dequeued_us == 0)
+        item_to_start->timings.dequeued_us =
+            SessionTimings::toMicros(Clock::now());
+      current_session_id_.store(item_to_start->session_id,
+                                std::memory_order_release);
+      current_poll_id_.store(item_to_start->poll_id, std::memory_order_release);
+
       // Correlation FIX: Set active_item_ BEFORE calling the handler.
       // Ensures immediate terminal results (structural errors) map correctly.
-      platform::LockGuard<platform::Mutex> lock(data_mutex_);
       active_item_ = {*item_to_start, Clock::now(), item_to_start->session_id};
     }
+  }
+
+  if (!item_to_start) {
+    // Cleared meanwhile
+    releaseSessionGate();
+    return false;
+  }
+
+  {
 
     if (!handler_->sendActiveMessage(item_to_start->message)) {
       ProtocolEvent fail_ev{};
@@ -289,6 +332,8 @@ uint32_t Scheduler::enqueue(uint8_t priority, ByteView message,
   it.priority = priority;
   it.due = Clock::now();
   it.message.assign(message);
+  it.timings.enqueued_us = SessionTimings::toMicros(it.due);
+  it.timings.priority = priority;
   const uint32_t session_id = next_session_id_++;
   it.session_id = session_id;
   it.poll_id = poll_id;
@@ -302,6 +347,10 @@ uint32_t Scheduler::enqueueAt(uint8_t priority, ByteView message,
   it.priority = priority;
   it.due = when;
   it.message.assign(message);
+  // Queue wait of deferred items is measured from their due time
+  it.timings.enqueued_us =
+      SessionTimings::toMicros(std::max(Clock::now(), when));
+  it.timings.priority = priority;
   const uint32_t session_id = next_session_id_++;
   it.session_id = session_id;
   it.poll_id = poll_id;
@@ -310,10 +359,28 @@ uint32_t Scheduler::enqueueAt(uint8_t priority, ByteView message,
 }
 
 void Scheduler::clear() {
-  platform::LockGuard<platform::Mutex> lock(data_mutex_);
-  scheduled_items_.clear();
-  std::make_heap(scheduled_items_.begin(), scheduled_items_.end(), Compare());
-  active_item_.reset();
+  bool was_active = false;
+  {
+    platform::LockGuard<platform::Mutex> lock(data_mutex_);
+    scheduled_items_.clear();
+    std::make_heap(scheduled_items_.begin(), scheduled_items_.end(),
+                   Compare());
+    was_active = active_item_.has_value();
+    active_item_.reset();
+  }
+  gate_closed_.store(false, std::memory_order_relaxed);
+  if (was_active) releaseSessionGate();
+}
+
+void Scheduler::releaseSessionGate() {
+  if (!gate_release_) return;
+  bool more = false;
+  {
+    platform::LockGuard<platform::Mutex> lock(data_mutex_);
+    more = !scheduled_items_.empty() &&
+           scheduled_items_.front().due <= Clock::now();
+  }
+  gate_release_(more);
 }
 
 Clock::time_point Scheduler::nextDueTime() const {
@@ -322,6 +389,12 @@ Clock::time_point Scheduler::nextDueTime() const {
     return active_item_->start_time + total_timeout_;
   }
 
+  // Deferred by the session gate: asked again on the next reactor tick or
+  // when the gate wakes the reactor
+  if (gate_closed_.load(std::memory_order_relaxed)) {
+    return Clock::time_point::max();
+  }
+
   // Starvation/Busy-wait Fix: If the handler is currently busy (e.g., with an
   // external bridge or reactive response), we cannot start a new transfer.
   // Any pending items should not cause a spin loop in the controller.
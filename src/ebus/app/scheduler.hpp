@@ -62,16 +62,27 @@ class Scheduler {
 
   void setReactiveCallback(ReactiveCallback callback);
 
+  /**
+   * @brief Shares the bus with bridge clients. acquire is asked before an
+   * attempt starts and may defer it; release is called when the attempt
+   * ended, with whether further items are due. Both are called without
+   * Scheduler locks held. Set before the first tick().
+   */
+  void setSessionGate(Delegate<bool()> acquire, Delegate<void(bool)> release);
+
   // Working Methods
   void attachHandlerCallbacks();
   void detachHandlerCallbacks();
   /**
    * @brief Injects a protocol result from the Reactor loop. Bridges the
    * decoupled events to the Scheduler's processing thread.
+   * @param completed Receives the latency breakdown of the session if the
+   * event finished it (success or final failure); left untouched otherwise.
    * @return true if the event resulted in a state change (e.g. terminal
    * result).
    */
-  bool injectProtocolEvent(const ProtocolEvent& event);
+  bool injectProtocolEvent(const ProtocolEvent& event,
+                           SessionTimings* completed = nullptr);
   /**
    * @brief Performs periodic maintenance. Returns true if work was done.
    */
@@ -96,6 +107,7 @@ class Scheduler {
     uint16_t poll_id = 0;
     uint8_t attempts = 0;
     Sequence message;
+    SessionTimings timings;
   };
 
   struct Compare {
@@ -140,6 +152,10 @@ class Scheduler {
 
   Delegate<void(ProtocolEvent&&)> event_sink_;
 
+  Delegate<bool()> gate_acquire_ = nullptr;
+  Delegate<void(bool)> gate_release_ = nullptr;
+  std::atomic<bool> gate_closed_{false};  // Waiting for the local turn
+
   std::atomic<uint32_t> next_session_id_;
 
   // Active transfer state
@@ -161,6 +177,7 @@ class Scheduler {
   // Private Helper Methods
   bool pushItem(Item&& it);
   Duration backoffDuration(int attempt) const;
+  void releaseSessionGate();
 
   // Handler callback targets
   void onBusRequestWon();
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ebus/detail/protocol_limits.hpp>
+#include <ebus/types.hpp>
+
+namespace ebus::detail {
+
+/**
+ * Arbitration state of one source of bus sessions: a write-capable client or
+ * the local scheduler.
+ */
+struct SessionShare {
+  uint8_t weight = 1;  // sessions per round while others are waiting
+  bool waiting = false;
+  Clock::time_point waiting_since;
+  uint64_t finish = 0;  // virtual finish tag of the last granted session
+
+  uint64_t sessions = 0;
+  uint64_t wait_total_us = 0;
+  uint64_t wait_max_us = 0;
+
+  float averageWaitMs() const {
+    return sessions == 0 ? 0.0f
+                         : static_cast<float>(wait_total_us) /
+                               static_cast<float>(sessions) / 1000.0f;
+  }
+};
+
+/**
+ * Start-time fair queueing of bus sessions. A waiting source is tagged with
+ * the later of the virtual time and the finish tag of its previous session;
+ * the lowest tag starts next, ties go to the source waiting longest. Every
+ * granted session moves the finish tag on by unit / weight, so while several
+ * sources keep waiting they take turns in proportion to their weights and
+ * none is starved. A new source starts at the current virtual time and gains
+ * no credit for the time it was idle.
+ */
+class SessionArbiter {
+ public:
+  // Divisible by every weight up to NetworkLimits::max_session_weight
+  static constexpr uint64_t unit = 840;
+  static_assert(NetworkLimits::max_session_weight <= 8,
+                "unit must be divisible by every session weight");
+
+  // Marks the source as waiting; the first request starts its wait time
+  void request(SessionShare& share, const Clock::time_point& now) const {
+    if (share.waiting) return;
+    share.waiting = true;
+    share.waiting_since = now;
+  }
+
+  void withdraw(SessionShare& share) const { share.waiting = false; }
+
+  // Whether a starts before b; both are waiting
+  bool precedes(const SessionShare& a, const SessionShare& b) const {
+    const uint64_t start_a = startTag(a);
+    const uint64_t start_b = startTag(b);
+    if (start_a != start_b) return start_a < start_b;
+    return a.waiting_since < b.waiting_since;
+  }
+
+  // Starts a session of the source and accounts its wait time
+  void grant(SessionShare& share, const Clock::time_point& now) {
+    const uint64_t start = startTag(share);
+    virtual_time_ = start;
+    share.finish = start + unit / std::max<uint8_t>(share.weight, 1);
+    share.waiting = false;
+
+    const uint64_t wait_us = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            now - share.waiting_since)
+            .count());
+    share.sessions++;
+    share.wait_total_us += wait_us;
+    share.wait_max_us = std::max(share.wait_max_us, wait_us);
+    total_sessions_++;
+  }
+
+  // Fraction of all granted sessions that went to the source
+  float shareOf(const SessionShare& share) const {
+    return total_sessions_ == 0 ? 0.0f
+                                : static_cast<float>(share.sessions) /
+                                      static_cast<float>(total_sessions_);
+  }
+
+  uint64_t totalSessions() const { return total_sessions_; }
+
+ private:
+  uint64_t virtual_time_ = 0;
+  uint64_t total_sessions_ = 0;
+
+  uint64_t startTag(const SessionShare& share) const {
+    return std::max(virtual_time_, share.finish);
+  }
+};
+
+}  // namespace ebus::detail
@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "app/subscription_manager.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ebus::detail {
+
+namespace {
+
+bool matches(const Subscription& sub, ByteView master) {
+  if (master.size() < 5 || master[2] != sub.pb || master[3] != sub.sb)
+    return false;
+  if (!sub.any_target && master[1] != sub.zz) return false;
+  const size_t data_size = std::min<size_t>(master[4], master.size() - 5);
+  if (data_size < sub.id_size) return false;
+  return std::equal(sub.id.begin(), sub.id.begin() + sub.id_size,
+                    master.begin() + 5);
+}
+
+bool isSignificant(const Subscription& sub, const DataValue& value,
+                   const DataValue& last) {
+  if (isNull(value) || isNull(last)) return isNull(value) != isNull(last);
+  if (!isNumeric(value) || !isNumeric(last)) return !(value == last);
+
+  const float current = asFloat(value);
+  const float previous = asFloat(last);
+  const float band =
+      sub.relative ? sub.deadband * std::fabs(previous) : sub.deadband;
+  return std::fabs(current - previous) > band;
+}
+
+}  // namespace
+
+void SubscriptionManager::setCallback(ChangeCallback callback) {
+  platform::LockGuard<platform::Mutex> lock(mutex_);
+  callback_ = callback;
+}
+
+uint16_t SubscriptionManager::subscribe(const Subscription& subscription) {
+  if (subscription.id_size > MessageDatabaseLimits::max_id_bytes ||
+      subscription.type == DataType::error ||
+      subscription.type == DataType::auto_detect)
+    return 0;
+  const size_t base = subscription.slave ? 0 : subscription.id_size;
+  if (base + subscription.offset + sizeOfDataType(subscription.type) >
+      SequenceLimits::max_data_bytes)
+    return 0;
+
+  platform::LockGuard<platform::Mutex> lock(mutex_);
+  if (entries_.size() >= SubscriptionLimits::max_subscriptions) return 0;
+
+  // After a wrap, IDs still in use are skipped; 0 is reserved (invalid)
+  uint16_t id = next_id_++;
+  while (id == 0 || isUsed(id)) id = next_id_++;
+
+  Entry entry;
+  entry.id = id;
+  entry.subscription = subscription;
+  entries_.push_back(entry);
+  return id;
+}
+
+void SubscriptionManager::unsubscribe(uint16_t id) {
+  platform::LockGuard<platform::Mutex> lock(mutex_);
+  for (auto& entry : entries_)
+    if (entry.id == id) entry.removed = true;
+  compact();
+  history_.erase(id);
+}
+
+void SubscriptionManager::clear() {
+  platform::LockGuard<platform::Mutex> lock(mutex_);
+  for (auto& entry : entries_) entry.removed = true;
+  compact();
+  history_.clear();
+}
+
+bool SubscriptionManager::isUsed(uint16_t id) const {
+  return std::any_of(entries_.begin(), entries_.end(),
+                     [id](const Entry& e) { return e.id == id; });
+}
+
+void SubscriptionManager::compact() {
+  // While process() walks the entries they must not shift; it compacts them
+  // when it is done
+  if (processing_) return;
+  entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                [](const Entry& e) { return e.removed; }),
+                 entries_.end());
+}
+
+void SubscriptionManager::process(ByteView master, ByteView slave,
+                                  uint64_t timestamp) {
+  // The lock is released around every callback so that it may change the
+  // subscriptions; removed entries stay in place until the loop is done.
+  {
+    platform::LockGuard<platform::Mutex> lock(mutex_);
+    processing_ = true;
+  }
+  for (size_t i = 0;; ++i) {
+    ChangeInfo info;
+    ChangeCallback callback;
+    {
+      platform::LockGuard<platform::Mutex> lock(mutex_);
+      if (i >= entries_.size()) {
+        processing_ = false;
+        compact();
+        return;
+      }
+      if (entries_[i].removed ||
+          !evaluate(entries_[i], master, slave, timestamp, info))
+        continue;
+      callback = callback_;
+    }
+    if (callback) callback(info);
+  }
+}
+
+bool SubscriptionManager::evaluate(Entry& entry, ByteView master,
+                                   ByteView slave, uint64_t timestamp,
+                                   ChangeInfo& info) {
+  const Subscription& sub = entry.subscription;
+  if (!matches(sub, master)) return false;
+
+  ByteView part;
+  if (sub.slave) {
+    if (slave.empty()) return false;
+    part = {slave.data() + 1, std::min<size_t>(slave[0], slave.size() - 1)};
+  } else {
+    const size_t data_size = std::min<size_t>(master[4], master.size() - 5);
+    part = {master.data() + 5 + sub.id_size, data_size - sub.id_size};
+  }
+
+  const size_t size = sizeOfDataType(sub.type);
+  if (sub.offset + size > part.size()) return false;
+  const auto value = decode(sub.type, {part.data() + sub.offset, size});
+  if (!value) return false;
+  ++matches_;
+
+  if (sub.history && isNumeric(*value) && !isNull(*value))
+    history_.append(entry.id, timestamp, asFloat(*value));
+
+  bool refresh = false;
+  if (entry.reported && !isSignificant(sub, *value, entry.last)) {
+    if (sub.max_silence_ms == 0 ||
+        timestamp - entry.last_report < sub.max_silence_ms)
+      return false;
+    refresh = true;
+  }
+
+  info.subscription_id = entry.id;
+  info.value = *value;
+  if (entry.reported) info.previous = entry.last;
+  info.refresh = refresh;
+  info.master_view = master;
+  info.slave_view = slave;
+  info.timestamp = timestamp;
+
+  entry.reported = true;
+  entry.last = *value;
+  entry.last_report = timestamp;
+  ++reports_;
+  return true;
+}
+
+void SubscriptionManager::fetchHistory(
+    uint16_t id, const HistoryQuery& query,
+    const TimeSeriesStore::SampleVisitor& visitor) const {
+  platform::LockGuard<platform::Mutex> lock(mutex_);
+  history_.forEach(id, query.from, query.to, visitor);
+}
+
+void SubscriptionManager::fetchHistory(
+    uint16_t id, const HistoryQuery& query,
+    const TimeSeriesStore::BucketVisitor& visitor) const {
+  platform::LockGuard<platform::Mutex> lock(mutex_);
+  history_.downsample(id, query.from, query.to, query.step_ms, visitor);
+}
+
+SubscriptionStatus SubscriptionManager::fetchStatus() const {
+  platform::LockGuard<platform::Mutex> lock(mutex_);
+  SubscriptionStatus status;
+  status.count = std::count_if(entries_.begin(), entries_.end(),
+                               [](const Entry& e) { return !e.removed; });
+  status.capacity = SubscriptionLimits::max_subscriptions;
+  status.matches = matches_;
+  status.reports = reports_;
+  status.history_samples = history_.sampleCount();
+  status.history_bytes = history_.memoryUsage();
+  status.history_capacity = TimeSeriesStore::capacity();
+  status.history_evictions = history_.evictions();
+  return status;
+}
+
+}  // namespace ebus::detail
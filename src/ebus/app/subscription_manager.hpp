@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+// Reports significant changes of decoded values in passive traffic.
+
+#pragma once
+
+#include <cstdint>
+#include <ebus/data_types.hpp>
+#include <ebus/detail/protocol_limits.hpp>
+#include <ebus/static_vector.hpp>
+#include <ebus/status.hpp>
+#include <ebus/subscription.hpp>
+#include <ebus/types.hpp>
+
+#include "platform/mutex.hpp"
+#include "utils/time_series.hpp"
+
+namespace ebus::detail {
+
+/**
+ * The SubscriptionManager decodes one field of every telegram matching a
+ * subscription and compares it with the value it reported last. Only changes
+ * beyond the deadband reach the callback, so a consumer sees a handful of
+ * events instead of a value every few seconds. An unchanged value is reported
+ * again after max_silence_ms; the silence is checked when a matching telegram
+ * arrives, not by a timer.
+ *
+ * Subscriptions with history enabled also record every decoded numeric value
+ * in a compressed TimeSeriesStore under their ID.
+ *
+ * The callback runs without the lock held and may add or remove
+ * subscriptions; removals during process() take effect at its end, so no
+ * other subscription is skipped.
+ */
+class SubscriptionManager {
+ public:
+  SubscriptionManager() = default;
+
+  SubscriptionManager(const SubscriptionManager&) = delete;
+  SubscriptionManager& operator=(const SubscriptionManager&) = delete;
+
+  // Configuration
+  void setCallback(ChangeCallback callback);
+
+  // Working Methods
+  // Returns an ID not used by any other subscription, or 0 if the manager is
+  // full or the subscription has no concrete type, an ID that is too long or
+  // a field beyond the data.
+  uint16_t subscribe(const Subscription& subscription);
+  void unsubscribe(uint16_t id);
+  void clear();
+
+  // Evaluates a telegram (QQ ZZ PB SB NN data) and its slave response (NN
+  // data, or empty) against all subscriptions.
+  void process(ByteView master, ByteView slave, uint64_t timestamp);
+
+  // Visits the value history of a subscription under the lock; the visitors
+  // must not call back into the manager.
+  void fetchHistory(uint16_t id, const HistoryQuery& query,
+                    const TimeSeriesStore::SampleVisitor& visitor) const;
+  void fetchHistory(uint16_t id, const HistoryQuery& query,
+                    const TimeSeriesStore::BucketVisitor& visitor) const;
+
+  // Status/Telemetry
+  SubscriptionStatus fetchStatus() const;
+
+ private:
+  struct Entry {
+    uint16_t id = 0;
+    Subscription subscription;
+    bool reported = false;
+    DataValue last;  // last reported value
+    uint64_t last_report = 0;
+    bool removed = false;  // unsubscribed during process()
+  };
+
+  mutable platform::Mutex mutex_;
+  StaticVector<Entry, SubscriptionLimits::max_subscriptions> entries_;
+  ChangeCallback callback_;
+  TimeSeriesStore history_;
+  uint16_t next_id_ = 1;
+  bool processing_ = false;
+  uint64_t matches_ = 0;
+  uint64_t reports_ = 0;
+
+  bool isUsed(uint16_t id) const;
+  // Erases removed entries unless process() is walking them
+  void compact();
+
+  // Decodes the subscribed field and decides whether to report it
+  bool evaluate(Entry& entry, ByteView master, ByteView slave,
+                uint64_t timestamp, ChangeInfo& info);
+};
+
+}  // namespace ebus::detail
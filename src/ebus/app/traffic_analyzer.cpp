@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "app/traffic_analyzer.hpp"
+
+#include <ebus/address.hpp>
+#include <ebus/detail/json_writer.hpp>
+#include <ebus/sequence.hpp>
+
+namespace ebus::detail {
+
+namespace {
+
+void count(TrafficCount& target, uint32_t wire_bytes) {
+  target.telegrams++;
+  target.wire_bytes += wire_bytes;
+}
+
+void writeCount(JsonWriter& writer, const TrafficCount& count) {
+  writer.writeField("telegrams", count.telegrams);
+  writer.writeField("wire_bytes", count.wire_bytes);
+  writer.writeField("errors", count.errors);
+}
+
+}  // namespace
+
+template <size_t Capacity>
+uint16_t TrafficAnalyzer::KeyIndex<Capacity>::lookup(uint16_t key,
+                                                     size_t size) {
+  // Fibonacci hashing spreads the neighbouring addresses and services
+  size_t i = static_cast<uint16_t>(key * 40503u) >> (16 - bits);
+  for (;; i = (i + 1) & (slot_count - 1)) {
+    Slot& slot = slots_[i];
+    if (slot.position == none) {
+      if (size >= Capacity) return none;
+      slot.key = key;
+      slot.position = static_cast<uint16_t>(size);
+      return slot.position;
+    }
+    if (slot.key == key) return slot.position;
+  }
+}
+
+void TrafficAnalyzer::setOwnAddress(uint8_t address) {
+  own_address_.store(address, std::memory_order_relaxed);
+}
+
+uint32_t TrafficAnalyzer::wireBytes(ByteView part) {
+  uint32_t bytes = 1;  // CRC
+  for (uint8_t byte : part) bytes += Symbols::needsEscape(byte) ? 2 : 1;
+  if (Symbols::needsEscape(Sequence::calculateCRC(part))) bytes++;
+  return bytes;
+}
+
+TrafficCount& TrafficAnalyzer::pair(uint8_t source, uint8_t target) {
+  const uint16_t position = pair_index_.lookup(
+      static_cast<uint16_t>(source << 8 | target), live_.pairs.size());
+  if (position == KeyIndex<TrafficLimits::max_pairs>::none)
+    return live_.pair_overflow;
+  if (position == live_.pairs.size()) {
+    TrafficPair entry;
+    entry.source = source;
+    entry.target = target;
+    live_.pairs.push_back(entry);
+  }
+  return live_.pairs[position].count;
+}
+
+TrafficService* TrafficAnalyzer::service(uint8_t pb, uint8_t sb) {
+  const uint16_t position = service_index_.lookup(
+      static_cast<uint16_t>(pb << 8 | sb), live_.services.size());
+  if (position == KeyIndex<TrafficLimits::max_services>::none) return nullptr;
+  if (position == live_.services.size()) {
+    TrafficService entry;
+    entry.pb = pb;
+    entry.sb = sb;
+    live_.services.push_back(entry);
+  }
+  return &live_.services[position];
+}
+
+void TrafficAnalyzer::recordTelegram(ByteView master, ByteView slave) {
+  if (master.size() < 5) return;
+
+  // Every part but a broadcast is acknowledged with one byte
+  uint32_t bytes = wireBytes(master);
+  if (master[1] != Symbols::broad) bytes++;
+  if (!slave.empty()) bytes += wireBytes(slave) + 1;
+
+  count(live_.total, bytes);
+  count(pair(master[0], master[1]), bytes);
+
+  TrafficService* entry = service(master[2], master[3]);
+  if (!entry) {
+    count(live_.service_overflow, bytes);
+    return;
+  }
+  count(entry->count, bytes);
+  if (master[0] == own_address_.load(std::memory_order_relaxed))
+    entry->own_telegrams++;
+}
+
+void TrafficAnalyzer::recordError(ByteView master) {
+  live_.total.errors++;
+  if (master.size() < 2) return;
+  pair(master[0], master[1]).errors++;
+
+  if (master.size() < 4) return;
+  TrafficService* entry = service(master[2], master[3]);
+  (entry ? entry->count : live_.service_overflow).errors++;
+}
+
+bool TrafficAnalyzer::publish(uint64_t timestamp) {
+  const uint64_t generation = snapshots_.generation() + 1;
+  return snapshots_.publish([&](TrafficMatrix& snapshot) {
+    snapshot = live_;
+    snapshot.generation = generation;
+    snapshot.timestamp = timestamp;
+  });
+}
+
+bool TrafficAnalyzer::fetchSnapshot(
+    const std::function<void(const TrafficMatrix&)>& callback) const {
+  if (!callback) return false;
+  return snapshots_.read(
+      [&](uint64_t, const TrafficMatrix& current, const TrafficMatrix*) {
+        callback(current);
+      });
+}
+
+}  // namespace ebus::detail
+
+namespace ebus {
+
+void TrafficMatrix::toJson(detail::JsonWriter& writer) const {
+  auto scope = writer.objectScope();
+  writer.writeField("generation", generation);
+  writer.writeTimestampField("timestamp", timestamp);
+
+  {
+    auto totalScope = writer.objectScope("total");
+    detail::writeCount(writer, total);
+  }
+
+  {
+    auto pairsScope = writer.arrayScope("pairs");
+    for (const auto& entry : pairs) {
+      auto entryScope = writer.objectScope();
+      writer.writeHexField("source", ByteView(&entry.source, 1));
+      writer.writeHexField("target", ByteView(&entry.target, 1));
+      detail::writeCount(writer, entry.count);
+    }
+  }
+
+  {
+    auto servicesScope = writer.arrayScope("services");
+    for (const auto& entry : services) {
+      auto entryScope = writer.objectScope();
+      writer.writeHexField("pb", ByteView(&entry.pb, 1));
+      writer.writeHexField("sb", ByteView(&entry.sb, 1));
+      detail::writeCount(writer, entry.count);
+      writer.writeField("own_telegrams", entry.own_telegrams);
+    }
+  }
+
+  {
+    auto overflowScope = writer.objectScope("pair_overflow");
+    detail::writeCount(writer, pair_overflow);
+  }
+  {
+    auto overflowScope = writer.objectScope("service_overflow");
+    detail::writeCount(writer, service_overflow);
+  }
+}
+
+}  // namespace ebus
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+// Counts passive traffic per source/target pair and per service.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ebus/detail/protocol_limits.hpp>
+#include <ebus/traffic.hpp>
+#include <ebus/types.hpp>
+#include <functional>
+
+#include "utils/snapshot_buffer.hpp"
+
+namespace ebus::detail {
+
+// Smallest number of bits that can address count slots
+constexpr size_t indexBits(size_t count) {
+  size_t bits = 1;
+  while ((size_t{1} << bits) < count) ++bits;
+  return bits;
+}
+
+/**
+ * The TrafficAnalyzer maintains a sparse source x target matrix and a
+ * service (PB SB) histogram of telegram counts, wire bytes and errors. Each
+ * table is a dense array of entries with an open-addressing index on top, so
+ * a telegram costs two hash lookups.
+ *
+ * Recording and publishing run on the Reactor thread only; readers get the
+ * latest published TrafficMatrix from a SnapshotBuffer without a lock.
+ */
+class TrafficAnalyzer {
+ public:
+  TrafficAnalyzer() = default;
+
+  TrafficAnalyzer(const TrafficAnalyzer&) = delete;
+  TrafficAnalyzer& operator=(const TrafficAnalyzer&) = delete;
+
+  // Configuration
+  void setOwnAddress(uint8_t address);
+
+  // Working Methods (Reactor thread)
+  // Counts a completed telegram (QQ ZZ PB SB NN data) and its slave response
+  // (NN data, or empty)
+  void recordTelegram(ByteView master, ByteView slave);
+  // Counts a failed telegram against whatever part of the header it has
+  void recordError(ByteView master);
+
+  /**
+   * @brief Publishes the current counters for fetchSnapshot().
+   * @return false if every spare slot is still held by readers.
+   */
+  bool publish(uint64_t timestamp);
+
+  // Status/Telemetry (any thread, lock-free)
+  bool fetchSnapshot(
+      const std::function<void(const TrafficMatrix&)>& callback) const;
+
+  // Bytes on the wire of a telegram part: escapes, CRC (escaped as needed)
+  static uint32_t wireBytes(ByteView part);
+
+ private:
+  // Maps a 16 bit key to the position of its entry in a dense array
+  template <size_t Capacity>
+  class KeyIndex {
+   public:
+    static constexpr uint16_t none = 0xffff;
+
+    // Returns the position of key; a new key gets position size unless the
+    // array is full (none)
+    uint16_t lookup(uint16_t key, size_t size);
+
+   private:
+    // At most half of the slots are used
+    static constexpr size_t bits = indexBits(2 * Capacity);
+    static constexpr size_t slot_count = size_t{1} << bits;
+
+    struct Slot {
+      uint16_t key = 0;
+      uint16_t position = none;
+    };
+    std::array<Slot, slot_count> slots_{};
+  };
+
+  std::atomic<uint8_t> own_address_{0xff};
+
+  TrafficMatrix live_;
+  KeyIndex<TrafficLimits::max_pairs> pair_index_;
+  KeyIndex<TrafficLimits::max_services> service_index_;
+
+  SnapshotBuffer<TrafficMatrix, TrafficLimits::snapshot_slots> snapshots_;
+
+  TrafficCount& pair(uint8_t source, uint8_t target);
+  TrafficService* service(uint8_t pb, uint8_t sb);
+};
+
+}  // namespace ebus::detail
@@ -44,6 +44,27 @@ void BusMonitor::resetMetrics() {
   handler_history_.clear();
   request_history_.clear();
 #endif
+#if EBUS_SESSION_STATS
+  for (auto& stats : session_stats_) stats.reset();
+#endif
+}
+
+void BusMonitor::resetLatencyWindow() {
+  sync.resetWindow();
+  write.resetWindow();
+  passive_first.resetWindow();
+  passive_data.resetWindow();
+  active_first.resetWindow();
+  active_data.resetWindow();
+
+  delay.resetWindow();
+  window.resetWindow();
+  transmit.resetWindow();
+  syn_postpone.resetWindow();
+
+#if EBUS_SESSION_STATS
+  for (auto& stats : session_stats_) stats.resetWindow();
+#endif
 }
 
 void BusMonitor::recordBusError() {
@@ -107,6 +128,43 @@ void BusMonitor::recordIsrSynPostponed(uint32_t count) {
   bus_acc_.syn_postponed_count.fetch_add(count, std::memory_order_relaxed);
 }
 
+void BusMonitor::recordSession(const SessionTimings& timings) {
+#if EBUS_SESSION_STATS
+  auto segment = [](TimingStats& stats, uint64_t begin_us, uint64_t end_us) {
+    if (begin_us > 0 && end_us >= begin_us)
+      stats.addSample(static_cast<uint32_t>(end_us - begin_us));
+  };
+
+  SessionStats& stats =
+      session_stats_[SessionLimits::priorityClass(timings.priority)];
+  segment(stats.queue_wait, timings.enqueued_us, timings.dequeued_us);
+  segment(stats.bus_wait, timings.dequeued_us, timings.won_us);
+  segment(stats.transfer, timings.won_us, timings.response_us);
+  segment(stats.dispatch, timings.response_us, timings.delivered_us);
+  segment(stats.total, timings.enqueued_us, timings.delivered_us);
+#else
+  (void)timings;
+#endif
+}
+
+#if EBUS_SESSION_STATS
+void BusMonitor::SessionStats::reset() {
+  queue_wait.reset();
+  bus_wait.reset();
+  transfer.reset();
+  dispatch.reset();
+  total.reset();
+}
+
+void BusMonitor::SessionStats::resetWindow() {
+  queue_wait.resetWindow();
+  bus_wait.resetWindow();
+  transfer.resetWindow();
+  dispatch.resetWindow();
+  total.resetWindow();
+}
+#endif
+
 void BusMonitor::updateUtilizationHistory() {
 #ifndef EBUS_MINIMAL_DIAGNOSTICS
   platform::LockGuard<platform::Mutex> lock(metrics_mutex_);
@@ -203,106 +261,145 @@ float BusMonitor::getBusUtilization() const {
 void BusMonitor::fetchMetrics(
     const std::function<void(const Metrics&)>& callback) const {
   metrics::SystemMetrics sm;
-  {
-    platform::LockGuard<platform::Mutex> lock(metrics_mutex_);
-    // Populate snapshot while holding the lock
-
-    // 1. Populate Handler Part
-    metrics::HandlerMetrics& hm = sm.handler;
-    hm = handler_acc_;
-
-    // Map Timing
-    hm.sync = sync.getValues();
-    hm.write = write.getValues();
-    hm.passive_first = passive_first.getValues();
-    hm.passive_data = passive_data.getValues();
-    hm.active_first = active_first.getValues();
-    hm.active_data = active_data.getValues();
-
-    // 2. Populate Request Part
-    metrics::RequestMetrics& rm = sm.request;
-    rm = request_acc_;
-
-    // 3. Populate Bus Part
-    metrics::BusMetrics& bm = sm.bus;
-    bm.start_bit_errors.store(
-        bus_acc_.start_bit_errors.load(std::memory_order_relaxed),
-        std::memory_order_relaxed);
-    bm.syn_postponed_count.store(
-        bus_acc_.syn_postponed_count.load(std::memory_order_relaxed),
-        std::memory_order_relaxed);
-    bm.congestion = bus_acc_.congestion;
-    bm.high_jitter = bus_acc_.high_jitter;
-    bm.last_error_us = bus_acc_.last_error_us;
-
-    // Map Timing
-    bm.delay = delay.getValues();
-    bm.window = window.getValues();
-    bm.transmit = transmit.getValues();
-    bm.syn_postpone = syn_postpone.getValues();
-
-    auto now = Clock::now();
-    uint64_t uptime_us = std::chrono::duration_cast<std::chrono::microseconds>(
-                             now - uptime_start_)
-                             .count();
-    bm.uptime_us = uptime_us;
-
-    // Physical Utilization Logic (Congestion detection)
-    if (uptime_us > 0) {
-      uint64_t total_low_us =
-          (total_low_bits_ * Physical::bit_time_num) / Physical::bit_time_den;
-      float utilization =
-          (static_cast<float>(total_low_us) / static_cast<float>(uptime_us)) *
-          100.0f;
-      bm.utilization = utilization;
-      // Congestion Logic: > 70% for > 10 seconds
-      // If a single uptime sample already indicates the bus has been up for
-      // at least 10s (samples are in microseconds), treat high utilization
-      // as sustained congestion immediately. Otherwise fall back to the
-      // time-point based detection across successive calls.
-      constexpr uint64_t ten_seconds_us =
-          SystemMetricsLimits::bus_congestion_detection_time_us;
-      if (utilization > SystemMetricsLimits::bus_congestion_threshold_percent) {
-        if (uptime_us >= ten_seconds_us) {
-          congestion_active_ = true;
+  collectMetrics(sm);
+
+  // Execute callback outside the lock to protect the Hot Path
+  if (callback) {
+    callback(sm);
+  }
+}
+
+bool BusMonitor::publishSnapshot() {
+  return snapshots_.publish([this](Metrics& sm) { collectMetrics(sm); });
+}
+
+bool BusMonitor::fetchSnapshot(
+    const std::function<void(const MetricsSnapshot&)>& callback) const {
+  return snapshots_.read([&](uint64_t generation, const Metrics& current,
+                             const Metrics* previous) {
+    if (callback) callback(MetricsSnapshot{generation, &current, previous});
+  });
+}
+
+uint64_t BusMonitor::snapshotGeneration() const {
+  return snapshots_.generation();
+}
+
+uint32_t BusMonitor::skippedSnapshots() const { return snapshots_.skipped(); }
+
+void BusMonitor::collectMetrics(Metrics& sm) const {
+  platform::LockGuard<platform::Mutex> lock(metrics_mutex_);
+  // Populate snapshot while holding the lock
+
+  // 1. Populate Handler Part
+  metrics::HandlerMetrics& hm = sm.handler;
+  hm = handler_acc_;
+
+  // Map Timing
+  hm.sync = sync.getValues();
+  hm.write = write.getValues();
+  hm.passive_first = passive_first.getValues();
+  hm.passive_data = passive_data.getValues();
+  hm.active_first = active_first.getValues();
+  hm.active_data = active_data.getValues();
+
+  // 2. Populate Request Part
+  metrics::RequestMetrics& rm = sm.request;
+  rm = request_acc_;
+
+  // 3. Populate Bus Part
+  metrics::BusMetrics& bm = sm.bus;
+  bm.reset();  // Snapshot slots are reused
+  bm.start_bit_errors.store(
+      bus_acc_.start_bit_errors.load(std::memory_order_relaxed),
+      std::memory_order_relaxed);
+  bm.syn_postponed_count.store(
+      bus_acc_.syn_postponed_count.load(std::memory_order_relaxed),
+      std::memory_order_relaxed);
+  bm.congestion = bus_acc_.congestion;
+  bm.high_jitter = bus_acc_.high_jitter;
+  bm.last_error_us = bus_acc_.last_error_us;
+
+  // Map Timing
+  bm.delay = delay.getValues();
+  bm.window = window.getValues();
+  bm.transmit = transmit.getValues();
+  bm.syn_postpone = syn_postpone.getValues();
+
+  auto now = Clock::now();
+  uint64_t uptime_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                           now - uptime_start_)
+                           .count();
+  bm.uptime_us = uptime_us;
+
+  // Physical Utilization Logic (Congestion detection)
+  if (uptime_us > 0) {
+    uint64_t total_low_us =
+        (total_low_bits_ * Physical::bit_time_num) / Physical::bit_time_den;
+    float utilization =
+        (static_cast<float>(total_low_us) / static_cast<float>(uptime_us)) *
+        100.0f;
+    bm.utilization = utilization;
+    // Congestion Logic: > 70% for > 10 seconds
+    // If a single uptime sample already indicates the bus has been up for
+    // at least 10s (samples are in microseconds), treat high utilization
+    // as sustained congestion immediately. Otherwise fall back to the
+    // time-point based detection across successive calls.
+    constexpr uint64_t ten_seconds_us =
+        SystemMetricsLimits::bus_congestion_detection_time_us;
+    if (utilization > SystemMetricsLimits::bus_congestion_threshold_percent) {
+      if (uptime_us >= ten_seconds_us) {
+        congestion_active_ = true;
+      } else {
+        if (congestion_start_point_ == Clock::time_point{}) {
+          congestion_start_point_ = now;
         } else {
-          if (congestion_start_point_ == Clock::time_point{}) {
-            congestion_start_point_ = now;
-          } else {
-            auto duration = std::chrono::duration_cast<std::chrono::seconds>(
-                                now - congestion_start_point_)
-                                .count();
-            if (duration >=
-                static_cast<long long>(
-                    SystemMetricsLimits::bus_congestion_detection_time_s)) {
-              congestion_active_ = true;
-            }
+          auto duration = std::chrono::duration_cast<std::chrono::seconds>(
+                              now - congestion_start_point_)
+                              .count();
+          if (duration >=
+              static_cast<long long>(
+                  SystemMetricsLimits::bus_congestion_detection_time_s)) {
+            congestion_active_ = true;
           }
         }
-      } else {
-        congestion_start_point_ = {};
-        congestion_active_ = false;
       }
+    } else {
+      congestion_start_point_ = {};
+      congestion_active_ = false;
     }
-    bm.congestion = congestion_active_;
-
-    // High Jitter Logic: If a SYN took > 10ms longer than expected
-    bm.high_jitter = bm.syn_postpone.max_us >
-                     SystemMetricsLimits::bus_high_jitter_threshold_us;
-
-    // 4. Populate Device Part
-    metrics::DeviceMetrics& dm = sm.devices;
-    dm = device_acc_;
-
-    // 5. Populate Controller Part
-    // This is the "shadow state" for controller metrics
-    sm.reactor = reactor_acc_;
   }
-
-  // Execute callback outside the lock to protect the Hot Path
-  if (callback) {
-    callback(sm);
+  bm.congestion = congestion_active_;
+
+  // High Jitter Logic: If a SYN took > 10ms longer than expected
+  bm.high_jitter = bm.syn_postpone.max_us >
+                   SystemMetricsLimits::bus_high_jitter_threshold_us;
+
+  // 4. Populate Device Part
+  metrics::DeviceMetrics& dm = sm.devices;
+  dm = device_acc_;
+
+  // 5. Populate Controller Part
+  // This is the "shadow state" for controller metrics
+  sm.reactor = reactor_acc_;
+
+#if EBUS_SESSION_STATS
+  // 6. Populate Session Part
+  constexpr size_t classes = SessionLimits::priority_classes;
+  for (size_t i = 0; i < classes; ++i) {
+    metrics::SessionClassMetrics& cm = sm.sessions.classes[i];
+    cm.priority_min = static_cast<uint8_t>((i * 256 + classes - 1) / classes);
+    cm.priority_max =
+        static_cast<uint8_t>(((i + 1) * 256 + classes - 1) / classes - 1);
+
+    const SessionStats& stats = session_stats_[i];
+    cm.queue_wait = stats.queue_wait.getValues();
+    cm.bus_wait = stats.bus_wait.getValues();
+    cm.transfer = stats.transfer.getValues();
+    cm.dispatch = stats.dispatch.getValues();
+    cm.total = stats.total.getValues();
   }
+#endif
 }
 
 void BusMonitor::fetchUtilizationHistory(
@@ -339,6 +436,11 @@ void MetricValues::toJson(detail::JsonWriter& writer) const {
   writer.writeField("max_us", max_us);
   writer.writeFieldFloat("mean_us", mean_us);
   writer.writeField("count", count);
+#ifndef EBUS_MINIMAL_DIAGNOSTICS
+  writer.writeField("p50_us", p50_us);
+  writer.writeField("p95_us", p95_us);
+  writer.writeField("p99_us", p99_us);
+#endif
 }
 
 void metrics::HandlerMetrics::reset() {
@@ -547,6 +649,22 @@ void metrics::ReactorMetrics::toJson(detail::JsonWriter& writer) const {
   writer.writeField("max_loop_cycle_us", max_loop_cycle_us);
 }
 
+void metrics::SessionClassMetrics::toJson(detail::JsonWriter& writer) const {
+  auto scope = writer.objectScope();
+  writer.writeField("priority_min", priority_min);
+  writer.writeField("priority_max", priority_max);
+  writer.writeField("queue_wait", queue_wait);
+  writer.writeField("bus_wait", bus_wait);
+  writer.writeField("transfer", transfer);
+  writer.writeField("dispatch", dispatch);
+  writer.writeField("total", total);
+}
+
+void metrics::SessionMetrics::toJson(detail::JsonWriter& writer) const {
+  auto scope = writer.arrayScope();
+  for (const auto& cls : classes) writer.writeValue(cls);
+}
+
 void metrics::SystemMetrics::toJson(detail::JsonWriter& writer) const {
   // Pre-calculate rates for the composite Quality score
   uint32_t m_total = handler.messages_passive + handler.messages_active +
@@ -604,9 +722,52 @@ void metrics::SystemMetrics::toJson(detail::JsonWriter& writer) const {
   writer.writeValue(devices);
   writer.appendKey("reactor");
   writer.writeValue(reactor);
+#if EBUS_SESSION_STATS
+  writer.appendKey("sessions");
+  writer.writeValue(sessions);
+#endif
   writer.writeFieldFloat("quality", quality);
 }
 
+void MetricsSnapshot::toJson(detail::JsonWriter& writer) const {
+  auto scope = writer.objectScope();
+  writer.writeField("generation", generation);
+  if (!current) return;
+  writer.appendKey("metrics");
+  writer.writeValue(*current);
+
+  // Counters only grow between two snapshots unless metrics were reset
+  if (!previous || current->bus.uptime_us <= previous->bus.uptime_us) return;
+
+  const auto& h = current->handler;
+  const auto& ph = previous->handler;
+  const auto& r = current->request;
+  const auto& pr = previous->request;
+
+  auto interval = writer.objectScope("interval");
+  writer.writeField("interval_us",
+                    current->bus.uptime_us - previous->bus.uptime_us);
+  writer.writeField("messages",
+                    (h.messages_passive - ph.messages_passive) +
+                        (h.messages_reactive - ph.messages_reactive) +
+                        (h.messages_active - ph.messages_active));
+  writer.writeField("errors", (h.error_passive - ph.error_passive) +
+                                  (h.error_reactive - ph.error_reactive) +
+                                  (h.error_active - ph.error_active));
+  writer.writeField("won", r.won_total - pr.won_total);
+  writer.writeField("lost", r.lost_total - pr.lost_total);
+  writer.writeField("collisions", r.collisions - pr.collisions);
+  writer.writeField("sent_bytes",
+                    (h.total_sent_data_bytes - ph.total_sent_data_bytes) +
+                        (h.total_sent_protocol_bytes -
+                         ph.total_sent_protocol_bytes));
+  writer.writeField(
+      "observed_bytes",
+      (h.total_observed_data_bytes - ph.total_observed_data_bytes) +
+          (h.total_observed_protocol_bytes -
+           ph.total_observed_protocol_bytes));
+}
+
 // --- Status Implementations ---
 
 void ThreadStatus::toJson(detail::JsonWriter& writer) const {
@@ -642,6 +803,8 @@ void ReactorStatus::toJson(detail::JsonWriter& writer) const {
   writer.writeField("protocol_queue_dropped", protocol_queue_dropped);
   writer.writeField("bus_queue_dropped", bus_queue_dropped);
   writer.writeField("max_loop_cycle_us", max_loop_cycle_us);
+  writer.writeField("decoded_telegrams", decoded_telegrams);
+  writer.writeField("undecoded_telegrams", undecoded_telegrams);
 }
 
 void BusStatus::toJson(detail::JsonWriter& writer) const {
@@ -663,6 +826,14 @@ void SchedulerStatus::toJson(detail::JsonWriter& writer) const {
   writer.writeField("queue", queue);
 }
 
+void BridgeLatencyValues::toJson(detail::JsonWriter& writer) const {
+  auto scope = writer.objectScope();
+  writer.writeField("receive_to_write", receive_to_write);
+  writer.writeField("write_to_echo", write_to_echo);
+  writer.writeField("echo_to_send", echo_to_send);
+  writer.writeField("total", total);
+}
+
 void ClientInfo::toJson(detail::JsonWriter& writer) const {
   auto scope = writer.objectScope();
   writer.writeField("fd", fd);
@@ -670,6 +841,19 @@ void ClientInfo::toJson(detail::JsonWriter& writer) const {
   writer.writeField("connected", connected);
   writer.writeField("write_capable", write_capable);
   writer.writeField("outbound_buffer_usage", outbound_buffer_usage);
+  writer.writeField("slow_policy", slow_policy);
+  writer.writeField("lag_bytes", lag_bytes);
+  writer.writeField("dropped_bytes", dropped_bytes);
+  writer.writeField("overflows", overflows);
+  writer.writeField("send_calls", send_calls);
+  writer.writeField("bytes_sent", bytes_sent);
+  writer.writeField("sends_per_second", sends_per_second);
+  writer.writeField("bytes_per_send", bytes_per_send);
+  writer.writeField("sessions", sessions);
+  writer.writeField("session_wait_avg_ms", session_wait_avg_ms);
+  writer.writeField("session_wait_max_ms", session_wait_max_ms);
+  writer.writeField("session_share", session_share);
+  if (write_capable) writer.writeField("latency", latency);
 }
 
 void ClientManagerStatus::toJson(detail::JsonWriter& writer) const {
@@ -678,6 +862,17 @@ void ClientManagerStatus::toJson(detail::JsonWriter& writer) const {
   writer.writeField("session_active", session_active);
   writer.writeField("session_state", session_state);
   writer.writeField("last_error", last_error);
+  writer.writeField("io_backend", io_backend);
+  writer.writeField("client_capacity", client_capacity);
+  writer.writeField("rejected_clients", rejected_clients);
+  writer.writeField("io_events", io_events);
+  writer.writeField("io_iteration", io_iteration);
+  writer.writeField("accept_latency", accept_latency);
+  writer.writeField("local_sessions", local_sessions);
+  writer.writeField("local_session_wait_avg_ms", local_session_wait_avg_ms);
+  writer.writeField("local_session_wait_max_ms", local_session_wait_max_ms);
+  writer.writeField("local_session_share", local_session_share);
+  writer.writeField("bridge_latency", bridge_latency);
 
   {
     auto arrayScope = writer.arrayScope("clients");
@@ -692,6 +887,8 @@ void DeviceManagerStatus::toJson(detail::JsonWriter& writer) const {
   writer.writeField("identified_count", identified_count);
   writer.writeField("device_capacity", device_capacity);
   writer.writeField("unknown_count", unknown_count);
+  writer.writeField("restored_count", restored_count);
+  writer.writeField("memory_usage", memory_usage);
 }
 
 void DeviceScannerStatus::toJson(detail::JsonWriter& writer) const {
@@ -714,6 +911,32 @@ void PollManagerStatus::toJson(detail::JsonWriter& writer) const {
   writer.writeField("poll_capacity", poll_capacity);
 }
 
+void SubscriptionStatus::toJson(detail::JsonWriter& writer) const {
+  auto scope = writer.objectScope();
+  writer.writeField("count", count);
+  writer.writeField("capacity", capacity);
+  writer.writeField("matches", matches);
+  writer.writeField("reports", reports);
+  writer.writeField("history_samples", history_samples);
+  writer.writeField("history_bytes", history_bytes);
+  writer.writeField("history_capacity", history_capacity);
+  writer.writeField("history_evictions", history_evictions);
+}
+
+void IdlePredictorStatus::toJson(detail::JsonWriter& writer) const {
+  auto scope = writer.objectScope();
+  writer.writeField("enabled", enabled);
+  writer.writeField("sources", sources);
+  writer.writeField("periodic_sources", periodic_sources);
+  writer.writeField("deferrals", deferrals);
+  writer.writeField("forced", forced);
+  writer.writeField("quiet_won", quiet_won);
+  writer.writeField("quiet_lost", quiet_lost);
+  writer.writeField("other_won", other_won);
+  writer.writeField("other_lost", other_lost);
+  writer.writeField("loss_reduction_percent", loss_reduction_percent);
+}
+
 void SystemResources::toJson(detail::JsonWriter& writer) const {
   auto scope = writer.objectScope();
   writer.writeField("last_update_timestamp_ms", last_update_timestamp_ms);
@@ -740,6 +963,8 @@ void ServiceStatus::toJson(detail::JsonWriter& writer) const {
   writer.writeField("device_manager", device_manager);
   writer.writeField("device_scanner", device_scanner);
   writer.writeField("poll_manager", poll_manager);
+  writer.writeField("subscriptions", subscriptions);
+  writer.writeField("idle_predictor", idle_predictor);
 }
 
 void serializeServiceStatus(const JsonChunkVisitor& visitor,
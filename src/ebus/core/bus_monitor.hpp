@@ -6,12 +6,14 @@
 #pragma once
 
 #include <array>
+#include <ebus/callbacks.hpp>
 #include <ebus/detail/protocol_limits.hpp>
 #include <ebus/metrics.hpp>
 #include <functional>
 
 #include "platform/mutex.hpp"
 #include "utils/circular_buffer.hpp"
+#include "utils/snapshot_buffer.hpp"
 #include "utils/timing_stats.hpp"
 
 namespace ebus::detail {
@@ -40,6 +42,12 @@ class BusMonitor {
   // Working Methods
   void resetMetrics();
 
+  /**
+   * @brief Clears the latency histograms of all timing stats so percentiles
+   * reflect only samples recorded from now on.
+   */
+  void resetLatencyWindow();
+
   // Thread-safe update helpers
   template <typename F>
   void updateHandler(F&& updater) {
@@ -110,8 +118,22 @@ class BusMonitor {
   void recordIsrStartBitError();
   void recordIsrSynPostponed(uint32_t count);
 
+  /**
+   * @brief Adds the latency breakdown of a finished Scheduler session to the
+   * statistics of its priority band.
+   */
+  void recordSession(const SessionTimings& timings);
+
   void updateUtilizationHistory();
 
+  /**
+   * @brief Publishes the current metrics as a new immutable snapshot. Called
+   * periodically by the reactor; the metrics lock is held only while the
+   * snapshot is filled.
+   * @return false if no slot was free (a reader still holds older ones).
+   */
+  bool publishSnapshot();
+
   void logPassiveReset();
   void logActiveReset();
   void clearHistory();
@@ -122,6 +144,16 @@ class BusMonitor {
   // Status/Telemetry
   float getBusUtilization() const;
   void fetchMetrics(const std::function<void(const Metrics&)>& callback) const;
+
+  /**
+   * @brief Invokes the callback with the latest published snapshot without
+   * taking the metrics lock.
+   * @return false if no snapshot has been published yet.
+   */
+  bool fetchSnapshot(
+      const std::function<void(const MetricsSnapshot&)>& callback) const;
+  uint64_t snapshotGeneration() const;
+  uint32_t skippedSnapshots() const;
   void fetchUtilizationHistory(
       const std::function<void(float)>& callback) const;
 #ifndef EBUS_MINIMAL_DIAGNOSTICS
@@ -158,6 +190,25 @@ class BusMonitor {
   metrics::DeviceMetrics device_acc_;
   metrics::ReactorMetrics reactor_acc_;
 
+  SnapshotBuffer<Metrics, DiagnosticsLimits::metrics_snapshot_slots>
+      snapshots_;
+
+  void collectMetrics(Metrics& sm) const;
+
+#if EBUS_SESSION_STATS
+  struct SessionStats {
+    TimingStats queue_wait;
+    TimingStats bus_wait;
+    TimingStats transfer;
+    TimingStats dispatch;
+    TimingStats total;
+
+    void reset();
+    void resetWindow();
+  };
+  std::array<SessionStats, SessionLimits::stats_classes> session_stats_;
+#endif
+
 #ifndef EBUS_MINIMAL_DIAGNOSTICS
   uint64_t last_history_low_bits_ = 0;
   uint64_t last_history_uptime_us_ = 0;
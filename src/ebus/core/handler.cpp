@@ -5,12 +5,15 @@
 
 #include "core/handler.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <ebus/detail/protocol_limits.hpp>
 #include <ebus/utils.hpp>
 #include <utility>
 
 #include "core/bus_monitor.hpp"
 #include "core/request.hpp"
+#include "utils/tracer.hpp"
 
 namespace ebus::detail {
 
@@ -138,6 +141,7 @@ bool Handler::sendActiveMessage(ByteView message) {
   active_telegram_.createMaster(source_address_, message);
   if (active_telegram_.getMasterState() == SequenceState::seq_ok) {
     active_message_ = true;
+    active_timings_ = {};
     // Proactively request the bus if it's currently idle. This ensures that
     // the low-level physical layer (ISR or Simulation reader) sees the
     // intent before the next SYN arrives on the wire.
@@ -152,6 +156,12 @@ bool Handler::sendActiveMessage(ByteView message) {
 
 void Handler::run(const BusEventInfo& info) {
   last_result_ = info.result;
+  const auto gap = std::chrono::duration_cast<std::chrono::microseconds>(
+                       info.timestamp - last_point_)
+                       .count();
+  byte_gap_us_ = static_cast<uint16_t>(std::clamp<int64_t>(gap, 0, 0xffff));
+  byte_after_syn_ = measure_sync_;
+
   // record timing
   if (info.byte != Symbols::syn) {
     if (active_message_) {
@@ -254,6 +264,9 @@ void Handler::passiveReceiveMaster(uint8_t byte) {
 
     passive_master_.push_back(byte);
 
+    if (passive_master_.size() == 1 && byte_after_syn_)
+      passive_telegram_timings_.first_byte_us = byte_gap_us_;
+
     if (passive_master_.size() == 5) passive_master_dbx_ = passive_master_[4];
 
     // AA >> A9 + 01 || A9 >> A9 + 00
@@ -337,7 +350,10 @@ void Handler::passiveReceiveMaster(uint8_t byte) {
     checkActiveBuffers();
 
     // Initiate request bus
-    if (active_message_ && request_) request_->requestBus(source_address_);
+    if (active_message_ && request_ &&
+        request_->requestBus(source_address_) &&
+        active_timings_.bus_request_us == 0)
+      active_timings_.bus_request_us = SessionTimings::toMicros(last_point_);
   }
 }
 
@@ -357,6 +373,7 @@ void Handler::passiveReceiveMasterAcknowledge(uint8_t byte) {
       transitionTo(HandlerState::passive_receive_slave);
     }
   } else if (byte != Symbols::syn && !passive_master_repeated_) {
+    if (byte == Symbols::nak) passive_telegram_timings_.naks++;
     passive_master_repeated_ = true;
     passive_telegram_.clear();
     passive_master_.clear();
@@ -381,6 +398,8 @@ void Handler::passiveReceiveSlave(uint8_t byte) {
       callPassiveReset();
       return;
     }
+    if (passive_telegram_timings_.response_us == 0)
+      passive_telegram_timings_.response_us = byte_gap_us_;
   }
 
   passive_slave_.push_back(byte);
@@ -417,6 +436,7 @@ void Handler::passiveReceiveSlaveAcknowledge(uint8_t byte) {
     callPassiveReset();
     transitionTo(HandlerState::passive_receive_master);
   } else if (byte == Symbols::nak && !passive_slave_repeated_) {
+    passive_telegram_timings_.naks++;
     passive_slave_repeated_ = true;
     passive_slave_.clear();
     passive_slave_dbx_ = 0;
@@ -514,6 +534,7 @@ void Handler::reactiveReceiveSlaveAcknowledge(uint8_t byte) {
 
 void Handler::requestBus(uint8_t byte) {
   auto won = [&]() {
+    active_timings_.won_us = SessionTimings::toMicros(last_point_);
     active_master_ = active_telegram_.getMaster();
     active_master_.push_back(active_telegram_.getMasterCRC(), false);
     active_master_.extend();
@@ -535,6 +556,7 @@ void Handler::requestBus(uint8_t byte) {
   auto lost = [&]() {
     callOnBusRequestLost();
     passive_master_.push_back(byte);
+    passive_telegram_timings_.first_byte_us = byte_gap_us_;
     active_message_ = false;
     active_telegram_.clear();  // Clear active message state
     active_master_.clear();
@@ -636,6 +658,7 @@ void Handler::activeSendMaster(uint8_t byte) {
 
 void Handler::activeReceiveMasterAcknowledge(uint8_t byte) {
   if (byte == Symbols::ack) {
+    active_timings_.master_ack_us = SessionTimings::toMicros(last_point_);
     if (active_telegram_.getType() == TelegramType::master_master) {
       callOnTelegram(MessageType::active, TelegramType::master_master,
                      {active_master_.data(), active_master_.size()},
@@ -651,6 +674,7 @@ void Handler::activeReceiveMasterAcknowledge(uint8_t byte) {
   } else if (byte == Symbols::nak &&
              !active_master_repeated_) {  // Negative ACK, retry master
                                           // message
+    active_telegram_timings_.naks++;
     active_master_repeated_ = true;
     active_master_index_ = 0;
     callWrite(active_master_[active_master_index_]);
@@ -669,6 +693,8 @@ void Handler::activeReceiveMasterAcknowledge(uint8_t byte) {
 
 void Handler::activeReceiveSlave(uint8_t byte) {
   if (active_slave_.empty()) {
+    if (active_telegram_timings_.response_us == 0)
+      active_telegram_timings_.response_us = byte_gap_us_;
     // Plausibility: Slave NN must be 0-16
     if (byte > SequenceLimits::max_data_bytes) {
       if (monitor_) monitor_->updateHandler([](auto& m) { m.invalid_bytes++; });
@@ -728,6 +754,7 @@ void Handler::activeSendSlavePositiveAcknowledge(
 void Handler::activeSendSlaveNegativeAcknowledge(
     [[maybe_unused]] uint8_t byte) {
   if (!active_slave_repeated_) {
+    active_telegram_timings_.naks++;
     active_slave_repeated_ = true;
     transitionTo(HandlerState::active_receive_slave);
   } else {
@@ -764,6 +791,7 @@ void Handler::transitionTo(HandlerState next) {
   }
 
   state_ = next;
+  EBUS_TRACE_INSTANT(ebus::toString(next));
   if (monitor_) {
     monitor_->logHandlerTransition(old_state, next);
   }
@@ -831,6 +859,7 @@ void Handler::callPassiveReset() {
   passive_slave_dbx_ = 0;
   passive_slave_index_ = 0;
   passive_slave_repeated_ = false;
+  passive_telegram_timings_ = {};
 }
 
 void Handler::callActiveReset() {
@@ -844,6 +873,7 @@ void Handler::callActiveReset() {
   active_slave_.clear();
   active_slave_dbx_ = 0;
   active_slave_repeated_ = false;
+  active_telegram_timings_ = {};
 }
 
 void Handler::callWrite(uint8_t byte) { pending_write_ = byte; }
@@ -902,6 +932,13 @@ void Handler::callOnTelegram(MessageType message_type,
     info.request_state = request_->getState();
     info.master_view = master_view;
     info.slave_view = slave_view;
+    if (message_type == MessageType::active) {
+      active_timings_.response_us = SessionTimings::toMicros(last_point_);
+      info.timings = &active_timings_;
+      info.telegram_timings = active_telegram_timings_;
+    } else {
+      info.telegram_timings = passive_telegram_timings_;
+    }
     protocol_callback_(info);
   }
 }
@@ -925,6 +962,13 @@ void Handler::callOnError(LogLevel level, ProtocolError protocol_error,
     info.request_state = request_->getState();
     info.master_view = master_view;
     info.slave_view = slave_view;
+    if (state_ >= HandlerState::request_bus &&
+        state_ <= HandlerState::active_send_slave_negative_acknowledge) {
+      info.timings = &active_timings_;
+      info.telegram_timings = active_telegram_timings_;
+    } else {
+      info.telegram_timings = passive_telegram_timings_;
+    }
     protocol_callback_(info);
   }
 }
@@ -71,6 +71,10 @@ class Handler {
   Clock::time_point last_point_;
   bool measure_sync_ = false;
 
+  // Gap to the previous byte and whether it was a SYN, for TelegramTimings
+  uint16_t byte_gap_us_ = 0;
+  bool byte_after_syn_ = false;
+
   // passive
   Telegram passive_telegram_;
 
@@ -82,10 +86,12 @@ class Handler {
   size_t passive_slave_dbx_ = 0;
   size_t passive_slave_index_ = 0;
   bool passive_slave_repeated_ = false;
+  TelegramTimings passive_telegram_timings_;
 
   // active
   bool active_message_ = false;
   Telegram active_telegram_;
+  SessionTimings active_timings_;  // bus-side milestones of the attempt
 
   Sequence active_master_;
   size_t active_master_index_ = 0;
@@ -94,6 +100,7 @@ class Handler {
   Sequence active_slave_;
   size_t active_slave_dbx_ = 0;
   bool active_slave_repeated_ = false;
+  TelegramTimings active_telegram_timings_;
 
   void passiveReceiveMaster(uint8_t byte);
   void passiveReceiveMasterAcknowledge(uint8_t byte);
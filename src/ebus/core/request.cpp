@@ -9,6 +9,7 @@
 #include <ebus/utils.hpp>
 
 #include "core/bus_monitor.hpp"
+#include "utils/tracer.hpp"
 
 namespace ebus::detail {
 
@@ -99,6 +100,7 @@ void Request::startBit() {
 }
 
 ebus::RequestResult Request::run(uint8_t byte) {
+  EBUS_TRACE_SCOPE("request.run");
   size_t idx = static_cast<size_t>(state_);
   if (idx < FsmLimits::num_request_states && state_requests[idx])
     (this->*state_requests[idx])(byte);
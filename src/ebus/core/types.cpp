@@ -222,11 +222,26 @@ const char* toString(ClientType type) noexcept {
       return "regular";
     case ClientType::enhanced:
       return "enhanced";
+    case ClientType::filtered:
+      return "filtered";
     default:
       return "unknown type";
   }
 }
 
+const char* toString(SlowClientPolicy policy) noexcept {
+  switch (policy) {
+    case SlowClientPolicy::drop_oldest:
+      return "drop_oldest";
+    case SlowClientPolicy::skip_to_syn:
+      return "skip_to_syn";
+    case SlowClientPolicy::disconnect:
+      return "disconnect";
+    default:
+      return "unknown policy";
+  }
+}
+
 const char* toString(SessionState state) noexcept {
   switch (state) {
     case SessionState::idle:
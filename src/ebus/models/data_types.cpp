@@ -110,7 +110,7 @@ struct JsonValueVisitor {
 
   void operator()(std::monostate) const { writer.write("null"); }
 
-  void operator()(const std::string& s) const {
+  void operator()(const DataString& s) const {
     writer.write("\"");
     writer.writeEscaped(s);
     writer.write("\"");
@@ -236,6 +236,101 @@ bool validateRange(int64_t val, uint8_t size, bool is_signed) {
   }
 }
 
+/**
+ * Column loop for the common 1 and 2 byte types. The type properties are
+ * template parameters, the scale comes from the meta table and is hoisted
+ * out of the loop; the arithmetic matches decode() step by step.
+ */
+template <typename Raw, bool IsSigned, bool IsBcd>
+size_t decodeColumnKernel(const Meta& m, const ByteView* payloads,
+                          size_t count, const Column& column) {
+  using Signed = std::make_signed_t<Raw>;
+  const bool flip =
+      m.reversed ? (column.endian == Endian::little)
+                 : (column.endian == Endian::big);
+  const bool scaled = m.scale.num != 1 || m.scale.den != 1;
+  const int64_t num = m.scale.num;
+  const int64_t den = m.scale.den;
+  const Raw replacement = static_cast<Raw>(m.replacement_value);
+  const size_t end = column.offset + sizeof(Raw);
+
+  size_t valid = 0;
+  for (size_t i = 0; i < count; ++i) {
+    bool null = payloads[i].size() < end;
+    int64_t value = 0;
+    if (!null) {
+      const uint8_t* data = payloads[i].data() + column.offset;
+      Raw bits = data[0];
+      if constexpr (sizeof(Raw) == 2) {
+        bits = flip ? static_cast<Raw>((data[0] << 8) | data[1])
+                    : static_cast<Raw>((data[1] << 8) | data[0]);
+      }
+      null = m.has_replacement && bits == replacement;
+      if constexpr (IsBcd) null = null || (bits & 0x0f) > 9 || (bits >> 4) > 9;
+
+      if (!null) {
+        if constexpr (IsBcd) {
+          value = (bits >> 4) * 10 + (bits & 0x0f);
+        } else {
+          const int64_t raw = IsSigned
+                                  ? static_cast<int64_t>(
+                                        static_cast<Signed>(bits))
+                                  : static_cast<int64_t>(bits);
+          value = scaled ? raw * num *
+                               detail::FixedPointLimits::fixed_point_scale /
+                               den
+                         : raw;
+        }
+      }
+    }
+
+    if (column.ints) column.ints[i] = value;
+    if (column.reals) {
+      column.reals[i] =
+          scaled ? static_cast<float>(value) /
+                       detail::FixedPointLimits::fixed_point_scale
+                 : static_cast<float>(value);
+    }
+    if (null) {
+      if (column.nulls) column.nulls[i / 8] |= static_cast<uint8_t>(1 << i % 8);
+    } else {
+      valid++;
+    }
+  }
+  return valid;
+}
+
+// Row by row through decode() for the remaining numeric types
+size_t decodeColumnScalar(const ByteView* payloads, size_t count,
+                          const Column& column) {
+  size_t valid = 0;
+  for (size_t i = 0; i < count; ++i) {
+    const ByteView& payload = payloads[i];
+    std::optional<DataValue> value;
+    if (payload.size() > column.offset) {
+      value = decode(column.type,
+                     {payload.data() + column.offset,
+                      payload.size() - column.offset},
+                     column.endian);
+    }
+
+    if (!value || isNull(*value)) {
+      if (column.ints) column.ints[i] = 0;
+      if (column.reals) column.reals[i] = 0.0f;
+      if (column.nulls) column.nulls[i / 8] |= static_cast<uint8_t>(1 << i % 8);
+      continue;
+    }
+    if (column.ints) {
+      column.ints[i] = std::holds_alternative<int64_t>(*value)
+                           ? std::get<int64_t>(*value)
+                           : asInt64(*value);
+    }
+    if (column.reals) column.reals[i] = asFloat(*value);
+    valid++;
+  }
+  return valid;
+}
+
 }  // namespace
 
 /* --- Core Operations --- */
@@ -247,7 +342,8 @@ std::optional<DataValue> decode(DataType dt, ByteView data, Endian e) {
   const bool flip = m->reversed ? (e == Endian::little) : (e == Endian::big);
 
   if (!m->is_numeric)
-    return std::string(reinterpret_cast<const char*>(data.data()), m->size);
+    return DataString(
+        std::string_view(reinterpret_cast<const char*>(data.data()), m->size));
 
   // Check for Replacement Values (Sentinels)
   uint32_t bit_pattern = 0;
@@ -315,6 +411,50 @@ std::optional<DataValue> decode(DataType dt, ByteView data, Endian e) {
                       : DataValue(static_cast<uint32_t>(raw_val));
 }
 
+size_t decodeColumn(const ByteView* payloads, size_t count,
+                    const Column& column) {
+  if (column.nulls) std::memset(column.nulls, 0, (count + 7) / 8);
+
+  const Meta* m = metaFor(column.type);
+  if (!m || !m->is_numeric) {
+    for (size_t i = 0; i < count; ++i) {
+      if (column.ints) column.ints[i] = 0;
+      if (column.reals) column.reals[i] = 0.0f;
+    }
+    if (column.nulls) std::memset(column.nulls, 0xff, (count + 7) / 8);
+    return 0;
+  }
+
+  switch (column.type) {
+    case DataType::bcd:
+      return decodeColumnKernel<uint8_t, false, true>(*m, payloads, count,
+                                                      column);
+    case DataType::data1c:
+      return decodeColumnKernel<uint8_t, false, false>(*m, payloads, count,
+                                                       column);
+    case DataType::uint16:
+    case DataType::uint16r:
+      return decodeColumnKernel<uint16_t, false, false>(*m, payloads, count,
+                                                        column);
+    case DataType::int16:
+    case DataType::int16r:
+    case DataType::data2b:
+    case DataType::data2br:
+    case DataType::data2c:
+    case DataType::data2cr:
+      return decodeColumnKernel<uint16_t, true, false>(*m, payloads, count,
+                                                       column);
+    default:
+      return decodeColumnScalar(payloads, count, column);
+  }
+}
+
+void decodeColumns(const ByteView* payloads, size_t count,
+                   const Column* columns, size_t column_count) {
+  for (size_t c = 0; c < column_count; ++c)
+    decodeColumn(payloads, count, columns[c]);
+}
+
 bool isValid(DataType dt, ByteView data) noexcept {
   const Meta* m = metaFor(dt);
   if (!m || data.size() < m->size) return false;
@@ -361,7 +501,7 @@ Sequence encode(DataType dt, const DataValue& value, Endian e) {
 
   // Handle Strings
   if (!m->is_numeric) {
-    if (auto* str = std::get_if<std::string>(&value)) {
+    if (auto* str = std::get_if<DataString>(&value)) {
       s.assign(ByteView(reinterpret_cast<const uint8_t*>(str->data()),
                         std::min(str->size(), static_cast<size_t>(m->size))),
                false);
@@ -464,7 +604,7 @@ int64_t asInt64(const DataValue& value) noexcept {
         if constexpr (std::is_integral_v<T>) return static_cast<int64_t>(arg);
         if constexpr (std::is_floating_point_v<T>)
           return static_cast<int64_t>(std::round(arg));
-        if constexpr (std::is_same_v<T, std::string>) {
+        if constexpr (std::is_same_v<T, DataString>) {
           if (arg.empty()) return 0;
           std::string_view sv = arg;
           int base = 10;
@@ -488,12 +628,9 @@ int64_t asInt64(const DataValue& value) noexcept {
       value);
 }
 
-std::string const& asString(const DataValue& value) noexcept {
-  static const std::string empty;
-  if (const std::string* s = std::get_if<std::string>(&value)) {
-    return *s;
-  }
-  return empty;
+std::string_view asString(const DataValue& value) noexcept {
+  if (const DataString* s = std::get_if<DataString>(&value)) return *s;
+  return {};
 }
 
 // New struct for the visitor
@@ -501,7 +638,9 @@ struct ToStringValueVisitor {
   std::string& out;
 
   void operator()(std::monostate) const { out += "null"; }
-  void operator()(const std::string& s) const { out += s; }
+  void operator()(const DataString& s) const {
+    out.append(s.data(), s.size());
+  }
 
   void operator()(int64_t val) const {
     char buffer[64];
@@ -543,7 +682,7 @@ void toString(std::string& out, const DataValue& value, std::string_view unit) {
 }
 
 void toHexString(std::string& out, const DataValue& value, char separator) {
-  if (const std::string* s = std::get_if<std::string>(&value)) {
+  if (const DataString* s = std::get_if<DataString>(&value)) {
     if (s->empty()) return;
     for (size_t i = 0; i < s->size(); ++i) {
       if (i > 0 && i % 2 == 0 && separator != 0) out += separator;
@@ -585,7 +724,7 @@ DataType getDataType(const DataValue& value) noexcept {
           return DataType::error;  // Cannot infer specific scaled type from
                                    // generic int64_t
         if constexpr (std::is_floating_point_v<T>) return DataType::float4;
-        if constexpr (std::is_same_v<T, std::string>) return DataType::char8;
+        if constexpr (std::is_same_v<T, DataString>) return DataType::char8;
         return DataType::error;
       },
       value);
@@ -27,6 +27,48 @@ static constexpr std::array<uint8_t, 4> vec_b5090125 = {0xb5, 0x09, 0x01, 0x25};
 static constexpr std::array<uint8_t, 4> vec_b5090126 = {0xb5, 0x09, 0x01, 0x26};
 static constexpr std::array<uint8_t, 4> vec_b5090127 = {0xb5, 0x09, 0x01, 0x27};
 
+void DeviceStats::recordTelegram(size_t bytes,
+                                 const TelegramTimings& timings,
+                                 uint64_t timestamp) {
+  telegrams_++;
+  bytes_ += static_cast<uint32_t>(bytes);
+  naks_ += timings.naks;
+  if (timestamp > last_seen_) last_seen_ = timestamp;
+}
+
+void DeviceStats::recordResponse(uint16_t response_us) {
+  response_sum_ += response_us;
+  response_count_++;
+
+  response_histogram_.record(response_us);
+}
+
+void DeviceStats::recordFirstByte(uint16_t first_byte_us) {
+  first_byte_sum_ += first_byte_us;
+  first_byte_count_++;
+}
+
+void DeviceStats::recordError(uint8_t naks) {
+  errors_++;
+  naks_ += naks;
+}
+
+void DeviceStats::fill(DeviceInfo::Traffic& traffic) const {
+  traffic.telegrams = telegrams_;
+  traffic.bytes = bytes_;
+  traffic.errors = errors_;
+  traffic.naks = naks_;
+  traffic.last_seen = last_seen_;
+  if (response_count_ > 0) {
+    traffic.response_mean_us =
+        static_cast<uint32_t>(response_sum_ / response_count_);
+    traffic.response_p99_us = response_histogram_.valueAtPercentile(99.0f);
+  }
+  if (first_byte_count_ > 0)
+    traffic.first_byte_mean_us =
+        static_cast<uint32_t>(first_byte_sum_ / first_byte_count_);
+}
+
 ebus::Sequence Device::createScanCommand(uint8_t slave) {
   Sequence sequence;
   sequence.push_back(slave, false);
@@ -35,29 +77,71 @@ ebus::Sequence Device::createScanCommand(uint8_t slave) {
   return sequence;
 }
 
-void Device::update(uint8_t slave_addr, ByteView master_view,
+bool Device::update(uint8_t slave_addr, ByteView master_view,
                     ByteView slave_view) {
   slave_ = slave_addr;
   message_count_++;
+  restored_ = false;
 
   if (slave_view.empty()) {
     // If no slave view, we can't identify the device further.
-    return;
+    return false;
   }
 
+  ModelSequence* target = nullptr;
   if (ebus::matches(master_view, vec_070400, 2))
-    vec_070400_.assign(slave_view);
+    target = &vec_070400_;
   else if (ebus::matches(master_view, vec_b5090124, 2))
-    vec_b5090124_.assign(slave_view);
+    target = &vec_b5090124_;
   else if (ebus::matches(master_view, vec_b5090125, 2))
-    vec_b5090125_.assign(slave_view);
+    target = &vec_b5090125_;
   else if (ebus::matches(master_view, vec_b5090126, 2))
-    vec_b5090126_.assign(slave_view);
+    target = &vec_b5090126_;
   else if (ebus::matches(master_view, vec_b5090127, 2))
-    vec_b5090127_.assign(slave_view);
+    target = &vec_b5090127_;
+  if (!target) return false;
+
+  const bool changed = ByteView(*target) != slave_view;
+  target->assign(slave_view);
 
   // Mark as identified if 07 04 data is present.
   if (!vec_070400_.empty()) identified_ = true;
+  return changed;
+}
+
+void Device::writeSnapshot(std::vector<uint8_t>& out) const {
+  out.push_back(slave_);
+  for (int i = 0; i < 4; ++i)
+    out.push_back(static_cast<uint8_t>(message_count_ >> (8 * i)));
+
+  for (const ModelSequence* seq : {&vec_070400_, &vec_b5090124_,
+                                   &vec_b5090125_, &vec_b5090126_,
+                                   &vec_b5090127_}) {
+    out.push_back(static_cast<uint8_t>(seq->size()));
+    for (size_t i = 0; i < seq->size(); ++i) out.push_back((*seq)[i]);
+  }
+}
+
+bool Device::readSnapshot(ByteView& in) {
+  if (in.size() < 5) return false;
+  slave_ = in[0];
+  message_count_ = 0;
+  for (int i = 0; i < 4; ++i)
+    message_count_ |= static_cast<uint32_t>(in[1 + i]) << (8 * i);
+  in = ByteView(in.data() + 5, in.size() - 5);
+
+  for (ModelSequence* seq : {&vec_070400_, &vec_b5090124_, &vec_b5090125_,
+                             &vec_b5090126_, &vec_b5090127_}) {
+    if (in.empty() || in[0] > SequenceLimits::model_capacity ||
+        in.size() < 1u + in[0])
+      return false;
+    seq->assign(ByteView(in.data() + 1, in[0]));
+    in = ByteView(in.data() + 1 + in[0], in.size() - 1 - in[0]);
+  }
+
+  identified_ = !vec_070400_.empty();
+  restored_ = true;
+  return true;
 }
 
 bool Device::getNextPendingVendorCommand(uint16_t& cursor,
@@ -107,6 +191,8 @@ ebus::DeviceInfo Device::getDevice() const {
   DeviceInfo info;
   info.slave_address = slave_;
   info.frequency = message_count_;
+  info.restored = restored_;
+  stats_.fill(info.traffic);
 
   if (vec_070400_.size() >= 11) {
     info.manufacturer = vec_070400_[1];
@@ -192,6 +278,19 @@ void DeviceInfo::toJson(detail::JsonWriter& writer) const {
   }
 
   writer.writeField("frequency", frequency);
+  writer.writeField("restored", restored);
+
+  {
+    auto tScope = writer.objectScope("traffic");
+    writer.writeField("telegrams", traffic.telegrams);
+    writer.writeField("bytes", traffic.bytes);
+    writer.writeField("errors", traffic.errors);
+    writer.writeField("naks", traffic.naks);
+    writer.writeField("response_mean_us", traffic.response_mean_us);
+    writer.writeField("response_p99_us", traffic.response_p99_us);
+    writer.writeField("first_byte_mean_us", traffic.first_byte_mean_us);
+    writer.writeTimestampField("last_seen", traffic.last_seen);
+  }
 }
 
 static constexpr const char* manufacturer_table[256] = {
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <cstdint>
+#include <ebus/callbacks.hpp>
 #include <ebus/detail/delegate.hpp>
 #include <ebus/device.hpp>
 #include <ebus/sequence.hpp>
@@ -13,8 +14,43 @@
 #include <string>
 #include <vector>
 
+#include "utils/latency_histogram.hpp"
+
 namespace ebus::detail {
 
+/**
+ * Traffic and health counters of a device. Every record method is O(1); the
+ * response latency percentile is read from a LatencyHistogramImpl with four
+ * sub-buckets per power of two over 0..65535 us, whose 16 bit counters are
+ * halved together when one saturates, so it favours recent traffic.
+ */
+class DeviceStats {
+ public:
+  void recordTelegram(size_t bytes, const TelegramTimings& timings,
+                      uint64_t timestamp);
+  void recordResponse(uint16_t response_us);
+  void recordFirstByte(uint16_t first_byte_us);
+  void recordError(uint8_t naks);
+
+  void fill(DeviceInfo::Traffic& traffic) const;
+
+  using ResponseHistogram = LatencyHistogramImpl<uint16_t, 2, 16>;
+
+ private:
+  uint32_t telegrams_ = 0;
+  uint32_t bytes_ = 0;
+  uint32_t errors_ = 0;
+  uint32_t naks_ = 0;
+  uint64_t last_seen_ = 0;
+
+  uint64_t response_sum_ = 0;
+  uint32_t response_count_ = 0;
+  uint64_t first_byte_sum_ = 0;
+  uint32_t first_byte_count_ = 0;
+
+  ResponseHistogram response_histogram_;
+};
+
 /**
  * Represents a device on the eBUS, identified by its slave address and
  * identification data. Provides methods to update its data.  Also provides
@@ -27,24 +63,37 @@ class Device {
   static Sequence createScanCommand(uint8_t slave);
 
   // Working Methods
-  void update(uint8_t slave_addr, ByteView master_view, ByteView slave_view);
+  // Returns true if identification or vendor data changed
+  bool update(uint8_t slave_addr, ByteView master_view, ByteView slave_view);
   bool getNextPendingVendorCommand(uint16_t& cursor, Sequence& out_cmd) const;
   bool getFirstPendingVendorCommand(Sequence& out_cmd) const;
 
+  // Snapshot record: slave u8 | frequency u32 LE | five times length u8 +
+  // bytes (07 04, B5 09 24..27 responses)
+  void writeSnapshot(std::vector<uint8_t>& out) const;
+  // Restores a record and advances in past it; marks the device as restored
+  bool readSnapshot(ByteView& in);
+
   // Status/Telemetry
   bool isIdentified() const { return identified_; }
+  // Loaded from a snapshot and not observed on the bus since
+  bool isRestored() const { return restored_; }
   uint8_t getSlave() const;
   std::vector<uint8_t> getIdentificationData() const;
   std::vector<uint8_t> getVendorData(uint8_t sub) const;
   DeviceInfo getDevice() const;
 
+  DeviceStats& stats() { return stats_; }
+
  private:
   // Internal types
   using ModelSequence = SequenceImpl<detail::SequenceLimits::model_capacity>;
 
   uint8_t slave_ = 0;
   bool identified_ = false;  // True if 07 04 has been successfully received
+  bool restored_ = false;
   uint32_t message_count_ = 0;
+  DeviceStats stats_;
 
   ModelSequence vec_070400_;
 
@@ -0,0 +1,500 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "ebus/message_database.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <optional>
+#include <utility>
+
+#include "ebus/detail/json_reader.hpp"
+#include "ebus/utils.hpp"
+
+namespace ebus {
+
+namespace {
+
+using detail::MessageDatabaseLimits::field_columns;
+using detail::MessageDatabaseLimits::max_id_bytes;
+using detail::MessageDatabaseLimits::message_columns;
+
+// ebusd base type names and their library counterparts
+struct TypeAlias {
+  const char* name;
+  DataType dt;
+};
+
+constexpr TypeAlias type_aliases[] = {
+    {"BCD", DataType::bcd},      {"D1B", DataType::data1b},
+    {"D1C", DataType::data1c},   {"D2B", DataType::data2b},
+    {"D2C", DataType::data2c},   {"EXP", DataType::float4},
+    {"EXR", DataType::float4r},  {"SCH", DataType::int8},
+    {"SIN", DataType::int16},    {"SIR", DataType::int16r},
+    {"SLG", DataType::int32},    {"SLR", DataType::int32r},
+    {"UCH", DataType::uint8},    {"UIN", DataType::uint16},
+    {"UIR", DataType::uint16r},  {"ULG", DataType::uint32},
+    {"ULR", DataType::uint32r},
+};
+
+constexpr DataType hex_types[] = {DataType::hex1, DataType::hex2,
+                                  DataType::hex3, DataType::hex4,
+                                  DataType::hex5, DataType::hex6,
+                                  DataType::hex7, DataType::hex8};
+
+constexpr DataType char_types[] = {DataType::char1, DataType::char2,
+                                   DataType::char3, DataType::char4,
+                                   DataType::char5, DataType::char6,
+                                   DataType::char7, DataType::char8};
+
+// Result of a type column: a DataType or a number of ignored bytes
+struct FieldType {
+  DataType dt = DataType::error;
+  uint8_t ignored = 0;
+};
+
+std::string_view trim(std::string_view s) {
+  while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front())))
+    s.remove_prefix(1);
+  while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back())))
+    s.remove_suffix(1);
+  return s;
+}
+
+// Strict hex string to bytes; nullopt on odd length, bad digits or overflow
+std::optional<size_t> parseHex(std::string_view hex, uint8_t* out,
+                               size_t out_size) {
+  if (hex.size() % 2 != 0 || hex.size() / 2 > out_size) return std::nullopt;
+  for (size_t i = 0; i < hex.size() / 2; ++i) {
+    const char* first = hex.data() + i * 2;
+    auto [ptr, ec] = std::from_chars(first, first + 2, out[i], 16);
+    if (ec != std::errc{} || ptr != first + 2) return std::nullopt;
+  }
+  return hex.size() / 2;
+}
+
+FieldType parseType(std::string_view column) {
+  char name[16];
+  if (column.empty() || column.size() >= sizeof(name)) return {};
+
+  std::string_view length;
+  const size_t colon = column.find(':');
+  if (colon != std::string_view::npos) {
+    length = column.substr(colon + 1);
+    column = column.substr(0, colon);
+  }
+  for (size_t i = 0; i < column.size(); ++i)
+    name[i] = static_cast<char>(
+        std::toupper(static_cast<unsigned char>(column[i])));
+  name[column.size()] = '\0';
+  const std::string_view upper(name, column.size());
+
+  size_t n = 1;
+  if (!length.empty()) {
+    auto val = toNumStrict<size_t>(length);
+    if (!val) return {};
+    n = *val;
+  }
+  if (upper == "IGN") {
+    if (n == 0 || n > detail::SequenceLimits::max_data_bytes) return {};
+    return {DataType::error, static_cast<uint8_t>(n)};
+  }
+  if (upper == "HEX" || upper == "STR") {
+    if (n == 0 || n > std::size(hex_types)) return {};
+    return {upper == "HEX" ? hex_types[n - 1] : char_types[n - 1]};
+  }
+  if (!length.empty()) return {};
+
+  for (const auto& alias : type_aliases)
+    if (upper == alias.name) return {alias.dt};
+
+  const DataType dt = stringToDataType(name);
+  if (dt == DataType::auto_detect) return {};
+  return {dt};
+}
+
+// ebusd divider column: positive divides, negative multiplies, value lists
+// (e.g. "0=off;1=on") leave the raw value
+std::optional<float> parseDivider(std::string_view column) {
+  if (column.empty() || column.find('=') != std::string_view::npos)
+    return 1.0f;
+  auto divider = toNumStrict<int32_t>(column);
+  if (!divider || *divider == 0) return std::nullopt;
+  return *divider > 0 ? 1.0f / static_cast<float>(*divider)
+                      : static_cast<float>(-*divider);
+}
+
+// Splits a CSV line; cells may be quoted to contain commas
+template <typename Func>
+void forEachCell(std::string_view line, Func func) {
+  size_t pos = 0;
+  while (pos <= line.size()) {
+    std::string_view cell;
+    if (pos < line.size() && line[pos] == '"') {
+      const size_t end = line.find('"', pos + 1);
+      if (end == std::string_view::npos) {
+        cell = line.substr(pos + 1);
+        pos = line.size();
+      } else {
+        cell = line.substr(pos + 1, end - pos - 1);
+        pos = end + 1;
+      }
+      const size_t comma = line.find(',', pos);
+      pos = comma == std::string_view::npos ? line.size() + 1 : comma + 1;
+    } else {
+      const size_t comma = line.find(',', pos);
+      const size_t end = comma == std::string_view::npos ? line.size() : comma;
+      cell = line.substr(pos, end - pos);
+      pos = end + 1;
+    }
+    func(trim(cell));
+  }
+}
+
+bool parseCsvLine(std::string_view line, MessageDefinition& def) {
+  std::string_view cells[message_columns];
+  std::vector<std::string_view> fields;
+  size_t column = 0;
+  forEachCell(line, [&](std::string_view cell) {
+    if (column < message_columns)
+      cells[column] = cell;
+    else
+      fields.push_back(cell);
+    column++;
+  });
+  if (column < message_columns || cells[0].empty()) return false;
+
+  def.circuit = std::string(cells[1]);
+  def.name = std::string(cells[3]);
+
+  if (!cells[6].empty()) {
+    if (parseHex(cells[6], &def.zz, 1) != size_t{1}) return false;
+    def.any_target = false;
+  }
+
+  uint8_t pbsb[2];
+  if (parseHex(cells[7], pbsb, 2) != size_t{2}) return false;
+  def.pb = pbsb[0];
+  def.sb = pbsb[1];
+
+  auto id_size = parseHex(cells[8], def.id.data(), def.id.size());
+  if (!id_size) return false;
+  def.id_size = static_cast<uint8_t>(*id_size);
+
+  const bool read = std::tolower(static_cast<unsigned char>(cells[0][0])) ==
+                    'r';
+  size_t offsets[2] = {0, 0};
+  for (size_t i = 0; i + 2 < fields.size(); i += field_columns) {
+    const std::string_view part = fields[i + 1];
+    const std::string_view type = fields[i + 2];
+    if (fields[i].empty() && part.empty() && type.empty()) continue;
+
+    FieldDefinition field;
+    field.name = std::string(fields[i]);
+    if (part.empty())
+      field.slave = read;
+    else if (part == "s" || part == "m")
+      field.slave = part == "s";
+    else
+      return false;
+
+    const FieldType parsed = parseType(type);
+    size_t& offset = offsets[field.slave ? 1 : 0];
+    if (parsed.ignored > 0) {
+      offset += parsed.ignored;
+      continue;
+    }
+    if (parsed.dt == DataType::error) return false;
+
+    auto factor = parseDivider(i + 3 < fields.size() ? fields[i + 3]
+                                                     : std::string_view{});
+    if (!factor) return false;
+    if (i + 4 < fields.size()) field.unit = std::string(fields[i + 4]);
+
+    field.type = parsed.dt;
+    field.factor = *factor;
+    if (offset > detail::SequenceLimits::max_data_bytes) return false;
+    field.offset = static_cast<uint8_t>(offset);
+    offset += sizeOfDataType(parsed.dt);
+    def.fields.push_back(std::move(field));
+  }
+  return true;
+}
+
+bool readString(detail::JsonReader& r, std::string_view& out) {
+  if (r.next() != detail::JsonReader::Token::string) return false;
+  out = r.value();
+  return true;
+}
+
+bool parseJsonField(detail::JsonReader& r, FieldDefinition& field,
+                    std::optional<size_t>& offset) {
+  bool valid = true;
+  r.forEachField([&](std::string_view key, detail::JsonReader& inner) {
+    std::string_view text;
+    if (key == "name" || key == "unit" || key == "type" || key == "part") {
+      if (!readString(inner, text)) {
+        valid = false;
+        return true;
+      }
+      if (key == "name") {
+        field.name = std::string(text);
+      } else if (key == "unit") {
+        field.unit = std::string(text);
+      } else if (key == "type") {
+        const FieldType parsed = parseType(text);
+        if (parsed.ignored > 0) valid = false;
+        field.type = parsed.dt;
+      } else if (text == "s" || text == "m") {
+        field.slave = text == "s";
+      } else {
+        valid = false;
+      }
+      return true;
+    }
+    if (key == "offset" || key == "factor") {
+      if (inner.next() != detail::JsonReader::Token::number) {
+        valid = false;
+        return true;
+      }
+      if (key == "factor") {
+        field.factor = inner.asNum<float>();
+      } else {
+        offset = inner.asNumStrict<size_t>();
+        if (!offset) valid = false;
+      }
+      return true;
+    }
+    return false;
+  });
+  return valid;
+}
+
+bool parseJsonDefinition(detail::JsonReader& r, MessageDefinition& def) {
+  bool valid = true;
+  bool has_pbsb = false;
+  r.forEachField([&](std::string_view key, detail::JsonReader& inner) {
+    std::string_view text;
+    if (key == "circuit" || key == "name" || key == "zz" || key == "pbsb" ||
+        key == "id") {
+      if (!readString(inner, text)) {
+        valid = false;
+        return true;
+      }
+      if (key == "circuit") {
+        def.circuit = std::string(text);
+      } else if (key == "name") {
+        def.name = std::string(text);
+      } else if (key == "zz") {
+        if (parseHex(text, &def.zz, 1) != size_t{1}) valid = false;
+        def.any_target = false;
+      } else if (key == "pbsb") {
+        uint8_t pbsb[2];
+        if (parseHex(text, pbsb, 2) != size_t{2}) valid = false;
+        def.pb = pbsb[0];
+        def.sb = pbsb[1];
+        has_pbsb = true;
+      } else {
+        auto id_size = parseHex(text, def.id.data(), def.id.size());
+        if (!id_size) valid = false;
+        def.id_size = static_cast<uint8_t>(id_size.value_or(0));
+      }
+      return true;
+    }
+    if (key == "fields") {
+      if (inner.next() != detail::JsonReader::Token::array_start) {
+        valid = false;
+        return true;
+      }
+      size_t offsets[2] = {0, 0};
+      while (true) {
+        const auto t = inner.next();
+        if (t == detail::JsonReader::Token::array_end) break;
+        if (t != detail::JsonReader::Token::object_start) {
+          valid = false;
+          return true;
+        }
+        FieldDefinition field;
+        std::optional<size_t> offset;
+        if (!parseJsonField(inner, field, offset)) valid = false;
+        size_t& next = offsets[field.slave ? 1 : 0];
+        if (offset) next = *offset;
+        if (next > detail::SequenceLimits::max_data_bytes) valid = false;
+        field.offset = static_cast<uint8_t>(next);
+        next += sizeOfDataType(field.type);
+        def.fields.push_back(std::move(field));
+      }
+      return true;
+    }
+    return false;
+  });
+  return valid && has_pbsb;
+}
+
+}  // namespace
+
+uint64_t MessageDatabase::makeKey(uint8_t pb, uint8_t sb, const uint8_t* id,
+                                  uint8_t id_size) {
+  uint64_t key = (static_cast<uint64_t>(pb) << 56) |
+                 (static_cast<uint64_t>(sb) << 48) |
+                 (static_cast<uint64_t>(id_size) << 40);
+  for (uint8_t i = 0; i < id_size; ++i)
+    key |= static_cast<uint64_t>(id[i]) << (8 * (max_id_bytes - 1 - i));
+  return key;
+}
+
+bool MessageDatabase::add(MessageDefinition definition) {
+  if (definition.id_size > max_id_bytes) return false;
+  for (const auto& field : definition.fields) {
+    const size_t size = sizeOfDataType(field.type);
+    if (field.type == DataType::error ||
+        field.type == DataType::auto_detect)
+      return false;
+    const size_t base = field.slave ? 0 : definition.id_size;
+    if (base + field.offset + size > detail::SequenceLimits::max_data_bytes)
+      return false;
+  }
+  definitions_.push_back(std::move(definition));
+  built_ = false;
+  return true;
+}
+
+MessageDatabase::LoadResult MessageDatabase::loadCsv(std::string_view csv) {
+  LoadResult result;
+  while (!csv.empty()) {
+    const size_t eol = csv.find('\n');
+    std::string_view line = csv.substr(0, eol);
+    csv = eol == std::string_view::npos ? std::string_view{}
+                                        : csv.substr(eol + 1);
+
+    line = trim(line);
+    if (line.empty() || line.front() == '#' || line.front() == '*') continue;
+
+    MessageDefinition def;
+    if (parseCsvLine(line, def) && add(std::move(def)))
+      result.added++;
+    else
+      result.rejected++;
+  }
+  build();
+  return result;
+}
+
+MessageDatabase::LoadResult MessageDatabase::loadJson(std::string_view json) {
+  LoadResult result;
+  detail::JsonReader reader(json);
+  if (reader.next() != detail::JsonReader::Token::array_start) {
+    result.rejected++;
+    return result;
+  }
+  while (true) {
+    const auto t = reader.next();
+    if (t == detail::JsonReader::Token::array_end) break;
+    if (t != detail::JsonReader::Token::object_start) {
+      result.rejected++;
+      break;
+    }
+    MessageDefinition def;
+    if (parseJsonDefinition(reader, def) && add(std::move(def)))
+      result.added++;
+    else
+      result.rejected++;
+  }
+  build();
+  return result;
+}
+
+void MessageDatabase::build() {
+  index_.clear();
+  index_.reserve(definitions_.size());
+  id_sizes_ = 0;
+  for (size_t i = 0; i < definitions_.size(); ++i) {
+    const auto& def = definitions_[i];
+    index_.push_back({makeKey(def.pb, def.sb, def.id.data(), def.id_size),
+                      static_cast<uint32_t>(i)});
+    id_sizes_ |= static_cast<uint8_t>(1u << def.id_size);
+  }
+
+  // Equal keys: definitions for a target before those for any target
+  std::stable_sort(index_.begin(), index_.end(),
+                   [this](const IndexEntry& a, const IndexEntry& b) {
+                     if (a.key != b.key) return a.key < b.key;
+                     return !definitions_[a.definition].any_target &&
+                            definitions_[b.definition].any_target;
+                   });
+  built_ = true;
+}
+
+const MessageDefinition* MessageDatabase::find(ByteView master) const {
+  if (!built_ || master.size() < 5) return nullptr;
+
+  const uint8_t target = master[1];
+  const size_t data_size = std::min<size_t>(master[4], master.size() - 5);
+  const uint8_t* data = master.data() + 5;
+
+  for (size_t n = std::min(data_size, max_id_bytes) + 1; n-- > 0;) {
+    if ((id_sizes_ & (1u << n)) == 0) continue;
+
+    const uint64_t key =
+        makeKey(master[2], master[3], data, static_cast<uint8_t>(n));
+    auto it = std::lower_bound(
+        index_.begin(), index_.end(), key,
+        [](const IndexEntry& e, uint64_t k) { return e.key < k; });
+    for (; it != index_.end() && it->key == key; ++it) {
+      const MessageDefinition& def = definitions_[it->definition];
+      if (def.any_target || def.zz == target) return &def;
+    }
+  }
+  return nullptr;
+}
+
+const MessageDefinition* MessageDatabase::decode(
+    ByteView master, ByteView slave, uint64_t timestamp,
+    const ValueCallback& callback) const {
+  const MessageDefinition* def = find(master);
+  if (!def) return nullptr;
+
+  const ByteView parts[2] = {
+      {master.data() + 5 + def->id_size,
+       std::min<size_t>(master[4], master.size() - 5) - def->id_size},
+      slave.empty() ? ByteView{}
+                    : ByteView{slave.data() + 1,
+                               std::min<size_t>(slave[0], slave.size() - 1)}};
+
+  ValueInfo info;
+  info.circuit = def->circuit;
+  info.message = def->name;
+  info.master_view = master;
+  info.slave_view = slave;
+  info.timestamp = timestamp;
+
+  for (const auto& field : def->fields) {
+    const ByteView part = parts[field.slave ? 1 : 0];
+    const size_t size = sizeOfDataType(field.type);
+    if (field.offset + size > part.size()) continue;
+
+    auto value = ebus::decode(field.type, {part.data() + field.offset, size});
+    if (!value) continue;
+    if (field.factor != 1.0f && isNumeric(*value) && !isNull(*value))
+      value = asFloat(*value) * field.factor;
+
+    info.field = field.name;
+    info.unit = field.unit;
+    info.value = std::move(*value);
+    if (callback) callback(info);
+  }
+  return def;
+}
+
+void MessageDatabase::clear() {
+  definitions_.clear();
+  index_.clear();
+  id_sizes_ = 0;
+  built_ = false;
+}
+
+}  // namespace ebus
@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__linux__) && !defined(ESP_PLATFORM) && \
+    !defined(EBUS_SELECT_POLLER)
+#define EBUS_EPOLL_POLLER 1
+#include <sys/epoll.h>
+#include <unistd.h>
+#elif defined(ESP_PLATFORM)
+#include <lwip/sockets.h>
+#else
+#include <sys/select.h>
+#endif
+
+#include "platform/mutex.hpp"
+
+namespace ebus::detail::platform {
+
+/**
+ * Readiness notification for the client I/O loop. Every registered file
+ * descriptor carries an opaque 64-bit token that is handed back on readiness,
+ * so the caller dispatches in O(ready) without scanning its tables.
+ *
+ * Linux uses epoll; registrations with edge = true are edge-triggered and
+ * report writability only on transitions, so callers must drain reads and
+ * flush writes until EAGAIN. Elsewhere (ESP-IDF/lwIP) a select() backend
+ * rebuilds the fd_sets from the registrations on every wait(); it is always
+ * level-triggered and bounded by FD_SETSIZE.
+ *
+ * add/modify/remove are thread-safe; wait() is called by one thread only.
+ */
+class IoPoller {
+ public:
+  // Public Types & Constants
+  enum Event : uint16_t { in = 0x01, out = 0x02, err = 0x04 };
+
+  struct Ready {
+    uint64_t token = 0;
+    uint16_t events = 0;
+  };
+
+#if defined(EBUS_EPOLL_POLLER)
+  static constexpr const char* backend = "epoll";
+  static constexpr bool edge_triggered = true;
+#else
+  static constexpr const char* backend = "select";
+  static constexpr bool edge_triggered = false;
+#endif
+
+  // Lifecycle
+  IoPoller() = default;
+  ~IoPoller() { close(); }
+
+  bool init() {
+#if defined(EBUS_EPOLL_POLLER)
+    if (epoll_fd_ < 0) epoll_fd_ = ::epoll_create1(EPOLL_CLOEXEC);
+    return epoll_fd_ >= 0;
+#else
+    return true;
+#endif
+  }
+
+  void close() {
+#if defined(EBUS_EPOLL_POLLER)
+    if (epoll_fd_ >= 0) ::close(epoll_fd_);
+    epoll_fd_ = -1;
+#else
+    LockGuard<Mutex> lock(mutex_);
+    entries_.clear();
+#endif
+  }
+
+  // Special Members & Operators
+  IoPoller(const IoPoller&) = delete;
+  IoPoller& operator=(const IoPoller&) = delete;
+
+  // Working Methods
+  /**
+   * @brief Registers fd for the given events. Registering an fd again
+   * replaces its token and events.
+   */
+  bool add(int fd, uint64_t token, uint16_t events, bool edge = false) {
+    if (fd < 0) return false;
+#if defined(EBUS_EPOLL_POLLER)
+    epoll_event ev = toEpoll(token, events, edge);
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &ev) == 0) return true;
+    return errno == EEXIST &&
+           ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &ev) == 0;
+#else
+    (void)edge;
+    if (fd >= FD_SETSIZE) return false;
+    LockGuard<Mutex> lock(mutex_);
+    for (auto& entry : entries_) {
+      if (entry.fd == fd) {
+        entry.token = token;
+        entry.events = events;
+        return true;
+      }
+    }
+    entries_.push_back({fd, token, events});
+    return true;
+#endif
+  }
+
+  /**
+   * @brief Changes the events of a registered fd (e.g. write interest for
+   * level-triggered registrations).
+   */
+  bool modify(int fd, uint64_t token, uint16_t events, bool edge = false) {
+#if defined(EBUS_EPOLL_POLLER)
+    epoll_event ev = toEpoll(token, events, edge);
+    return fd >= 0 && ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &ev) == 0;
+#else
+    return add(fd, token, events, edge);
+#endif
+  }
+
+  /**
+   * @brief Unregisters fd if it is still registered with token. Call it
+   * before closing the fd; a closed fd number may already be reused by a
+   * newer registration, which the token check keeps intact.
+   */
+  void remove(int fd, uint64_t token) {
+    if (fd < 0) return;
+#if defined(EBUS_EPOLL_POLLER)
+    (void)token;
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+#else
+    LockGuard<Mutex> lock(mutex_);
+    for (size_t i = 0; i < entries_.size(); ++i) {
+      if (entries_[i].fd == fd && entries_[i].token == token) {
+        entries_[i] = entries_.back();
+        entries_.pop_back();
+        return;
+      }
+    }
+#endif
+  }
+
+  /**
+   * @brief Forgets an fd that has already been closed elsewhere. epoll drops
+   * closed descriptors by itself, so only the select() table is touched.
+   */
+  void discard(int fd, uint64_t token) {
+#if defined(EBUS_EPOLL_POLLER)
+    (void)fd;
+    (void)token;
+#else
+    remove(fd, token);
+#endif
+  }
+
+  /**
+   * @brief Waits up to timeout_ms for readiness.
+   * @return The number of entries written to ready, 0 on timeout or -1 on
+   * error (errno is preserved).
+   */
+  int wait(Ready* ready, size_t max_ready, uint32_t timeout_ms) {
+#if defined(EBUS_EPOLL_POLLER)
+    epoll_event events[max_wait_events];
+    const int limit = static_cast<int>(
+        max_ready < max_wait_events ? max_ready : max_wait_events);
+    int count = ::epoll_wait(epoll_fd_, events, limit,
+                             static_cast<int>(timeout_ms));
+    for (int i = 0; i < count; ++i) {
+      ready[i].token = events[i].data.u64;
+      ready[i].events = fromEpoll(events[i].events);
+    }
+    return count;
+#else
+    fd_set readfds, writefds, exceptfds;
+    FD_ZERO(&readfds);
+    FD_ZERO(&writefds);
+    FD_ZERO(&exceptfds);
+    int max_fd = -1;
+    {
+      LockGuard<Mutex> lock(mutex_);
+      snapshot_ = entries_;
+    }
+    for (const auto& entry : snapshot_) {
+      if (entry.events & in) FD_SET(entry.fd, &readfds);
+      if (entry.events & out) FD_SET(entry.fd, &writefds);
+      if (entry.events & err) FD_SET(entry.fd, &exceptfds);
+      if (entry.fd > max_fd) max_fd = entry.fd;
+    }
+
+    struct timeval tv{static_cast<time_t>(timeout_ms / 1000),
+                      static_cast<suseconds_t>((timeout_ms % 1000) * 1000)};
+    int activity = ::select(max_fd + 1, &readfds, &writefds, &exceptfds, &tv);
+    if (activity <= 0) return activity;
+
+    int count = 0;
+    for (const auto& entry : snapshot_) {
+      if (static_cast<size_t>(count) >= max_ready) break;
+      uint16_t events = 0;
+      if (FD_ISSET(entry.fd, &readfds)) events |= in;
+      if (FD_ISSET(entry.fd, &writefds)) events |= out;
+      if (FD_ISSET(entry.fd, &exceptfds)) events |= err;
+      if (events) ready[count++] = {entry.token, events};
+    }
+    return count;
+#endif
+  }
+
+ private:
+#if defined(EBUS_EPOLL_POLLER)
+  static constexpr size_t max_wait_events = 64;
+  int epoll_fd_ = -1;
+
+  static epoll_event toEpoll(uint64_t token, uint16_t events, bool edge) {
+    epoll_event ev{};
+    if (events & in) ev.events |= EPOLLIN | EPOLLRDHUP;
+    if (events & out) ev.events |= EPOLLOUT;
+    if (edge) ev.events |= EPOLLET;
+    ev.data.u64 = token;
+    return ev;
+  }
+
+  // Hang-ups are reported as readable: the next recv() returns 0 after the
+  // remaining data, which runs the regular close path.
+  static uint16_t fromEpoll(uint32_t events) {
+    uint16_t result = 0;
+    if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) result |= in;
+    if (events & EPOLLOUT) result |= out;
+    if (events & EPOLLERR) result |= err;
+    return result;
+  }
+#else
+  struct Entry {
+    int fd;
+    uint64_t token;
+    uint16_t events;
+  };
+
+  mutable Mutex mutex_;
+  std::vector<Entry> entries_;
+  std::vector<Entry> snapshot_;  // wait() thread only
+#endif
+};
+
+}  // namespace ebus::detail::platform
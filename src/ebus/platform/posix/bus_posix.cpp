@@ -16,6 +16,7 @@
 #include "core/bus_monitor.hpp"
 #include "core/request.hpp"
 #include "platform/system.hpp"
+#include "utils/tracer.hpp"
 
 namespace ebus::detail::platform {
 
@@ -206,8 +207,11 @@ void BusPosix::writeByte(const uint8_t byte) {
   lockAndInvoke(listeners_mutex_, getWriteListeners(), byte);
 
   ensureOpen();
-  if (::write(fd_, &byte, 1) == -1)
-    throw std::runtime_error("BusPosix: write error");
+  {
+    EBUS_TRACE_SCOPE("bus.write");
+    if (::write(fd_, &byte, 1) == -1)
+      throw std::runtime_error("BusPosix: write error");
+  }
 
   if (monitor_) monitor_->transmit.markEnd();
 }
@@ -261,6 +265,7 @@ void BusPosix::readerThread() {
 
     if (n == 1) {
       auto arrival_time = Clock::now();
+      EBUS_TRACE_INSTANT("bus.read");
 
       lockAndInvoke(listeners_mutex_, getReadListeners(), byte);
       recordUtilization(byte);
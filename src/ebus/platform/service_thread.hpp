@@ -12,6 +12,8 @@
 #include <string>
 #include <string_view>
 
+#include "utils/tracer.hpp"
+
 #if defined(ESP_PLATFORM)
 #include <esp_heap_caps.h>
 #include <esp_system.h>
@@ -50,6 +52,7 @@ class ServiceThread {
     xTaskCreatePinnedToCore(
         [](void* arg) {
           auto* self = static_cast<ServiceThread*>(arg);
+          EBUS_TRACE_THREAD(self->name_.c_str());
           self->func_();
           xSemaphoreGive(self->done_sem_);
           self->handle_ = nullptr;
@@ -59,7 +62,10 @@ class ServiceThread {
         (core_ >= 0) ? core_ : tskNO_AFFINITY);
 #elif defined(POSIX)
     if (thread_.joinable()) thread_.join();
-    thread_ = std::thread(func_);
+    thread_ = std::thread([this] {
+      EBUS_TRACE_THREAD(name_.c_str());
+      func_();
+    });
 #endif
   }
 
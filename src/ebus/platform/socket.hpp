@@ -20,9 +20,13 @@
 #include <netinet/tcp.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
+#include <sys/un.h>
 
 #include <cerrno>
+#include <cstring>
 #endif
 
 #include <fcntl.h>
@@ -82,6 +86,14 @@ inline ssize_t recv(int fd, void* buf, size_t len, Flags flags) {
 
 inline bool isInterrupted() { return errno == EINTR; }
 
+// Removes a stale AF_UNIX socket file; other file types are left alone
+inline void unlinkLocalSocket([[maybe_unused]] const char* path) {
+#if defined(POSIX)
+  struct stat st;
+  if (::lstat(path, &st) == 0 && S_ISSOCK(st.st_mode)) ::unlink(path);
+#endif
+}
+
 inline bool isWouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK; }
 
 class Socket {
@@ -92,13 +104,13 @@ class Socket {
     dgram = SOCK_DGRAM
   };
 
-  explicit Socket(Type type = Type::invalid) : type_(type) {
+  explicit Socket(Type type = Type::invalid, int af = AF_INET)
+      : type_(type) {
     if (type_ == Type::invalid) {
       fd_ = -1;
       return;
     }
 
-    int af = AF_INET;
     int sock_type = static_cast<int>(type_);
 #if defined(ESP_PLATFORM)
     fd_ = ::socket(af, sock_type, 0);
@@ -208,6 +220,28 @@ class Socket {
 #endif
   }
 
+  // Gathers count buffers into one send; may also transfer partially.
+  ssize_t writev(const struct iovec* iov, int count) {
+    assert(isValid() && "Socket is not valid");
+    assert(iov != nullptr && count > 0 && "Segments must not be empty");
+
+#if defined(ESP_PLATFORM)
+    return ::writev(fd_, iov, count);
+#elif defined(POSIX)
+    struct msghdr msg{};
+    msg.msg_iov = const_cast<struct iovec*>(iov);
+    msg.msg_iovlen = static_cast<size_t>(count);
+    int flags = 0;
+#if defined(MSG_NOSIGNAL)
+    flags |= MSG_NOSIGNAL;
+#endif
+    ssize_t n = ::sendmsg(fd_, &msg, flags);
+    // Fallback for non-socket FDs (pipes in mocks)
+    if (n < 0 && errno == ENOTSOCK) return ::writev(fd_, iov, count);
+    return n;
+#endif
+  }
+
   bool close() {
     if (!isValid()) {
       return true;
@@ -235,9 +269,10 @@ class Socket {
   /**
    * @brief Creates and configures a listening socket on the given port.
    * @param port The port to listen on.
+   * @param backlog Pending connections the kernel queues until accepted.
    * @return A configured Socket, or an invalid Socket if setup fails.
    */
-  static inline Socket createListenSocket(uint16_t port) {
+  static inline Socket createListenSocket(uint16_t port, int backlog = 4) {
     Socket sock(Type::stream);
     if (!sock.isValid()) {
       return Socket(Type::invalid);
@@ -252,10 +287,49 @@ class Socket {
       return Socket(Type::invalid);
     }
 
-    if (!sock.listen(4)) {
+    if (!sock.listen(backlog)) {
+      return Socket(Type::invalid);
+    }
+    return sock;
+  }
+
+  /**
+   * @brief Creates a listening AF_UNIX stream socket bound to path, replacing
+   * a socket file left behind by a previous run. Local sockets are POSIX only.
+   * @param path Filesystem path, shorter than sockaddr_un::sun_path.
+   * @param backlog Pending connections the kernel queues until accepted.
+   * @return A configured Socket, or an invalid Socket if setup fails.
+   */
+  static inline Socket createLocalListenSocket(
+      [[maybe_unused]] const char* path, [[maybe_unused]] int backlog = 4) {
+#if defined(POSIX)
+    struct sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    const size_t len = std::strlen(path);
+    if (len == 0 || len >= sizeof(addr.sun_path)) {
+      return Socket(Type::invalid);
+    }
+    std::memcpy(addr.sun_path, path, len + 1);
+
+    Socket sock(Type::stream, AF_UNIX);
+    if (!sock.isValid()) {
+      return Socket(Type::invalid);
+    }
+
+    unlinkLocalSocket(path);
+    if (::bind(sock.fd_, reinterpret_cast<const struct sockaddr*>(&addr),
+               sizeof(addr)) != 0) {
+      return Socket(Type::invalid);
+    }
+
+    if (!sock.listen(backlog)) {
+      unlinkLocalSocket(path);
       return Socket(Type::invalid);
     }
     return sock;
+#else
+    return Socket(Type::invalid);
+#endif
   }
 
   // Non-blocking operations
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace ebus::detail {
+
+/**
+ * Append-only byte ring shared by every client of one wire format. A single
+ * writer appends and publishes the new head; readers keep their own absolute
+ * read position (cursor) and copy straight out of the storage, so a byte is
+ * stored once no matter how many clients forward it.
+ *
+ * Positions are 64-bit and never wrap. A reader further than lagLimit()
+ * behind its head must skip ahead: the writer is about to overwrite the
+ * bytes it has not sent yet. The limit leaves half the ring as margin, so
+ * bytes being written out are not overwritten meanwhile.
+ *
+ * The writer can mark boundaries (the positions of SYN symbols), so a reader
+ * that has to skip ahead can resume at the start of a telegram.
+ */
+class BroadcastRing {
+ public:
+  // Public Types & Constants
+  struct Segment {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+  };
+
+  static constexpr size_t min_capacity = 64;
+  static constexpr size_t max_boundaries = 16;
+
+  // Lifecycle
+  explicit BroadcastRing(size_t capacity) : capacity_(capacityFor(capacity)) {
+    storage_.reset(new uint8_t[capacity_]);
+  }
+
+  // Special Members & Operators
+  BroadcastRing(const BroadcastRing&) = delete;
+  BroadcastRing& operator=(const BroadcastRing&) = delete;
+
+  // Working Methods
+  /**
+   * @brief Appends len bytes (at most lagLimit()) and publishes them. Must
+   * only be called from one thread.
+   */
+  void append(const uint8_t* data, size_t len) {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    const size_t offset = static_cast<size_t>(head) & (capacity_ - 1);
+    const size_t first = len < capacity_ - offset ? len : capacity_ - offset;
+    std::memcpy(&storage_[offset], data, first);
+    std::memcpy(&storage_[0], data + first, len - first);
+    head_.store(head + len, std::memory_order_release);
+  }
+
+  /**
+   * @brief Splits [from, to) into at most two contiguous segments.
+   * @return The number of segments written to out.
+   */
+  size_t segments(uint64_t from, uint64_t to, Segment out[2]) const {
+    if (to <= from) return 0;
+    const size_t offset = static_cast<size_t>(from) & (capacity_ - 1);
+    const size_t len = static_cast<size_t>(to - from);
+    const size_t first = len < capacity_ - offset ? len : capacity_ - offset;
+    out[0] = {&storage_[offset], first};
+    if (first == len) return 1;
+    out[1] = {&storage_[0], len - first};
+    return 2;
+  }
+
+  /**
+   * @brief Records the current head as a boundary; the next byte appended
+   * starts there. Writer thread only.
+   */
+  void markBoundary() {
+    const uint64_t count = boundary_count_.load(std::memory_order_relaxed);
+    boundaries_[count % max_boundaries].store(
+        head_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    boundary_count_.store(count + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Finds the first of the recent boundaries at or after from that
+   * is published already.
+   * @return false if none of the recorded boundaries qualifies.
+   */
+  bool nextBoundary(uint64_t from, uint64_t& position) const {
+    const uint64_t count = boundary_count_.load(std::memory_order_acquire);
+    const uint64_t head = this->head();
+    const size_t recorded = count < max_boundaries ? count : max_boundaries;
+    bool found = false;
+    // Entries overwritten meanwhile still hold valid, newer boundaries
+    for (size_t i = 0; i < recorded; ++i) {
+      const uint64_t boundary =
+          boundaries_[i].load(std::memory_order_relaxed);
+      if (boundary < from || boundary >= head) continue;
+      if (!found || boundary < position) position = boundary;
+      found = true;
+    }
+    return found;
+  }
+
+  uint8_t at(uint64_t position) const {
+    return storage_[static_cast<size_t>(position) & (capacity_ - 1)];
+  }
+
+  bool isLagging(uint64_t cursor, uint64_t head) const {
+    return head - cursor > lagLimit();
+  }
+
+  // Status/Telemetry
+  uint64_t head() const { return head_.load(std::memory_order_acquire); }
+  size_t capacity() const { return capacity_; }
+  size_t lagLimit() const { return capacity_ / 2; }
+
+  // Capacity allocated for a requested size: the next power of two
+  static size_t capacityFor(size_t capacity) {
+    size_t result = min_capacity;
+    while (result < capacity) result <<= 1;
+    return result;
+  }
+
+ private:
+  const size_t capacity_;
+  std::unique_ptr<uint8_t[]> storage_;
+  std::atomic<uint64_t> head_{0};
+  std::atomic<uint64_t> boundaries_[max_boundaries] = {};
+  std::atomic<uint64_t> boundary_count_{0};
+};
+
+}  // namespace ebus::detail
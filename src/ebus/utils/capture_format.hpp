@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ebus/types.hpp>
+
+namespace ebus::detail::capture {
+
+/**
+ * Binary bus capture format (version 1).
+ *
+ * A segment starts with a 24 byte header:
+ *   magic "EBCP" | version u8 | 3 reserved bytes |
+ *   base timestamp u64 LE (ebus::Clock us) | wall clock u64 LE (us since epoch)
+ *
+ * followed by one record per bus byte:
+ *   varint (LEB128)  (delta_us << 4) | (request_state << 2) | flags
+ *   u8               bus byte
+ *   u8               handler_state | (request_result << 4)
+ *   [u8              lock counter, only if flags & lock_counter_follows]
+ *
+ * delta_us is relative to the previous record (the base timestamp for the
+ * first one), so a typical record takes 4 bytes. Every segment is
+ * self-contained: the lock counter starts at 0 and is only written when it
+ * changes.
+ */
+inline constexpr char magic[4] = {'E', 'B', 'C', 'P'};
+inline constexpr uint8_t version = 1;
+inline constexpr size_t header_size = 24;
+inline constexpr size_t max_record_size = 10 + 3;  // varint + 3 bytes
+
+inline constexpr uint8_t lock_counter_follows = 0x01;
+inline constexpr uint8_t gap_before = 0x02;  // records were dropped before
+
+struct Header {
+  uint64_t base_us = 0;
+  uint64_t wall_us = 0;
+};
+
+struct Record {
+  uint64_t timestamp_us = 0;
+  uint8_t byte = 0;
+  HandlerState handler_state = HandlerState::passive_receive_master;
+  RequestState request_state = RequestState::observe;
+  RequestResult result = RequestResult::observe_data;
+  uint8_t lock_counter = 0;
+  bool gap = false;  // records were lost right before this one
+};
+
+namespace internal {
+inline void putU64(uint8_t* out, uint64_t value) {
+  for (int i = 0; i < 8; ++i) out[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+inline uint64_t getU64(const uint8_t* in) {
+  uint64_t value = 0;
+  for (int i = 0; i < 8; ++i) value |= static_cast<uint64_t>(in[i]) << (8 * i);
+  return value;
+}
+}  // namespace internal
+
+inline size_t encodeHeader(const Header& header, uint8_t* out) {
+  std::memcpy(out, magic, sizeof(magic));
+  out[4] = version;
+  out[5] = out[6] = out[7] = 0;
+  internal::putU64(out + 8, header.base_us);
+  internal::putU64(out + 16, header.wall_us);
+  return header_size;
+}
+
+inline bool decodeHeader(const uint8_t* data, size_t size, Header& header) {
+  if (size < header_size || std::memcmp(data, magic, sizeof(magic)) != 0 ||
+      data[4] != version)
+    return false;
+  header.base_us = internal::getU64(data + 8);
+  header.wall_us = internal::getU64(data + 16);
+  return true;
+}
+
+/**
+ * Delta-encodes records of one segment.
+ */
+class Encoder {
+ public:
+  void reset(uint64_t base_us) {
+    last_us_ = base_us;
+    lock_counter_ = 0;
+  }
+
+  /**
+   * @brief Encodes a record into out (at least max_record_size bytes).
+   * @return The number of bytes written.
+   */
+  size_t encode(const Record& record, uint8_t* out) {
+    const uint64_t delta =
+        record.timestamp_us > last_us_ ? record.timestamp_us - last_us_ : 0;
+    last_us_ = std::max(last_us_, record.timestamp_us);
+
+    uint8_t flags = record.gap ? gap_before : 0;
+    if (record.lock_counter != lock_counter_) flags |= lock_counter_follows;
+
+    uint64_t value = (delta << 4) |
+                     (static_cast<uint64_t>(record.request_state) << 2) | flags;
+    size_t pos = 0;
+    do {
+      uint8_t part = value & 0x7f;
+      value >>= 7;
+      out[pos++] = value ? (part | 0x80) : part;
+    } while (value);
+
+    out[pos++] = record.byte;
+    out[pos++] = static_cast<uint8_t>(
+        static_cast<uint8_t>(record.handler_state) |
+        (static_cast<uint8_t>(record.result) << 4));
+    if (flags & lock_counter_follows) {
+      out[pos++] = record.lock_counter;
+      lock_counter_ = record.lock_counter;
+    }
+    return pos;
+  }
+
+ private:
+  uint64_t last_us_ = 0;
+  uint8_t lock_counter_ = 0;
+};
+
+/**
+ * Decodes the records of one segment in place, without copying the data.
+ */
+class Decoder {
+ public:
+  Decoder(const uint8_t* data, size_t size, uint64_t base_us)
+      : data_(data), size_(size), last_us_(base_us) {}
+
+  /**
+   * @brief Decodes the next record.
+   * @return false at the end of the data or on a truncated record.
+   */
+  bool next(Record& record) {
+    if (pos_ >= size_) return false;
+
+    size_t pos = pos_;
+    uint64_t value = 0;
+    for (int shift = 0;; shift += 7) {
+      if (pos >= size_ || shift > 63) return fail();
+      const uint8_t part = data_[pos++];
+      value |= static_cast<uint64_t>(part & 0x7f) << shift;
+      if (!(part & 0x80)) break;
+    }
+
+    const uint8_t flags = value & 0x03;
+    const size_t length = (flags & lock_counter_follows) ? 3 : 2;
+    if (size_ - pos < length) return fail();
+
+    last_us_ += value >> 4;
+    record.timestamp_us = last_us_;
+    record.request_state = static_cast<RequestState>((value >> 2) & 0x03);
+    record.gap = flags & gap_before;
+    record.byte = data_[pos];
+    record.handler_state = static_cast<HandlerState>(data_[pos + 1] & 0x0f);
+    record.result = static_cast<RequestResult>(data_[pos + 1] >> 4);
+    if (flags & lock_counter_follows) lock_counter_ = data_[pos + 2];
+    record.lock_counter = lock_counter_;
+
+    pos_ = pos + length;
+    return true;
+  }
+
+  /**
+   * @brief True if decoding stopped at an incomplete record (e.g. the tail of
+   * a segment that was still being written).
+   */
+  bool truncated() const { return truncated_; }
+  size_t offset() const { return pos_; }
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t pos_ = 0;
+  uint64_t last_us_;
+  uint8_t lock_counter_ = 0;
+  bool truncated_ = false;
+
+  bool fail() {
+    truncated_ = true;
+    return false;
+  }
+};
+
+}  // namespace ebus::detail::capture
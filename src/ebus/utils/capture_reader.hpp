@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "utils/capture_format.hpp"
+
+namespace ebus::detail {
+
+/**
+ * Memory-maps a capture segment and decodes its records on the fly, without
+ * reading the file into a buffer (POSIX only).
+ */
+class CaptureReader {
+ public:
+  // Lifecycle
+  CaptureReader() = default;
+  ~CaptureReader() { close(); }
+
+  /**
+   * @brief Maps the segment at path and validates its header.
+   * @return false if the file cannot be mapped or is not a capture segment.
+   */
+  bool open(const char* path) {
+    close();
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st{};
+    if (::fstat(fd, &st) == 0 &&
+        static_cast<size_t>(st.st_size) >= capture::header_size) {
+      void* map = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ,
+                         MAP_PRIVATE, fd, 0);
+      if (map != MAP_FAILED) {
+        data_ = static_cast<const uint8_t*>(map);
+        size_ = static_cast<size_t>(st.st_size);
+      }
+    }
+    ::close(fd);
+
+    if (data_ && !capture::decodeHeader(data_, size_, header_)) close();
+    return data_ != nullptr;
+  }
+
+  void close() {
+    if (data_) ::munmap(const_cast<uint8_t*>(data_), size_);
+    data_ = nullptr;
+    size_ = 0;
+    header_ = {};
+  }
+
+  // Special Members & Operators
+  CaptureReader(const CaptureReader&) = delete;
+  CaptureReader& operator=(const CaptureReader&) = delete;
+
+  // Working Methods
+  /**
+   * @brief Returns a decoder over the mapped records.
+   */
+  capture::Decoder records() const {
+    return capture::Decoder(data_ ? data_ + capture::header_size : nullptr,
+                            data_ ? size_ - capture::header_size : 0,
+                            header_.base_us);
+  }
+
+  /**
+   * @brief Invokes callback(const capture::Record&) for every record.
+   * @return The number of decoded records.
+   */
+  template <typename F>
+  size_t forEach(F&& callback) const {
+    capture::Decoder decoder = records();
+    capture::Record record;
+    size_t count = 0;
+    while (decoder.next(record)) {
+      callback(record);
+      ++count;
+    }
+    return count;
+  }
+
+  // Status/Telemetry
+  bool isOpen() const { return data_ != nullptr; }
+  const capture::Header& header() const { return header_; }
+  size_t size() const { return size_; }
+
+  /**
+   * @brief Converts a record timestamp to wall clock microseconds.
+   */
+  uint64_t wallClockUs(const capture::Record& record) const {
+    return header_.wall_us + (record.timestamp_us - header_.base_us);
+  }
+
+ private:
+  const uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+  capture::Header header_;
+};
+
+}  // namespace ebus::detail
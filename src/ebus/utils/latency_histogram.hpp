@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ebus/detail/protocol_limits.hpp>
+#include <limits>
+
+namespace ebus::detail {
+
+namespace histogram {
+
+// Uniform access to plain and atomic bucket counters
+template <typename Counter>
+struct CounterTraits {
+  using Value = Counter;
+  static Value load(const Counter& counter) { return counter; }
+  static void store(Counter& counter, Value value) { counter = value; }
+  static Value increment(Counter& counter) { return ++counter; }
+};
+
+template <typename T>
+struct CounterTraits<std::atomic<T>> {
+  using Value = T;
+  static Value load(const std::atomic<T>& counter) {
+    return counter.load(std::memory_order_relaxed);
+  }
+  static void store(std::atomic<T>& counter, Value value) {
+    counter.store(value, std::memory_order_relaxed);
+  }
+  static Value increment(std::atomic<T>& counter) {
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+};
+
+}  // namespace histogram
+
+/**
+ * Fixed-size log-linear histogram (HDR-style) for microsecond samples.
+ * Values below 2^(SubBucketBits + 1) are recorded exactly; above that, every
+ * power of two is split into 2^SubBucketBits linear sub-buckets, which bounds
+ * the relative error of reported percentiles. Samples of 2^MaxValueBits and
+ * above are accumulated in the last bucket.
+ *
+ * Counter is a plain or atomic unsigned integer; with atomic counters the
+ * histogram is lock-free. When a bucket saturates, all buckets are halved
+ * together, which keeps the distribution and favours recent samples.
+ */
+template <typename Counter, uint32_t SubBucketBits, uint32_t MaxValueBits>
+class LatencyHistogramImpl {
+  static_assert(SubBucketBits >= 1 && SubBucketBits < MaxValueBits &&
+                    MaxValueBits <= 31,
+                "Invalid histogram layout");
+
+  using Traits = histogram::CounterTraits<Counter>;
+
+ public:
+  // Public Types & Constants
+  static constexpr uint32_t sub_bucket_bits = SubBucketBits;
+  static constexpr uint32_t sub_bucket_count = 1u << sub_bucket_bits;
+  static constexpr size_t bucket_count =
+      (MaxValueBits - SubBucketBits + 1) * size_t{sub_bucket_count};
+
+  // Lifecycle
+  LatencyHistogramImpl() { reset(); }
+
+  // Working Methods
+  inline void record(uint32_t value) {
+    if (Traits::increment(buckets_[bucketIndex(value)]) ==
+        std::numeric_limits<typename Traits::Value>::max())
+      halve();
+  }
+
+  inline void reset() {
+    for (auto& bucket : buckets_) Traits::store(bucket, 0);
+  }
+
+  // Status/Telemetry
+  uint64_t getCount() const {
+    uint64_t total = 0;
+    for (const auto& bucket : buckets_) total += Traits::load(bucket);
+    return total;
+  }
+
+  /**
+   * @brief Returns the highest value equivalent to the bucket that contains
+   * the given percentile (0..100), or 0 if no samples were recorded.
+   */
+  uint32_t valueAtPercentile(float percentile) const {
+    std::array<typename Traits::Value, bucket_count> counts;
+    uint64_t total = 0;
+    for (size_t i = 0; i < bucket_count; ++i) {
+      counts[i] = Traits::load(buckets_[i]);
+      total += counts[i];
+    }
+    if (total == 0) return 0;
+
+    if (percentile < 0.0f) percentile = 0.0f;
+    if (percentile > 100.0f) percentile = 100.0f;
+    uint64_t target = static_cast<uint64_t>((percentile / 100.0f) *
+                                            static_cast<float>(total));
+    if (target == 0) target = 1;
+
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < bucket_count; ++i) {
+      cumulative += counts[i];
+      if (cumulative >= target) return bucketUpperBound(i);
+    }
+    return bucketUpperBound(bucket_count - 1);
+  }
+
+  static constexpr size_t bucketIndex(uint32_t value) {
+    if (value < (sub_bucket_count << 1)) return value;
+
+    uint32_t msb = 31 - static_cast<uint32_t>(__builtin_clz(value));
+    if (msb >= MaxValueBits) return bucket_count - 1;
+
+    uint32_t shift = msb - sub_bucket_bits;
+    return static_cast<size_t>((shift + 1) * sub_bucket_count +
+                               ((value >> shift) - sub_bucket_count));
+  }
+
+  static constexpr uint32_t bucketLowerBound(size_t index) {
+    if (index < sub_bucket_count) return static_cast<uint32_t>(index);
+
+    uint32_t shift = static_cast<uint32_t>(index / sub_bucket_count) - 1;
+    uint32_t sub = static_cast<uint32_t>(index % sub_bucket_count);
+    return (sub_bucket_count + sub) << shift;
+  }
+
+  static constexpr uint32_t bucketUpperBound(size_t index) {
+    if (index < sub_bucket_count) return static_cast<uint32_t>(index);
+
+    uint32_t shift = static_cast<uint32_t>(index / sub_bucket_count) - 1;
+    return bucketLowerBound(index) + ((1u << shift) - 1);
+  }
+
+ private:
+  std::array<Counter, bucket_count> buckets_;
+
+  void halve() {
+    for (auto& bucket : buckets_)
+      Traits::store(bucket, static_cast<typename Traits::Value>(
+                                Traits::load(bucket) / 2));
+  }
+};
+
+// Lock-free histogram of the protocol and session timings
+using LatencyHistogram =
+    LatencyHistogramImpl<std::atomic<uint32_t>,
+                         HistogramLimits::sub_bucket_bits,
+                         HistogramLimits::max_value_bits>;
+static_assert(LatencyHistogram::bucket_count == HistogramLimits::bucket_count,
+              "HistogramLimits::bucket_count does not match the layout");
+
+}  // namespace ebus::detail
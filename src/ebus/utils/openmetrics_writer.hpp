@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <charconv>
+#include <cstring>
+#include <ebus/detail/protocol_limits.hpp>
+#include <ebus/types.hpp>
+#include <initializer_list>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace ebus {
+char* formatFloat(float value, int precision, char* buffer, size_t buffer_size,
+                  float lower_threshold, float upper_threshold);
+}  // namespace ebus
+
+namespace ebus::detail {
+
+/**
+ * Streaming writer for the OpenMetrics text exposition format. Like the
+ * JsonWriter it buffers small parts and hands chunks to a JsonChunkVisitor,
+ * so a complete scrape never has to be materialized in memory.
+ */
+class OpenMetricsWriter {
+ public:
+  // Public Types & Constants
+  struct Label {
+    std::string_view key;
+    std::string_view value;
+  };
+  using Labels = std::initializer_list<Label>;
+
+  // Lifecycle
+  explicit OpenMetricsWriter(JsonChunkVisitor visitor)
+      : visitor_(std::move(visitor)) {}
+  ~OpenMetricsWriter() { flush(); }
+
+  // Special Members & Operators
+  OpenMetricsWriter(const OpenMetricsWriter&) = delete;
+  OpenMetricsWriter& operator=(const OpenMetricsWriter&) = delete;
+
+  // Working Methods
+  void write(std::string_view s) {
+    if (pos_ + s.size() > sizeof(buffer_)) {
+      flush();
+      if (s.size() > sizeof(buffer_)) {
+        visitor_(s);
+        return;
+      }
+    }
+    std::memcpy(buffer_ + pos_, s.data(), s.size());
+    pos_ += s.size();
+  }
+
+  void flush() {
+    if (pos_ > 0) {
+      visitor_(std::string_view(buffer_, pos_));
+      pos_ = 0;
+    }
+  }
+
+  /**
+   * @brief Writes the metadata of a metric family. Must precede its samples.
+   * @param type One of counter, gauge, summary, info, stateset, unknown.
+   * @param unit Optional unit; the family name must end with "_<unit>".
+   */
+  void family(std::string_view name, std::string_view type,
+              std::string_view help, std::string_view unit = {}) {
+    write("# TYPE ");
+    write(name);
+    write(" ");
+    write(type);
+    write("\n");
+    if (!unit.empty()) {
+      write("# UNIT ");
+      write(name);
+      write(" ");
+      write(unit);
+      write("\n");
+    }
+    write("# HELP ");
+    write(name);
+    write(" ");
+    write(help);
+    write("\n");
+  }
+
+  /**
+   * @brief Writes one sample line "<name><suffix>{labels} <value>". Labels
+   * with an empty key are skipped.
+   */
+  template <typename T>
+  std::enable_if_t<std::is_integral_v<T>, void> sample(std::string_view name,
+                                                       std::string_view suffix,
+                                                       Labels labels, T value) {
+    writeSeries(name, suffix, labels);
+    char buf[JsonLimits::formatting_buffer_size];
+    auto res = std::to_chars(buf, buf + sizeof(buf), value);
+    write(std::string_view(buf, res.ptr - buf));
+    write("\n");
+  }
+
+  void sample(std::string_view name, std::string_view suffix, Labels labels,
+              bool value) {
+    sample(name, suffix, labels, value ? 1 : 0);
+  }
+
+  void sample(std::string_view name, std::string_view suffix, Labels labels,
+              float value) {
+    writeSeries(name, suffix, labels);
+    char buf[JsonLimits::formatting_buffer_size]{};
+    const char* end =
+        ebus::formatFloat(value, 3, buf, sizeof(buf),
+                          FormattingLimits::float_lower_threshold,
+                          FormattingLimits::float_upper_threshold);
+    write(std::string_view(buf, end - buf));
+    write("\n");
+  }
+
+  /**
+   * @brief Terminates the exposition with the mandatory "# EOF" marker.
+   */
+  void finish() {
+    write("# EOF\n");
+    flush();
+  }
+
+ private:
+  JsonChunkVisitor visitor_;
+  char buffer_[JsonLimits::writer_buffer_size];
+  size_t pos_ = 0;
+
+  void writeSeries(std::string_view name, std::string_view suffix,
+                   Labels labels) {
+    write(name);
+    write(suffix);
+    bool first = true;
+    for (const auto& label : labels) {
+      if (label.key.empty()) continue;
+      write(first ? "{" : ",");
+      first = false;
+      write(label.key);
+      write("=\"");
+      writeEscaped(label.value);
+      write("\"");
+    }
+    if (!first) write("}");
+    write(" ");
+  }
+
+  void writeEscaped(std::string_view s) {
+    size_t start = 0;
+    for (size_t i = 0; i < s.size(); ++i) {
+      const char* escape = nullptr;
+      if (s[i] == '\\') escape = "\\\\";
+      if (s[i] == '"') escape = "\\\"";
+      if (s[i] == '\n') escape = "\\n";
+      if (escape) {
+        write(s.substr(start, i - start));
+        write(escape);
+        start = i + 1;
+      }
+    }
+    write(s.substr(start));
+  }
+};
+
+}  // namespace ebus::detail
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace ebus::detail {
+
+/**
+ * Multi-slot buffer for immutable snapshots with a single publisher and any
+ * number of lock-free readers. The publisher fills a slot nobody reads and
+ * then makes it the latest one; readers pin a slot with a per-slot counter,
+ * so a slow reader never blocks the publisher and never sees a torn value.
+ *
+ * Every publication gets a generation number (starting at 1). The snapshot
+ * published right before the latest one is retained as well, which lets
+ * readers compute deltas between consecutive snapshots. With more pinned
+ * slots than spare ones a publication is skipped and counted.
+ */
+template <typename T, size_t Slots>
+class SnapshotBuffer {
+  static_assert(Slots >= 3, "SnapshotBuffer needs at least 3 slots");
+
+ public:
+  // Working Methods
+  /**
+   * @brief Fills a free slot via fill(T&) and publishes it. Must only be
+   * called from one thread.
+   * @return false if every spare slot is still pinned by readers.
+   */
+  template <typename F>
+  bool publish(F&& fill) {
+    const size_t latest = latest_.load();
+    for (size_t i = 0; i < Slots; ++i) {
+      if (i == latest || i == previous_) continue;
+      Slot& slot = slots_[i];
+      if (slot.readers.load() != 0) continue;
+      // Invalidate first, then re-check: a reader pinning concurrently
+      // either sees generation 0 or is seen here.
+      slot.generation.store(0);
+      if (slot.readers.load() != 0) continue;
+
+      fill(slot.value);
+      slot.previous = latest;
+      slot.generation.store(++generation_);
+      previous_ = latest;
+      latest_.store(i);
+      return true;
+    }
+    skipped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  /**
+   * @brief Invokes reader(generation, current, previous) with the latest
+   * snapshot. previous points to the snapshot of generation - 1 or is
+   * nullptr if it is no longer available.
+   * @return false if nothing has been published yet.
+   */
+  template <typename F>
+  bool read(F&& reader) const {
+    for (size_t attempt = 0; attempt < Slots * 2; ++attempt) {
+      const size_t latest = latest_.load();
+      if (latest >= Slots) return false;
+      const Slot& slot = slots_[latest];
+      const uint64_t generation = slot.generation.load();
+      if (generation == 0 || !pin(slot, generation)) continue;
+
+      const Slot* previous = nullptr;
+      if (slot.previous < Slots && pin(slots_[slot.previous], generation - 1))
+        previous = &slots_[slot.previous];
+
+      reader(generation, slot.value, previous ? &previous->value : nullptr);
+
+      if (previous) previous->readers.fetch_sub(1);
+      slot.readers.fetch_sub(1);
+      return true;
+    }
+    return false;
+  }
+
+  // Status/Telemetry
+  uint64_t generation() const {
+    const size_t latest = latest_.load();
+    return latest < Slots ? slots_[latest].generation.load() : 0;
+  }
+
+  uint32_t skipped() const { return skipped_.load(std::memory_order_relaxed); }
+
+ private:
+  struct Slot {
+    T value{};
+    size_t previous = Slots;
+    std::atomic<uint64_t> generation{0};
+    mutable std::atomic<uint32_t> readers{0};
+  };
+
+  std::array<Slot, Slots> slots_{};
+  std::atomic<size_t> latest_{Slots};
+  std::atomic<uint32_t> skipped_{0};
+
+  // Publisher-only state
+  size_t previous_ = Slots;
+  uint64_t generation_ = 0;
+
+  static bool pin(const Slot& slot, uint64_t generation) {
+    slot.readers.fetch_add(1);
+    if (slot.generation.load() == generation) return true;
+    slot.readers.fetch_sub(1);
+    return false;
+  }
+};
+
+}  // namespace ebus::detail
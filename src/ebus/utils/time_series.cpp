@@ -0,0 +1,288 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "utils/time_series.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace ebus::detail {
+
+namespace {
+
+// Worst case of one sample: '1111' + 32 bit delta-of-delta, '11' + 5 bit
+// leading zeros + 5 bit length + 32 meaningful bits
+constexpr size_t max_sample_bits = 4 + 32 + 2 + 5 + 5 + 32;
+
+uint32_t floatBits(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+float bitsFloat(uint32_t bits) {
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+uint8_t leadingZeros(uint32_t value) {
+  uint8_t n = 0;
+  for (uint32_t mask = 0x80000000u; mask && !(value & mask); mask >>= 1) ++n;
+  return n;
+}
+
+uint8_t trailingZeros(uint32_t value) {
+  uint8_t n = 0;
+  for (uint32_t mask = 1; mask && !(value & mask); mask <<= 1) ++n;
+  return n;
+}
+
+// Most significant bit first; the block data starts zeroed
+void putBits(uint8_t* data, uint16_t& pos, uint32_t value, unsigned count) {
+  for (unsigned i = count; i-- > 0; ++pos)
+    if ((value >> i) & 1u) data[pos >> 3] |= 0x80u >> (pos & 7);
+}
+
+struct BitReader {
+  const uint8_t* data;
+  size_t pos = 0;
+
+  bool bit() {
+    const bool set = (data[pos >> 3] >> (7 - (pos & 7))) & 1u;
+    ++pos;
+    return set;
+  }
+
+  uint32_t bits(unsigned count) {
+    uint32_t value = 0;
+    while (count--) value = (value << 1) | (bit() ? 1u : 0u);
+    return value;
+  }
+};
+
+int64_t signExtend(uint32_t value, unsigned count) {
+  if (count == 32) return static_cast<int32_t>(value);
+  const uint32_t sign = 1u << (count - 1);
+  return static_cast<int64_t>(value ^ sign) - sign;
+}
+
+}  // namespace
+
+bool TimeSeriesStore::append(uint16_t series, uint64_t timestamp,
+                             float value) {
+  if (series == 0) return false;
+
+  Block* block = openBlock(series);
+  if (block) {
+    if (timestamp < block->last_time) return false;
+    const int64_t delta = static_cast<int64_t>(timestamp - block->last_time);
+    const int64_t dod = delta - block->last_delta;
+    const bool fits = dod >= std::numeric_limits<int32_t>::min() &&
+                      dod <= std::numeric_limits<int32_t>::max() &&
+                      block->bit_size + max_sample_bits <= block_bytes * 8 &&
+                      block->count < std::numeric_limits<uint16_t>::max();
+    if (!fits) {
+      block->open = false;
+      block = nullptr;
+    } else {
+      uint8_t* data = block->data.data();
+      uint16_t& pos = block->bit_size;
+
+      // Timestamp: delta-of-delta in the smallest of four ranges
+      if (dod == 0) {
+        putBits(data, pos, 0b0, 1);
+      } else if (dod >= -64 && dod <= 63) {
+        putBits(data, pos, 0b10, 2);
+        putBits(data, pos, static_cast<uint32_t>(dod), 7);
+      } else if (dod >= -256 && dod <= 255) {
+        putBits(data, pos, 0b110, 3);
+        putBits(data, pos, static_cast<uint32_t>(dod), 9);
+      } else if (dod >= -2048 && dod <= 2047) {
+        putBits(data, pos, 0b1110, 4);
+        putBits(data, pos, static_cast<uint32_t>(dod), 12);
+      } else {
+        putBits(data, pos, 0b1111, 4);
+        putBits(data, pos, static_cast<uint32_t>(dod), 32);
+      }
+
+      // Value: XOR with the previous one
+      const uint32_t bits = floatBits(value);
+      const uint32_t x = bits ^ block->last_bits;
+      if (x == 0) {
+        putBits(data, pos, 0b0, 1);
+      } else {
+        const uint8_t leading = leadingZeros(x);
+        const uint8_t trailing = trailingZeros(x);
+        if (block->leading != 0xff && leading >= block->leading &&
+            trailing >= block->trailing) {
+          putBits(data, pos, 0b10, 2);
+          putBits(data, pos, x >> block->trailing,
+                  32 - block->leading - block->trailing);
+        } else {
+          const unsigned length = 32 - leading - trailing;
+          putBits(data, pos, 0b11, 2);
+          putBits(data, pos, leading, 5);
+          putBits(data, pos, length - 1, 5);
+          putBits(data, pos, x >> trailing, length);
+          block->leading = leading;
+          block->trailing = trailing;
+        }
+      }
+
+      block->last_delta = delta;
+      block->last_bits = bits;
+      block->last_time = timestamp;
+      ++block->count;
+      return true;
+    }
+  }
+
+  // First sample of a block: the timestamp lives in the header, the value
+  // is stored raw
+  Block& fresh = allocateBlock();
+  fresh.series = series;
+  fresh.open = true;
+  fresh.count = 1;
+  fresh.first_time = timestamp;
+  fresh.last_time = timestamp;
+  fresh.last_bits = floatBits(value);
+  putBits(fresh.data.data(), fresh.bit_size, fresh.last_bits, 32);
+  return true;
+}
+
+void TimeSeriesStore::erase(uint16_t series) {
+  for (auto& block : blocks_)
+    if (block.series == series) block = Block{};
+}
+
+void TimeSeriesStore::clear() {
+  blocks_.clear();
+  blocks_.shrink_to_fit();
+}
+
+size_t TimeSeriesStore::sampleCount() const {
+  size_t count = 0;
+  for (const auto& block : blocks_)
+    if (block.series != 0) count += block.count;
+  return count;
+}
+
+TimeSeriesStore::Block* TimeSeriesStore::openBlock(uint16_t series) {
+  for (auto& block : blocks_)
+    if (block.series == series && block.open) return &block;
+  return nullptr;
+}
+
+TimeSeriesStore::Block& TimeSeriesStore::allocateBlock() {
+  for (auto& block : blocks_)
+    if (block.series == 0) return block;
+
+  // Reserved in full so that the vector never grows beyond max_blocks
+  if (blocks_.empty()) blocks_.reserve(max_blocks);
+  if (blocks_.size() < max_blocks) return blocks_.emplace_back();
+
+  // Pool exhausted: reuse the block whose newest sample is the oldest
+  auto oldest = std::min_element(
+      blocks_.begin(), blocks_.end(), [](const Block& a, const Block& b) {
+        return a.last_time < b.last_time;
+      });
+  *oldest = Block{};
+  ++evictions_;
+  return *oldest;
+}
+
+template <typename Visitor>
+void TimeSeriesStore::scan(uint16_t series, uint64_t from, uint64_t to,
+                           Visitor&& visitor) const {
+  if (series == 0 || from > to) return;
+
+  std::vector<const Block*> ordered;
+  for (const auto& block : blocks_)
+    if (block.series == series && block.last_time >= from &&
+        block.first_time <= to)
+      ordered.push_back(&block);
+  std::sort(ordered.begin(), ordered.end(),
+            [](const Block* a, const Block* b) {
+              return a->first_time < b->first_time;
+            });
+
+  for (const Block* block : ordered) {
+    BitReader reader{block->data.data()};
+    uint64_t timestamp = block->first_time;
+    uint32_t bits = reader.bits(32);
+    int64_t delta = 0;
+    uint8_t leading = 0;
+    uint8_t trailing = 0;
+
+    for (uint16_t i = 0; i < block->count; ++i) {
+      if (i > 0) {
+        unsigned width = 0;
+        if (reader.bit()) {
+          if (!reader.bit())
+            width = 7;
+          else if (!reader.bit())
+            width = 9;
+          else if (!reader.bit())
+            width = 12;
+          else
+            width = 32;
+        }
+        if (width) delta += signExtend(reader.bits(width), width);
+        timestamp += static_cast<uint64_t>(delta);
+
+        if (reader.bit()) {
+          if (reader.bit()) {
+            leading = static_cast<uint8_t>(reader.bits(5));
+            trailing =
+                static_cast<uint8_t>(32 - leading - (reader.bits(5) + 1));
+          }
+          bits ^= reader.bits(32 - leading - trailing) << trailing;
+        }
+      }
+      if (timestamp > to) return;
+      if (timestamp >= from) visitor(timestamp, bitsFloat(bits));
+    }
+  }
+}
+
+void TimeSeriesStore::forEach(uint16_t series, uint64_t from, uint64_t to,
+                              const SampleVisitor& visitor) const {
+  if (!visitor) return;
+  scan(series, from, to,
+       [&](uint64_t timestamp, float value) { visitor(timestamp, value); });
+}
+
+void TimeSeriesStore::downsample(uint16_t series, uint64_t from, uint64_t to,
+                                 uint32_t step,
+                                 const BucketVisitor& visitor) const {
+  if (!visitor) return;
+
+  Bucket bucket;
+  double sum = 0.0;
+  auto flush = [&] {
+    if (bucket.count == 0) return;
+    bucket.mean = static_cast<float>(sum / bucket.count);
+    visitor(bucket);
+  };
+
+  scan(series, from, to, [&](uint64_t timestamp, float value) {
+    const uint64_t start =
+        step ? from + (timestamp - from) / step * step : from;
+    if (bucket.count == 0 || start != bucket.start) {
+      flush();
+      bucket = Bucket{start, 0, value, value, 0.0f};
+      sum = 0.0;
+    }
+    ++bucket.count;
+    bucket.min = std::min(bucket.min, value);
+    bucket.max = std::max(bucket.max, value);
+    sum += value;
+  });
+  flush();
+}
+
+}  // namespace ebus::detail
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ebus/detail/delegate.hpp>
+#include <ebus/detail/protocol_limits.hpp>
+#include <vector>
+
+namespace ebus::detail {
+
+/**
+ * Compressed in-memory history of float samples for several series.
+ *
+ * Samples are packed into fixed-size blocks with the Gorilla scheme:
+ * timestamps as delta-of-delta in 1 to 36 bits, values as the XOR with the
+ * previous value, stored as a single bit when unchanged and otherwise as its
+ * meaningful bits, reusing the previous leading/trailing-zero window when it
+ * fits. All series share a pool of at most HistoryLimits::max_bytes; once it
+ * is exhausted, the block with the oldest samples is evicted and reused.
+ * The pool is allocated in full on first use.
+ *
+ * Not thread-safe; the owner serializes access.
+ */
+class TimeSeriesStore {
+ public:
+  struct Bucket {
+    uint64_t start = 0;  // first timestamp of the bucket interval
+    uint32_t count = 0;
+    float min = 0.0f;
+    float max = 0.0f;
+    float mean = 0.0f;
+  };
+
+  using SampleVisitor = Delegate<void(uint64_t timestamp, float value)>;
+  using BucketVisitor = Delegate<void(const Bucket& bucket)>;
+
+  static constexpr size_t block_bytes = HistoryLimits::block_bytes;
+
+  TimeSeriesStore() = default;
+
+  TimeSeriesStore(const TimeSeriesStore&) = delete;
+  TimeSeriesStore& operator=(const TimeSeriesStore&) = delete;
+
+  // Working Methods
+  /**
+   * @brief Appends a sample to a series (1..65535).
+   * @return false if the sample is older than the last one of the series.
+   */
+  bool append(uint16_t series, uint64_t timestamp, float value);
+  void erase(uint16_t series);
+  void clear();
+
+  // Visits the samples of a series in [from, to] in time order
+  void forEach(uint16_t series, uint64_t from, uint64_t to,
+               const SampleVisitor& visitor) const;
+
+  // Aggregates the samples in [from, to] into buckets of step ms aligned to
+  // from; empty buckets are skipped
+  void downsample(uint16_t series, uint64_t from, uint64_t to, uint32_t step,
+                  const BucketVisitor& visitor) const;
+
+  // Status/Telemetry
+  size_t sampleCount() const;
+  size_t blockCount() const { return blocks_.size(); }
+  size_t memoryUsage() const { return blocks_.capacity() * sizeof(Block); }
+  uint64_t evictions() const { return evictions_; }
+  static constexpr size_t capacity() { return max_blocks * sizeof(Block); }
+
+ private:
+  struct Block {
+    uint16_t series = 0;  // 0 = free
+    bool open = false;    // still appended to
+    uint16_t count = 0;
+    uint16_t bit_size = 0;
+    uint64_t first_time = 0;
+    uint64_t last_time = 0;
+
+    // Encoder state, valid while open
+    int64_t last_delta = 0;
+    uint32_t last_bits = 0;
+    uint8_t leading = 0xff;  // 0xff: no window yet
+    uint8_t trailing = 0;
+
+    std::array<uint8_t, block_bytes> data{};
+  };
+
+  static constexpr size_t max_blocks =
+      HistoryLimits::max_bytes / sizeof(Block) > 2
+          ? HistoryLimits::max_bytes / sizeof(Block)
+          : 2;
+
+  std::vector<Block> blocks_;
+  uint64_t evictions_ = 0;
+
+  Block* openBlock(uint16_t series);
+  Block& allocateBlock();
+
+  template <typename Visitor>
+  void scan(uint16_t series, uint64_t from, uint64_t to,
+            Visitor&& visitor) const;
+};
+
+}  // namespace ebus::detail
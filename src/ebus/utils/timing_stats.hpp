@@ -5,17 +5,21 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <ebus/metrics.hpp>
 #include <ebus/utils.hpp>
 
+#include "utils/latency_histogram.hpp"
+
 namespace ebus::detail {
 
 /**
  * Specialized metric tracker for measuring durations between time points
- * and generic value samples.
+ * and generic value samples. Unless built with EBUS_MINIMAL_DIAGNOSTICS, each
+ * sample is also recorded in a fixed-size latency histogram for percentiles.
  */
 class TimingStats {
  public:
@@ -35,6 +39,9 @@ class TimingStats {
     sum_.fetch_add(value, std::memory_order_relaxed);
     updateMaxAtomic(max_, value);
     count_.fetch_add(1, std::memory_order_relaxed);
+#ifndef EBUS_MINIMAL_DIAGNOSTICS
+    histogram_.record(value);
+#endif
   }
 
   inline void reset() {
@@ -43,6 +50,19 @@ class TimingStats {
     sum_.store(0, std::memory_order_relaxed);
     count_.store(0, std::memory_order_relaxed);
     marked_.store(false, std::memory_order_relaxed);
+#ifndef EBUS_MINIMAL_DIAGNOSTICS
+    histogram_.reset();
+#endif
+  }
+
+  /**
+   * @brief Starts a new percentile window. Cumulative last/max/mean/count are
+   * kept; only the histogram is cleared.
+   */
+  inline void resetWindow() {
+#ifndef EBUS_MINIMAL_DIAGNOSTICS
+    histogram_.reset();
+#endif
   }
 
   inline void markBegin(const Clock::time_point& begin = Clock::now()) {
@@ -75,10 +95,17 @@ class TimingStats {
 
   // Status/Telemetry
   inline MetricValues getValues() const {
-    return {last_.load(std::memory_order_relaxed),
-            max_.load(std::memory_order_relaxed),
-            sum_.load(std::memory_order_relaxed),
-            count_.load(std::memory_order_relaxed)};
+    MetricValues values{last_.load(std::memory_order_relaxed),
+                        max_.load(std::memory_order_relaxed),
+                        sum_.load(std::memory_order_relaxed),
+                        count_.load(std::memory_order_relaxed)};
+#ifndef EBUS_MINIMAL_DIAGNOSTICS
+    // Bucket bounds may exceed the observed peak; never report above max.
+    values.p50_us = std::min(histogram_.valueAtPercentile(50.0f), values.max_us);
+    values.p95_us = std::min(histogram_.valueAtPercentile(95.0f), values.max_us);
+    values.p99_us = std::min(histogram_.valueAtPercentile(99.0f), values.max_us);
+#endif
+    return values;
   }
   uint32_t getLast() const { return last_.load(std::memory_order_relaxed); }
   uint64_t getCount() const { return count_.load(std::memory_order_relaxed); }
@@ -90,6 +117,9 @@ class TimingStats {
   std::atomic<uint64_t> count_{0};
   std::atomic<bool> marked_{false};
   std::atomic<uint64_t> begin_time_us_{0};
+#ifndef EBUS_MINIMAL_DIAGNOSTICS
+  LatencyHistogram histogram_;
+#endif
 };
 
 }  // namespace ebus::detail
\ No newline at end of file
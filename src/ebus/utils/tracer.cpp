@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "utils/tracer.hpp"
+
+#include <algorithm>
+#include <ebus/detail/json_writer.hpp>
+#include <string_view>
+
+namespace ebus::detail {
+
+void Tracer::toJson(JsonWriter& writer) const {
+  constexpr uint64_t capacity = TraceLimits::events_per_thread;
+  constexpr int pid = 1;
+
+  auto scope = writer.objectScope();
+  {
+    auto events = writer.arrayScope("traceEvents");
+    for (size_t tid = 0; tid < rings_.size(); ++tid) {
+      const Ring& r = rings_[tid];
+      const uint64_t head = r.head.load(std::memory_order_acquire);
+      if (head == 0) continue;
+
+      // Thread name metadata
+      char name[TraceLimits::thread_name_size] = "ebus_thread";
+      if (r.named.load(std::memory_order_acquire)) {
+        for (size_t i = 0; i < sizeof(name); ++i)
+          name[i] = r.name[i].load(std::memory_order_relaxed);
+        name[sizeof(name) - 1] = '\0';
+      }
+      {
+        auto meta = writer.objectScope();
+        writer.writeField("name", "thread_name");
+        writer.writeField("ph", "M");
+        writer.writeField("pid", pid);
+        writer.writeField("tid", tid);
+        auto args = writer.objectScope("args");
+        writer.writeField("name", std::string_view(name));
+      }
+
+      uint64_t begin = head > capacity ? head - capacity : 0;
+      begin = std::max(begin, r.cleared.load(std::memory_order_relaxed));
+      for (uint64_t index = begin; index < head; ++index) {
+        const Event& event = r.events[index % capacity];
+        const char* event_name = event.name.load(std::memory_order_relaxed);
+        const uint64_t ts_us = event.ts_us.load(std::memory_order_relaxed);
+        const uint32_t dur_us = event.dur_us.load(std::memory_order_relaxed);
+        const char phase = event.phase.load(std::memory_order_relaxed);
+
+        // Skip the slot if the owner thread started overwriting it meanwhile
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (index + capacity < r.claimed.load(std::memory_order_relaxed) ||
+            !event_name)
+          continue;
+
+        auto entry = writer.objectScope();
+        writer.writeField("name", event_name);
+        writer.writeField("cat", "ebus");
+        writer.writeField("ph", std::string_view(&phase, 1));
+        writer.writeField("ts", ts_us);
+        if (phase == 'X') writer.writeField("dur", dur_us);
+        if (phase == 'i') writer.writeField("s", "t");
+        writer.writeField("pid", pid);
+        writer.writeField("tid", tid);
+      }
+    }
+  }
+  writer.writeField("displayTimeUnit", "ms");
+}
+
+}  // namespace ebus::detail
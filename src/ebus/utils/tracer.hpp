@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ebus/detail/protocol_limits.hpp>
+#include <ebus/types.hpp>
+
+namespace ebus::detail {
+
+class JsonWriter;  // Forward declaration
+
+/**
+ * Timeline tracer recording into per-thread lock-free ring buffers. Each
+ * thread claims its own ring on first use, so recording never contends; the
+ * dump reads concurrently and skips events overwritten meanwhile (seqlock
+ * style). Rings are returned when their thread exits and reused by later
+ * threads. Use the EBUS_TRACE_* macros, which compile to nothing unless the
+ * library is built with EBUS_TRACING.
+ */
+class Tracer {
+ public:
+  // Lifecycle
+  static Tracer& getInstance() {
+    static Tracer instance;
+    return instance;
+  }
+
+  // Working Methods
+  /**
+   * @brief Names the calling thread in the trace (copied, may be truncated).
+   */
+  void setThreadName(const char* name) {
+    Ring* r = ring();
+    if (!r) return;
+    r->named.store(false, std::memory_order_relaxed);
+    size_t i = 0;
+    for (; name && name[i] && i + 1 < TraceLimits::thread_name_size; ++i)
+      r->name[i].store(name[i], std::memory_order_relaxed);
+    r->name[i].store('\0', std::memory_order_relaxed);
+    r->named.store(true, std::memory_order_release);
+  }
+
+  /**
+   * @brief Records a duration event. name must have static storage duration.
+   */
+  void complete(const char* name, uint64_t begin_us, uint64_t end_us) {
+    record(name, begin_us, static_cast<uint32_t>(end_us - begin_us), 'X');
+  }
+
+  /**
+   * @brief Records an instant event. name must have static storage duration.
+   */
+  void instant(const char* name) { record(name, nowUs(), 0, 'i'); }
+
+  /**
+   * @brief Hides all events recorded so far from subsequent dumps.
+   */
+  void clear() {
+    for (auto& r : rings_)
+      r.cleared.store(r.head.load(std::memory_order_acquire),
+                      std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Writes all rings as a Chrome trace-event JSON object, loadable in
+   * chrome://tracing and Perfetto.
+   */
+  void toJson(JsonWriter& writer) const;
+
+  // Status/Telemetry
+  /**
+   * @brief Number of threads that found no free ring and were not traced.
+   */
+  uint32_t untracedThreads() const {
+    return untraced_threads_.load(std::memory_order_relaxed);
+  }
+
+  static uint64_t nowUs() {
+    return static_cast<uint64_t>(Clock::now().time_since_epoch().count());
+  }
+
+  /**
+   * RAII helper recording the lifetime of a scope as a duration event.
+   */
+  class Scope {
+   public:
+    explicit Scope(const char* name) : name_(name), begin_us_(nowUs()) {}
+    ~Scope() { getInstance().complete(name_, begin_us_, nowUs()); }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    const char* name_;
+    uint64_t begin_us_;
+  };
+
+ private:
+  struct Event {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> ts_us{0};
+    std::atomic<uint32_t> dur_us{0};
+    std::atomic<char> phase{'i'};
+  };
+
+  struct Ring {
+    std::atomic<bool> in_use{false};
+    std::atomic<bool> named{false};
+    std::array<std::atomic<char>, TraceLimits::thread_name_size> name{};
+    std::atomic<uint64_t> claimed{0};  // bumped before a slot is written
+    std::atomic<uint64_t> head{0};     // bumped after a slot is written
+    std::atomic<uint64_t> cleared{0};
+    std::array<Event, TraceLimits::events_per_thread> events{};
+  };
+
+  /**
+   * Releases the ring of a thread when the thread exits.
+   */
+  struct ThreadHandle {
+    Ring* ring = nullptr;
+    bool exhausted = false;
+    ~ThreadHandle() {
+      if (ring) ring->in_use.store(false, std::memory_order_release);
+    }
+  };
+
+  std::array<Ring, TraceLimits::max_threads> rings_{};
+  std::atomic<uint32_t> untraced_threads_{0};
+
+  Tracer() = default;
+
+  Ring* ring() {
+    static thread_local ThreadHandle handle;
+    if (handle.ring || handle.exhausted) return handle.ring;
+
+    for (auto& r : rings_) {
+      bool expected = false;
+      if (r.in_use.compare_exchange_strong(expected, true,
+                                           std::memory_order_acq_rel)) {
+        r.named.store(false, std::memory_order_relaxed);
+        handle.ring = &r;
+        return handle.ring;
+      }
+    }
+    handle.exhausted = true;
+    untraced_threads_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  void record(const char* name, uint64_t ts_us, uint32_t dur_us, char phase) {
+    Ring* r = ring();
+    if (!r) return;
+
+    const uint64_t index = r->head.load(std::memory_order_relaxed);
+    r->claimed.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Event& event = r->events[index % TraceLimits::events_per_thread];
+    event.name.store(name, std::memory_order_relaxed);
+    event.ts_us.store(ts_us, std::memory_order_relaxed);
+    event.dur_us.store(dur_us, std::memory_order_relaxed);
+    event.phase.store(phase, std::memory_order_relaxed);
+
+    r->head.store(index + 1, std::memory_order_release);
+  }
+};
+
+}  // namespace ebus::detail
+
+/**
+ * Trace macros compile to nothing unless EBUS_TRACING is defined, so trace
+ * points cost nothing in regular builds.
+ */
+#ifdef EBUS_TRACING
+#define EBUS_TRACE_CONCAT_IMPL(a, b) a##b
+#define EBUS_TRACE_CONCAT(a, b) EBUS_TRACE_CONCAT_IMPL(a, b)
+#define EBUS_TRACE_SCOPE(name)                     \
+  ::ebus::detail::Tracer::Scope EBUS_TRACE_CONCAT( \
+      ebus_trace_scope_, __LINE__)(name)
+#define EBUS_TRACE_INSTANT(name) \
+  ::ebus::detail::Tracer::getInstance().instant(name)
+#define EBUS_TRACE_THREAD(name) \
+  ::ebus::detail::Tracer::getInstance().setThreadName(name)
+#else
+#define EBUS_TRACE_SCOPE(name) ((void)0)
+#define EBUS_TRACE_INSTANT(name) ((void)0)
+#define EBUS_TRACE_THREAD(name) ((void)0)
+#endif
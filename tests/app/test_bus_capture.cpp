@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#include "app/bus_capture.hpp"
+#include "utils/capture_reader.hpp"
+
+using namespace ebus;
+using namespace ebus::detail;
+
+namespace {
+
+bool exists(const std::string& path) {
+  FILE* file = std::fopen(path.c_str(), "rb");
+  if (!file) return false;
+  std::fclose(file);
+  return true;
+}
+
+}  // namespace
+
+TEST_CASE("BusCapture: writes rotating segments", "[app][capture]") {
+  const std::string prefix = "test_bus_capture";
+  BusCapture capture;
+  REQUIRE(capture.start(prefix, CaptureLimits::min_segment_size, 2));
+  CHECK(capture.isActive());
+  CHECK_FALSE(capture.start(prefix));
+
+  // ~4 bytes per record: 1000 records span several 1 KiB segments
+  const size_t total = 1000;
+  Clock::time_point ts = Clock::now();
+  for (size_t i = 0; i < total; ++i) {
+    capture.record(BusEventInfo(static_cast<uint8_t>(i),
+                                HandlerState::request_bus, RequestState::first,
+                                RequestResult::first_won, 0, ts));
+    ts += std::chrono::microseconds(4170);
+    // Let the writer catch up so that no record is dropped
+    while (capture.stats().records + 64 < i)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  capture.stop();
+  CHECK_FALSE(capture.isActive());
+
+  BusCapture::Stats stats = capture.stats();
+  CHECK(stats.records == total);
+  CHECK(stats.dropped == 0);
+  REQUIRE(stats.segments >= 3);
+
+  // Only the newest two segments survive
+  const uint32_t last = stats.segments - 1;
+  CHECK_FALSE(exists(BusCapture::segmentPath(prefix, last - 2)));
+  REQUIRE(exists(BusCapture::segmentPath(prefix, last - 1)));
+  REQUIRE(exists(BusCapture::segmentPath(prefix, last)));
+
+  // Segments are self-contained and continue each other
+  uint64_t previous_ts = 0;
+  size_t count = 0;
+  for (uint32_t index = last - 1; index <= last; ++index) {
+    CaptureReader reader;
+    REQUIRE(reader.open(BusCapture::segmentPath(prefix, index).c_str()));
+    CHECK(reader.size() <= CaptureLimits::min_segment_size);
+    count += reader.forEach([&](const capture::Record& record) {
+      CHECK(record.timestamp_us > previous_ts);
+      CHECK(record.handler_state == HandlerState::request_bus);
+      CHECK(record.request_state == RequestState::first);
+      CHECK(record.result == RequestResult::first_won);
+      previous_ts = record.timestamp_us;
+    });
+    std::remove(BusCapture::segmentPath(prefix, index).c_str());
+  }
+  CHECK(count > 0);
+  CHECK(previous_ts ==
+        static_cast<uint64_t>((ts - std::chrono::microseconds(4170))
+                                  .time_since_epoch()
+                                  .count()));
+}
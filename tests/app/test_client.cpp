@@ -211,3 +211,210 @@ TEST_CASE("EnhancedClient: Invalid protocol handling",
   close(sv[0]);
   close(sv[1]);
 }
+
+TEST_CASE("Clients: Shared broadcast ring", "[app][client][broadcast]") {
+  int ro[2];
+  int en[2];
+  REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, ro) == 0);
+  REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, en) == 0);
+
+  Request req;
+  BroadcastRing raw(64);
+  BroadcastRing encoded(64);
+  ReadOnlyClient reader(std::make_unique<platform::Socket>(ro[0]), &req,
+                        ebus::RuntimeConfig{}.network.outbound_buffer_size,
+                        &raw);
+  EnhancedClient enhanced(std::make_unique<platform::Socket>(en[0]), &req,
+                          ebus::RuntimeConfig{}.network.outbound_buffer_size,
+                          &encoded);
+  REQUIRE(reader.sharesBroadcast());
+  REQUIRE(enhanced.sharesBroadcast());
+
+  auto publish = [&](uint8_t byte) {
+    if (byte == ebus::Symbols::syn) {
+      raw.markBoundary();
+      encoded.markBoundary();
+    }
+    raw.append(&byte, 1);
+    uint8_t out[2];
+    encoded.append(out, enhanced::Protocol::encodeReceived(byte, out));
+  };
+
+  SECTION("Bytes are sent from the ring") {
+    publish(0x10);
+    publish(ebus::Symbols::syn);
+    REQUIRE(reader.hasPendingOutgoingData());
+    REQUIRE(reader.flushOutgoingData());
+    REQUIRE_FALSE(reader.hasPendingOutgoingData());
+
+    uint8_t buf[4];
+    REQUIRE(recv(ro[1], buf, sizeof(buf), 0) == 2);
+    CHECK(buf[0] == 0x10);
+    CHECK(buf[1] == ebus::Symbols::syn);
+
+    REQUIRE(enhanced.flushOutgoingData());
+    REQUIRE(recv(en[1], buf, sizeof(buf), 0) == 3);
+    CHECK(buf[0] == 0x10);
+    CHECK(buf[1] == 0xc6);  // received 0xaa
+    CHECK(buf[2] == 0xaa);
+  }
+
+  SECTION("Responses keep their place in the stream") {
+    publish(0x10);
+
+    // CMD_INIT is answered after the byte published before it
+    uint8_t init_cmd[2];
+    enhanced::Protocol::encode(0x00, 0x00, init_cmd);
+    enhanced.handleIncomingStream(init_cmd, 2);
+    publish(0x20);
+
+    REQUIRE(enhanced.flushOutgoingData());
+    uint8_t buf[8];
+    REQUIRE(recv(en[1], buf, sizeof(buf), 0) == 4);
+    CHECK(buf[0] == 0x10);
+    CHECK(buf[1] == 0xc0);  // resetted
+    CHECK(buf[2] == 0x80);
+    CHECK(buf[3] == 0x20);
+  }
+
+  SECTION("Arbitration result replaces the published byte") {
+    req.setLockCounter(0);
+    if (req.busAvailable()) req.requestBus(0x33, true);
+    req.busRequestCompleted();
+    req.run(ebus::Symbols::syn);
+    req.run(0x33);
+    REQUIRE(req.getResult() == ebus::RequestResult::first_won);
+
+    // The active sender answers before the byte is published
+    enhanced.onBusByte({0x33, ebus::HandlerState::passive_receive_master,
+                        req.getState(), req.getResult(), req.getLockCounter(),
+                        ebus::Clock::now()});
+    publish(0x33);
+
+    REQUIRE(enhanced.flushOutgoingData());
+    uint8_t buf[8];
+    REQUIRE(recv(en[1], buf, sizeof(buf), 0) == 2);
+    uint8_t started[2];
+    enhanced::Protocol::encode(enhanced::Response::started, 0x33, started);
+    CHECK(buf[0] == started[0]);
+    CHECK(buf[1] == started[1]);
+  }
+
+  SECTION("Lagging clients drop the oldest bytes") {
+    // More than half of the ring behind: a quarter of it is kept
+    for (int i = 0; i < 40; ++i) publish(static_cast<uint8_t>(i));
+    REQUIRE(reader.flushOutgoingData());
+    ebus::ClientInfo info = reader.getClientInfo();
+    CHECK(info.dropped_bytes == 24);
+    CHECK(info.overflows == 1);
+    CHECK(info.lag_bytes == 0);
+    CHECK(std::string(info.slow_policy.c_str()) == "drop_oldest");
+
+    uint8_t buf[32];
+    REQUIRE(recv(ro[1], buf, sizeof(buf), 0) == 16);
+    CHECK(buf[0] == 24);
+    CHECK(buf[15] == 39);
+  }
+
+  SECTION("Enhanced clients resume at a sequence start") {
+    for (int i = 0; i < 20; ++i) publish(0x90);  // two bytes each
+    publish(0x01);
+    REQUIRE(enhanced.flushOutgoingData());
+    CHECK(enhanced.getClientInfo().dropped_bytes == 26);
+
+    uint8_t buf[32];
+    REQUIRE(recv(en[1], buf, sizeof(buf), 0) == 15);
+    CHECK((buf[0] & 0xc0) == 0xc0);
+    CHECK(buf[14] == 0x01);
+  }
+
+  SECTION("Lagging clients skip to a telegram start") {
+    reader.setSlowPolicy(ebus::SlowClientPolicy::skip_to_syn);
+    for (int i = 0; i < 30; ++i) publish(0x01);
+    publish(ebus::Symbols::syn);
+    for (int i = 0; i < 5; ++i) publish(0x02);
+    REQUIRE(reader.flushOutgoingData());
+    CHECK(reader.getClientInfo().dropped_bytes == 30);
+
+    uint8_t buf[32];
+    REQUIRE(recv(ro[1], buf, sizeof(buf), 0) == 6);
+    CHECK(buf[0] == ebus::Symbols::syn);
+    CHECK(buf[5] == 0x02);
+  }
+
+  SECTION("Without a recent SYN the client waits for the next one") {
+    reader.setSlowPolicy(ebus::SlowClientPolicy::skip_to_syn);
+    for (int i = 0; i < 40; ++i) publish(0x01);
+    REQUIRE(reader.flushOutgoingData());
+    CHECK_FALSE(reader.hasPendingOutgoingData());
+
+    publish(0x03);
+    publish(ebus::Symbols::syn);
+    publish(0x04);
+    REQUIRE(reader.flushOutgoingData());
+    CHECK(reader.getClientInfo().dropped_bytes == 41);
+
+    uint8_t buf[8];
+    REQUIRE(recv(ro[1], buf, sizeof(buf), 0) == 2);
+    CHECK(buf[0] == ebus::Symbols::syn);
+    CHECK(buf[1] == 0x04);
+  }
+
+  SECTION("Lagging clients can be disconnected") {
+    reader.setSlowPolicy(ebus::SlowClientPolicy::disconnect);
+    for (int i = 0; i < 40; ++i) publish(0x01);
+    CHECK_FALSE(reader.flushOutgoingData());
+    CHECK_FALSE(reader.isConnected());
+    CHECK(reader.getClientInfo().overflows == 1);
+  }
+
+  close(ro[0]);
+  close(ro[1]);
+  close(en[0]);
+  close(en[1]);
+}
+
+TEST_CASE("Clients: Bridge latency stages", "[app][client][latency]") {
+  int sv[2];
+  REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+
+  Request req;
+  BridgeLatency aggregate;
+  RegularClient client(std::make_unique<platform::Socket>(sv[0]), &req,
+                       ebus::RuntimeConfig{}.network.outbound_buffer_size);
+  client.setLatencyAggregate(&aggregate);
+
+  const uint8_t sent[2] = {0x33, 0xfe};
+  client.handleIncomingStream(sent, sizeof(sent));
+
+  ebus::BusEventInfo info;
+  for (size_t i = 0; i < sizeof(sent); ++i) {
+    uint8_t byte = 0;
+    REQUIRE(client.popPendingIncomingData(byte));
+    info.byte = byte;
+    info.result = i == 0 ? ebus::RequestResult::first_won
+                         : ebus::RequestResult::observe_data;
+    REQUIRE(client.onBusByte(info) == BridgeAction::bypass_wait);
+    REQUIRE(client.flushOutgoingData());
+  }
+
+  // Foreign traffic is not timed
+  info.byte = 0x10;
+  client.onBusByte(info);
+  REQUIRE(client.flushOutgoingData());
+
+  const ebus::BridgeLatencyValues latency = client.getClientInfo().latency;
+  CHECK(latency.receive_to_write.count == 2);
+  CHECK(latency.write_to_echo.count == 2);
+  CHECK(latency.echo_to_send.count == 2);
+  CHECK(latency.total.count == 2);
+  CHECK(latency.total.max_us >= latency.echo_to_send.max_us);
+  CHECK(aggregate.getValues().total.count == 2);
+
+  uint8_t buf[4];
+  REQUIRE(recv(sv[1], buf, 2, MSG_WAITALL) == 2);
+  CHECK(buf[0] == 0x33);
+  CHECK(buf[1] == 0xfe);
+
+  close(sv[1]);
+}
@@ -4,10 +4,12 @@
  */
 
 #include <sys/socket.h>
+#include <sys/un.h>
 #include <unistd.h>
 
 #include <catch2/catch_all.hpp>
 #include <chrono>
+#include <cstring>
 #include <ebus/types.hpp>
 #include <iostream>
 #include <thread>
@@ -281,3 +283,453 @@ TEST_CASE("ClientManager Client Removal") {
   manager.stop();
   close(sv[1]);
 }
+
+TEST_CASE("ClientManager Runtime Client Limits") {
+  Request req;
+  ebus::BusConfig config;
+  ebus::RuntimeConfig runtime = {.address = 0xff};
+  runtime.network.enable_server = false;
+  runtime.network.max_readonly_clients = 6;
+  runtime.network.max_enhanced_clients = 0;
+
+  BusMonitor monitor;
+  platform::Bus bus(config, runtime, &req, &monitor);
+  BusHandler busHandler(&req, nullptr);
+
+  bus.addBusEventListener(Delegate<void(const BusEvent&)>::bind<
+                          BusHandler, &BusHandler::onBusEvent>(&busHandler));
+
+  ClientManager manager(&bus, &busHandler, &req, &monitor);
+  bus.start();
+  manager.start(runtime);
+
+  // More read-only clients than the compile-time default of 4
+  std::vector<int> remotes;
+  for (int i = 0; i < 6; ++i) {
+    int sv[2];
+    socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+    REQUIRE(manager.addClient(std::make_unique<platform::Socket>(sv[0]),
+                              ebus::ClientType::read_only));
+    remotes.push_back(sv[1]);
+  }
+
+  int extra[2];
+  socketpair(AF_UNIX, SOCK_STREAM, 0, extra);
+  CHECK_FALSE(manager.addClient(std::make_unique<platform::Socket>(extra[0]),
+                                ebus::ClientType::read_only));
+
+  int disabled[2];
+  socketpair(AF_UNIX, SOCK_STREAM, 0, disabled);
+  CHECK_FALSE(manager.addClient(
+      std::make_unique<platform::Socket>(disabled[0]),
+      ebus::ClientType::enhanced));
+
+  bus.writeByte(ebus::Symbols::syn);
+
+  for (int fd : remotes) {
+    uint8_t byte = 0;
+    REQUIRE(readFromSocket(fd, &byte, 1));
+    CHECK(byte == ebus::Symbols::syn);
+  }
+
+  ebus::ClientManagerStatus status = manager.fetchStatus();
+  CHECK(status.clients.size() == 6);
+  CHECK(status.client_capacity == runtime.network.max_regular_clients + 6 +
+                                    runtime.network.max_filtered_clients);
+  CHECK(status.rejected_clients == 2);
+  CHECK(status.io_events > 0);
+  CHECK(status.io_iteration.count > 0);
+  CHECK(std::string(status.io_backend.c_str()) ==
+        platform::IoPoller::backend);
+
+  manager.stop();
+  bus.stop();
+  for (int fd : remotes) close(fd);
+  close(extra[1]);
+  close(disabled[1]);
+}
+
+TEST_CASE("ClientManager Read-only Output Coalescing") {
+  Request req;
+  ebus::BusConfig config;
+  ebus::RuntimeConfig runtime = {.address = 0xff};
+  runtime.network.enable_server = false;
+  runtime.network.readonly_flush_on_syn = true;
+
+  BusMonitor monitor;
+  platform::Bus bus(config, runtime, &req, &monitor);
+  BusHandler busHandler(&req, nullptr);
+
+  bus.addBusEventListener(Delegate<void(const BusEvent&)>::bind<
+                          BusHandler, &BusHandler::onBusEvent>(&busHandler));
+
+  ClientManager manager(&bus, &busHandler, &req, &monitor);
+  bus.start();
+  manager.start(runtime);
+
+  int ro[2];
+  socketpair(AF_UNIX, SOCK_STREAM, 0, ro);
+  REQUIRE(manager.addClient(std::make_unique<platform::Socket>(ro[0]),
+                            ebus::ClientType::read_only));
+  int reg[2];
+  socketpair(AF_UNIX, SOCK_STREAM, 0, reg);
+  REQUIRE(manager.addClient(std::make_unique<platform::Socket>(reg[0]),
+                            ebus::ClientType::regular));
+
+  const std::vector<uint8_t> telegram = {0x10, 0x08, 0xb5, 0x10, 0x01, 0x00};
+  for (uint8_t byte : telegram) {
+    bus.writeByte(byte);
+    uint8_t echo = 0;
+    REQUIRE(readFromSocket(reg[1], &echo, 1));
+    CHECK(echo == byte);
+  }
+
+  // The read-only client is held back until the SYN
+  uint8_t early = 0;
+  CHECK(recv(ro[1], &early, 1, MSG_DONTWAIT) < 0);
+
+  bus.writeByte(ebus::Symbols::syn);
+  std::vector<uint8_t> received(telegram.size() + 1);
+  REQUIRE(readFromSocket(ro[1], received.data(), received.size()));
+  CHECK(received.back() == ebus::Symbols::syn);
+
+  ebus::ClientManagerStatus status = manager.fetchStatus();
+  REQUIRE(status.clients.size() == 2);
+  for (const auto& client : status.clients) {
+    if (std::string(client.type.c_str()) == "read_only") {
+      CHECK(client.send_calls == 1);
+      CHECK(client.bytes_per_send == Catch::Approx(received.size()));
+    } else {
+      CHECK(client.send_calls >= telegram.size());
+    }
+    CHECK(client.sends_per_second > 0.0f);
+  }
+
+  manager.stop();
+  bus.stop();
+  close(ro[1]);
+  close(reg[1]);
+}
+
+TEST_CASE("ClientManager Filtered Telegram Subscriptions") {
+  Request req;
+  ebus::BusConfig config;
+  ebus::RuntimeConfig runtime = {.address = 0xff};
+  runtime.network.enable_server = false;
+
+  BusMonitor monitor;
+  platform::Bus bus(config, runtime, &req, &monitor);
+  BusHandler busHandler(&req, nullptr);
+
+  ClientManager manager(&bus, &busHandler, &req, &monitor);
+  manager.start(runtime);
+
+  int sv[2];
+  socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+  REQUIRE(manager.addClient(std::make_unique<platform::Socket>(sv[0]),
+                            ebus::ClientType::filtered));
+
+  auto telegram = [](std::vector<uint8_t> master,
+                     std::vector<uint8_t> slave) {
+    ProtocolEvent ev{};
+    ev.type = ProtocolEvent::Type::telegram;
+    ev.telegram_type = ebus::TelegramType::master_slave;
+    ev.master.assign(master.data(), master.size());
+    ev.slave.assign(slave.data(), slave.size());
+    return ev;
+  };
+
+  // Without rules nothing is forwarded
+  manager.onTelegram(telegram({0x10, 0x08, 0xb5, 0x10, 0x00}, {0x00}));
+
+  // Subscribe to PB/SB B5 09 of any source and target
+  const uint8_t add[] = {0x09, 0x01, 0x00, 0x00, 0x00, 0x00,
+                         0xb5, 0xff, 0x09, 0xff};
+  REQUIRE(write(sv[1], add, sizeof(add)) == sizeof(add));
+
+  uint8_t ack[filtered::Protocol::ack_len];
+  REQUIRE(readFromSocket(sv[1], ack, sizeof(ack)));
+  CHECK(ack[1] == static_cast<uint8_t>(filtered::Frame::ack));
+  CHECK(ack[3] == static_cast<uint8_t>(filtered::Status::ok));
+  CHECK(ack[4] == 1);
+
+  manager.onTelegram(telegram({0x10, 0x08, 0xb5, 0x10, 0x00}, {0x00}));
+  manager.onTelegram(
+      telegram({0x10, 0x15, 0xb5, 0x09, 0x01, 0x0d}, {0x01, 0x42}));
+
+  // Only the matching telegram arrives, as one frame
+  uint8_t frame[13];
+  REQUIRE(readFromSocket(sv[1], frame, sizeof(frame)));
+  CHECK(frame[0] == 12);
+  CHECK(frame[1] == static_cast<uint8_t>(filtered::Frame::telegram));
+  CHECK(frame[4] == 0x10);
+  CHECK(frame[5] == 0x15);
+  CHECK(frame[12] == 0x42);
+  uint8_t extra = 0;
+  CHECK(recv(sv[1], &extra, 1, MSG_DONTWAIT) < 0);
+
+  ebus::ClientManagerStatus status = manager.fetchStatus();
+  REQUIRE(status.clients.size() == 1);
+  CHECK(std::string(status.clients[0].type.c_str()) == "filtered");
+  CHECK_FALSE(status.clients[0].write_capable);
+
+  manager.stop();
+  close(sv[1]);
+}
+
+TEST_CASE("ClientManager Local Socket Listeners") {
+  Request req;
+  ebus::BusConfig config;
+  ebus::RuntimeConfig runtime = {.address = 0xff};
+  runtime.network.enable_server = true;
+  // Local only: no TCP listener for any type
+  runtime.network.port_regular = 0;
+  runtime.network.port_readonly = 0;
+  runtime.network.port_enhanced = 0;
+  runtime.network.port_filtered = 0;
+  const std::string path =
+      "/tmp/ebus_test_" + std::to_string(getpid()) + ".sock";
+  runtime.network.unix_path_regular = path;
+
+  BusMonitor monitor;
+  platform::Bus bus(config, runtime, &req, &monitor);
+  BusHandler busHandler(&req, nullptr);
+
+  bus.addBusEventListener(Delegate<void(const BusEvent&)>::bind<
+                          BusHandler, &BusHandler::onBusEvent>(&busHandler));
+
+  ClientManager manager(&bus, &busHandler, &req, &monitor);
+  bus.start();
+  manager.start(runtime);
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  REQUIRE(fd >= 0);
+  struct sockaddr_un addr = {};
+  addr.sun_family = AF_UNIX;
+  std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+  REQUIRE(connect(fd, reinterpret_cast<struct sockaddr*>(&addr),
+                  sizeof(addr)) == 0);
+
+  ebus::ClientManagerStatus status;
+  for (int i = 0; i < 100; ++i) {
+    status = manager.fetchStatus();
+    if (!status.clients.empty()) break;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  REQUIRE(status.clients.size() == 1);
+  CHECK(std::string(status.clients[0].type.c_str()) == "regular");
+  CHECK(status.clients[0].write_capable);
+
+  // Handled by the regular client class: raw bus bytes
+  bus.writeByte(ebus::Symbols::syn);
+  uint8_t byte = 0;
+  REQUIRE(readFromSocket(fd, &byte, 1));
+  CHECK(byte == ebus::Symbols::syn);
+
+  manager.stop();
+  bus.stop();
+  close(fd);
+
+  // The socket file is removed with the listener
+  CHECK(access(path.c_str(), F_OK) != 0);
+}
+
+namespace {
+
+struct FakeSubmitter {
+  std::vector<uint8_t> message;
+  uint8_t priority = 0;
+  uint32_t next_session = 42;
+
+  uint32_t submit(uint8_t prio, ebus::ByteView msg) {
+    priority = prio;
+    message.assign(msg.begin(), msg.end());
+    return next_session;
+  }
+};
+
+std::vector<uint8_t> encodeSubmit(const std::vector<uint8_t>& message) {
+  std::vector<uint8_t> out;
+  uint8_t seq[2];
+  enhanced::Protocol::encode(enhanced::Command::submit,
+                             static_cast<uint8_t>(message.size()), seq);
+  out.insert(out.end(), seq, seq + 2);
+  for (uint8_t byte : message) {
+    enhanced::Protocol::encode(enhanced::Command::submit, byte, seq);
+    out.insert(out.end(), seq, seq + 2);
+  }
+  return out;
+}
+
+// Reads one result frame: status and payload
+std::vector<uint8_t> readSubmitResult(int fd, uint8_t& status) {
+  uint8_t seq[2];
+  enhanced::Response res;
+  uint8_t len = 0;
+  REQUIRE(readFromSocket(fd, seq, 2));
+  enhanced::Protocol::decode(seq, res, status);
+  REQUIRE(res == enhanced::Response::submitted);
+  REQUIRE(readFromSocket(fd, seq, 2));
+  enhanced::Protocol::decode(seq, res, len);
+  std::vector<uint8_t> payload(len);
+  for (uint8_t& byte : payload) {
+    REQUIRE(readFromSocket(fd, seq, 2));
+    enhanced::Protocol::decode(seq, res, byte);
+  }
+  return payload;
+}
+
+}  // namespace
+
+TEST_CASE("ClientManager Enhanced Telegram Submission") {
+  Request req;
+  ebus::BusConfig config;
+  ebus::RuntimeConfig runtime = {.address = 0xff};
+  runtime.network.enable_server = false;
+
+  BusMonitor monitor;
+  platform::Bus bus(config, runtime, &req, &monitor);
+  BusHandler busHandler(&req, nullptr);
+
+  FakeSubmitter submitter;
+  ClientManager manager(&bus, &busHandler, &req, &monitor);
+  manager.setTelegramSubmitter(
+      Delegate<uint32_t(uint8_t, ebus::ByteView)>::bind<
+          FakeSubmitter, &FakeSubmitter::submit>(&submitter));
+  manager.start(runtime);
+
+  int sv[2];
+  socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+  REQUIRE(manager.addClient(std::make_unique<platform::Socket>(sv[0]),
+                            ebus::ClientType::enhanced));
+
+  // ZZ PB SB NN data, sent by the gateway with its own source address
+  const std::vector<uint8_t> message = {0x08, 0xb5, 0x09, 0x01, 0x0d};
+  const std::vector<uint8_t> submit = encodeSubmit(message);
+  REQUIRE(write(sv[1], submit.data(), submit.size()) ==
+          static_cast<ssize_t>(submit.size()));
+  REQUIRE(waitFor([&] { return !submitter.message.empty(); }));
+  CHECK(submitter.message == message);
+  CHECK(submitter.priority == EnhancedProtocolLimits::submit_priority);
+
+  SECTION("Slave response is returned as one frame") {
+    ProtocolEvent ev{};
+    ev.type = ProtocolEvent::Type::telegram;
+    ev.session_id = 42;
+    const uint8_t slave[] = {0x02, 0x34, 0x12};
+    ev.slave.assign(slave, sizeof(slave));
+    manager.onSessionResult(ev);
+
+    uint8_t status = 0xff;
+    std::vector<uint8_t> payload = readSubmitResult(sv[1], status);
+    CHECK(status == static_cast<uint8_t>(enhanced::SubmitStatus::ok));
+    CHECK(payload == std::vector<uint8_t>(slave, slave + sizeof(slave)));
+
+    // Sessions of other origins are not answered
+    manager.onSessionResult(ev);
+    uint8_t extra = 0;
+    CHECK(recv(sv[1], &extra, 1, MSG_DONTWAIT) < 0);
+  }
+
+  SECTION("Failures carry the protocol error") {
+    ProtocolEvent ev{};
+    ev.type = ProtocolEvent::Type::error;
+    ev.session_id = 42;
+    ev.protocol_error = ebus::ProtocolError::error_active_slave_ack;
+    manager.onSessionResult(ev);
+
+    uint8_t status = 0xff;
+    std::vector<uint8_t> payload = readSubmitResult(sv[1], status);
+    CHECK(status == static_cast<uint8_t>(enhanced::SubmitStatus::failed));
+    REQUIRE(payload.size() == 1);
+    CHECK(payload[0] == static_cast<uint8_t>(
+                            ebus::ProtocolError::error_active_slave_ack));
+  }
+
+  SECTION("Invalid lengths and a full scheduler are rejected") {
+    const std::vector<uint8_t> too_long = encodeSubmit(
+        std::vector<uint8_t>(EnhancedProtocolLimits::max_submit_len + 1));
+    REQUIRE(write(sv[1], too_long.data(), too_long.size()) ==
+            static_cast<ssize_t>(too_long.size()));
+    uint8_t status = 0xff;
+    CHECK(readSubmitResult(sv[1], status).empty());
+    CHECK(status == static_cast<uint8_t>(enhanced::SubmitStatus::rejected));
+
+    submitter.next_session = 0;
+    REQUIRE(write(sv[1], submit.data(), submit.size()) ==
+            static_cast<ssize_t>(submit.size()));
+    CHECK(readSubmitResult(sv[1], status).empty());
+    CHECK(status == static_cast<uint8_t>(enhanced::SubmitStatus::rejected));
+  }
+
+  SECTION("Pending submits are answered on stop") {
+    // More restarts than pending slots: none of them may leak
+    for (size_t i = 0; i <= EnhancedProtocolLimits::max_pending_submits;
+         ++i) {
+      if (i > 0) {
+        submitter.message.clear();
+        REQUIRE(write(sv[1], submit.data(), submit.size()) ==
+                static_cast<ssize_t>(submit.size()));
+        REQUIRE(waitFor([&] { return !submitter.message.empty(); }));
+      }
+      manager.stop();
+      manager.start(runtime);
+
+      uint8_t status = 0xff;
+      CHECK(readSubmitResult(sv[1], status).empty());
+      CHECK(status == static_cast<uint8_t>(enhanced::SubmitStatus::rejected));
+    }
+  }
+
+  manager.stop();
+  close(sv[1]);
+}
+
+TEST_CASE("ClientManager Session Arbitration") {
+  Request request;
+  ebus::BusConfig config;
+  ebus::RuntimeConfig runtime{};
+  runtime.address = 0x01;
+
+  BusMonitor monitor;
+  platform::Bus bus(config, runtime, &request, &monitor);
+  Handler handler(runtime.address, &bus, &request, &monitor);
+  BusHandler busHandler(&request, &handler);
+
+  ClientManager manager(&bus, &busHandler, &request, &monitor);
+  manager.setSessionTimeout(999999);
+  manager.setTransmitTimeout(999999);
+  int wakeups = 0;
+  manager.setLocalSessionWakeup([&]() { wakeups++; });
+
+  int sv[2];
+  socketpair(AF_UNIX, SOCK_STREAM, 0, sv);
+  manager.addClient(std::make_unique<platform::Socket>(sv[0]),
+                    ebus::ClientType::regular);
+  manager.start();
+
+  // Nobody else waits: the scheduler gets the bus at once
+  REQUIRE(manager.acquireLocalSession());
+
+  // A client asking meanwhile waits for the scheduler's turn to end
+  const uint8_t address = 0x33;
+  send(sv[1], &address, 1, 0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  REQUIRE_FALSE(manager.isSessionActive());
+
+  // Then it is the client's turn, although the scheduler wants more
+  manager.releaseLocalSession(true);
+  REQUIRE(waitFor([&] { return manager.isSessionActive(); }));
+  REQUIRE_FALSE(manager.acquireLocalSession());
+
+  auto status = manager.fetchStatus();
+  REQUIRE(status.local_sessions == 1);
+  REQUIRE(status.local_session_share == Catch::Approx(0.5f));
+  REQUIRE(status.clients.size() == 1);
+  REQUIRE(status.clients[0].sessions == 1);
+  REQUIRE(status.clients[0].session_wait_max_ms >= 40.0f);
+  REQUIRE(wakeups == 0);
+
+  manager.stop();
+  close(sv[1]);
+}
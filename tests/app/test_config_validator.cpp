@@ -52,6 +52,40 @@ TEST_CASE("ConfigValidator: Validation Logic", "[detail][config]") {
     REQUIRE(ConfigValidator::validate(config) == false);
     config.runtime.network.port_regular = 3333;
 
+    // Metrics endpoint: 0 disables it, otherwise it needs its own port
+    config.runtime.network.port_metrics = 9100;
+    REQUIRE(ConfigValidator::validate(config) == true);
+    config.runtime.network.port_metrics = 3335;
+    REQUIRE(ConfigValidator::validate(config) == false);
+    config.runtime.network.port_metrics = 0;
+
+    // Read-only flush window has an upper bound
+    config.runtime.network.readonly_flush_window_ms =
+        NetworkLimits::max_flush_window_ms;
+    REQUIRE(ConfigValidator::validate(config) == true);
+    config.runtime.network.readonly_flush_window_ms =
+        NetworkLimits::max_flush_window_ms + 1;
+    REQUIRE(ConfigValidator::validate(config) == false);
+    config.runtime.network.readonly_flush_window_ms = 0;
+
+    // Port 0 is allowed for a type with its own local socket
+    config.runtime.network.unix_path_regular = "/run/ebus/regular.sock";
+    config.runtime.network.port_regular = 0;
+    REQUIRE(ConfigValidator::validate(config) == true);
+    config.runtime.network.unix_path_enhanced = "/run/ebus/regular.sock";
+    REQUIRE(ConfigValidator::validate(config) == false);
+    config.runtime.network.unix_path_enhanced =
+        std::string(NetworkLimits::max_unix_path_len + 1, 'x');
+    REQUIRE(ConfigValidator::validate(config) == false);
+    config.runtime.network.unix_path_enhanced.clear();
+    config.runtime.network.unix_path_regular.clear();
+    config.runtime.network.port_regular = 3333;
+
+    REQUIRE(ConfigValidator::validateJson(
+        R"({"network":{"port_readonly":0,"unix_path_readonly":"/tmp/r"}})"));
+    REQUIRE_FALSE(ConfigValidator::validateJson(
+        R"({"network":{"port_readonly":0,"unix_path_readonly":""}})"));
+
     // Duplicate ports
     config.runtime.network.port_readonly = 3333;
     REQUIRE(ConfigValidator::validate(config) == false);
@@ -6,12 +6,16 @@
 #include <atomic>
 #include <catch2/catch_all.hpp>
 #include <chrono>
+#include <cstdio>
 #include <ebus/controller.hpp>
 #include <ebus/utils.hpp>
 #include <iostream>
+#include <string>
 #include <thread>
 #include <vector>
 
+#include "app/device_manager.hpp"
+#include "core/bus_monitor.hpp"
 #include "platform/simulation/bus_simulator.hpp"
 #include "test_helpers.hpp"
 
@@ -211,4 +215,77 @@ TEST_CASE("Controller: Drain Loop Burst", "[app][controller][reactor]") {
       ebus::detail::waitCondition([&] { return telegram_count >= 10; }, 3000));
 
   controller.stop();
-}
\ No newline at end of file
+}
+
+TEST_CASE("Controller: Device inventory warm start", "[app][controller]") {
+  const std::string path = "test_controller_inventory.bin";
+  std::remove(path.c_str());
+
+  ebus::EbusConfig config;
+  config.runtime.address = 0x31;
+  config.runtime.system_inquiry = false;
+  config.runtime.system_response = false;
+  config.runtime.device.inventory_path = path;
+
+  // A snapshot with one identified device
+  std::vector<uint8_t> snapshot;
+  {
+    BusMonitor monitor;
+    DeviceManager dm(&monitor);
+    dm.update(ebus::toVector("1008070400"),
+              ebus::toVector("0a05424f53434801010101"));
+    snapshot = dm.saveSnapshot({});
+  }
+
+  {
+    ebus::Controller controller(config);
+    REQUIRE_FALSE(controller.loadInventory(ebus::toVector("00")));
+    REQUIRE(controller.loadInventory(snapshot));
+    REQUIRE(controller.start());
+    controller.stop();  // writes the inventory file
+  }
+
+  ebus::Controller warm(config);
+  REQUIRE(warm.start());
+  size_t restored = 0;
+  warm.fetchDevices([&](const ebus::DeviceInfo& info) {
+    if (info.slave_address == 0x08 && info.restored) restored++;
+  });
+  REQUIRE(restored == 1);
+  REQUIRE(warm.saveInventory().size() == snapshot.size());
+  warm.stop();
+  std::remove(path.c_str());
+}
+
+TEST_CASE("Controller: Periodic device inventory saves", "[app][controller]") {
+  const std::string path = "test_controller_inventory_periodic.bin";
+  std::remove(path.c_str());
+
+  ebus::EbusConfig config;
+  config.runtime.address = 0x31;
+  config.runtime.system_inquiry = false;
+  config.runtime.system_response = false;
+  config.runtime.device.inventory_path = path;
+  config.runtime.device.inventory_interval_s = 1;
+  config.runtime.bus.syn_gen = true;
+
+  ebus::Controller controller(config);
+  auto& vbus = controller.getVirtualBus();
+  REQUIRE(controller.start());
+
+  // A new master changes the inventory; it is written in the background
+  // while the controller keeps running
+  vbus.injectMasterMessage(0x03, "fe070000");
+  auto fileSize = [&path] {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return 0L;
+    std::fseek(file, 0, SEEK_END);
+    const long size = std::ftell(file);
+    std::fclose(file);
+    return size;
+  };
+  REQUIRE(ebus::detail::waitCondition([&] { return fileSize() > 0; }, 5000));
+
+  controller.stop();
+  std::remove(path.c_str());
+}
@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: GPL-3.0-or-later
  */
 
+#include <algorithm>
 #include <catch2/catch_all.hpp>
 #include <ebus/utils.hpp>
 #include <string>
@@ -90,3 +91,174 @@ TEST_CASE("DeviceManager: Manufacturer Filtering", "[app][devicemanager]") {
   ebus::Sequence out_cmd;
   REQUIRE(dm.findNextPendingVendorCommand(0x08, out_cmd) == 256);
 }
+
+TEST_CASE("DeviceManager: Inventory Snapshot", "[app][devicemanager]") {
+  BusMonitor monitor;
+  DeviceManager dm(&monitor);
+  dm.setOwnAddress(0xff);
+
+  // Vaillant device, fully profiled (07 04 and B5 09 24..27)
+  const uint32_t initial = dm.revision();
+  dm.update(ebus::toVector("1008070400"),
+            ebus::toVector("0ab5504d5330300107430200"));
+  dm.update(ebus::toVector("1008b5090124"),
+            ebus::toVector("0a00323131323334353637"));
+  dm.update(ebus::toVector("1008b5090125"),
+            ebus::toVector("09383930313233343536"));
+  dm.update(ebus::toVector("1008b5090126"),
+            ebus::toVector("09373839303132333435"));
+  dm.update(ebus::toVector("1008b5090127"), ebus::toVector("023637"));
+  REQUIRE_FALSE(dm.needsDeepScan(0x08));
+  REQUIRE(dm.revision() > initial);
+
+  // Repeated identical responses do not change the inventory
+  const uint32_t revision = dm.revision();
+  dm.update(ebus::toVector("1008b5090127"), ebus::toVector("023637"));
+  REQUIRE(dm.revision() == revision);
+
+  std::bitset<256> quarantined;
+  quarantined.set(0x52);
+  const auto snapshot = dm.saveSnapshot(quarantined);
+
+  BusMonitor restored_monitor;
+  DeviceManager restored(&restored_monitor);
+  restored.setOwnAddress(0xff);
+  std::bitset<256> restored_quarantine;
+  REQUIRE(restored.loadSnapshot(snapshot, restored_quarantine));
+  REQUIRE(restored_quarantine == quarantined);
+
+  // Identified and profiled without a single scan
+  REQUIRE(restored.isIdentified(0x08));
+  REQUIRE_FALSE(restored.needsDeepScan(0x08));
+  std::bitset<256> observed;
+  restored.getObservedSlaves(observed);
+  REQUIRE(observed.test(0x08));
+  REQUIRE(observed.test(0x15));  // slave of master 0x10
+
+  std::vector<ebus::DeviceInfo> devices;
+  restored.fetchDevices(
+      [&](const ebus::DeviceInfo& info) { devices.push_back(info); });
+  REQUIRE(devices.size() == 2);
+  REQUIRE(devices[0].slave_address == 0x08);
+  REQUIRE(devices[0].restored);
+  REQUIRE(devices[0].vaillant.serial_number.size() == 28);
+  REQUIRE(restored.fetchStatus().restored_count == 2);
+
+  // Passive traffic confirms a restored device
+  restored.update(ebus::toVector("3108b51000"), ebus::toVector("00"));
+  REQUIRE(restored.fetchStatus().restored_count == 1);  // 0x15 left
+
+  // Restoring again keeps the live data of known addresses
+  REQUIRE(restored.loadSnapshot(snapshot, restored_quarantine));
+  REQUIRE(restored.fetchStatus().identified_count == 3);
+  REQUIRE(restored.fetchStatus().restored_count == 1);
+
+  SECTION("Malformed snapshots are rejected") {
+    DeviceManager other;
+    std::bitset<256> q;
+    auto corrupt = snapshot;
+    corrupt[corrupt.size() / 2] ^= 0x01;
+    REQUIRE_FALSE(other.loadSnapshot(corrupt, q));
+
+    auto truncated = snapshot;
+    truncated.resize(truncated.size() - 8);
+    REQUIRE_FALSE(other.loadSnapshot(truncated, q));
+
+    auto future = snapshot;
+    future[4] = 2;
+    REQUIRE_FALSE(other.loadSnapshot(future, q));
+    REQUIRE(other.fetchStatus().identified_count == 0);
+  }
+}
+
+TEST_CASE("DeviceManager: Every Slave Address Within Budget",
+          "[app][devicemanager]") {
+  DeviceManager dm;
+  dm.setOwnAddress(0xff);
+
+  // 0x10 polls every slave address that is not a master, SYN or escape;
+  // the own one (0x04) and that of 0x10 (0x15) are not counted
+  size_t slaves = 0;
+  for (size_t addr = 0; addr < 256; ++addr) {
+    const uint8_t zz = static_cast<uint8_t>(addr);
+    if (!ebus::isSlave(zz) || zz == ebus::slaveOf(0x10) ||
+        zz == ebus::slaveOf(0xff))
+      continue;
+    slaves++;
+    std::vector<uint8_t> master = {0x10, zz, 0x07, 0x04, 0x00};
+    std::vector<uint8_t> slave = {0x00};
+    dm.update(master, slave);
+  }
+
+  size_t count = 0;
+  dm.fetchDevices([&](const ebus::DeviceInfo&) { count++; });
+  const auto limited = dm.fetchStatus();
+  REQUIRE(count == std::min(limited.device_capacity, slaves + 1));
+  REQUIRE(limited.memory_usage <= DeviceLimits::memory_budget);
+
+  // A larger budget admits all of them (plus 0x15 of the polling master)
+  DeviceManager full;
+  full.setOwnAddress(0xff);
+  full.setMemoryBudget(1u << 20);
+  for (size_t addr = 0; addr < 256; ++addr) {
+    const uint8_t zz = static_cast<uint8_t>(addr);
+    if (!ebus::isSlave(zz)) continue;
+    std::vector<uint8_t> master = {0x10, zz, 0x07, 0x04, 0x00};
+    std::vector<uint8_t> slave = {0x00};
+    full.update(master, slave);
+  }
+  REQUIRE(full.fetchStatus().identified_count == slaves + 1);
+  REQUIRE(full.isIdentified(0xfe) == false);  // broadcast is no slave
+
+  // Shrinking keeps the existing entries
+  full.setMemoryBudget(0);
+  std::vector<uint8_t> master = {0x10, 0x08, 0x07, 0x04, 0x00};
+  std::vector<uint8_t> slave = {0x00};
+  full.update(master, slave);
+  REQUIRE(full.fetchStatus().identified_count == slaves + 1);
+}
+
+TEST_CASE("DeviceManager: Traffic Statistics", "[app][devicemanager]") {
+  DeviceManager dm;
+  dm.setOwnAddress(0xff);
+
+  std::vector<uint8_t> master = {0x10, 0x08, 0xb5, 0x10, 0x01, 0x00};
+  std::vector<uint8_t> slave = {0x02, 0x01, 0x02};
+
+  // 100 telegrams with a response latency of 5000 us, one with 12000 us
+  ebus::TelegramTimings timings;
+  timings.first_byte_us = 1500;
+  timings.response_us = 5000;
+  for (uint64_t t = 1; t <= 100; ++t) dm.update(master, slave, timings, t);
+  timings.response_us = 12000;
+  timings.naks = 1;
+  dm.update(master, slave, timings, 200);
+
+  timings = {};
+  timings.naks = 2;
+  dm.recordError(master, timings);
+
+  ebus::DeviceInfo target;
+  ebus::DeviceInfo source;
+  dm.fetchDevices([&](const ebus::DeviceInfo& info) {
+    if (info.slave_address == 0x08) target = info;
+    if (info.slave_address == 0x15) source = info;
+  });
+
+  REQUIRE(target.traffic.telegrams == 101);
+  REQUIRE(target.traffic.bytes == 101 * (master.size() + slave.size()));
+  REQUIRE(target.traffic.errors == 1);
+  REQUIRE(target.traffic.naks == 3);
+  REQUIRE(target.traffic.last_seen == 200);
+  REQUIRE(target.traffic.response_mean_us == (100 * 5000 + 12000) / 101);
+  // The p99 lies in the bucket of 5000 us: [4096, 4096 * 1.25)
+  REQUIRE(target.traffic.response_p99_us == 5119);
+  REQUIRE(target.traffic.first_byte_mean_us == 0);
+
+  // The source master is charged with the telegrams and the first byte
+  REQUIRE(source.traffic.telegrams == 101);
+  REQUIRE(source.traffic.first_byte_mean_us == 1500);
+  REQUIRE(source.traffic.naks == 0);
+  REQUIRE(source.traffic.response_mean_us == 0);
+
+}
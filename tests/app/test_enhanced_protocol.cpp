@@ -108,3 +108,37 @@ TEST_CASE("Exhaustive roundtrip (4096 cases)", "[app][enhanced]") {
     }
   }
 }
+
+TEST_CASE("Submit result frame encoding", "[app][enhanced]") {
+  SECTION("Status, length and payload as submitted sequences") {
+    const uint8_t slave[] = {0x02, 0x0a, 0xff};
+    uint8_t out[ebus::detail::EnhancedProtocolLimits::max_submit_result_len];
+    const size_t len =
+        Protocol::encodeSubmitResult(SubmitStatus::ok, slave, 3, out);
+    REQUIRE(len == 10);
+
+    uint8_t val = 0;
+    Response res;
+    Protocol::decode(out, res, val);
+    REQUIRE(res == Response::submitted);
+    REQUIRE(val == static_cast<uint8_t>(SubmitStatus::ok));
+    Protocol::decode(out + 2, res, val);
+    REQUIRE(val == 3);
+    for (size_t i = 0; i < 3; ++i) {
+      REQUIRE(Protocol::isValidSequence(out[4 + 2 * i], out[5 + 2 * i]));
+      Protocol::decode(out + 4 + 2 * i, res, val);
+      REQUIRE(res == Response::submitted);
+      REQUIRE(val == slave[i]);
+    }
+  }
+
+  SECTION("Rejection without payload") {
+    uint8_t out[ebus::detail::EnhancedProtocolLimits::max_submit_result_len];
+    REQUIRE(Protocol::encodeSubmitResult(SubmitStatus::rejected, nullptr, 0,
+                                         out) == 4);
+    uint8_t val = 0;
+    Response res;
+    Protocol::decode(out, res, val);
+    REQUIRE(val == static_cast<uint8_t>(SubmitStatus::rejected));
+  }
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_all.hpp>
+#include <vector>
+
+#include "app/filtered_protocol.hpp"
+
+using namespace ebus::detail::filtered;
+
+namespace {
+
+bool matches(const Filter& filter, std::vector<uint8_t> master) {
+  return filter.matches(ebus::ByteView(master));
+}
+
+}  // namespace
+
+TEST_CASE("Filtered protocol: rules compile into lookup tables",
+          "[app][filtered]") {
+  Filter filter;
+
+  SECTION("No rules match nothing") {
+    CHECK_FALSE(matches(filter, {0x10, 0x08, 0xb5, 0x10, 0x00}));
+  }
+
+  SECTION("Zero masks match everything") {
+    REQUIRE(filter.add(Rule{}));
+    CHECK(matches(filter, {0x10, 0x08, 0xb5, 0x10, 0x00}));
+    CHECK(matches(filter, {0xff, 0xfe, 0x07, 0x04, 0x00}));
+    CHECK_FALSE(matches(filter, {0x10, 0x08, 0xb5}));  // no SB
+  }
+
+  SECTION("Fields combine within a rule, rules are alternatives") {
+    // Target 0x08 with PB B5 and any SB
+    REQUIRE(filter.add({0x00, 0x00, 0x08, 0xff, 0xb5, 0xff, 0x00, 0x00}));
+    // Any telegram of service 07 04
+    REQUIRE(filter.add({0x00, 0x00, 0x00, 0x00, 0x07, 0xff, 0x04, 0xff}));
+    CHECK(filter.size() == 2);
+
+    CHECK(matches(filter, {0x10, 0x08, 0xb5, 0x10, 0x00}));
+    CHECK(matches(filter, {0x31, 0x15, 0x07, 0x04, 0x00}));
+    CHECK_FALSE(matches(filter, {0x10, 0x15, 0xb5, 0x10, 0x00}));
+    // Target of the first rule with the service of the second
+    CHECK_FALSE(matches(filter, {0x10, 0x08, 0x07, 0x00, 0x00}));
+  }
+
+  SECTION("Masks select bit ranges") {
+    // Every master with priority class 0 (low nibble of QQ)
+    REQUIRE(filter.add({0x00, 0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}));
+    CHECK(matches(filter, {0x10, 0x08, 0xb5, 0x10, 0x00}));
+    CHECK(matches(filter, {0x30, 0x08, 0xb5, 0x10, 0x00}));
+    CHECK_FALSE(matches(filter, {0x31, 0x08, 0xb5, 0x10, 0x00}));
+  }
+
+  SECTION("The rule count is bounded and clear resets it") {
+    for (size_t i = 0; i < ebus::detail::FilteredProtocolLimits::max_rules;
+         ++i)
+      REQUIRE(filter.add({0x00, 0x00, static_cast<uint8_t>(i), 0xff}));
+    CHECK_FALSE(filter.add(Rule{}));
+    CHECK(matches(filter, {0x10, 0x1f, 0xb5, 0x10, 0x00}));
+
+    filter.clear();
+    CHECK(filter.size() == 0);
+    CHECK_FALSE(matches(filter, {0x10, 0x1f, 0xb5, 0x10, 0x00}));
+  }
+}
+
+TEST_CASE("Filtered protocol: frame encoding", "[app][filtered]") {
+  const std::vector<uint8_t> master = {0x10, 0x08, 0xb5, 0x10, 0x01, 0x00};
+  const std::vector<uint8_t> slave = {0x01, 0x42};
+  uint8_t frame[ebus::detail::FilteredProtocolLimits::max_frame_len];
+
+  const size_t len = Protocol::encodeTelegram(
+      ebus::TelegramType::master_slave, master, slave, frame);
+  REQUIRE(len == 3 + 1 + master.size() + 1 + slave.size());
+  CHECK(frame[0] == len - 1);
+  CHECK(frame[1] == static_cast<uint8_t>(Frame::telegram));
+  CHECK(frame[2] == static_cast<uint8_t>(ebus::TelegramType::master_slave));
+  CHECK(frame[3] == master.size());
+  CHECK(std::vector<uint8_t>(frame + 4, frame + 4 + master.size()) == master);
+  CHECK(frame[4 + master.size()] == slave.size());
+  CHECK(frame[len - 1] == 0x42);
+
+  uint8_t ack[Protocol::ack_len];
+  Protocol::encodeAck(Command::add, Status::ok, 3, ack);
+  CHECK(ack[0] == Protocol::ack_len - 1);
+  CHECK(ack[1] == static_cast<uint8_t>(Frame::ack));
+  CHECK(ack[2] == static_cast<uint8_t>(Command::add));
+  CHECK(ack[3] == static_cast<uint8_t>(Status::ok));
+  CHECK(ack[4] == 3);
+}
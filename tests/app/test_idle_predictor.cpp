@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cstdint>
+
+#include "app/idle_predictor.hpp"
+
+using namespace ebus::detail;
+using ebus::Clock;
+using std::chrono::milliseconds;
+
+namespace {
+
+const Clock::time_point t0 = Clock::time_point{} + std::chrono::hours(1);
+
+constexpr milliseconds window{IdleLimits::scan_window_ms};
+
+// A boiler sending bursts of three telegrams every 10 s; returns the start
+// of the next burst
+Clock::time_point feedBursts(IdlePredictor& predictor, int bursts,
+                             Clock::time_point start = t0) {
+  for (int i = 0; i < bursts; ++i, start += milliseconds(10000))
+    for (int j = 0; j < 3; ++j)
+      predictor.observe(0x03, start + milliseconds(150 * j));
+  return start;
+}
+
+}  // namespace
+
+TEST_CASE("IdlePredictor: Learns the rhythm of a master", "[app][idle]") {
+  IdlePredictor predictor;
+
+  // Irregular traffic of a second master is never predicted
+  const int gaps[] = {700, 4000, 1300, 9000, 2500, 600, 5200, 3100};
+  Clock::time_point t = t0;
+  for (int gap : gaps) predictor.observe(0x10, t += milliseconds(gap));
+  predictor.observe(0x08, t0);  // not a master
+
+  const auto next = feedBursts(predictor, 4);
+  REQUIRE(predictor.fetchStatus().periodic_sources == 0);
+  const auto after = feedBursts(predictor, 6, next);
+  REQUIRE(after == next + milliseconds(60000));
+
+  const auto status = predictor.fetchStatus();
+  REQUIRE(status.sources == 2);
+  REQUIRE(status.periodic_sources == 1);
+
+  const auto last = after - milliseconds(10000);
+  // During the burst and right after it
+  REQUIRE_FALSE(predictor.isQuietWindow(last + milliseconds(300), window));
+  // Between two bursts
+  REQUIRE(predictor.isQuietWindow(last + milliseconds(5000), window));
+  // A scan would still run into the next burst
+  REQUIRE_FALSE(predictor.isQuietWindow(after - milliseconds(100), window));
+  REQUIRE_FALSE(predictor.isQuietWindow(after + milliseconds(200), window));
+  // A skipped burst is still expected one period later
+  REQUIRE(predictor.isQuietWindow(after + milliseconds(5000), window));
+  REQUIRE_FALSE(predictor.isQuietWindow(after + milliseconds(9950), window));
+  // Silent for longer: the prediction is dropped
+  REQUIRE(predictor.isQuietWindow(after + milliseconds(30000), window));
+
+  // A new rhythm is learned from scratch
+  predictor.observe(0x03, after + milliseconds(3000));
+  REQUIRE(predictor.fetchStatus().periodic_sources == 0);
+}
+
+TEST_CASE("IdlePredictor: Admission of background traffic", "[app][idle]") {
+  IdlePredictor predictor;
+  const auto next = feedBursts(predictor, 6);
+
+  // Just before the next burst the scan is held back until it is over
+  Clock::time_point t = next - milliseconds(100);
+  REQUIRE_FALSE(predictor.admit(t));
+  while (!predictor.admit(t)) {
+    t += milliseconds(20);
+    REQUIRE(t < next + milliseconds(2000));
+  }
+  REQUIRE(t > next);
+  auto status = predictor.fetchStatus();
+  REQUIRE(status.deferrals == 1);
+  REQUIRE(status.forced == 0);
+
+  // An endless burst: the scan goes out after the maximum deferral
+  t = next + milliseconds(100);
+  const auto deferred = t;
+  bool admitted = false;
+  for (; !admitted; t += milliseconds(100)) {
+    predictor.observe(0x03, t);
+    admitted = predictor.admit(t);
+  }
+  REQUIRE(t - deferred > milliseconds(IdleLimits::max_defer_ms));
+  status = predictor.fetchStatus();
+  REQUIRE(status.deferrals == 2);
+  REQUIRE(status.forced == 1);
+
+  // Disabled, everything is admitted
+  predictor.setEnabled(false);
+  REQUIRE(predictor.admit(t));
+  REQUIRE_FALSE(predictor.fetchStatus().enabled);
+}
+
+TEST_CASE("IdlePredictor: Arbitration outcomes", "[app][idle]") {
+  IdlePredictor predictor;
+  const auto next = feedBursts(predictor, 6);
+
+  // A scan session scheduled into a quiet window
+  predictor.trackSession(7, next - milliseconds(5000));
+  predictor.recordArbitration(7, true);
+  predictor.recordArbitration(7, true);
+  predictor.recordArbitration(7, false);
+  predictor.recordArbitration(7, true);
+
+  // Other sessions
+  predictor.recordArbitration(8, false);
+  predictor.recordArbitration(8, true);
+  predictor.recordArbitration(0, false);
+  predictor.recordArbitration(9, true);
+
+  auto status = predictor.fetchStatus();
+  REQUIRE(status.quiet_won == 3);
+  REQUIRE(status.quiet_lost == 1);
+  REQUIRE(status.other_won == 2);
+  REQUIRE(status.other_lost == 2);
+  REQUIRE(status.loss_reduction_percent == Catch::Approx(50.0f));
+
+  // Scheduled right before a burst, the session counts as other traffic
+  predictor.trackSession(10, next - milliseconds(50));
+  predictor.recordArbitration(10, false);
+  status = predictor.fetchStatus();
+  REQUIRE(status.other_lost == 3);
+}
@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include "app/metrics_endpoint.hpp"
+#include "core/bus_monitor.hpp"
+#include "utils/openmetrics_writer.hpp"
+
+using namespace ebus::detail;
+
+namespace {
+
+std::string readAll(int fd) {
+  std::string out;
+  char buf[512];
+  ssize_t n;
+  while ((n = ::read(fd, buf, sizeof(buf))) > 0)
+    out.append(buf, static_cast<size_t>(n));
+  return out;
+}
+
+std::string scrape(MetricsEndpoint& endpoint, const char* request) {
+  int fds[2];
+  REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+  REQUIRE(endpoint.addConnection(fds[0]));
+  REQUIRE(::write(fds[1], request, std::strlen(request)) > 0);
+
+  endpoint.handle(fds[0]);
+  REQUIRE(endpoint.connectionCount() == 0);
+
+  std::string response = readAll(fds[1]);
+  ::close(fds[1]);
+  return response;
+}
+
+}  // namespace
+
+TEST_CASE("OpenMetricsWriter: families, labels and EOF",
+          "[app][metrics_endpoint]") {
+  std::string out;
+  {
+    OpenMetricsWriter writer([&](std::string_view chunk) { out += chunk; });
+    writer.family("ebus_test", "counter", "Test counter");
+    writer.sample("ebus_test", "_total", {}, 42u);
+    writer.sample("ebus_test", "_total", {{"role", "a\"b"}, {}, {"x", "1"}},
+                  7);
+    writer.family("ebus_gauge_percent", "gauge", "Test gauge", "percent");
+    writer.sample("ebus_gauge_percent", "", {}, 12.5f);
+    writer.finish();
+  }
+
+  CHECK(out ==
+        "# TYPE ebus_test counter\n"
+        "# HELP ebus_test Test counter\n"
+        "ebus_test_total 42\n"
+        "ebus_test_total{role=\"a\\\"b\",x=\"1\"} 7\n"
+        "# TYPE ebus_gauge_percent gauge\n"
+        "# UNIT ebus_gauge_percent percent\n"
+        "# HELP ebus_gauge_percent Test gauge\n"
+        "ebus_gauge_percent 12.5\n"
+        "# EOF\n");
+}
+
+TEST_CASE("OpenMetrics export of system metrics", "[app][metrics_endpoint]") {
+  BusMonitor monitor;
+  monitor.updateHandler([](auto& m) { m.messages_active = 3; });
+  monitor.sync.addSample(100);
+
+  std::string out;
+  monitor.fetchMetrics([&](const ebus::Metrics& m) {
+    OpenMetricsWriter writer([&](std::string_view chunk) { out += chunk; });
+    exportOpenMetrics(writer, m);
+    writer.finish();
+  });
+
+  CHECK(out.find("ebus_messages_total{role=\"active\"} 3\n") !=
+        std::string::npos);
+  CHECK(out.find("ebus_latency_microseconds_count{phase=\"sync\"} 1\n") !=
+        std::string::npos);
+  CHECK(out.find("ebus_latency_max_microseconds{phase=\"sync\"} 100\n") !=
+        std::string::npos);
+#ifndef EBUS_MINIMAL_DIAGNOSTICS
+  CHECK(out.find("ebus_latency_microseconds{phase=\"sync\",quantile=\"0.5\"} "
+                 "100\n") != std::string::npos);
+#endif
+
+  // Every family is declared exactly once
+  CHECK(out.find("# TYPE ebus_messages ") ==
+        out.rfind("# TYPE ebus_messages "));
+  CHECK(out.size() > 6);
+  CHECK(out.compare(out.size() - 6, 6, "# EOF\n") == 0);
+}
+
+TEST_CASE("MetricsEndpoint: serves GET /metrics", "[app][metrics_endpoint]") {
+  MetricsEndpoint endpoint;
+  BusMonitor monitor;
+  endpoint.setExporter(
+      [m = &monitor](size_t part, const ebus::JsonChunkVisitor& visitor) {
+        OpenMetricsWriter writer(visitor);
+        if (part == metrics_parts) {
+          writer.finish();
+          return false;
+        }
+        m->fetchMetrics([&](const ebus::Metrics& metrics) {
+          exportOpenMetrics(writer, metrics, part);
+        });
+        return true;
+      });
+
+  SECTION("Exposition") {
+    std::string response =
+        scrape(endpoint, "GET /metrics HTTP/1.1\r\nHost: x\r\n\r\n");
+    CHECK(response.rfind("HTTP/1.1 200 OK\r\n", 0) == 0);
+    CHECK(response.find("Content-Type: application/openmetrics-text") !=
+          std::string::npos);
+    CHECK(response.find("\r\n\r\n# TYPE ebus_messages counter\n") !=
+          std::string::npos);
+    CHECK(response.compare(response.size() - 6, 6, "# EOF\n") == 0);
+  }
+
+  SECTION("Unknown path") {
+    std::string response = scrape(endpoint, "GET /other HTTP/1.1\r\n\r\n");
+    CHECK(response.rfind("HTTP/1.1 404 Not Found\r\n", 0) == 0);
+  }
+
+  SECTION("Unsupported method") {
+    std::string response = scrape(endpoint, "POST /metrics HTTP/1.1\r\n\r\n");
+    CHECK(response.rfind("HTTP/1.1 405 Method Not Allowed\r\n", 0) == 0);
+  }
+}
+
+TEST_CASE("MetricsEndpoint: incomplete requests wait for more data",
+          "[app][metrics_endpoint]") {
+  MetricsEndpoint endpoint;
+  int fds[2];
+  REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+  REQUIRE(endpoint.addConnection(fds[0]));
+  REQUIRE(::write(fds[1], "GET /met", 8) == 8);
+
+  endpoint.handle(fds[0]);
+  CHECK(endpoint.connectionCount() == 1);
+
+  endpoint.stop();
+  CHECK(endpoint.connectionCount() == 0);
+  ::close(fds[1]);
+}
+
+TEST_CASE("MetricsEndpoint: slow scrapers do not block",
+          "[app][metrics_endpoint]") {
+  MetricsEndpoint endpoint;
+  // Far more than the socket buffer, rendered in 4 KiB parts
+  constexpr size_t parts = 256;
+  const std::string chunk(4096, 'x');
+  size_t rendered = 0;
+  endpoint.setExporter(
+      [&chunk, &rendered](size_t part, const ebus::JsonChunkVisitor& visitor) {
+        if (part == parts) return false;
+        visitor(chunk);
+        rendered++;
+        return true;
+      });
+
+  int fds[2];
+  REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+  REQUIRE(endpoint.addConnection(fds[0]));
+  const char* request = "GET /metrics HTTP/1.1\r\n\r\n";
+  REQUIRE(::write(fds[1], request, std::strlen(request)) > 0);
+
+  // The socket takes only part of the response; the rest stays pending
+  const auto start = std::chrono::steady_clock::now();
+  endpoint.handle(fds[0]);
+  CHECK(std::chrono::steady_clock::now() - start <
+        std::chrono::milliseconds(NetworkLimits::metrics_send_timeout_ms));
+  REQUIRE(endpoint.connectionCount() == 1);
+  // Parts are only rendered as the socket drains
+  CHECK(rendered < parts);
+
+  SECTION("Resumes when writable") {
+    std::string response;
+    char buf[4096];
+    while (endpoint.connectionCount() == 1) {
+      ssize_t n = ::recv(fds[1], buf, sizeof(buf), MSG_DONTWAIT);
+      if (n > 0) response.append(buf, static_cast<size_t>(n));
+      endpoint.handle(fds[0]);
+    }
+    response += readAll(fds[1]);
+    CHECK(response.rfind("HTTP/1.1 200 OK\r\n", 0) == 0);
+    CHECK(rendered == parts);
+    const size_t body = parts * chunk.size();
+    REQUIRE(response.size() > body);
+    CHECK(response.find_first_not_of('x', response.size() - body) ==
+          std::string::npos);
+  }
+
+  SECTION("Dropped after the send timeout") {
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds(NetworkLimits::metrics_send_timeout_ms + 50));
+    endpoint.checkTimeouts();
+    CHECK(endpoint.connectionCount() == 0);
+  }
+
+  ::close(fds[1]);
+}
@@ -6,7 +6,9 @@
 #include <atomic>
 #include <catch2/catch_all.hpp>
 #include <chrono>
+#include <memory>
 #include <ebus/callbacks.hpp>
+#include <ebus/message_database.hpp>
 #include <ebus/types.hpp>
 #include <ebus/utils.hpp>
 #include <string>
@@ -15,6 +17,7 @@
 
 #include "app/device_manager.hpp"
 #include "app/device_scanner.hpp"
+#include "app/idle_predictor.hpp"
 #include "app/poll_manager.hpp"
 #include "app/reactor.hpp"
 #include "app/scheduler.hpp"
@@ -323,6 +326,85 @@ TEST_CASE("Reactor: Protocol Callback Dispatch on Telegram Event",
   env.bus.stop();
 }
 
+TEST_CASE("Reactor: Idle Prediction Uses the Bus Completion Time",
+          "[app][reactor][integration]") {
+  ReactorTestEnv env(0x10, false);
+  IdlePredictor predictor;
+  env.reactor.setIdlePredictor(&predictor);
+
+  env.bus.start();
+  env.reactor.start();
+
+  // Telegrams of a master every 10 s, all delivered to the Reactor at once;
+  // only their completion times show the rhythm
+  const auto start = Clock::now() - std::chrono::seconds(100);
+  for (int i = 0; i < 10; ++i) {
+    ProtocolEvent ev{};
+    ev.type = ProtocolEvent::Type::telegram;
+    ev.message_type = MessageType::passive;
+    ev.telegram_type = TelegramType::broadcast;
+    ev.master.assign(toVector("03fe070400").data(), 5);
+    ev.stampCompletion(start + std::chrono::seconds(10 * i));
+    while (!env.reactor.pushProtocolEvent(std::move(ev)))
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  auto periodic = [&] {
+    return predictor.fetchStatus().periodic_sources == 1;
+  };
+  REQUIRE(waitCondition(periodic, 2000));
+
+  env.reactor.stop();
+  env.bus.stop();
+}
+
+TEST_CASE("Reactor: Message Database Decodes Telegrams",
+          "[app][reactor][integration]") {
+  ReactorTestEnv env(0x10, false);
+
+  auto database = std::make_shared<MessageDatabase>();
+  REQUIRE(database->loadCsv("r,bai,,FlowTemp,,,08,b509,0d,temp,s,D2C,,C,\n")
+              .added == 1);
+  env.reactor.setMessageDatabase(database);
+
+  std::atomic<int> values{0};
+  std::atomic<int64_t> temp{0};
+  env.reactor.setValueCallback([&](const ValueInfo& info) {
+    if (info.message == "FlowTemp" && info.field == "temp")
+      temp.store(asInt64(info.value));
+    values++;
+  });
+
+  env.bus.start();
+  env.reactor.start();
+
+  auto push = [&](const char* master, const char* slave) {
+    ProtocolEvent ev{};
+    ev.type = ProtocolEvent::Type::telegram;
+    ev.message_type = MessageType::passive;
+    ev.telegram_type = TelegramType::master_slave;
+    const auto m = toVector(master);
+    const auto s = toVector(slave);
+    ev.master.assign(m.data(), m.size());
+    ev.slave.assign(s.data(), s.size());
+    env.reactor.pushProtocolEvent(std::move(ev));
+  };
+
+  push("1008b509010d", "02a001");
+  push("1008b50a00", "00");
+
+  auto counted = [&] {
+    const auto status = env.reactor.fetchStatus();
+    return status.decoded_telegrams == 1 && status.undecoded_telegrams == 1;
+  };
+  REQUIRE(waitCondition(counted, 2000));
+  REQUIRE(values.load() == 1);
+  REQUIRE(temp.load() == 26);
+
+  env.reactor.stop();
+  env.bus.stop();
+}
+
 TEST_CASE("Reactor: Protocol Callback Dispatch on Error Event",
           "[app][reactor][integration]") {
   ReactorTestEnv env(0x10, false);
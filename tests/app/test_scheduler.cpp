@@ -150,6 +150,7 @@ TEST_CASE("Scheduler: MS Success (52b509030d4600)", "[app][scheduler]") {
 
   std::atomic<uint32_t> last_success_session{0};
   std::atomic<uint32_t> last_error_session{0};
+  ebus::SessionTimings timings;
 
   uint32_t session_id = scheduler.enqueue(1, ebus::toVector("52b509030d4600"));
   REQUIRE(session_id > 0);
@@ -165,7 +166,7 @@ TEST_CASE("Scheduler: MS Success (52b509030d4600)", "[app][scheduler]") {
     if (received_ev.session_id != 0) {
       ev = std::move(received_ev);
       received_ev = ProtocolEvent{};
-      scheduler.injectProtocolEvent(ev);
+      scheduler.injectProtocolEvent(ev, &timings);
       if (ev.type == ProtocolEvent::Type::error) {
         last_error_session.store(ev.session_id);
       } else if (ev.type == ProtocolEvent::Type::telegram &&
@@ -180,6 +181,26 @@ TEST_CASE("Scheduler: MS Success (52b509030d4600)", "[app][scheduler]") {
 
   REQUIRE(last_success_session.load() == session_id);
 
+  // Session milestones are reported in order on completion
+  CHECK(timings.priority == 1);
+  REQUIRE(timings.enqueued_us > 0);
+  CHECK(timings.dequeued_us >= timings.enqueued_us);
+  CHECK(timings.bus_request_us > 0);
+  CHECK(timings.won_us >= timings.bus_request_us);
+  CHECK(timings.master_ack_us >= timings.won_us);
+  CHECK(timings.response_us >= timings.master_ack_us);
+
+  timings.delivered_us = timings.response_us;
+  monitor.recordSession(timings);
+  monitor.fetchMetrics([](const ebus::Metrics& m) {
+    const auto& cls = m.sessions.classes[SessionLimits::priorityClass(1)];
+    CHECK(cls.priority_min == 0);
+#if EBUS_SESSION_STATS
+    CHECK(cls.total.count == 1);
+    CHECK(cls.transfer.count == 1);
+#endif
+  });
+
   bus.stop();
 }
 
@@ -265,3 +286,58 @@ TEST_CASE("Scheduler: Retry Success (52b509030d4600)", "[app][scheduler]") {
 
   bus.stop();
 }
+
+TEST_CASE("Scheduler: Session Gate", "[app][scheduler]") {
+  Request request;
+  ebus::BusConfig config;
+
+  ebus::RuntimeConfig runtime;
+  runtime.address = 0x01;
+
+  BusMonitor monitor;
+  platform::Bus bus(config, runtime, &request, &monitor);
+  Handler handler(runtime.address, &bus, &request, &monitor);
+
+  Scheduler scheduler(&handler);
+  scheduler.setMaxAttempts(1);
+
+  bool open = false;
+  int acquired = 0;
+  std::vector<bool> released;
+  scheduler.setSessionGate(
+      [&]() {
+        acquired++;
+        return open;
+      },
+      [&](bool more) { released.push_back(more); });
+
+  uint32_t first = scheduler.enqueue(1, ebus::toVector("feb5050327002d"));
+  scheduler.enqueue(1, ebus::toVector("feb5050327002d"));
+
+  // Deferred: nothing starts and the reactor is not spun
+  REQUIRE_FALSE(scheduler.tick());
+  REQUIRE(acquired == 1);
+  REQUIRE_FALSE(handler.isActiveMessagePending());
+  REQUIRE(scheduler.nextDueTime() == ebus::Clock::time_point::max());
+
+  open = true;
+  REQUIRE(scheduler.tick());
+  REQUIRE(acquired == 2);
+  REQUIRE(released.empty());
+
+  // A terminal result ends the turn and reports the second item as due
+  ProtocolEvent ev{};
+  ev.type = ProtocolEvent::Type::error;
+  ev.session_id = first;
+  ev.protocol_error = ebus::ProtocolError::invalid_message;
+  REQUIRE(scheduler.injectProtocolEvent(ev));
+  REQUIRE(released.size() == 1);
+  REQUIRE(released[0]);
+
+  // Clearing an active attempt ends its turn too
+  handler.reset();
+  REQUIRE(scheduler.tick());
+  scheduler.clear();
+  REQUIRE(released.size() == 2);
+  REQUIRE_FALSE(released[1]);
+}
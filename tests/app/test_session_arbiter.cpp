@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <array>
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cstddef>
+
+#include "app/session_arbiter.hpp"
+
+using namespace ebus::detail;
+
+namespace {
+
+// Grants n sessions to the source whose turn it is, every source keeps
+// asking for more
+template <size_t N>
+void runSessions(SessionArbiter& arbiter, std::array<SessionShare, N>& shares,
+                 int n, ebus::Clock::time_point now) {
+  for (auto& share : shares) arbiter.request(share, now);
+  for (int i = 0; i < n; ++i) {
+    SessionShare* best = nullptr;
+    for (auto& share : shares)
+      if (!best || arbiter.precedes(share, *best)) best = &share;
+    arbiter.grant(*best, now);
+    arbiter.request(*best, now);
+  }
+}
+
+}  // namespace
+
+TEST_CASE("SessionArbiter alternates equal weights", "[app][session]") {
+  SessionArbiter arbiter;
+  std::array<SessionShare, 2> shares;
+  const auto now = ebus::Clock::now();
+
+  runSessions(arbiter, shares, 10, now);
+  REQUIRE(shares[0].sessions == 5);
+  REQUIRE(shares[1].sessions == 5);
+  REQUIRE(arbiter.totalSessions() == 10);
+  REQUIRE(arbiter.shareOf(shares[0]) == Catch::Approx(0.5f));
+}
+
+TEST_CASE("SessionArbiter honours weights", "[app][session]") {
+  SessionArbiter arbiter;
+  std::array<SessionShare, 2> shares;
+  shares[0].weight = 3;
+  const auto now = ebus::Clock::now();
+
+  runSessions(arbiter, shares, 40, now);
+  REQUIRE(shares[0].sessions == 30);
+  REQUIRE(shares[1].sessions == 10);
+}
+
+TEST_CASE("SessionArbiter prefers the longest waiting source on ties",
+          "[app][session]") {
+  SessionArbiter arbiter;
+  SessionShare early;
+  SessionShare late;
+  const auto now = ebus::Clock::now();
+
+  arbiter.request(late, now);
+  arbiter.request(early, now - std::chrono::milliseconds(5));
+  REQUIRE(arbiter.precedes(early, late));
+
+  // A repeated request keeps the original wait start
+  arbiter.request(late, now - std::chrono::milliseconds(10));
+  REQUIRE(arbiter.precedes(early, late));
+}
+
+TEST_CASE("SessionArbiter gives an idle source no credit", "[app][session]") {
+  SessionArbiter arbiter;
+  std::array<SessionShare, 1> busy;
+  const auto now = ebus::Clock::now();
+  runSessions(arbiter, busy, 20, now);
+
+  // A newcomer gets its turn next, but not 20 sessions in a row
+  SessionShare idle;
+  arbiter.request(idle, now);
+  REQUIRE(arbiter.precedes(idle, busy[0]));
+  arbiter.grant(idle, now);
+  arbiter.request(idle, now + std::chrono::milliseconds(1));
+  REQUIRE(arbiter.precedes(busy[0], idle));
+}
+
+TEST_CASE("SessionArbiter accounts wait times", "[app][session]") {
+  SessionArbiter arbiter;
+  SessionShare share;
+  const auto start = ebus::Clock::now();
+
+  arbiter.request(share, start);
+  arbiter.grant(share, start + std::chrono::milliseconds(4));
+  arbiter.request(share, start);
+  arbiter.grant(share, start + std::chrono::milliseconds(2));
+
+  REQUIRE_FALSE(share.waiting);
+  REQUIRE(share.sessions == 2);
+  REQUIRE(share.wait_max_us == 4000);
+  REQUIRE(share.averageWaitMs() == Catch::Approx(3.0f));
+
+  arbiter.request(share, start);
+  arbiter.withdraw(share);
+  REQUIRE_FALSE(share.waiting);
+  REQUIRE(share.sessions == 2);
+}
@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <ebus/utils.hpp>
+#include <vector>
+
+#include "app/subscription_manager.hpp"
+
+using namespace ebus;
+using namespace ebus::detail;
+
+namespace {
+
+const auto master = toVector("1008b509030d1800");
+
+// Flow temperature: DATA2C in the slave response of B5 09 0D
+Subscription flowTemp() {
+  Subscription sub;
+  sub.pb = 0xb5;
+  sub.sb = 0x09;
+  sub.id[0] = 0x0d;
+  sub.id_size = 1;
+  sub.type = DataType::data2c;
+  sub.slave = true;
+  return sub;
+}
+
+struct Recorder {
+  std::vector<ChangeInfo> changes;
+
+  void attach(SubscriptionManager& manager) {
+    manager.setCallback([this](const ChangeInfo& info) {
+      changes.push_back(info);
+    });
+  }
+
+  size_t feed(SubscriptionManager& manager, const char* slave,
+              uint64_t timestamp = 0, const std::vector<uint8_t>& m = master) {
+    const size_t before = changes.size();
+    manager.process(m, toVector(slave), timestamp);
+    return changes.size() - before;
+  }
+};
+
+}  // namespace
+
+TEST_CASE("SubscriptionManager: Absolute deadband", "[app][subscription]") {
+  SubscriptionManager manager;
+  Recorder recorder;
+  recorder.attach(manager);
+
+  Subscription sub = flowTemp();
+  sub.deadband = 0.5f;
+  const uint16_t id = manager.subscribe(sub);
+  REQUIRE(id != 0);
+
+  // The first value is always reported
+  REQUIRE(recorder.feed(manager, "02a001") == 1);  // 26.0
+  REQUIRE(recorder.changes[0].subscription_id == id);
+  REQUIRE(isNull(recorder.changes[0].previous));
+  REQUIRE_FALSE(recorder.changes[0].refresh);
+
+  // Jitter within the band is suppressed, also when it accumulates
+  REQUIRE(recorder.feed(manager, "02a401") == 0);  // 26.25
+  REQUIRE(recorder.feed(manager, "02a801") == 0);  // 26.5
+
+  // Compared with the last reported value, not the last seen one
+  REQUIRE(recorder.feed(manager, "02a901") == 1);  // 26.5625
+  REQUIRE(asFloat(recorder.changes[1].value) == Catch::Approx(26.5625f));
+  REQUIRE(asFloat(recorder.changes[1].previous) == Catch::Approx(26.0f));
+
+  // Other messages and short responses are ignored
+  REQUIRE(recorder.feed(manager, "02f001", 0, toVector("1008b509030e1800")) ==
+          0);
+  REQUIRE(recorder.feed(manager, "01f0") == 0);
+
+  const auto status = manager.fetchStatus();
+  REQUIRE(status.count == 1);
+  REQUIRE(status.matches == 4);
+  REQUIRE(status.reports == 2);
+}
+
+TEST_CASE("SubscriptionManager: Relative deadband", "[app][subscription]") {
+  SubscriptionManager manager;
+  Recorder recorder;
+  recorder.attach(manager);
+
+  Subscription sub = flowTemp();
+  sub.deadband = 0.05f;  // 5 %
+  sub.relative = true;
+  manager.subscribe(sub);
+
+  REQUIRE(recorder.feed(manager, "024001") == 1);  // 20.0
+  REQUIRE(recorder.feed(manager, "025001") == 0);  // 21.0
+  REQUIRE(recorder.feed(manager, "025201") == 1);  // 21.125
+  // The band follows the last reported value
+  REQUIRE(recorder.feed(manager, "026201") == 0);  // 22.125
+  REQUIRE(recorder.feed(manager, "027001") == 1);  // 23.0
+}
+
+TEST_CASE("SubscriptionManager: Silence refresh", "[app][subscription]") {
+  SubscriptionManager manager;
+  Recorder recorder;
+  recorder.attach(manager);
+
+  Subscription sub = flowTemp();
+  sub.deadband = 1.0f;
+  sub.max_silence_ms = 60000;
+  manager.subscribe(sub);
+
+  REQUIRE(recorder.feed(manager, "02a001", 1000) == 1);
+  REQUIRE(recorder.feed(manager, "02a001", 30000) == 0);
+  REQUIRE(recorder.feed(manager, "02a401", 61000) == 1);
+  REQUIRE(recorder.changes[1].refresh);
+  // The refresh restarts the silence period
+  REQUIRE(recorder.feed(manager, "02a001", 100000) == 0);
+  REQUIRE(recorder.feed(manager, "02a001", 121000) == 1);
+}
+
+TEST_CASE("SubscriptionManager: Null and text values", "[app][subscription]") {
+  SubscriptionManager manager;
+  Recorder recorder;
+  recorder.attach(manager);
+
+  Subscription sub = flowTemp();
+  sub.deadband = 100.0f;
+  manager.subscribe(sub);
+
+  REQUIRE(recorder.feed(manager, "02a001") == 1);
+  // Replacement value 0x8000 and back are changes regardless of the band
+  REQUIRE(recorder.feed(manager, "020080") == 1);
+  REQUIRE(isNull(recorder.changes[1].value));
+  REQUIRE(recorder.feed(manager, "020080") == 0);
+  REQUIRE(recorder.feed(manager, "02a001") == 1);
+
+  Subscription text;
+  text.any_target = false;
+  text.zz = 0x08;
+  text.pb = 0xb5;
+  text.sb = 0x10;
+  text.type = DataType::char2;
+  text.offset = 1;
+  REQUIRE(manager.subscribe(text) != 0);
+
+  const auto telegram = [](const char* hex) { return toVector(hex); };
+  REQUIRE(recorder.feed(manager, "", 0, telegram("1008b51003004f4b")) == 1);
+  REQUIRE(recorder.feed(manager, "", 0, telegram("1008b51003014f4b")) == 0);
+  REQUIRE(recorder.feed(manager, "", 0, telegram("1008b51003004e4f")) == 1);
+  REQUIRE(asString(recorder.changes.back().value) == "NO");
+  // Bound to target 08
+  REQUIRE(recorder.feed(manager, "", 0, telegram("1015b51003004f4b")) == 0);
+}
+
+TEST_CASE("SubscriptionManager: Registration", "[app][subscription]") {
+  SubscriptionManager manager;
+
+  Subscription invalid = flowTemp();
+  invalid.type = DataType::error;
+  REQUIRE(manager.subscribe(invalid) == 0);
+  invalid = flowTemp();
+  invalid.id_size = MessageDatabaseLimits::max_id_bytes + 1;
+  REQUIRE(manager.subscribe(invalid) == 0);
+
+  std::vector<uint16_t> ids;
+  for (size_t i = 0; i < SubscriptionLimits::max_subscriptions; ++i) {
+    const uint16_t id = manager.subscribe(flowTemp());
+    REQUIRE(id != 0);
+    ids.push_back(id);
+  }
+  REQUIRE(manager.subscribe(flowTemp()) == 0);
+
+  // The callback may remove subscriptions while they are evaluated
+  size_t reported = 0;
+  manager.setCallback([&manager, &reported](const ChangeInfo& info) {
+    ++reported;
+    manager.unsubscribe(info.subscription_id);
+  });
+  manager.process(master, toVector("02a001"), 0);
+  REQUIRE(reported > 0);
+  REQUIRE(manager.fetchStatus().count == ids.size() - reported);
+
+  manager.clear();
+  REQUIRE(manager.fetchStatus().count == 0);
+  REQUIRE(manager.fetchStatus().capacity ==
+          SubscriptionLimits::max_subscriptions);
+}
+
+TEST_CASE("SubscriptionManager: Removal during process",
+          "[app][subscription]") {
+  SubscriptionManager manager;
+  const uint16_t first = manager.subscribe(flowTemp());
+  const uint16_t second = manager.subscribe(flowTemp());
+  const uint16_t third = manager.subscribe(flowTemp());
+
+  // Removing the current or an earlier entry does not skip the next one
+  std::vector<uint16_t> reported;
+  manager.setCallback([&manager, &reported](const ChangeInfo& info) {
+    reported.push_back(info.subscription_id);
+    if (reported.size() == 1) return;
+    manager.unsubscribe(reported.front());
+    manager.unsubscribe(info.subscription_id);
+  });
+  manager.process(master, toVector("02a001"), 0);
+  REQUIRE(reported == std::vector<uint16_t>{first, second, third});
+  REQUIRE(manager.fetchStatus().count == 0);
+}
+
+TEST_CASE("SubscriptionManager: IDs are unique after a wrap",
+          "[app][subscription]") {
+  SubscriptionManager manager;
+  const uint16_t kept = manager.subscribe(flowTemp());
+  REQUIRE(kept == 1);
+
+  // Run through the whole ID range once
+  for (uint32_t i = 0; i < 0xffff; ++i) {
+    const uint16_t id = manager.subscribe(flowTemp());
+    REQUIRE(id != 0);
+    REQUIRE(id != kept);
+    manager.unsubscribe(id);
+  }
+  const uint16_t id = manager.subscribe(flowTemp());
+  REQUIRE(id != 0);
+  REQUIRE(id != kept);
+  REQUIRE(manager.fetchStatus().count == 2);
+}
+
+TEST_CASE("SubscriptionManager: Value history", "[app][subscription]") {
+  SubscriptionManager manager;
+
+  Subscription sub = flowTemp();
+  sub.deadband = 10.0f;
+  sub.history = true;
+  const uint16_t id = manager.subscribe(sub);
+  const uint16_t plain = manager.subscribe(flowTemp());
+
+  // Every decoded value is recorded, not only the reported changes
+  manager.process(master, toVector("02a001"), 10000);  // 26.0
+  manager.process(master, toVector("02a801"), 20000);  // 26.5
+  manager.process(master, toVector("020080"), 30000);  // null, skipped
+  manager.process(master, toVector("02b001"), 40000);  // 27.0
+
+  std::vector<float> values;
+  manager.fetchHistory(id, HistoryQuery{},
+                       TimeSeriesStore::SampleVisitor(
+                           [&values](uint64_t, float v) {
+                             values.push_back(v);
+                           }));
+  REQUIRE(values == std::vector<float>{26.0f, 26.5f, 27.0f});
+
+  size_t buckets = 0;
+  HistoryQuery query;
+  query.from = 15000;
+  query.step_ms = 60000;
+  manager.fetchHistory(id, query,
+                       TimeSeriesStore::BucketVisitor(
+                           [&buckets](const TimeSeriesStore::Bucket& b) {
+                             buckets += b.count;
+                           }));
+  REQUIRE(buckets == 2);
+
+  values.clear();
+  manager.fetchHistory(plain, HistoryQuery{},
+                       TimeSeriesStore::SampleVisitor(
+                           [&values](uint64_t, float v) {
+                             values.push_back(v);
+                           }));
+  REQUIRE(values.empty());
+  REQUIRE(manager.fetchStatus().history_samples == 3);
+
+  manager.unsubscribe(id);
+  REQUIRE(manager.fetchStatus().history_samples == 0);
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <ebus/detail/json_writer.hpp>
+#include <string>
+#include <vector>
+
+#include "app/traffic_analyzer.hpp"
+
+using namespace ebus::detail;
+
+namespace {
+
+using Bytes = std::vector<uint8_t>;
+
+const ebus::TrafficPair* findPair(const ebus::TrafficMatrix& matrix,
+                                  uint8_t source, uint8_t target) {
+  for (const auto& entry : matrix.pairs)
+    if (entry.source == source && entry.target == target) return &entry;
+  return nullptr;
+}
+
+const ebus::TrafficService* findService(const ebus::TrafficMatrix& matrix,
+                                        uint8_t pb, uint8_t sb) {
+  for (const auto& entry : matrix.services)
+    if (entry.pb == pb && entry.sb == sb) return &entry;
+  return nullptr;
+}
+
+}  // namespace
+
+TEST_CASE("TrafficAnalyzer: Wire bytes", "[app][traffic]") {
+  // Data plus CRC; 0xAA and 0xA9 take two bytes on the wire
+  REQUIRE(TrafficAnalyzer::wireBytes(Bytes{0x10, 0x08, 0xb5, 0x10, 0x00}) ==
+          6);
+  REQUIRE(TrafficAnalyzer::wireBytes(
+              Bytes{0x10, 0x08, 0xb5, 0x10, 0x02, 0xaa, 0xa9}) == 10);
+  REQUIRE(TrafficAnalyzer::wireBytes(Bytes{}) == 1);
+}
+
+TEST_CASE("TrafficAnalyzer: Matrix and service histogram", "[app][traffic]") {
+  TrafficAnalyzer traffic;
+  traffic.setOwnAddress(0x31);
+
+  REQUIRE_FALSE(traffic.fetchSnapshot([](const ebus::TrafficMatrix&) {}));
+
+  const Bytes poll = {0x10, 0x08, 0xb5, 0x11, 0x01, 0x01};
+  const Bytes response = {0x02, 0x11, 0x22};
+  const Bytes own_poll = {0x31, 0x08, 0xb5, 0x11, 0x01, 0x01};
+  const Bytes broadcast = {0x10, 0xfe, 0x07, 0x00, 0x00};
+
+  for (int i = 0; i < 3; ++i) traffic.recordTelegram(poll, response);
+  traffic.recordTelegram(own_poll, response);
+  traffic.recordTelegram(broadcast, {});
+  traffic.recordError(poll);
+  traffic.recordError({});
+  REQUIRE(traffic.publish(1000));
+
+  // Later records do not change the published matrix
+  traffic.recordTelegram(poll, response);
+
+  ebus::TrafficMatrix matrix;
+  REQUIRE(traffic.fetchSnapshot(
+      [&](const ebus::TrafficMatrix& published) { matrix = published; }));
+  REQUIRE(matrix.generation == 1);
+  REQUIRE(matrix.timestamp == 1000);
+
+  // Master part and slave response with CRC and ACK each; no ACK for the
+  // broadcast
+  const uint32_t poll_bytes = 7 + 1 + 4 + 1;
+  REQUIRE(matrix.total.telegrams == 5);
+  REQUIRE(matrix.total.wire_bytes == 4 * poll_bytes + 6);
+  REQUIRE(matrix.total.errors == 2);
+
+  REQUIRE(matrix.pairs.size() == 3);
+  const auto* pair = findPair(matrix, 0x10, 0x08);
+  REQUIRE(pair != nullptr);
+  REQUIRE(pair->count.telegrams == 3);
+  REQUIRE(pair->count.wire_bytes == 3 * poll_bytes);
+  REQUIRE(pair->count.errors == 1);
+  REQUIRE(findPair(matrix, 0x31, 0x08)->count.telegrams == 1);
+
+  // The same service polled by 0x10 and by us
+  REQUIRE(matrix.services.size() == 2);
+  const auto* service = findService(matrix, 0xb5, 0x11);
+  REQUIRE(service != nullptr);
+  REQUIRE(service->count.telegrams == 4);
+  REQUIRE(service->own_telegrams == 1);
+  REQUIRE(service->count.errors == 1);
+  REQUIRE(findService(matrix, 0x07, 0x00)->count.wire_bytes == 6);
+
+  std::string json;
+  {
+    JsonWriter writer([&json](std::string_view chunk) { json += chunk; });
+    matrix.toJson(writer);
+  }
+  REQUIRE(json.find("\"source\":\"10\"") != std::string::npos);
+  REQUIRE(json.find("\"own_telegrams\":1") != std::string::npos);
+}
+
+TEST_CASE("TrafficAnalyzer: Capacity overflow", "[app][traffic]") {
+  TrafficAnalyzer traffic;
+
+  // One more target and service than the tables hold
+  const size_t extra = TrafficLimits::max_pairs + 1;
+  for (size_t i = 0; i < extra; ++i) {
+    const uint8_t target = static_cast<uint8_t>(0x40 + i % 0x60);
+    const uint8_t sb = static_cast<uint8_t>(i);
+    const Bytes master = {0x10, target, static_cast<uint8_t>(i >> 8), sb,
+                          0x00};
+    traffic.recordTelegram(master, {});
+  }
+  REQUIRE(traffic.publish(0));
+
+  traffic.fetchSnapshot([&](const ebus::TrafficMatrix& matrix) {
+    size_t pairs = 0;
+    for (const auto& entry : matrix.pairs) pairs += entry.count.telegrams;
+    REQUIRE(pairs + matrix.pair_overflow.telegrams == extra);
+    REQUIRE(matrix.services.size() ==
+            std::min(extra, TrafficLimits::max_services));
+    REQUIRE(matrix.services.size() + matrix.service_overflow.telegrams ==
+            extra);
+    REQUIRE(matrix.total.telegrams == extra);
+  });
+}
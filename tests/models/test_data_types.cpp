@@ -7,6 +7,7 @@
 #include <catch2/catch_all.hpp>
 #include <cctype>
 #include <cmath>
+#include <cstring>
 #include <ebus/data_types.hpp>
 #include <ebus/sequence.hpp>
 #include <ebus/types.hpp>
@@ -290,7 +291,7 @@ TEST_CASE("Datatypes: char and hex", "[models][datatypes]") {
     Sequence bytes = ebus::encode(DataType::char8, str);
     auto decoded = ebus::decode(DataType::char8, bytes);
     REQUIRE(decoded.has_value());
-    REQUIRE(std::get<std::string>(*decoded).find(str) == 0);
+    REQUIRE(asString(*decoded).find(str) == 0);
   }
 
   std::vector<std::string> hex_strings = {"",       "00",     "FF",      "1234",
@@ -303,10 +304,38 @@ TEST_CASE("Datatypes: char and hex", "[models][datatypes]") {
     Sequence bytes = ebus::encode(DataType::hex8, str_lower);
     auto decoded = ebus::decode(DataType::hex8, bytes);
     REQUIRE(decoded.has_value());
-    REQUIRE(std::get<std::string>(*decoded).find(str_lower) == 0);
+    REQUIRE(asString(*decoded).find(str_lower) == 0);
   }
 }
 
+TEST_CASE("Datatypes: inline strings", "[models][datatypes]") {
+  STATIC_REQUIRE(std::is_trivially_copyable_v<DataValue>);
+  STATIC_REQUIRE(sizeof(DataValue) <= 24);
+
+  const auto bytes = toVector("45425553");  // "EBUS"
+  auto decoded = decode(DataType::char4, bytes);
+  REQUIRE(decoded.has_value());
+  REQUIRE(std::holds_alternative<DataString>(*decoded));
+  REQUIRE(asString(*decoded) == "EBUS");
+  REQUIRE(toString(*decoded) == "EBUS");
+  REQUIRE(getDataType(*decoded) == DataType::char8);
+  REQUIRE(asString(DataValue(uint8_t{1})).empty());
+
+  // Input beyond the largest CHAR type is truncated
+  DataString text(std::string("0123456789"));
+  REQUIRE(text.size() == DataString::capacity);
+  REQUIRE(std::string_view(text) == "01234567");
+  REQUIRE(DataValue(text) == DataValue("01234567"));
+  REQUIRE(DataValue(text) != DataValue("0123"));
+
+  // Raw bytes including zeros survive a round trip
+  const auto raw = toVector("00ff0010");
+  auto hex = decode(DataType::hex4, raw);
+  REQUIRE(hex.has_value());
+  REQUIRE(asString(*hex).size() == 4);
+  REQUIRE(encode(DataType::hex4, *hex) == Sequence(raw));
+}
+
 TEST_CASE("Datatypes: metadata", "[models][datatypes]") {
   auto types = ebus::getSupportedDataTypes();
   REQUIRE_FALSE(types.empty());
@@ -630,4 +659,106 @@ TEST_CASE("Datatypes: all types roundtrip", "[models][datatypes]") {
       REQUIRE(*re_decoded == *decoded);
     }
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Datatypes: columnar decode matches decode()",
+          "[models][datatypes][column]") {
+  const DataType types[] = {
+      DataType::bcd,     DataType::data1c,  DataType::uint16,
+      DataType::uint16r, DataType::int16,   DataType::int16r,
+      DataType::data2b,  DataType::data2br, DataType::data2c,
+      DataType::data2cr, DataType::uint8,   DataType::data1b,
+      DataType::int32,   DataType::float4,  DataType::char2};
+
+  // Every 2 byte pattern behind one leading byte, plus a short payload
+  std::vector<uint8_t> storage(0x10000 * 5);
+  std::vector<ByteView> payloads;
+  for (uint32_t i = 0; i < 0x10000; ++i) {
+    uint8_t* p = &storage[i * 5];
+    p[0] = 0x55;
+    p[1] = static_cast<uint8_t>(i);
+    p[2] = static_cast<uint8_t>(i >> 8);
+    p[3] = static_cast<uint8_t>(i * 7);
+    p[4] = static_cast<uint8_t>(i >> 3);
+    payloads.push_back({p, 5});
+  }
+  payloads.push_back({storage.data(), 1});
+  const size_t count = payloads.size();
+
+  std::vector<int64_t> ints(count);
+  std::vector<float> reals(count);
+  std::vector<uint8_t> nulls((count + 7) / 8);
+
+  for (DataType dt : types) {
+    for (Endian e : {Endian::little, Endian::big}) {
+      INFO(dataTypeToString(dt));
+      Column column;
+      column.type = dt;
+      column.offset = 1;
+      column.endian = e;
+      column.ints = ints.data();
+      column.reals = reals.data();
+      column.nulls = nulls.data();
+      const size_t valid = decodeColumn(payloads.data(), count, column);
+
+      size_t expected_valid = 0;
+      size_t mismatches = 0;
+      for (size_t i = 0; i < count; ++i) {
+        const auto& p = payloads[i];
+        std::optional<DataValue> scalar;
+        if (p.size() > 1) scalar = decode(dt, {p.data() + 1, p.size() - 1}, e);
+        const bool null = !scalar || isNull(*scalar) || !isNumeric(*scalar);
+        if (column.isNull(i) != null) {
+          mismatches++;
+          continue;
+        }
+        if (null) {
+          if (ints[i] != 0) mismatches++;
+          continue;
+        }
+        expected_valid++;
+        const int64_t expected_int = std::holds_alternative<int64_t>(*scalar)
+                                         ? std::get<int64_t>(*scalar)
+                                         : asInt64(*scalar);
+        const float expected_real = asFloat(*scalar);
+        if (ints[i] != expected_int ||
+            std::memcmp(&reals[i], &expected_real, sizeof(float)) != 0)
+          mismatches++;
+      }
+      REQUIRE(mismatches == 0);
+      REQUIRE(valid == expected_valid);
+    }
+  }
+}
+
+TEST_CASE("Datatypes: columnar decode of a layout",
+          "[models][datatypes][column]") {
+  // DATA2C flow temperature, BCD status; the second telegram carries
+  // replacement values, the third is truncated
+  const auto a = toVector("a00105");
+  const auto b = toVector("0080ff");
+  const auto c = toVector("a0");
+  const ByteView payloads[] = {a, b, c};
+
+  float temps[3];
+  uint8_t temp_nulls[1];
+  int64_t states[3];
+  uint8_t state_nulls[1];
+
+  Column columns[2];
+  columns[0].type = DataType::data2c;
+  columns[0].reals = temps;
+  columns[0].nulls = temp_nulls;
+  columns[1].type = DataType::bcd;
+  columns[1].offset = 2;
+  columns[1].ints = states;
+  columns[1].nulls = state_nulls;
+  decodeColumns(payloads, 3, columns, 2);
+
+  REQUIRE(temps[0] == Catch::Approx(26.0f));
+  REQUIRE(states[0] == 5);
+  REQUIRE(temp_nulls[0] == 0b110);
+  REQUIRE(state_nulls[0] == 0b110);
+  REQUIRE(columns[1].isNull(1));
+  REQUIRE_FALSE(columns[1].isNull(0));
+}
@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cstdint>
+#include <ebus/data_types.hpp>
+#include <ebus/message_database.hpp>
+#include <ebus/utils.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace ebus;
+
+namespace {
+
+const char* const csv_definitions =
+    "# type,circuit,level,name,comment,qq,zz,pbsb,id,field,part,type,"
+    "divider,unit,comment\n"
+    "r,bai,,FlowTemp,,,08,b509,0d1800,temp,s,D2C,,C,,status,s,UCH,,,\n"
+    "r,bai,,Status,,,,b509,0d,code,,UCH,,,\n"
+    "r,bai,,Status08,,,08,b509,0d,code,,UCH,,,\n"
+    "w,bai,,SetTemp,,,08,b510,,,,IGN:1,,,,temp,m,D1C,,C,\n"
+    "u,broadcast,,Outside,,,fe,b516,01,temp,m,D2B,10,C,\r\n"
+    "*r,,,,,,,b509,,,,,,,\n";
+
+using Values = std::map<std::string, DataValue>;
+
+Values decodeAll(const MessageDatabase& db, const char* master,
+                 const char* slave, std::string* message = nullptr) {
+  const auto m = toVector(master);
+  const auto s = toVector(slave);
+  static Values values;
+  values.clear();
+  const MessageDefinition* def =
+      db.decode(m, s, 0, [](const ValueInfo& info) {
+        values[std::string(info.field)] = info.value;
+      });
+  if (message) *message = def ? def->name : "";
+  return values;
+}
+
+}  // namespace
+
+TEST_CASE("MessageDatabase loads ebusd-style CSV", "[models][database]") {
+  MessageDatabase db;
+  const auto result = db.loadCsv(csv_definitions);
+  REQUIRE(result.added == 5);
+  REQUIRE(result.rejected == 0);
+  REQUIRE(db.size() == 5);
+
+  const auto& set_temp = *db.find(toVector("1008b51002ff50"));
+  REQUIRE(set_temp.name == "SetTemp");
+  REQUIRE(set_temp.fields.size() == 1);
+  REQUIRE(set_temp.fields[0].offset == 1);
+  REQUIRE_FALSE(set_temp.fields[0].slave);
+
+  SECTION("Rejects malformed lines and keeps the rest") {
+    MessageDatabase other;
+    const auto r = other.loadCsv(
+        "r,bai,,Bad,,,,b5,,x,s,UCH,,,\n"
+        "r,bai,,Unknown,,,,b509,,x,s,NOPE,,,\n"
+        "r,bai,,LongId,,,,b509,0102030405,x,s,UCH,,,\n"
+        "r,bai,,Good,,,,b509,,x,s,UCH,,,\n");
+    REQUIRE(r.added == 1);
+    REQUIRE(r.rejected == 3);
+  }
+}
+
+TEST_CASE("MessageDatabase decodes named values", "[models][database]") {
+  MessageDatabase db;
+  db.loadCsv(csv_definitions);
+  std::string message;
+
+  // Slave data: DATA2C 0x01a0 = 26.0, UCH 5
+  auto values = decodeAll(db, "1008b509030d1800", "03a00105", &message);
+  REQUIRE(message == "FlowTemp");
+  REQUIRE(values.size() == 2);
+  REQUIRE(asFloat(values["temp"]) == Catch::Approx(26.0f));
+  REQUIRE(std::get<uint8_t>(values["status"]) == 5);
+
+  // Master data after an ignored byte
+  values = decodeAll(db, "1008b51002ff50", "", &message);
+  REQUIRE(message == "SetTemp");
+  REQUIRE(asFloat(values["temp"]) == Catch::Approx(40.0f));
+
+  // Divider turns the value into a float
+  values = decodeAll(db, "10feb51603010001", "", &message);
+  REQUIRE(message == "Outside");
+  REQUIRE(std::get<float>(values["temp"]) == Catch::Approx(0.1f));
+
+  // Replacement values are reported as null, missing bytes not at all
+  values = decodeAll(db, "1008b509030d1800", "020080", &message);
+  REQUIRE(values.size() == 1);
+  REQUIRE(isNull(values["temp"]));
+
+  values = decodeAll(db, "1008b50a00", "", &message);
+  REQUIRE(message.empty());
+  REQUIRE(values.empty());
+}
+
+TEST_CASE("MessageDatabase prefers the most specific definition",
+          "[models][database]") {
+  MessageDatabase db;
+  db.loadCsv(csv_definitions);
+
+  auto name = [&](const char* master) {
+    const MessageDefinition* def = db.find(toVector(master));
+    return def ? def->name : std::string();
+  };
+
+  // Longest ID first
+  REQUIRE(name("1008b509030d1800") == "FlowTemp");
+  // The shorter ID matches when the long one differs
+  REQUIRE(name("1008b509030d2a00") == "Status08");
+  // A definition for the target precedes one for any target
+  REQUIRE(name("1015b509030d2a00") == "Status");
+  // FlowTemp is only defined for target 08
+  REQUIRE(name("1015b509030d1800") == "Status");
+  // IDs never extend beyond NN
+  REQUIRE(name("1008b509010d1800") == "Status08");
+  REQUIRE(name("1008b509000d1800").empty());
+  REQUIRE(name("1008b5").empty());
+}
+
+TEST_CASE("MessageDatabase loads JSON definitions", "[models][database]") {
+  MessageDatabase db;
+  const auto result = db.loadJson(R"([
+    {"circuit": "bai", "name": "Water", "zz": "08", "pbsb": "b509",
+     "id": "0d", "fields": [
+       {"name": "flow", "part": "s", "type": "DATA2C", "unit": "C"},
+       {"name": "return", "part": "s", "type": "D2C"},
+       {"name": "pressure", "part": "s", "type": "UCH", "offset": 5,
+        "factor": 0.1, "unit": "bar"}]},
+    {"name": "Broken", "fields": []},
+    {"circuit": "bai", "name": "BadType", "pbsb": "b509",
+     "fields": [{"name": "x", "type": "IGN"}]}
+  ])");
+  REQUIRE(result.added == 1);
+  REQUIRE(result.rejected == 2);
+
+  const MessageDefinition* def = db.find(toVector("1008b509010d"));
+  REQUIRE(def != nullptr);
+  REQUIRE(def->circuit == "bai");
+  REQUIRE(def->fields.size() == 3);
+  REQUIRE(def->fields[1].offset == 2);
+  REQUIRE(def->fields[2].offset == 5);
+  REQUIRE(def->fields[0].unit == "C");
+
+  auto values = decodeAll(db, "1008b509010d", "06a0011001ff0f");
+  REQUIRE(asFloat(values["flow"]) == Catch::Approx(26.0f));
+  REQUIRE(asFloat(values["return"]) == Catch::Approx(17.0f));
+  REQUIRE(std::get<float>(values["pressure"]) == Catch::Approx(1.5f));
+}
+
+namespace {
+
+// 5000 definitions over 20 PBs, 250 SBs and IDs of 0 to 4 bytes
+MessageDatabase makeLargeDatabase(std::vector<std::vector<uint8_t>>& probes) {
+  MessageDatabase db;
+  for (uint32_t i = 0; i < 5000; ++i) {
+    MessageDefinition def;
+    def.circuit = "c" + std::to_string(i % 7);
+    def.name = "m" + std::to_string(i);
+    def.pb = static_cast<uint8_t>(i % 20);
+    def.sb = static_cast<uint8_t>(i / 20);
+    def.id_size = static_cast<uint8_t>(i % 5);
+    for (uint8_t b = 0; b < def.id_size; ++b)
+      def.id[b] = static_cast<uint8_t>(i >> (b * 2));
+    def.fields.push_back({"value", "", DataType::uint16, true, 0, 1.0f});
+    REQUIRE(db.add(def));
+
+    std::vector<uint8_t> master = {0x10, 0x08, def.pb, def.sb, def.id_size};
+    master.insert(master.end(), def.id.begin(),
+                  def.id.begin() + def.id_size);
+    probes.push_back(master);
+  }
+  db.build();
+  return db;
+}
+
+}  // namespace
+
+TEST_CASE("MessageDatabase resolves 5000 definitions", "[models][database]") {
+  std::vector<std::vector<uint8_t>> probes;
+  const MessageDatabase db = makeLargeDatabase(probes);
+  REQUIRE(db.size() == 5000);
+
+  for (size_t i = 0; i < probes.size(); ++i) {
+    const MessageDefinition* def = db.find(probes[i]);
+    REQUIRE(def != nullptr);
+    REQUIRE(def->name == "m" + std::to_string(i));
+  }
+}
+
+TEST_CASE("MessageDatabase lookup throughput", "[.][benchmark][database]") {
+  std::vector<std::vector<uint8_t>> probes;
+  const MessageDatabase db = makeLargeDatabase(probes);
+  const auto slave = toVector("02a001");
+
+  auto measure = [&](auto&& lookup) {
+    constexpr int rounds = 200;
+    size_t hits = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r)
+      for (const auto& probe : probes) hits += lookup(probe);
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    REQUIRE(hits == rounds * probes.size());
+    return static_cast<double>(hits) / elapsed.count();
+  };
+
+  const double finds = measure(
+      [&](const std::vector<uint8_t>& m) { return db.find(m) != nullptr; });
+  const double decodes = measure([&](const std::vector<uint8_t>& m) {
+    return db.decode(m, slave, 0, [](const ValueInfo&) {}) != nullptr;
+  });
+
+  WARN("5000 definitions: " << static_cast<uint64_t>(finds)
+                            << " lookups/s, " << static_cast<uint64_t>(decodes)
+                            << " decodes/s");
+}
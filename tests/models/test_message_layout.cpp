@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <cstring>
+#include <ebus/data_types.hpp>
+#include <ebus/message_layout.hpp>
+#include <ebus/types.hpp>
+#include <string>
+#include <vector>
+
+using namespace ebus;
+
+namespace {
+
+// The layout decodes exactly what decode() returns, null and invalid
+// values both as nullopt
+template <DataType DT, Endian E = Endian::little>
+bool matchesScalar(const std::vector<uint8_t>& bytes) {
+  using F = Field<DT, 0, E>;
+  const auto fast = F::decode(bytes.data());
+  const auto scalar = ebus::decode(DT, bytes, E);
+  if (!scalar || isNull(*scalar)) return !fast.has_value();
+  if (!fast) return false;
+
+  if constexpr (F::spec.kind == detail::FieldSpec::Kind::text) {
+    return asString(*scalar) == std::string(fast->data(), fast->size());
+  } else {
+    const auto* value = std::get_if<typename F::value_type>(&*scalar);
+    // Bitwise, so NaN patterns compare equal too
+    return value && std::memcmp(value, &*fast, sizeof(*value)) == 0;
+  }
+}
+
+template <DataType DT, Endian E = Endian::little>
+void checkAllPatterns() {
+  constexpr size_t size = sizeOfDataType(DT);
+  std::vector<uint8_t> bytes(size);
+  const uint32_t patterns = size == 1 ? 0x100u : 0x10000u;
+  for (uint32_t p = 0; p < patterns; ++p) {
+    bytes[0] = static_cast<uint8_t>(p);
+    if (size > 1) bytes[1] = static_cast<uint8_t>(p >> 8);
+    for (size_t i = 2; i < size; ++i)
+      bytes[i] = static_cast<uint8_t>(p * 31 + i);
+    INFO(dataTypeToString(DT) << " pattern " << p);
+    REQUIRE(matchesScalar<DT, E>(bytes));
+  }
+}
+
+}  // namespace
+
+TEST_CASE("MessageLayout: fields match the scalar decoder",
+          "[models][layout]") {
+  checkAllPatterns<DataType::bcd>();
+  checkAllPatterns<DataType::uint8>();
+  checkAllPatterns<DataType::int8>();
+  checkAllPatterns<DataType::data1b>();
+  checkAllPatterns<DataType::data1c>();
+  checkAllPatterns<DataType::char1>();
+  checkAllPatterns<DataType::hex1>();
+
+  checkAllPatterns<DataType::uint16>();
+  checkAllPatterns<DataType::uint16r>();
+  checkAllPatterns<DataType::int16>();
+  checkAllPatterns<DataType::int16r>();
+  checkAllPatterns<DataType::data2b>();
+  checkAllPatterns<DataType::data2br>();
+  checkAllPatterns<DataType::data2c>();
+  checkAllPatterns<DataType::data2cr>();
+  checkAllPatterns<DataType::data2c, Endian::big>();
+  checkAllPatterns<DataType::uint16r, Endian::big>();
+
+  checkAllPatterns<DataType::uint32>();
+  checkAllPatterns<DataType::uint32r>();
+  checkAllPatterns<DataType::int32>();
+  checkAllPatterns<DataType::int32r>();
+  checkAllPatterns<DataType::float4>();
+  checkAllPatterns<DataType::float4r>();
+  checkAllPatterns<DataType::char8>();
+  checkAllPatterns<DataType::hex3>();
+}
+
+TEST_CASE("MessageLayout: decodes a payload into typed values",
+          "[models][layout]") {
+  // Flow temperature, status byte and a BCD hour
+  using Layout =
+      MessageLayout<Field<DataType::data2c, 0>, Field<DataType::uint8, 2>,
+                    Field<DataType::bcd, 3>>;
+  static_assert(Layout::size == 4);
+  static_assert(Layout::field_count == 3);
+  static_assert(std::is_same_v<Layout::FieldAt<0>::value_type, int64_t>);
+  static_assert(std::is_same_v<Layout::FieldAt<2>::value_type, uint8_t>);
+
+  const std::vector<uint8_t> payload = {0x2c, 0x02, 0xff, 0x23};
+  Layout::Values values;
+  REQUIRE(Layout::decode(payload, values));
+
+  const auto& [flow, status, hour] = values;
+  REQUIRE(flow.has_value());
+  CHECK(*flow == 34750000);  // 34.75 fixed-point
+  CHECK_FALSE(status.has_value());  // replacement value
+  REQUIRE(hour.has_value());
+  CHECK(*hour == 23);
+
+  // Too short: rejected as a whole
+  const std::vector<uint8_t> truncated = {0x2c, 0x02, 0x01};
+  REQUIRE_FALSE(Layout::decode(truncated).has_value());
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+
+#include "platform/io_poller.hpp"
+
+using namespace ebus::detail;
+
+TEST_CASE("IoPoller: Reports readiness with tokens", "[platform][poller]") {
+  platform::IoPoller poller;
+  REQUIRE(poller.init());
+
+  int a[2];
+  int b[2];
+  REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, a) == 0);
+  REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, b) == 0);
+
+  REQUIRE(poller.add(a[0], 0x100, platform::IoPoller::in));
+  REQUIRE(poller.add(b[0], 0x200, platform::IoPoller::in));
+
+  platform::IoPoller::Ready ready[4];
+  CHECK(poller.wait(ready, 4, 10) == 0);
+
+  const uint8_t byte = 0x42;
+  REQUIRE(::write(b[1], &byte, 1) == 1);
+
+  int count = poller.wait(ready, 4, 100);
+  REQUIRE(count == 1);
+  CHECK(ready[0].token == 0x200);
+  CHECK((ready[0].events & platform::IoPoller::in) != 0);
+
+  SECTION("Removed descriptors are no longer reported") {
+    poller.remove(b[0], 0x200);
+    CHECK(poller.wait(ready, 4, 10) == 0);
+  }
+
+  SECTION("Write interest can be added later") {
+    REQUIRE(poller.modify(a[0], 0x100,
+                          platform::IoPoller::in | platform::IoPoller::out));
+    count = poller.wait(ready, 4, 100);
+    REQUIRE(count >= 1);
+    bool writable = false;
+    for (int i = 0; i < count; ++i) {
+      const uint16_t events = ready[i].events;
+      if (ready[i].token == 0x100 && (events & platform::IoPoller::out))
+        writable = true;
+    }
+    CHECK(writable);
+  }
+
+  SECTION("Hang-up is reported as readable") {
+    ::close(a[1]);
+    a[1] = -1;
+    count = poller.wait(ready, 4, 100);
+    bool hangup = false;
+    for (int i = 0; i < count; ++i)
+      if (ready[i].token == 0x100 && (ready[i].events & platform::IoPoller::in))
+        hangup = true;
+    CHECK(hangup);
+  }
+
+  for (int fd : {a[0], a[1], b[0], b[1]})
+    if (fd >= 0) ::close(fd);
+}
+
+TEST_CASE("IoPoller: Re-adding replaces the token", "[platform][poller]") {
+  platform::IoPoller poller;
+  REQUIRE(poller.init());
+
+  int sv[2];
+  REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+
+  REQUIRE(poller.add(sv[0], 1, platform::IoPoller::in));
+  REQUIRE(poller.add(sv[0], 2, platform::IoPoller::in));
+
+  const uint8_t byte = 0x01;
+  REQUIRE(::write(sv[1], &byte, 1) == 1);
+
+  platform::IoPoller::Ready ready[2];
+  REQUIRE(poller.wait(ready, 2, 100) == 1);
+  CHECK(ready[0].token == 2);
+
+  ::close(sv[0]);
+  ::close(sv[1]);
+}
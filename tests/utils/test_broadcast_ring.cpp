@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "utils/broadcast_ring.hpp"
+
+using namespace ebus::detail;
+
+namespace {
+
+std::vector<uint8_t> collect(const BroadcastRing& ring, uint64_t from,
+                             uint64_t to) {
+  BroadcastRing::Segment segments[2];
+  std::vector<uint8_t> bytes;
+  size_t n = ring.segments(from, to, segments);
+  for (size_t i = 0; i < n; ++i)
+    bytes.insert(bytes.end(), segments[i].data,
+                 segments[i].data + segments[i].size);
+  return bytes;
+}
+
+}  // namespace
+
+TEST_CASE("BroadcastRing: capacity is a power of two",
+          "[utils][broadcast_ring]") {
+  CHECK(BroadcastRing(1).capacity() == BroadcastRing::min_capacity);
+  CHECK(BroadcastRing(100).capacity() == 128);
+  CHECK(BroadcastRing(4096).capacity() == 4096);
+  CHECK(BroadcastRing(4096).lagLimit() == 2048);
+}
+
+TEST_CASE("BroadcastRing: readers copy from their own cursor",
+          "[utils][broadcast_ring]") {
+  BroadcastRing ring(64);
+  REQUIRE(ring.head() == 0);
+
+  const uint8_t first[] = {0x10, 0x20, 0x30};
+  ring.append(first, sizeof(first));
+  REQUIRE(ring.head() == 3);
+
+  CHECK(collect(ring, 0, ring.head()) ==
+        std::vector<uint8_t>{0x10, 0x20, 0x30});
+  CHECK(collect(ring, 2, ring.head()) == std::vector<uint8_t>{0x30});
+  CHECK(collect(ring, 3, ring.head()).empty());
+}
+
+TEST_CASE("BroadcastRing: wrapped ranges split into two segments",
+          "[utils][broadcast_ring]") {
+  BroadcastRing ring(64);
+  std::vector<uint8_t> filler(60, 0x00);
+  ring.append(filler.data(), filler.size());
+
+  const uint8_t tail[] = {1, 2, 3, 4, 5, 6, 7, 8};
+  ring.append(tail, sizeof(tail));
+  REQUIRE(ring.head() == 68);
+
+  BroadcastRing::Segment segments[2];
+  REQUIRE(ring.segments(60, 68, segments) == 2);
+  CHECK(segments[0].size == 4);
+  CHECK(segments[1].size == 4);
+  CHECK(collect(ring, 60, 68) ==
+        std::vector<uint8_t>{1, 2, 3, 4, 5, 6, 7, 8});
+}
+
+TEST_CASE("BroadcastRing: lagging readers are detected by distance",
+          "[utils][broadcast_ring]") {
+  BroadcastRing ring(64);
+  std::vector<uint8_t> bytes(32, 0xaa);
+  ring.append(bytes.data(), bytes.size());
+
+  CHECK_FALSE(ring.isLagging(0, ring.head()));
+  ring.append(bytes.data(), 1);
+  CHECK(ring.isLagging(0, ring.head()));
+  CHECK_FALSE(ring.isLagging(1, ring.head()));
+}
+
+TEST_CASE("BroadcastRing: boundaries mark published SYN positions",
+          "[utils][broadcast_ring]") {
+  BroadcastRing ring(64);
+  const uint8_t syn = 0xaa;
+  const uint8_t data = 0x01;
+  uint64_t position = 0;
+
+  ring.append(&data, 1);
+  ring.markBoundary();
+  CHECK_FALSE(ring.nextBoundary(0, position));  // not published yet
+  ring.append(&syn, 1);
+  REQUIRE(ring.nextBoundary(0, position));
+  CHECK(position == 1);
+  CHECK(ring.at(position) == syn);
+  CHECK_FALSE(ring.nextBoundary(2, position));
+
+  // Only the most recent boundaries are remembered
+  for (size_t i = 0; i < BroadcastRing::max_boundaries; ++i) {
+    ring.append(&data, 1);
+    ring.markBoundary();
+    ring.append(&syn, 1);
+  }
+  REQUIRE(ring.nextBoundary(0, position));
+  CHECK(position == 3);
+}
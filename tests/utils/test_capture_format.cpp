@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_all.hpp>
+#include <cstdio>
+#include <vector>
+
+#include "utils/capture_format.hpp"
+#include "utils/capture_reader.hpp"
+
+using namespace ebus;
+using namespace ebus::detail;
+
+namespace {
+
+std::vector<uint8_t> encodeAll(const std::vector<capture::Record>& records,
+                               uint64_t base_us) {
+  std::vector<uint8_t> out;
+  capture::Encoder encoder;
+  encoder.reset(base_us);
+  uint8_t buffer[capture::max_record_size];
+  for (const auto& record : records) {
+    size_t length = encoder.encode(record, buffer);
+    out.insert(out.end(), buffer, buffer + length);
+  }
+  return out;
+}
+
+capture::Record makeRecord(uint64_t ts, uint8_t byte, uint8_t lock = 0) {
+  capture::Record record;
+  record.timestamp_us = ts;
+  record.byte = byte;
+  record.lock_counter = lock;
+  return record;
+}
+
+}  // namespace
+
+TEST_CASE("Capture format: records round trip", "[utils][capture]") {
+  std::vector<capture::Record> records = {makeRecord(1000, 0xaa),
+                                          makeRecord(1000, 0x10),
+                                          makeRecord(5170, 0x08, 3)};
+  records[1].handler_state = HandlerState::release_bus;
+  records[1].request_state = RequestState::second;
+  records[1].result = RequestResult::second_error;
+  records[2].gap = true;
+
+  std::vector<uint8_t> data = encodeAll(records, 1000);
+  // Zero delta: 1 byte varint + byte + states. A 4.17 ms delta needs a
+  // 3 byte varint and the changed lock counter adds 1 byte.
+  CHECK(data.size() == 3 + 3 + 6);
+
+  capture::Decoder decoder(data.data(), data.size(), 1000);
+  capture::Record record;
+  for (const auto& expected : records) {
+    REQUIRE(decoder.next(record));
+    CHECK(record.timestamp_us == expected.timestamp_us);
+    CHECK(record.byte == expected.byte);
+    CHECK(record.handler_state == expected.handler_state);
+    CHECK(record.request_state == expected.request_state);
+    CHECK(record.result == expected.result);
+    CHECK(record.lock_counter == expected.lock_counter);
+    CHECK(record.gap == expected.gap);
+  }
+  CHECK_FALSE(decoder.next(record));
+  CHECK_FALSE(decoder.truncated());
+}
+
+TEST_CASE("Capture format: header and truncated tail", "[utils][capture]") {
+  uint8_t header[capture::header_size];
+  capture::encodeHeader({42, 1700000000000000}, header);
+
+  capture::Header decoded;
+  REQUIRE(capture::decodeHeader(header, sizeof(header), decoded));
+  CHECK(decoded.base_us == 42);
+  CHECK(decoded.wall_us == 1700000000000000);
+  CHECK_FALSE(capture::decodeHeader(header, sizeof(header) - 1, decoded));
+  header[0] = 'X';
+  CHECK_FALSE(capture::decodeHeader(header, sizeof(header), decoded));
+
+  std::vector<uint8_t> data =
+      encodeAll({makeRecord(100, 0x01), makeRecord(300, 0x02)}, 0);
+  capture::Decoder decoder(data.data(), data.size() - 1, 0);
+  capture::Record record;
+  REQUIRE(decoder.next(record));
+  CHECK(record.byte == 0x01);
+  CHECK_FALSE(decoder.next(record));
+  CHECK(decoder.truncated());
+}
+
+TEST_CASE("Capture reader: maps a segment file", "[utils][capture]") {
+  const char* path = "test_capture_reader.ebcap";
+  uint8_t header[capture::header_size];
+  capture::encodeHeader({500, 2000000}, header);
+  std::vector<uint8_t> data =
+      encodeAll({makeRecord(600, 0xaa), makeRecord(900, 0x33)}, 500);
+
+  FILE* file = std::fopen(path, "wb");
+  REQUIRE(file != nullptr);
+  std::fwrite(header, 1, sizeof(header), file);
+  std::fwrite(data.data(), 1, data.size(), file);
+  std::fclose(file);
+
+  CaptureReader reader;
+  REQUIRE(reader.open(path));
+  std::vector<uint64_t> wall;
+  CHECK(reader.forEach([&](const capture::Record& record) {
+    wall.push_back(reader.wallClockUs(record));
+  }) == 2);
+  CHECK(wall == std::vector<uint64_t>{2000100, 2000400});
+  reader.close();
+  std::remove(path);
+
+  CHECK_FALSE(reader.open("does_not_exist.ebcap"));
+}
@@ -193,6 +193,24 @@ TEST_CASE("JSON Utils: Pull-Parser Extraction", "[utils][json]") {
     // 3)
     REQUIRE(cfg.lock_counter == 3);
   }
+
+  SECTION("mergeFromJson parses slow client policies by name") {
+    ebus::RuntimeConfig cfg;
+    REQUIRE(cfg.mergeFromJson(
+        R"({"network": {"readonly_slow_policy": "skip_to_syn",
+                        "enhanced_slow_policy": "disconnect"}})"));
+    REQUIRE(cfg.network.readonly_slow_policy ==
+            ebus::SlowClientPolicy::skip_to_syn);
+    REQUIRE(cfg.network.enhanced_slow_policy ==
+            ebus::SlowClientPolicy::disconnect);
+    REQUIRE(cfg.network.regular_slow_policy ==
+            ebus::SlowClientPolicy::drop_oldest);
+
+    // Unknown names leave the policy unchanged
+    cfg.mergeFromJson(R"({"network": {"regular_slow_policy": "block"}})");
+    REQUIRE(cfg.network.regular_slow_policy ==
+            ebus::SlowClientPolicy::drop_oldest);
+  }
 }
 
 TEST_CASE("JSON Reader: Find and Reset", "[utils][json]") {
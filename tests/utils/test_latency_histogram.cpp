@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_all.hpp>
+
+#include "utils/latency_histogram.hpp"
+#include "utils/timing_stats.hpp"
+
+using namespace ebus::detail;
+
+TEST_CASE("LatencyHistogram: Bucket mapping", "[utils][histogram]") {
+  // Small values are exact
+  for (uint32_t v = 0; v < 2 * LatencyHistogram::sub_bucket_count; ++v) {
+    REQUIRE(LatencyHistogram::bucketIndex(v) == v);
+    REQUIRE(LatencyHistogram::bucketUpperBound(v) == v);
+  }
+
+  SECTION("Every value lies within its bucket bounds") {
+    for (uint32_t v : {16u, 17u, 100u, 4300u, 4999u, 65535u, 1000000u}) {
+      size_t idx = LatencyHistogram::bucketIndex(v);
+      REQUIRE(LatencyHistogram::bucketLowerBound(idx) <= v);
+      REQUIRE(LatencyHistogram::bucketUpperBound(idx) >= v);
+    }
+  }
+
+  SECTION("Indices are monotonic") {
+    size_t prev = 0;
+    for (uint32_t v = 1; v < (1u << 20); v += 37) {
+      size_t idx = LatencyHistogram::bucketIndex(v);
+      REQUIRE(idx >= prev);
+      prev = idx;
+    }
+  }
+
+  SECTION("Out of range values are clamped") {
+    REQUIRE(LatencyHistogram::bucketIndex(0xffffffff) ==
+            LatencyHistogram::bucket_count - 1);
+  }
+}
+
+TEST_CASE("LatencyHistogram: Percentiles", "[utils][histogram]") {
+  LatencyHistogram hist;
+  REQUIRE(hist.valueAtPercentile(50.0f) == 0);
+
+  for (uint32_t v = 1; v <= 1000; ++v) hist.record(v);
+  REQUIRE(hist.getCount() == 1000);
+
+  // Relative error is bounded by the sub-bucket resolution
+  const float tolerance = 1.0f / LatencyHistogram::sub_bucket_count;
+  REQUIRE(hist.valueAtPercentile(50.0f) ==
+          Catch::Approx(500).epsilon(tolerance));
+  REQUIRE(hist.valueAtPercentile(95.0f) ==
+          Catch::Approx(950).epsilon(tolerance));
+  REQUIRE(hist.valueAtPercentile(99.0f) ==
+          Catch::Approx(990).epsilon(tolerance));
+
+  hist.reset();
+  REQUIRE(hist.getCount() == 0);
+}
+
+TEST_CASE("LatencyHistogram: Narrow counters and range",
+          "[utils][histogram]") {
+  // The layout of the per-device response histogram
+  using Histogram = LatencyHistogramImpl<uint16_t, 2, 16>;
+  REQUIRE(Histogram::bucket_count == 60);
+  REQUIRE(Histogram::bucketIndex(7) == 7);
+  REQUIRE(Histogram::bucketIndex(8) == 8);
+  REQUIRE(Histogram::bucketIndex(65535) == Histogram::bucket_count - 1);
+  REQUIRE(Histogram::bucketIndex(70000) == Histogram::bucket_count - 1);
+  REQUIRE(Histogram::bucketUpperBound(Histogram::bucket_count - 1) == 65535);
+  for (uint32_t v = 8; v < 65536; v += 97) {
+    const size_t idx = Histogram::bucketIndex(v);
+    REQUIRE(v <= Histogram::bucketUpperBound(idx));
+    REQUIRE(v > Histogram::bucketUpperBound(idx - 1));
+  }
+
+  // A saturated bucket halves all of them, keeping the distribution
+  Histogram hist;
+  for (int i = 0; i < 3 * 65535; ++i) hist.record(5000);
+  for (int i = 0; i < 1000; ++i) hist.record(100);
+  REQUIRE(hist.getCount() < 65535 + 1000);
+  REQUIRE(hist.valueAtPercentile(50.0f) == 5119);
+  REQUIRE(hist.valueAtPercentile(1.0f) == 111);
+}
+
+TEST_CASE("TimingStats: Percentile window", "[utils][timingstats]") {
+  TimingStats stats;
+  for (int i = 0; i < 99; ++i) stats.addSample(100);
+  stats.addSample(10000);
+
+  auto values = stats.getValues();
+#ifndef EBUS_MINIMAL_DIAGNOSTICS
+  REQUIRE(values.p50_us == Catch::Approx(100).epsilon(0.125));
+  REQUIRE(values.p99_us == Catch::Approx(100).epsilon(0.125));
+  REQUIRE(values.p99_us <= values.max_us);
+
+  stats.resetWindow();
+  stats.addSample(10000);
+  values = stats.getValues();
+  REQUIRE(values.p50_us == Catch::Approx(10000).epsilon(0.125));
+#endif
+  // Cumulative values survive a window reset
+  REQUIRE(values.count == 101);
+  REQUIRE(values.max_us == 10000);
+}
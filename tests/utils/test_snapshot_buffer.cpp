@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <atomic>
+#include <catch2/catch_all.hpp>
+#include <chrono>
+#include <ebus/detail/json_writer.hpp>
+#include <string>
+#include <thread>
+
+#include "core/bus_monitor.hpp"
+#include "utils/snapshot_buffer.hpp"
+
+using namespace ebus::detail;
+
+namespace {
+
+struct Pair {
+  uint64_t a = 0;
+  uint64_t b = 0;
+};
+
+}  // namespace
+
+TEST_CASE("SnapshotBuffer: generations and previous snapshot",
+          "[utils][snapshot_buffer]") {
+  SnapshotBuffer<int, 3> buffer;
+
+  SECTION("Empty buffer") {
+    bool called = false;
+    CHECK_FALSE(buffer.read([&](uint64_t, const int&, const int*) {
+      called = true;
+    }));
+    CHECK_FALSE(called);
+    CHECK(buffer.generation() == 0);
+  }
+
+  SECTION("Latest and previous") {
+    REQUIRE(buffer.publish([](int& v) { v = 10; }));
+    CHECK(buffer.read([](uint64_t generation, const int& current,
+                         const int* previous) {
+      CHECK(generation == 1);
+      CHECK(current == 10);
+      CHECK(previous == nullptr);
+    }));
+
+    for (int i = 2; i <= 5; ++i) {
+      REQUIRE(buffer.publish([i](int& v) { v = i * 10; }));
+    }
+    CHECK(buffer.generation() == 5);
+    CHECK(buffer.read([](uint64_t generation, const int& current,
+                         const int* previous) {
+      CHECK(generation == 5);
+      CHECK(current == 50);
+      REQUIRE(previous != nullptr);
+      CHECK(*previous == 40);
+    }));
+  }
+
+  SECTION("Pinned slots are never reused") {
+    REQUIRE(buffer.publish([](int& v) { v = 1; }));
+    REQUIRE(buffer.publish([](int& v) { v = 2; }));
+
+    buffer.read([&](uint64_t, const int& current, const int* previous) {
+      // Latest and previous are pinned: the only spare slot can be used once
+      CHECK(buffer.publish([](int& v) { v = 3; }));
+      CHECK_FALSE(buffer.publish([](int& v) { v = 4; }));
+      CHECK(current == 2);
+      REQUIRE(previous != nullptr);
+      CHECK(*previous == 1);
+    });
+    CHECK(buffer.skipped() == 1);
+
+    CHECK(buffer.publish([](int& v) { v = 5; }));
+    buffer.read([](uint64_t generation, const int& current, const int*) {
+      CHECK(generation == 4);
+      CHECK(current == 5);
+    });
+  }
+}
+
+TEST_CASE("SnapshotBuffer: concurrent readers see consistent snapshots",
+          "[utils][snapshot_buffer]") {
+  SnapshotBuffer<Pair, 4> buffer;
+  std::atomic<bool> done{false};
+  std::atomic<uint32_t> torn{0};
+
+  std::thread reader([&] {
+    uint64_t last = 0;
+    while (!done.load()) {
+      buffer.read([&](uint64_t generation, const Pair& current,
+                      const Pair* previous) {
+        if (current.b != current.a * 2 || current.a != generation ||
+            generation < last)
+          torn++;
+        if (previous && previous->a + 1 != generation) torn++;
+        last = generation;
+      });
+    }
+  });
+
+  for (uint64_t i = 1; i <= 20000; ++i) {
+    buffer.publish([i](Pair& p) {
+      p.a = i;
+      p.b = i * 2;
+    });
+  }
+  done.store(true);
+  reader.join();
+
+  CHECK(torn.load() == 0);
+}
+
+TEST_CASE("BusMonitor: published metrics snapshots",
+          "[utils][snapshot_buffer]") {
+  BusMonitor monitor;
+  CHECK_FALSE(monitor.fetchSnapshot([](const ebus::MetricsSnapshot&) {}));
+
+  monitor.updateHandler([](auto& m) { m.messages_active = 2; });
+  REQUIRE(monitor.publishSnapshot());
+  monitor.updateHandler([](auto& m) { m.messages_active = 7; });
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  REQUIRE(monitor.publishSnapshot());
+
+  // Updates after publishing are not visible until the next snapshot
+  monitor.updateHandler([](auto& m) { m.messages_active = 9; });
+
+  std::string json;
+  CHECK(monitor.fetchSnapshot([&](const ebus::MetricsSnapshot& snapshot) {
+    CHECK(snapshot.generation == 2);
+    REQUIRE(snapshot.current != nullptr);
+    REQUIRE(snapshot.previous != nullptr);
+    CHECK(snapshot.current->handler.messages_active == 7);
+    CHECK(snapshot.previous->handler.messages_active == 2);
+
+    JsonWriter writer([&](std::string_view chunk) { json += chunk; });
+    snapshot.toJson(writer);
+  }));
+  CHECK(monitor.snapshotGeneration() == 2);
+
+  CHECK(json.find("\"generation\":2") != std::string::npos);
+  CHECK(json.find("\"interval\":{\"interval_us\":") != std::string::npos);
+  CHECK(json.find("\"messages\":5") != std::string::npos);
+}
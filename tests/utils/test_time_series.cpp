@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "utils/time_series.hpp"
+
+using namespace ebus::detail;
+
+namespace {
+
+constexpr uint64_t all = std::numeric_limits<uint64_t>::max();
+
+using Samples = std::vector<std::pair<uint64_t, float>>;
+
+Samples collect(const TimeSeriesStore& store, uint16_t series,
+                uint64_t from = 0, uint64_t to = all) {
+  Samples samples;
+  store.forEach(series, from, to, [&samples](uint64_t t, float v) {
+    samples.emplace_back(t, v);
+  });
+  return samples;
+}
+
+bool sameBits(float a, float b) { return std::memcmp(&a, &b, sizeof a) == 0; }
+
+}  // namespace
+
+TEST_CASE("TimeSeriesStore: Lossless round trip", "[utils][timeseries]") {
+  TimeSeriesStore store;
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> jitter(-400, 400);
+  std::uniform_int_distribution<int> gap(0, 20);
+  std::uniform_real_distribution<float> noise(-1000.0f, 1000.0f);
+
+  // Regular intervals with jitter, occasional long gaps, repeated, slowly
+  // changing and random values
+  Samples expected;
+  uint64_t t = 1700000000000ull;
+  float value = 20.0f;
+  for (int i = 0; i < 600; ++i) {
+    t += 10000 + jitter(rng) + (gap(rng) == 0 ? 3600000 : 0);
+    if (i % 3 == 1) value += 0.0625f;
+    if (i % 50 == 0) value = noise(rng);
+    expected.emplace_back(t, value);
+    REQUIRE(store.append(1, t, value));
+  }
+  expected.emplace_back(t, -0.0f);  // same timestamp, sign bit only
+  REQUIRE(store.append(1, t, -0.0f));
+
+  const Samples samples = collect(store, 1);
+  REQUIRE(samples.size() == expected.size());
+  size_t mismatches = 0;
+  for (size_t i = 0; i < samples.size(); ++i)
+    if (samples[i].first != expected[i].first ||
+        !sameBits(samples[i].second, expected[i].second))
+      ++mismatches;
+  REQUIRE(mismatches == 0);
+  REQUIRE(store.sampleCount() == expected.size());
+
+  // Out of order samples are rejected
+  REQUIRE_FALSE(store.append(1, t - 1, 1.0f));
+  REQUIRE_FALSE(store.append(0, t, 1.0f));
+}
+
+TEST_CASE("TimeSeriesStore: Compression", "[utils][timeseries]") {
+  TimeSeriesStore store;
+
+  // A temperature reported every 10 s that rarely changes
+  uint64_t t = 0;
+  for (int i = 0; i < 2000; ++i) {
+    t += 10000;
+    store.append(1, t, 40.0f + static_cast<float>(i / 100) * 0.5f);
+  }
+
+  const double bytes_per_sample =
+      static_cast<double>(store.blockCount() * TimeSeriesStore::block_bytes) /
+      store.sampleCount();
+  REQUIRE(store.sampleCount() == 2000);
+  REQUIRE(bytes_per_sample < 0.5);
+}
+
+TEST_CASE("TimeSeriesStore: Range queries and downsampling",
+          "[utils][timeseries]") {
+  TimeSeriesStore store;
+  for (uint64_t t = 1000; t <= 10000; t += 1000)
+    store.append(3, t, static_cast<float>(t / 1000));
+  store.append(4, 5500, 99.0f);
+
+  const Samples range = collect(store, 3, 2500, 5000);
+  REQUIRE(range.size() == 3);
+  REQUIRE(range.front().first == 3000);
+  REQUIRE(range.back().second == 5.0f);
+  REQUIRE(collect(store, 3, 6000, 5000).empty());
+  REQUIRE(collect(store, 5).empty());
+
+  std::vector<TimeSeriesStore::Bucket> buckets;
+  store.downsample(3, 0, all, 4000,
+                   [&buckets](const TimeSeriesStore::Bucket& bucket) {
+                     buckets.push_back(bucket);
+                   });
+  REQUIRE(buckets.size() == 3);
+  REQUIRE(buckets[0].start == 0);
+  REQUIRE(buckets[0].count == 3);  // 1, 2, 3
+  REQUIRE(buckets[1].start == 4000);
+  REQUIRE(buckets[1].min == 4.0f);
+  REQUIRE(buckets[1].max == 7.0f);
+  REQUIRE(buckets[1].mean == Catch::Approx(5.5f));
+  REQUIRE(buckets[2].count == 3);  // 8, 9, 10
+
+  store.erase(3);
+  REQUIRE(collect(store, 3).empty());
+  REQUIRE(collect(store, 4).size() == 1);
+}
+
+TEST_CASE("TimeSeriesStore: Memory cap evicts the oldest blocks",
+          "[utils][timeseries]") {
+  TimeSeriesStore store;
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<float> noise(0.0f, 100.0f);
+
+  // The whole pool is reserved with the first sample
+  REQUIRE(store.memoryUsage() == 0);
+  store.append(1, 0, 0.0f);
+  REQUIRE(store.memoryUsage() == TimeSeriesStore::capacity());
+
+  // Noisy values fill blocks quickly
+  uint64_t t = 0;
+  for (int i = 0; i < 20000; ++i) {
+    t += 1000;
+    store.append(static_cast<uint16_t>(1 + i % 2), t, noise(rng));
+  }
+
+  REQUIRE(store.memoryUsage() == TimeSeriesStore::capacity());
+  REQUIRE(store.memoryUsage() <= ebus::detail::HistoryLimits::max_bytes);
+  REQUIRE(store.evictions() > 0);
+
+  // The newest samples survive, continuous up to the last one
+  const Samples samples = collect(store, 2);
+  REQUIRE_FALSE(samples.empty());
+  REQUIRE(samples.back().first == t);
+  for (size_t i = 1; i < samples.size(); ++i)
+    REQUIRE(samples[i].first - samples[i - 1].first == 2000);
+
+  store.clear();
+  REQUIRE(store.memoryUsage() == 0);
+  REQUIRE(store.sampleCount() == 0);
+}
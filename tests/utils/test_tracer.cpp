@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2026 Roland Jax
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <catch2/catch_all.hpp>
+#include <ebus/detail/json_writer.hpp>
+#include <string>
+#include <thread>
+
+#include "utils/tracer.hpp"
+
+using namespace ebus::detail;
+
+namespace {
+
+std::string dump() {
+  std::string out;
+  JsonWriter writer([&](std::string_view chunk) { out += chunk; });
+  Tracer::getInstance().toJson(writer);
+  return out;
+}
+
+size_t count(const std::string& haystack, const std::string& needle) {
+  size_t n = 0;
+  for (size_t pos = haystack.find(needle); pos != std::string::npos;
+       pos = haystack.find(needle, pos + needle.size()))
+    ++n;
+  return n;
+}
+
+}  // namespace
+
+TEST_CASE("Tracer: Chrome trace-event export", "[utils][tracer]") {
+  Tracer& tracer = Tracer::getInstance();
+  tracer.clear();
+
+  std::thread worker([&] {
+    tracer.setThreadName("test_worker");
+    tracer.complete("test.scope", 1000, 1250);
+    tracer.instant("test.instant");
+  });
+  worker.join();
+
+  std::string json = dump();
+  CHECK(json.rfind("{\"traceEvents\":[", 0) == 0);
+  CHECK(json.find("\"name\":\"thread_name\",\"ph\":\"M\"") !=
+        std::string::npos);
+  CHECK(json.find("\"args\":{\"name\":\"test_worker\"}") != std::string::npos);
+  CHECK(json.find("{\"name\":\"test.scope\",\"cat\":\"ebus\",\"ph\":\"X\","
+                  "\"ts\":1000,\"dur\":250,") != std::string::npos);
+  CHECK(json.find("{\"name\":\"test.instant\",\"cat\":\"ebus\",\"ph\":\"i\",")
+        != std::string::npos);
+  CHECK(json.find("\"displayTimeUnit\":\"ms\"}") != std::string::npos);
+
+  tracer.clear();
+  CHECK(dump().find("test.scope") == std::string::npos);
+}
+
+TEST_CASE("Tracer: rings keep the latest events", "[utils][tracer]") {
+  Tracer& tracer = Tracer::getInstance();
+  tracer.clear();
+
+  std::thread worker([&] {
+    tracer.setThreadName("test_wrap");
+    for (size_t i = 0; i < TraceLimits::events_per_thread + 10; ++i)
+      tracer.complete("test.wrap", i, i + 1);
+  });
+  worker.join();
+
+  std::string json = dump();
+  CHECK(count(json, "\"name\":\"test.wrap\"") ==
+        TraceLimits::events_per_thread);
+  CHECK(json.find("\"ts\":9,") == std::string::npos);
+  CHECK(json.find("\"ts\":10,") != std::string::npos);
+  CHECK(tracer.untracedThreads() == 0);
+}
@@ -9,6 +9,8 @@
 // and output to standard output. Various formatting options are available for
 // attractive output. Dumping of binary values ​​is also supported.
 // It automatically detects and supports the ebusd Enhanced Protocol.
+// Binary capture segments (*.ebcap) are detected by their header and replayed
+// with their recorded timestamps.
 // attractive output. Dumping of binary values ​​is also supported.
 
 #include <arpa/inet.h>
@@ -38,6 +40,7 @@
 
 #include "app/enhanced_protocol.hpp"
 #include "core/telegram.hpp"
+#include "utils/capture_reader.hpp"
 
 using namespace ebus::detail;
 
@@ -67,6 +70,9 @@ bool json_output = false;
 bool pretty = false;
 bool status_report = false;
 
+// Wall clock of the replayed capture record (0 = use the current time)
+uint64_t replay_wall_us = 0;
+
 struct {
   uint32_t total = 0;
   uint32_t valid = 0;
@@ -78,7 +84,10 @@ const char* timestamp() {
   struct timeval tv;
   struct tm tm;
 
-  if (gettimeofday(&tv, nullptr) != 0) {
+  if (replay_wall_us != 0) {
+    tv.tv_sec = static_cast<time_t>(replay_wall_us / 1000000);
+    tv.tv_usec = static_cast<suseconds_t>(replay_wall_us % 1000000);
+  } else if (gettimeofday(&tv, nullptr) != 0) {
     std::cerr << "the current time could not be retrieved" << std::endl;
     std::exit(EXIT_FAILURE);
   }
@@ -452,6 +461,26 @@ void run(const char* hostname, const char* port, int max_retries = 5) {
   }
 }
 
+bool replayCapture(const char* path) {
+  CaptureReader reader;
+  if (!reader.open(path)) return false;
+
+  capture::Decoder decoder = reader.records();
+  capture::Record record;
+  while (decoder.next(record)) {
+    if (record.gap && !noerror)
+      std::cerr << "capture gap: records were dropped" << std::endl;
+    replay_wall_us = reader.wallClockUs(record);
+    collect(record.byte);
+  }
+  replay_wall_us = 0;
+
+  if (decoder.truncated() && !noerror)
+    std::cerr << "capture '" << path << "' ends with a truncated record"
+              << std::endl;
+  return true;
+}
+
 void usage() {
   std::cout << "Usage: ebusread [options] <stdin|device|file|host:port>";
   std::cout << std::endl;
@@ -544,7 +573,9 @@ int main(int argc, char* argv[]) {
   if (argv[optind] != nullptr) {
     std::string tmp = argv[optind];
     size_t pos = tmp.find(':');
-    if (pos == std::string::npos) {
+    if (pos == std::string::npos && replayCapture(argv[optind])) {
+      // Binary capture segment, replayed with recorded timestamps
+    } else if (pos == std::string::npos) {
       std::ifstream stream(argv[optind], std::ios::binary);
       if (stream.is_open() == true) {
         while (stream.peek() != EOF) {